@@ -0,0 +1,169 @@
+#!/usr/bin/env python3
+"""Converts a BDF bitmap font into a constexpr glyph atlas header for the dash library.
+
+Only the requested characters are kept. Each glyph is stored as 1 bit per pixel rows,
+most significant bit on the left, ceil(width / 8) bytes per row, and every glyph is
+placed in a cell of the font height so the blitter never has to look at baselines.
+
+Usage:
+    python3 .scripts/python/generate_glyphs.py lib/dash/fonts/dash_5x7.bdf \
+        lib/dash/fonts/dash_5x7.h --name DASH_5X7 --chars " %-./0123456789:ACEORSTVW"
+
+Only the standard library is used, so it runs anywhere PlatformIO does.
+"""
+
+import argparse
+import os
+import sys
+
+FIRST = 0x20
+LAST = 0x7E
+
+
+def parse_bdf(path):
+    ascent = descent = None
+    glyphs = {}
+    with open(path, "r", encoding="ascii") as source:
+        lines = iter(source.read().splitlines())
+
+    for line in lines:
+        fields = line.split()
+        if not fields:
+            continue
+        if fields[0] == "FONT_ASCENT":
+            ascent = int(fields[1])
+        elif fields[0] == "FONT_DESCENT":
+            descent = int(fields[1])
+        elif fields[0] == "STARTCHAR":
+            glyph = {"encoding": None, "advance": None, "bbx": None, "rows": []}
+            for line in lines:
+                fields = line.split()
+                if fields[0] == "ENCODING":
+                    glyph["encoding"] = int(fields[1])
+                elif fields[0] == "DWIDTH":
+                    glyph["advance"] = int(fields[1])
+                elif fields[0] == "BBX":
+                    glyph["bbx"] = tuple(int(value) for value in fields[1:5])
+                elif fields[0] == "BITMAP":
+                    for line in lines:
+                        if line.strip() == "ENDCHAR":
+                            break
+                        glyph["rows"].append(int(line.strip(), 16))
+                    break
+            if None in (glyph["encoding"], glyph["advance"], glyph["bbx"]):
+                sys.exit("%s: incomplete glyph definition" % path)
+            glyphs[glyph["encoding"]] = glyph
+
+    if ascent is None or descent is None:
+        sys.exit("%s: FONT_ASCENT and FONT_DESCENT are required" % path)
+    return ascent, descent, glyphs
+
+
+def pack(glyph, ascent, height):
+    glyph_width, rows, x_offset, y_offset = glyph["bbx"]
+    if x_offset < 0:
+        sys.exit("glyph %d: negative x offset is not supported" % glyph["encoding"])
+    width = glyph_width + x_offset
+    stride = (width + 7) // 8
+    top = ascent - rows - y_offset
+    if top < 0 or top + rows > height:
+        sys.exit("glyph %d: outside the font ascent and descent" % glyph["encoding"])
+
+    # BDF rows are padded to whole bytes, MSB first
+    padding = ((glyph_width + 7) // 8) * 8 - glyph_width
+    data = []
+    for y in range(height):
+        bits = 0
+        if top <= y < top + rows:
+            bits = (glyph["rows"][y - top] >> padding) << (stride * 8 - width)
+        data.extend((bits >> (8 * (stride - 1 - i))) & 0xFF for i in range(stride))
+    return width, stride, data
+
+
+def printable(code):
+    character = chr(code)
+    return "'\\\\'" if character == "\\" else "'\\''" if character == "'" else "'%s'" % character
+
+
+def generate(args):
+    ascent, descent, glyphs = parse_bdf(args.font)
+    height = ascent + descent
+    chars = sorted(set(args.chars)) if args.chars else [chr(code) for code in sorted(glyphs)]
+
+    entries = []
+    bitmaps = []
+    for character in chars:
+        code = ord(character)
+        if code < FIRST or code > LAST:
+            sys.exit("%r: only printable ASCII is supported" % character)
+        if code not in glyphs:
+            sys.exit("%r: not in %s" % (character, args.font))
+        width, stride, data = pack(glyphs[code], ascent, height)
+        entries.append((code, width, glyphs[code]["advance"], len(bitmaps)))
+        bitmaps.extend(data)
+
+    index = [0xFF] * (LAST - FIRST + 1)
+    for position, entry in enumerate(entries):
+        index[entry[0] - FIRST] = position
+
+    guard = "DASH_FONTS_%s_H" % args.name
+    lines = [
+        "// Generated by .scripts/python/generate_glyphs.py from %s, do not edit." % os.path.basename(args.font),
+        "#ifndef %s" % guard,
+        "#define %s" % guard,
+        "",
+        "#include <stdint.h>",
+        "",
+        '#include "../font.h"',
+        "",
+        "namespace Dash {",
+        "namespace Fonts {",
+        "",
+        "constexpr uint8_t %s_BITMAPS[] = {" % args.name,
+    ]
+    for code, width, advance, offset in entries:
+        stride = (width + 7) // 8
+        data = bitmaps[offset:offset + stride * height]
+        lines.append("    %s // %s" % (" ".join("0x%02X," % value for value in data), printable(code)))
+    lines += [
+        "};",
+        "",
+        "constexpr Glyph %s_GLYPHS[] = {" % args.name,
+    ]
+    for code, width, advance, offset in entries:
+        lines.append("    { %d, %d, %d }, // %s" % (width, advance, offset, printable(code)))
+    lines += [
+        "};",
+        "",
+        "// Glyph index for each printable ASCII character, NO_GLYPH if it is not in the subset",
+        "constexpr uint8_t %s_INDEX[] = {" % args.name,
+    ]
+    for row in range(0, len(index), 16):
+        lines.append("    " + " ".join("%d," % value if value != 0xFF else "NO_GLYPH," for value in index[row:row + 16]))
+    lines += [
+        "};",
+        "",
+        "constexpr Font %s = { %d, %s_GLYPHS, %s_BITMAPS, %s_INDEX };" % (args.name, height, args.name, args.name, args.name),
+        "",
+        "} // namespace Fonts",
+        "} // namespace Dash",
+        "",
+        "#endif // %s" % guard,
+        "",
+    ]
+
+    with open(args.output, "w", encoding="ascii", newline="\n") as output:
+        output.write("\n".join(lines))
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("font", help="BDF font to convert")
+    parser.add_argument("output", help="header to write")
+    parser.add_argument("--name", required=True, help="C++ identifier of the font, e.g. DASH_5X7")
+    parser.add_argument("--chars", help="characters to keep, all glyphs in the font if omitted")
+    generate(parser.parse_args())
+
+
+if __name__ == "__main__":
+    main()
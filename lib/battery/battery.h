@@ -2,6 +2,9 @@
 #ifndef BATTERY_H
 #define BATTERY_H
 
+#include "kernels.h"
 #include "messages.h"
+#include "pack.h"
+#include "soc.h"
 
 #endif // BATTERY_H
\ No newline at end of file
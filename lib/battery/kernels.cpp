@@ -0,0 +1,95 @@
+#include "kernels.h"
+
+namespace Battery {
+
+void statistics(const uint16_t* __restrict values, uint32_t count, VoltageStatistics& out) {
+    if (count == 0) {
+        out = {};
+        return;
+    }
+
+    uint16_t min = UINT16_MAX;
+    uint16_t max = 0;
+    uint32_t sum = 0;
+    for (uint32_t i = 0; i < count; i++) {
+        uint16_t v = values[i];
+        min = v < min ? v : min;
+        max = v > max ? v : max;
+        sum += v;
+    }
+
+    out.min = min;
+    out.max = max;
+    out.mean = (uint16_t)(sum / count);
+    out.spread = (uint16_t)(max - min);
+}
+
+void statistics(const int8_t* __restrict values, uint32_t count, TemperatureStatistics& out) {
+    if (count == 0) {
+        out = {};
+        return;
+    }
+
+    int8_t min = INT8_MAX;
+    int8_t max = INT8_MIN;
+    int32_t sum = 0;
+    for (uint32_t i = 0; i < count; i++) {
+        int8_t v = values[i];
+        min = v < min ? v : min;
+        max = v > max ? v : max;
+        sum += v;
+    }
+
+    out.min = min;
+    out.max = max;
+    // Floor division so negative means round the same way as positive ones
+    int32_t mean = sum >= 0 ? sum / (int32_t)count : -((-sum + (int32_t)count - 1) / (int32_t)count);
+    out.mean = (int8_t)mean;
+    out.spread = (uint8_t)(max - min);
+}
+
+uint32_t flag_range(const uint16_t* __restrict values, uint32_t count, uint16_t low, uint16_t high, uint8_t low_flag, uint8_t high_flag, uint8_t* __restrict flags) {
+    uint32_t flagged = 0;
+    for (uint32_t i = 0; i < count; i++) {
+        uint8_t flag = (uint8_t)((values[i] < low ? low_flag : 0) | (values[i] > high ? high_flag : 0));
+        flags[i] = flag;
+        flagged += flag != 0;
+    }
+    return flagged;
+}
+
+uint32_t flag_range(const int8_t* __restrict values, uint32_t count, int8_t low, int8_t high, uint8_t low_flag, uint8_t high_flag, uint8_t* __restrict flags) {
+    uint32_t flagged = 0;
+    for (uint32_t i = 0; i < count; i++) {
+        uint8_t flag = (uint8_t)((values[i] < low ? low_flag : 0) | (values[i] > high ? high_flag : 0));
+        flags[i] = flag;
+        flagged += flag != 0;
+    }
+    return flagged;
+}
+
+uint32_t flag_stale(const uint32_t* __restrict last_seen, uint32_t count, uint32_t now, uint32_t timeout, uint8_t flag, uint8_t* __restrict flags) {
+    uint32_t stale = 0;
+    for (uint32_t i = 0; i < count; i++) {
+        uint32_t expired = now - last_seen[i] > timeout;
+        flags[i] |= (uint8_t)(expired ? flag : 0);
+        stale += expired;
+    }
+    return stale;
+}
+
+uint32_t find(const uint16_t* values, uint32_t count, uint16_t value) {
+    for (uint32_t i = 0; i < count; i++) {
+        if (values[i] == value) return i;
+    }
+    return count;
+}
+
+uint32_t find(const int8_t* values, uint32_t count, int8_t value) {
+    for (uint32_t i = 0; i < count; i++) {
+        if (values[i] == value) return i;
+    }
+    return count;
+}
+
+} // namespace Battery
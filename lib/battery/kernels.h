@@ -0,0 +1,64 @@
+#ifndef BATTERY_KERNELS_H
+#define BATTERY_KERNELS_H
+
+#include <stdint.h>
+
+namespace Battery {
+
+/**
+ * Pack scan kernels over structure-of-arrays cell storage.
+ *
+ * Every kernel is a single pass over contiguous arrays without branches in the loop body,
+ * the shape compilers vectorize (check with -fopt-info-vec-optimized). Storage is aligned
+ * to 16 bytes so a hand written 128-bit SIMD variant can replace any of them as is.
+ */
+
+/**
+ * @param mean: Mean rounded down
+ * @param spread: max - min
+ **/
+struct VoltageStatistics {
+    uint16_t min;
+    uint16_t max;
+    uint16_t mean;
+    uint16_t spread;
+};
+
+struct TemperatureStatistics {
+    int8_t min;
+    int8_t max;
+    int8_t mean;
+    uint8_t spread;
+};
+
+/**
+ * @brief Min, max, mean and spread of a column, all zero when count is 0
+ **/
+void statistics(const uint16_t* values, uint32_t count, VoltageStatistics& out);
+void statistics(const int8_t* values, uint32_t count, TemperatureStatistics& out);
+
+/**
+ * @brief Flags values outside [low, high], overwriting flags
+ * @param low_flag Flag set on values below low
+ * @param high_flag Flag set on values above high
+ * @returns The number of values flagged
+ **/
+uint32_t flag_range(const uint16_t* values, uint32_t count, uint16_t low, uint16_t high, uint8_t low_flag, uint8_t high_flag, uint8_t* flags);
+uint32_t flag_range(const int8_t* values, uint32_t count, int8_t low, int8_t high, uint8_t low_flag, uint8_t high_flag, uint8_t* flags);
+
+/**
+ * @brief Adds a flag to entries not updated within a timeout
+ * @param last_seen Update times in milliseconds, wrapping
+ * @returns The number of entries flagged as stale
+ **/
+uint32_t flag_stale(const uint32_t* last_seen, uint32_t count, uint32_t now, uint32_t timeout, uint8_t flag, uint8_t* flags);
+
+/**
+ * @returns The index of the first occurrence of value, or count if it is not present
+ **/
+uint32_t find(const uint16_t* values, uint32_t count, uint16_t value);
+uint32_t find(const int8_t* values, uint32_t count, int8_t value);
+
+} // namespace Battery
+
+#endif // BATTERY_KERNELS_H
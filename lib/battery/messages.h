@@ -170,4 +170,51 @@ struct Message18FF50E5 {
     uint64_t reserved : 64;
 };
 
+/**
+ * ID: 0x036
+ * @name Cell Broadcast
+ * @note Sent once per cell in turn, so the whole pack is covered every cycle. Unlike the
+ * configurable messages this layout is fixed by Orion and big-endian, so every 16-bit
+ * value arrives as a high and a low byte.
+ * @param cellId: Cell index, starting at 0
+ * @param instantVoltage: Instantaneous cell voltage in 0.1 mV
+ * @param internalResistance: Cell internal resistance in 0.01 mOhm, 15 bits
+ * @param shunting: 1 if the cell is being balanced, 0 otherwise, top bit of byte 3
+ * @param openVoltage: Estimated open cell voltage in 0.1 mV
+ * @param checksum: Low byte of the sum of the ID, the length and the first 7 bytes
+ */
+struct Message36 {
+    uint64_t cellId : 8;
+    uint64_t instantVoltageHigh : 8;
+    uint64_t instantVoltageLow : 8;
+    uint64_t internalResistanceHigh : 7;
+    uint64_t shunting : 1;
+    uint64_t internalResistanceLow : 8;
+    uint64_t openVoltageHigh : 8;
+    uint64_t openVoltageLow : 8;
+    uint64_t checksum : 8;
+};
+
+/**
+ * ID: 0x1838F380
+ * @name Thermistor Module General Broadcast
+ * @note Sent once per thermistor in turn by the thermistor expansion module.
+ * @param thermistorId: Thermistor index across all modules, starting at 0
+ * @param temperature: Thermistor temperature in degrees C, signed
+ * @param moduleThermistorId: Thermistor index within its module
+ * @param lowestTemperature: Lowest temperature of the module in degrees C, signed
+ * @param highestTemperature: Highest temperature of the module in degrees C, signed
+ * @param highestThermistorId: Index of the hottest thermistor
+ * @param lowestThermistorId: Index of the coldest thermistor
+ */
+struct Message1838F380 {
+    uint64_t thermistorId : 16;
+    uint64_t temperature : 8;
+    uint64_t moduleThermistorId : 8;
+    uint64_t lowestTemperature : 8;
+    uint64_t highestTemperature : 8;
+    uint64_t highestThermistorId : 8;
+    uint64_t lowestThermistorId : 8;
+};
+
 #endif // BATTERY_MESSAGES_H
\ No newline at end of file
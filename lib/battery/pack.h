@@ -0,0 +1,209 @@
+#ifndef BATTERY_PACK_H
+#define BATTERY_PACK_H
+
+#include <stdint.h>
+#include <cstring>
+
+#include "core/core.h"
+#include "can/can.h"
+#include "kernels.h"
+#include "messages.h"
+
+namespace Battery {
+
+// Identifiers of the Orion per-cell and per-thermistor broadcasts, as configured on the BMS.
+constexpr uint32_t CELL_BROADCAST_ID = 0x036;
+constexpr uint32_t THERMISTOR_BROADCAST_ID = 0x1838F380;
+
+/**
+ * @brief Checksum of an Orion cell broadcast
+ * @returns The low byte of the sum of the identifier, the length and the first 7 data bytes
+ **/
+inline uint8_t cell_broadcast_checksum(const uint8_t* data) {
+    uint32_t sum = CELL_BROADCAST_ID + 8;
+    for (uint32_t i = 0; i < 7; i++) {
+        sum += data[i];
+    }
+    return (uint8_t)sum;
+}
+
+/**
+ * Bits of the per-cell and per-thermistor flags.
+ */
+namespace Flag {
+    constexpr uint8_t UNDER_VOLTAGE = 1U << 0;
+    constexpr uint8_t OVER_VOLTAGE = 1U << 1;
+    constexpr uint8_t UNDER_TEMPERATURE = 1U << 2;
+    constexpr uint8_t OVER_TEMPERATURE = 1U << 3;
+    constexpr uint8_t STALE = 1U << 4;      /**< No broadcast within the timeout, including never received */
+}
+
+/**
+ * @brief Result of a full pack scan
+ * @param cells_flagged: Cells out of limits or stale
+ * @param thermistors_flagged: Thermistors out of limits or stale
+ **/
+struct PackSummary {
+    VoltageStatistics voltage;
+    TemperatureStatistics temperature;
+    uint16_t min_voltage_cell;
+    uint16_t max_voltage_cell;
+    uint16_t min_temperature_thermistor;
+    uint16_t max_temperature_thermistor;
+    uint16_t cells_flagged;
+    uint16_t thermistors_flagged;
+
+    bool ok() const { return cells_flagged == 0 && thermistors_flagged == 0; }
+};
+
+/**
+ * @brief Per-cell state of an Orion BMS pack (EV 2.11.4)
+ *
+ * Cell and thermistor broadcasts are demultiplexed into one array per quantity, so a scan of
+ * the pack is a handful of linear passes through the kernels in kernels.h. Every cell and
+ * thermistor must keep reporting, anything silent for longer than the timeout is flagged.
+ * Cell broadcasts that are not 8 bytes long or fail their checksum are counted and dropped.
+ *
+ * Not synchronized, dispatch and scan from the same task.
+ *
+ * @tparam Cells Number of cells in series
+ * @tparam Thermistors Number of cell thermistors
+ **/
+template<uint16_t Cells, uint16_t Thermistors>
+class Pack {
+    static_assert(Cells > 0 && Thermistors > 0, "A pack needs cells and thermistors");
+
+public:
+    struct Limits {
+        uint16_t min_voltage;       /**< 0.1 mV */
+        uint16_t max_voltage;       /**< 0.1 mV */
+        int8_t min_temperature;     /**< degrees C */
+        int8_t max_temperature;     /**< degrees C */
+        uint32_t timeout_ms;        /**< Longest accepted time between broadcasts of one cell */
+    };
+
+    static constexpr uint16_t CELLS = Cells;
+    static constexpr uint16_t THERMISTORS = Thermistors;
+
+    Limits limits = { 28000, 42000, -20, 60, 1000 };
+
+    explicit Pack(Core::iClockStrategy* clock) : m_clock(clock), m_rejected(0) {
+        memset(m_voltage, 0, sizeof(m_voltage));
+        memset(m_open_voltage, 0, sizeof(m_open_voltage));
+        memset(m_resistance, 0, sizeof(m_resistance));
+        memset(m_temperature, 0, sizeof(m_temperature));
+        memset(m_cell_flags, 0, sizeof(m_cell_flags));
+        memset(m_thermistor_flags, 0, sizeof(m_thermistor_flags));
+
+        // Nothing has been heard yet, so everything starts out stale
+        uint32_t never = now_ms() - limits.timeout_ms - 1;
+        for (uint32_t i = 0; i < Cells; i++) m_cell_seen[i] = never;
+        for (uint32_t i = 0; i < Thermistors; i++) m_thermistor_seen[i] = never;
+    }
+
+    /**
+     * @brief Stores a cell or thermistor broadcast
+     * @returns true if the frame was a valid broadcast for a cell or thermistor of the pack, false otherwise
+     **/
+    bool dispatch(const CAN::Frame& frame) {
+        if (frame.identifier == CELL_BROADCAST_ID && !frame.extd) {
+            if (frame.data_length_code != 8 || frame.data[7] != cell_broadcast_checksum(frame.data)) {
+                m_rejected++;
+                return false;
+            }
+            Message36 message;
+            memcpy(&message, frame.data, sizeof(message));
+            uint32_t cell = message.cellId;
+            if (cell >= Cells) return false;
+            m_voltage[cell] = (uint16_t)(message.instantVoltageHigh << 8 | message.instantVoltageLow);
+            m_open_voltage[cell] = (uint16_t)(message.openVoltageHigh << 8 | message.openVoltageLow);
+            m_resistance[cell] = (uint16_t)(message.internalResistanceHigh << 8 | message.internalResistanceLow);
+            m_cell_seen[cell] = now_ms();
+            return true;
+        }
+
+        if (frame.identifier == THERMISTOR_BROADCAST_ID && frame.extd) {
+            Message1838F380 message;
+            memcpy(&message, frame.data, sizeof(message));
+            uint32_t thermistor = message.thermistorId;
+            if (thermistor >= Thermistors) return false;
+            m_temperature[thermistor] = (int8_t)(uint8_t)message.temperature;
+            m_thermistor_seen[thermistor] = now_ms();
+            return true;
+        }
+
+        return false;
+    }
+
+    /**
+     * @brief Computes the pack statistics and refreshes every flag
+     **/
+    PackSummary scan() {
+        PackSummary summary;
+        uint32_t now = now_ms();
+
+        statistics(m_voltage, Cells, summary.voltage);
+        flag_range(m_voltage, Cells, limits.min_voltage, limits.max_voltage, Flag::UNDER_VOLTAGE, Flag::OVER_VOLTAGE, m_cell_flags);
+        flag_stale(m_cell_seen, Cells, now, limits.timeout_ms, Flag::STALE, m_cell_flags);
+        summary.cells_flagged = (uint16_t)count_flagged(m_cell_flags, Cells);
+
+        statistics(m_temperature, Thermistors, summary.temperature);
+        flag_range(m_temperature, Thermistors, limits.min_temperature, limits.max_temperature, Flag::UNDER_TEMPERATURE, Flag::OVER_TEMPERATURE, m_thermistor_flags);
+        flag_stale(m_thermistor_seen, Thermistors, now, limits.timeout_ms, Flag::STALE, m_thermistor_flags);
+        summary.thermistors_flagged = (uint16_t)count_flagged(m_thermistor_flags, Thermistors);
+
+        summary.min_voltage_cell = (uint16_t)find(m_voltage, Cells, summary.voltage.min);
+        summary.max_voltage_cell = (uint16_t)find(m_voltage, Cells, summary.voltage.max);
+        summary.min_temperature_thermistor = (uint16_t)find(m_temperature, Thermistors, summary.temperature.min);
+        summary.max_temperature_thermistor = (uint16_t)find(m_temperature, Thermistors, summary.temperature.max);
+        return summary;
+    }
+
+    // Columns in 0.1 mV, 0.01 mOhm and degrees C, indexed by cell or thermistor.
+    const uint16_t* voltages() const { return m_voltage; }
+    const uint16_t* open_voltages() const { return m_open_voltage; }
+    const uint16_t* resistances() const { return m_resistance; }
+    const int8_t* temperatures() const { return m_temperature; }
+
+    // Flags from the latest scan.
+    uint8_t cell_flags(uint16_t cell) const { return m_cell_flags[cell]; }
+    uint8_t thermistor_flags(uint16_t thermistor) const { return m_thermistor_flags[thermistor]; }
+
+    // Cell broadcasts dropped for their length or checksum.
+    uint32_t rejected() const { return m_rejected; }
+
+private:
+    Core::iClockStrategy* m_clock;
+    uint32_t m_rejected;
+
+    alignas(16) uint16_t m_voltage[Cells];
+    alignas(16) uint16_t m_open_voltage[Cells];
+    alignas(16) uint16_t m_resistance[Cells];
+    alignas(16) uint32_t m_cell_seen[Cells];
+    alignas(16) uint8_t m_cell_flags[Cells];
+    alignas(16) int8_t m_temperature[Thermistors];
+    alignas(16) uint32_t m_thermistor_seen[Thermistors];
+    alignas(16) uint8_t m_thermistor_flags[Thermistors];
+
+    uint32_t now_ms() {
+        return (uint32_t)(m_clock->micros() / 1000);
+    }
+
+    static uint32_t count_flagged(const uint8_t* flags, uint32_t count) {
+        uint32_t flagged = 0;
+        for (uint32_t i = 0; i < count; i++) {
+            flagged += flags[i] != 0;
+        }
+        return flagged;
+    }
+};
+
+template<uint16_t Cells, uint16_t Thermistors>
+constexpr uint16_t Pack<Cells, Thermistors>::CELLS;
+
+template<uint16_t Cells, uint16_t Thermistors>
+constexpr uint16_t Pack<Cells, Thermistors>::THERMISTORS;
+
+} // namespace Battery
+
+#endif // BATTERY_PACK_H
@@ -0,0 +1,138 @@
+#include "soc.h"
+
+namespace Battery {
+
+constexpr int64_t SocEstimator::MS_PER_HOUR;
+
+// Typical NMC cell at rest
+static const SocEstimator::OcvPoint DEFAULT_OCV[] = {
+    { 3000, 0 }, { 3450, 500 }, { 3600, 1500 }, { 3700, 3000 }, { 3800, 5000 },
+    { 3900, 6500 }, { 4000, 8000 }, { 4100, 9200 }, { 4200, 10000 },
+};
+
+SocEstimator::SocEstimator(Core::iClockStrategy* clock) {
+    m_clock = clock;
+    set_ocv(DEFAULT_OCV, sizeof(DEFAULT_OCV) / sizeof(DEFAULT_OCV[0]));
+
+    m_initialized = false;
+    m_charge = 0;
+    m_current_ma = 0;
+    m_have_current = false;
+    m_last_us = 0;
+    m_divergence = 0;
+    m_statistics = {};
+}
+
+bool SocEstimator::set_ocv(const OcvPoint* points, uint32_t count) {
+    if (points == nullptr || count < 2 || count > BATTERY_OCV_POINTS) {
+        return false;
+    }
+    for (uint32_t i = 1; i < count; i++) {
+        if (points[i].cell_mv <= points[i - 1].cell_mv || points[i].soc < points[i - 1].soc) {
+            return false;
+        }
+    }
+    for (uint32_t i = 0; i < count; i++) {
+        m_ocv_mv[i] = points[i].cell_mv;
+        m_ocv_soc[i] = points[i].soc;
+    }
+    m_ocv_count = count;
+    return true;
+}
+
+void SocEstimator::reset(uint16_t soc) {
+    if (soc > SOC_FULL) soc = SOC_FULL;
+    m_charge = capacity() * soc / SOC_FULL;
+    m_initialized = true;
+}
+
+uint16_t SocEstimator::soc() const {
+    int64_t full = capacity();
+    if (full <= 0) return 0;
+    return (uint16_t)(m_charge * SOC_FULL / full);
+}
+
+uint16_t SocEstimator::ocv_soc(int32_t cell_mv) const {
+    return Core::Lut::interpolate(m_ocv_mv, m_ocv_soc, m_ocv_count, cell_mv);
+}
+
+void SocEstimator::clamp() {
+    int64_t full = capacity();
+    if (m_charge < 0) m_charge = 0;
+    if (m_charge > full) m_charge = full;
+}
+
+void SocEstimator::integrate(int32_t current_ma) {
+    uint64_t now = m_clock->micros();
+    if (m_have_current && m_initialized) {
+        uint64_t elapsed_ms = (now - m_last_us) / 1000;
+        if (elapsed_ms > config.max_gap_ms) {
+            elapsed_ms = config.max_gap_ms;
+            m_statistics.gaps++;
+        }
+        // Trapezoid between the previous and the new sample
+        int64_t average_ma = ((int64_t)m_current_ma + current_ma) / 2;
+        m_charge -= average_ma * (int64_t)elapsed_ms;
+        clamp();
+        m_statistics.current_updates++;
+    }
+
+    m_last_us = now;
+    m_current_ma = current_ma;
+    m_have_current = true;
+}
+
+void SocEstimator::update(const Message1& message) {
+    int32_t current_ma = (int16_t)(uint16_t)message.packCurrent * (int32_t)config.ma_per_count;
+    integrate(current_ma);
+
+    int32_t pack_mv = (int32_t)message.packVoltage * config.mv_per_count;
+    int32_t magnitude = current_ma < 0 ? -current_ma : current_ma;
+    if (config.cells_in_series == 0 || magnitude > config.rest_current_ma) {
+        return;
+    }
+
+    // Discharge current sags the terminal voltage below the open circuit voltage
+    int32_t open_mv = pack_mv + current_ma * (int32_t)config.resistance_mohm / 1000;
+    int64_t target = capacity() * ocv_soc(open_mv / config.cells_in_series) / SOC_FULL;
+
+    if (!m_initialized) {
+        m_charge = target;
+        m_initialized = true;
+        return;
+    }
+
+    m_charge += (target - m_charge) >> config.correction_shift;
+    clamp();
+    m_statistics.voltage_corrections++;
+}
+
+void SocEstimator::update(const Message6& message) {
+    integrate((int16_t)(uint16_t)message.packCurrent * (int32_t)config.ma_per_count);
+}
+
+void SocEstimator::update(const Message355& message) {
+    uint16_t bms = (uint16_t)(message.packSOC > 100 ? 100 : message.packSOC) * 100;
+    if (!m_initialized) {
+        reset(bms);
+    }
+
+    m_divergence = (int32_t)soc() - bms;
+    int32_t magnitude = m_divergence < 0 ? -m_divergence : m_divergence;
+    if (magnitude > config.max_divergence) {
+        m_statistics.divergences++;
+    }
+}
+
+bool SocEstimator::dispatch(const CAN::Frame& frame) {
+    if (frame.extd) return false;
+
+    switch (frame.identifier) {
+        case 0x001: { Message1 message; memcpy(&message, frame.data, 8); update(message); return true; }
+        case 0x006: { Message6 message; memcpy(&message, frame.data, 8); update(message); return true; }
+        case 0x355: { Message355 message; memcpy(&message, frame.data, 8); update(message); return true; }
+        default: return false;
+    }
+}
+
+} // namespace Battery
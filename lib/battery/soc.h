@@ -0,0 +1,117 @@
+#ifndef BATTERY_SOC_H
+#define BATTERY_SOC_H
+
+#include <stdint.h>
+
+#include "core/core.h"
+#include "can/can.h"
+#include "messages.h"
+
+// Maximum number of points in the open circuit voltage table.
+#ifndef BATTERY_OCV_POINTS
+#define BATTERY_OCV_POINTS 12
+#endif
+
+namespace Battery {
+
+// Full charge in the SOC unit, hundredths of a percent.
+constexpr uint16_t SOC_FULL = 10000;
+
+/**
+ * @brief State of charge estimator fed directly from Orion broadcasts
+ *
+ * Coulomb counting integrates the pack current between consecutive current samples from
+ * Message1 and Message6, in mA·ms with 64-bit integers. When the pack is at rest, the
+ * estimate is pulled towards the SOC read from the open circuit voltage table, using the pack
+ * voltage corrected for the internal resistance. This removes integration drift without steps.
+ * Message355 is only used as a cross-check, or as the initial value if it arrives first.
+ *
+ * Every update is a fixed number of integer operations plus one binary search of the voltage table.
+ **/
+class SocEstimator {
+public:
+    struct OcvPoint {
+        uint16_t cell_mv;   /**< Open circuit cell voltage, mV */
+        uint16_t soc;       /**< SOC at that voltage, hundredths of a percent */
+    };
+
+    struct Config {
+        uint32_t capacity_mah;          /**< Usable pack capacity */
+        uint16_t cells_in_series;
+        uint16_t resistance_mohm;       /**< Pack internal resistance for the open circuit estimate */
+        uint16_t mv_per_count;          /**< Message1 packVoltage resolution, Orion sends 100 mV counts */
+        uint16_t ma_per_count;          /**< Message1 and Message6 current resolution, Orion sends 100 mA counts */
+        uint16_t rest_current_ma;       /**< Largest current magnitude considered at rest */
+        uint8_t correction_shift;       /**< At rest each voltage update closes 1/2^shift of the gap */
+        uint32_t max_gap_ms;            /**< Longest interval integrated, longer gaps are counted and clamped */
+        uint16_t max_divergence;        /**< Largest accepted difference to the BMS SOC, hundredths of a percent */
+    };
+
+    struct Statistics {
+        uint32_t current_updates;       /**< Current samples integrated */
+        uint32_t voltage_corrections;   /**< Voltage updates applied at rest */
+        uint32_t gaps;                  /**< Intervals longer than max_gap_ms */
+        uint32_t divergences;           /**< BMS SOC reports further than max_divergence away */
+    };
+
+    // Units follow the message documentation, positive current discharges the pack
+    Config config = { 20000, 96, 100, 100, 100, 2000, 8, 1000, 500 };
+
+    explicit SocEstimator(Core::iClockStrategy* clock);
+
+    /**
+     * @brief Replaces the open circuit voltage table
+     * @param points Points sorted by strictly increasing voltage and non-decreasing SOC
+     * @returns true if the table was replaced, false if the points are invalid.
+     **/
+    bool set_ocv(const OcvPoint* points, uint32_t count);
+
+    // Sets the SOC, e.g. from a stored value at startup.
+    void reset(uint16_t soc);
+
+    /**
+     * @brief Updates the estimate from an Orion broadcast
+     * @returns true if the frame was used, false otherwise
+     **/
+    bool dispatch(const CAN::Frame& frame);
+
+    void update(const Message1& message);
+    void update(const Message6& message);
+    void update(const Message355& message);
+
+    bool initialized() const { return m_initialized; }
+    // Estimated SOC, hundredths of a percent.
+    uint16_t soc() const;
+    int64_t remaining_mah() const { return m_charge / MS_PER_HOUR; }
+    // Estimate minus the latest BMS SOC, hundredths of a percent.
+    int32_t divergence() const { return m_divergence; }
+    // SOC the open circuit voltage table gives for a cell voltage.
+    uint16_t ocv_soc(int32_t cell_mv) const;
+
+    Statistics statistics() const { return m_statistics; }
+
+private:
+    static constexpr int64_t MS_PER_HOUR = 3600000;
+
+    Core::iClockStrategy* m_clock;
+    // Split axis and values for the table search
+    int32_t m_ocv_mv[BATTERY_OCV_POINTS];
+    uint16_t m_ocv_soc[BATTERY_OCV_POINTS];
+    uint32_t m_ocv_count;
+
+    bool m_initialized;
+    int64_t m_charge;           // mA·ms remaining
+    int32_t m_current_ma;
+    bool m_have_current;
+    uint64_t m_last_us;
+    int32_t m_divergence;
+    Statistics m_statistics;
+
+    int64_t capacity() const { return (int64_t)config.capacity_mah * MS_PER_HOUR; }
+    void integrate(int32_t current_ma);
+    void clamp();
+};
+
+} // namespace Battery
+
+#endif // BATTERY_SOC_H
@@ -2,8 +2,13 @@
 #ifndef CAN_H
 #define CAN_H
 
+#include "frame_pool.h"
+#include "mailbox.h"
 #include "provider.h"
 #include "service.h"
+#include "supervisor.h"
+#include "transmit_queue.h"
+#include "transmit_tracker.h"
 #include "types.h"
 
 #endif // CAN_H
\ No newline at end of file
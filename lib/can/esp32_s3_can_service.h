@@ -10,7 +10,8 @@
 
 namespace CAN {
 
-class ESP32S3CanService : public Service {
+// Final so BasicProvider<ESP32S3CanService> can call straight into the driver without virtual dispatch
+class ESP32S3CanService final : public Service {
 public:
 
     const Result install_driver(
@@ -41,8 +42,6 @@ public:
         return (Result)twai_transmit((twai_message_t*)frame, ticks_to_wait);
     }
 
-#endif // CAN_ESP32_S3_CAN_SERVICE_H
-
     const Result receive(Frame *frame, Tick ticks_to_wait) override {
         return (Result)twai_receive((twai_message_t*)frame, ticks_to_wait);
     }
@@ -79,3 +78,5 @@ public:
 } // namespace CAN
 
 #endif // ESP32
+
+#endif // CAN_ESP32_S3_CAN_SERVICE_H
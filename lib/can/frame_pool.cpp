@@ -0,0 +1,80 @@
+#include "frame_pool.h"
+
+using namespace CAN;
+
+constexpr uint16_t FramePool::NONE;
+
+FramePool::FramePool() : m_in_use(0), m_acquired(0), m_exhausted(0), m_high_water(0) {
+    for (uint32_t i = 0; i < CAN_FRAME_POOL_SIZE; i++) {
+        m_buffers[i].pool = this;
+        m_buffers[i].references.store(0, std::memory_order_relaxed);
+        m_buffers[i].next.store(i + 1 < CAN_FRAME_POOL_SIZE ? (uint16_t)(i + 1) : NONE, std::memory_order_relaxed);
+    }
+    m_free.store(0, std::memory_order_release);
+}
+
+FrameBuffer* FramePool::take() {
+    uint32_t head = m_free.load(std::memory_order_acquire);
+    for (;;) {
+        uint16_t index = (uint16_t)head;
+        if (index == NONE) {
+            m_exhausted.fetch_add(1, std::memory_order_relaxed);
+            return nullptr;
+        }
+        // A stale next is harmless, the tag makes the exchange fail if the head moved
+        uint16_t next = m_buffers[index].next.load(std::memory_order_relaxed);
+        uint32_t replacement = (head & 0xFFFF0000) + 0x10000 + next;
+        if (m_free.compare_exchange_weak(head, replacement, std::memory_order_acquire, std::memory_order_acquire)) {
+            break;
+        }
+    }
+
+    FrameBuffer* buffer = &m_buffers[(uint16_t)head];
+    buffer->references.store(1, std::memory_order_relaxed);
+
+    uint32_t in_use = m_in_use.fetch_add(1, std::memory_order_relaxed) + 1;
+    uint32_t high_water = m_high_water.load(std::memory_order_relaxed);
+    while (in_use > high_water && !m_high_water.compare_exchange_weak(high_water, in_use, std::memory_order_relaxed)) {
+    }
+    return buffer;
+}
+
+void FramePool::recycle(FrameBuffer* buffer) {
+    uint16_t index = (uint16_t)(buffer - m_buffers);
+    m_in_use.fetch_sub(1, std::memory_order_relaxed);
+
+    uint32_t head = m_free.load(std::memory_order_relaxed);
+    for (;;) {
+        buffer->next.store((uint16_t)head, std::memory_order_relaxed);
+        uint32_t replacement = (head & 0xFFFF0000) + 0x10000 + index;
+        if (m_free.compare_exchange_weak(head, replacement, std::memory_order_release, std::memory_order_relaxed)) {
+            return;
+        }
+    }
+}
+
+FrameHandle FramePool::acquire() {
+    FrameBuffer* buffer = take();
+    if (buffer == nullptr) {
+        return FrameHandle();
+    }
+    m_acquired.fetch_add(1, std::memory_order_relaxed);
+    return FrameHandle(buffer);
+}
+
+FrameHandle FramePool::acquire(const Frame& frame) {
+    FrameHandle handle = acquire();
+    if (handle) {
+        *handle.edit() = frame;
+    }
+    return handle;
+}
+
+FramePoolStatistics FramePool::statistics() const {
+    FramePoolStatistics statistics;
+    statistics.acquired = m_acquired.load(std::memory_order_relaxed);
+    statistics.exhausted = m_exhausted.load(std::memory_order_relaxed);
+    statistics.in_use = m_in_use.load(std::memory_order_relaxed);
+    statistics.high_water = m_high_water.load(std::memory_order_relaxed);
+    return statistics;
+}
@@ -0,0 +1,195 @@
+#ifndef CAN_FRAME_POOL_H
+#define CAN_FRAME_POOL_H
+
+#include <atomic>
+#include <stdint.h>
+
+#include "provider.h"
+#include "types.h"
+
+// Number of frame buffers in a pool.
+#ifndef CAN_FRAME_POOL_SIZE
+#define CAN_FRAME_POOL_SIZE 32
+#endif
+
+namespace CAN {
+
+class FramePool;
+
+/*
+ * A pooled frame and the number of handles referencing it.
+ */
+struct FrameBuffer {
+    Frame frame;
+    FramePool* pool;
+    std::atomic<uint16_t> references;
+    std::atomic<uint16_t> next;         /**< Next free buffer while in the free list */
+};
+
+/*
+ * Counters for a frame pool.
+ */
+struct FramePoolStatistics {
+    uint32_t acquired = 0;      /**< Buffers handed out */
+    uint32_t exhausted = 0;     /**< Acquisitions refused because every buffer was referenced */
+    uint32_t in_use = 0;        /**< Buffers referenced right now */
+    uint32_t high_water = 0;    /**< Most buffers referenced at once */
+};
+
+/*
+ * Shared, read-only reference to a pooled frame.
+ *
+ * Copying a handle adds a reader with an atomic increment, destroying or resetting one
+ * removes it, and the buffer returns to its pool when the last reader lets go. One received
+ * frame can so reach every consumer without being copied. Handles can travel through
+ * Core::MpscQueue, take them out with pop(value) so the queue keeps no reference.
+ */
+class FrameHandle {
+public:
+    FrameHandle() : m_buffer(nullptr) {}
+    FrameHandle(const FrameHandle& other) : m_buffer(other.m_buffer) { retain(); }
+    FrameHandle(FrameHandle&& other) : m_buffer(other.m_buffer) { other.m_buffer = nullptr; }
+    ~FrameHandle() { reset(); }
+
+    FrameHandle& operator=(const FrameHandle& other) {
+        if (m_buffer != other.m_buffer) {
+            reset();
+            m_buffer = other.m_buffer;
+            retain();
+        }
+        return *this;
+    }
+
+    FrameHandle& operator=(FrameHandle&& other) {
+        if (this != &other) {
+            reset();
+            m_buffer = other.m_buffer;
+            other.m_buffer = nullptr;
+        }
+        return *this;
+    }
+
+    // Drops this reference, the last one returns the buffer to its pool.
+    inline void reset();
+
+    explicit operator bool() const { return m_buffer != nullptr; }
+    const Frame& operator*() const { return m_buffer->frame; }
+    const Frame* operator->() const { return &m_buffer->frame; }
+    const Frame* get() const { return m_buffer != nullptr ? &m_buffer->frame : nullptr; }
+
+    uint16_t use_count() const {
+        return m_buffer != nullptr ? m_buffer->references.load(std::memory_order_relaxed) : 0;
+    }
+
+    /*
+     * The frame for writing, only while no other handle shares it.
+     * @returns nullptr if the handle is empty or shared.
+     */
+    Frame* edit() {
+        return use_count() == 1 ? &m_buffer->frame : nullptr;
+    }
+
+private:
+    friend class FramePool;
+
+    FrameBuffer* m_buffer;
+
+    // Adopts the reference the pool handed out
+    explicit FrameHandle(FrameBuffer* buffer) : m_buffer(buffer) {}
+
+    void retain() {
+        if (m_buffer != nullptr) {
+            m_buffer->references.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+};
+
+static_assert(sizeof(FrameHandle) == sizeof(FrameBuffer*), "A frame handle must stay one pointer wide");
+
+/*
+ * Fixed set of reference-counted frame buffers for zero-copy fan-out of received frames.
+ *
+ * One receive fills a buffer in place and every consumer gets a handle to it, so consumer
+ * queues hold a pointer per entry instead of a frame and only the pool is sized for the
+ * frames in flight. Acquiring and returning buffers is lock-free from any task: the free
+ * list head carries a tag against ABA. An exhausted pool refuses rather than blocks, and
+ * receive() then leaves the frame in the driver queue.
+ */
+class FramePool {
+public:
+    static_assert(CAN_FRAME_POOL_SIZE >= 1 && CAN_FRAME_POOL_SIZE < 0xFFFF, "CAN_FRAME_POOL_SIZE must be 1 to 65534");
+
+    FramePool();
+
+    FramePool(const FramePool&) = delete;
+    FramePool& operator=(const FramePool&) = delete;
+
+    /*
+     * Takes a buffer, writable through the handle's edit() until the handle is shared.
+     * @returns An empty handle if every buffer is referenced.
+     */
+    FrameHandle acquire();
+
+    /*
+     * Takes a buffer holding a copy of the frame.
+     * @returns An empty handle if every buffer is referenced.
+     */
+    FrameHandle acquire(const Frame& frame);
+
+    /*
+     * Receives the next frame straight into a buffer.
+     * @param timeout The timeout for reception in milliseconds.
+     * @returns An empty handle if nothing was received or every buffer is referenced.
+     */
+    template<typename ServiceT>
+    FrameHandle receive(BasicProvider<ServiceT>& provider, uint32_t timeout = 0) {
+        FrameBuffer* buffer = take();
+        if (buffer == nullptr) {
+            return FrameHandle();
+        }
+        if (!provider.receive(buffer->frame, timeout)) {
+            recycle(buffer);
+            return FrameHandle();
+        }
+        m_acquired.fetch_add(1, std::memory_order_relaxed);
+        return FrameHandle(buffer);
+    }
+
+    uint32_t capacity() const { return CAN_FRAME_POOL_SIZE; }
+    // Buffers no handle references.
+    uint32_t available() const { return CAN_FRAME_POOL_SIZE - m_in_use.load(std::memory_order_relaxed); }
+
+    FramePoolStatistics statistics() const;
+
+private:
+    friend class FrameHandle;
+
+    static constexpr uint16_t NONE = 0xFFFF;
+
+    FrameBuffer m_buffers[CAN_FRAME_POOL_SIZE];
+    // Tag in the upper 16 bits, index of the first free buffer in the lower 16 bits
+    std::atomic<uint32_t> m_free;
+    std::atomic<uint32_t> m_in_use;
+    std::atomic<uint32_t> m_acquired;
+    std::atomic<uint32_t> m_exhausted;
+    std::atomic<uint32_t> m_high_water;
+
+    // Pops a free buffer holding one reference, counts an exhaustion if there is none
+    FrameBuffer* take();
+    // Pushes a buffer without references back on the free list
+    void recycle(FrameBuffer* buffer);
+};
+
+void FrameHandle::reset() {
+    if (m_buffer == nullptr) {
+        return;
+    }
+    if (m_buffer->references.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        m_buffer->pool->recycle(m_buffer);
+    }
+    m_buffer = nullptr;
+}
+
+} // namespace CAN
+
+#endif // CAN_FRAME_POOL_H
@@ -0,0 +1,125 @@
+#include "mailbox.h"
+
+using namespace CAN;
+
+TransmitMailboxes::TransmitMailboxes(Provider* provider, Core::iLockStrategy* lock)
+    : m_provider(provider), m_lock(lock), m_count(0) {}
+
+TransmitMailboxes::Mailbox* TransmitMailboxes::find(uint32_t identifier) {
+    for (uint32_t i = 0; i < m_count; i++) {
+        if (m_mailboxes[i].identifier == identifier) {
+            return &m_mailboxes[i];
+        }
+    }
+    return nullptr;
+}
+
+bool TransmitMailboxes::configure(uint32_t identifier, Delivery delivery) {
+    Core::LockGuard guard(m_lock);
+
+    Mailbox* existing = find(identifier);
+    if (existing) {
+        existing->delivery = delivery;
+        return true;
+    }
+
+    if (m_count >= CAN_TRANSMIT_MAILBOXES) {
+        return false;
+    }
+
+    // Insertion sort by identifier
+    uint32_t index = m_count;
+    while (index > 0 && m_mailboxes[index - 1].identifier > identifier) {
+        m_mailboxes[index] = m_mailboxes[index - 1];
+        index--;
+    }
+
+    Mailbox& mailbox = m_mailboxes[index];
+    mailbox.identifier = identifier;
+    mailbox.delivery = delivery;
+    mailbox.full = false;
+    mailbox.statistics = MailboxStatistics();
+    m_count++;
+    return true;
+}
+
+bool TransmitMailboxes::post(const Frame& frame) {
+    Core::LockGuard guard(m_lock);
+
+    Mailbox* mailbox = find(frame.identifier);
+    if (!mailbox) {
+        return false;
+    }
+
+    if (mailbox->full) {
+        // The previous value never made it to the driver, it is no longer worth sending
+        mailbox->statistics.stale++;
+    }
+
+    mailbox->frame = frame;
+    mailbox->frame.ss = mailbox->delivery == Delivery::SINGLE_SHOT ? 1 : 0;
+    mailbox->full = true;
+    mailbox->statistics.posted++;
+
+    flush_locked();
+    return true;
+}
+
+uint32_t TransmitMailboxes::flush() {
+    Core::LockGuard guard(m_lock);
+    return flush_locked();
+}
+
+uint32_t TransmitMailboxes::flush_locked() {
+    uint32_t sent = 0;
+    for (uint32_t i = 0; i < m_count; i++) {
+        Mailbox& mailbox = m_mailboxes[i];
+        if (!mailbox.full) {
+            continue;
+        }
+        if (!m_provider->transmit(mailbox.frame, 0)) {
+            // Driver queue is full, the rest wait for the next flush
+            break;
+        }
+        mailbox.full = false;
+        mailbox.statistics.sent++;
+        sent++;
+    }
+    return sent;
+}
+
+uint32_t TransmitMailboxes::pending() {
+    Core::LockGuard guard(m_lock);
+    uint32_t count = 0;
+    for (uint32_t i = 0; i < m_count; i++) {
+        if (m_mailboxes[i].full) {
+            count++;
+        }
+    }
+    return count;
+}
+
+bool TransmitMailboxes::statistics(uint32_t identifier, MailboxStatistics& statistics) {
+    Core::LockGuard guard(m_lock);
+    Mailbox* mailbox = find(identifier);
+    if (!mailbox) {
+        return false;
+    }
+    statistics = mailbox->statistics;
+    return true;
+}
+
+uint32_t TransmitMailboxes::stale_count() {
+    Core::LockGuard guard(m_lock);
+    uint32_t count = 0;
+    for (uint32_t i = 0; i < m_count; i++) {
+        count += m_mailboxes[i].statistics.stale;
+    }
+    return count;
+}
+
+void TransmitMailboxes::alert_listener(Alert alerts, void* mailboxes) {
+    if (alerts & (Alerts::TX_SUCCESS | Alerts::TX_FAILED)) {
+        ((TransmitMailboxes*)mailboxes)->flush();
+    }
+}
@@ -0,0 +1,107 @@
+#ifndef CAN_MAILBOX_H
+#define CAN_MAILBOX_H
+
+#include <stdint.h>
+
+#include "core/lock.h"
+#include "provider.h"
+
+// Number of identifiers that can have a transmit mailbox.
+#ifndef CAN_TRANSMIT_MAILBOXES
+#define CAN_TRANSMIT_MAILBOXES 8
+#endif
+
+namespace CAN {
+
+/*
+ * How a mailbox frame is put on the wire.
+ */
+enum class Delivery {
+    RETRY,          /**< The controller retransmits until the frame is acknowledged */
+    SINGLE_SHOT,    /**< Sent once (Frame::ss), a newer value replaces it rather than a retry */
+};
+
+/*
+ * Counters for a single mailbox.
+ */
+struct MailboxStatistics {
+    uint32_t posted = 0;    /**< Frames posted to the mailbox */
+    uint32_t sent = 0;      /**< Frames accepted by the driver */
+    uint32_t stale = 0;     /**< Frames overwritten by a newer post before they were sent */
+};
+
+/*
+ * Latest-wins transmit mailboxes for setpoint style commands.
+ *
+ * Each registered identifier holds at most one pending frame. Posting a new frame for the
+ * same identifier replaces the pending one, so a congested bus never delivers an old
+ * setpoint after a newer one was produced. Pending frames are handed to the driver without
+ * blocking and wait in the mailbox while the driver queue is full. Keep the provider's
+ * transmit queue short so frames spend their wait here, where they can still be replaced.
+ */
+class TransmitMailboxes {
+public:
+    /*
+     * @param provider The provider frames are transmitted through.
+     * @param lock Guards the mailboxes when posting and flushing run on different tasks (can be nullptr).
+     */
+    TransmitMailboxes(Provider* provider, Core::iLockStrategy* lock = nullptr);
+
+    /*
+     * Registers a mailbox, or changes the delivery of an existing one.
+     * @param identifier The CAN identifier the mailbox carries.
+     * @param delivery Single shot or retried transmission.
+     * @returns true if the mailbox is registered, false if every mailbox is in use.
+     */
+    bool configure(uint32_t identifier, Delivery delivery = Delivery::SINGLE_SHOT);
+
+    /*
+     * Replaces the pending frame for the frame's identifier and tries to send it.
+     * @param frame The CAN frame to send, its identifier must have a mailbox.
+     * @returns true if the frame was stored, false if the identifier has no mailbox.
+     */
+    bool post(const Frame& frame);
+
+    /*
+     * Hands pending frames to the driver, lowest identifier (highest bus priority) first.
+     * @returns The number of frames the driver accepted.
+     */
+    uint32_t flush();
+
+    // Number of mailboxes holding a frame the driver has not accepted yet.
+    uint32_t pending();
+
+    /*
+     * Copies the counters for a mailbox.
+     * @returns true if the identifier has a mailbox, false otherwise.
+     */
+    bool statistics(uint32_t identifier, MailboxStatistics& statistics);
+
+    // Frames overwritten before being sent, across every mailbox.
+    uint32_t stale_count();
+
+    // Alert listener adapter that flushes when the driver frees queue room, pass the mailboxes as the context.
+    static void alert_listener(Alert alerts, void* mailboxes);
+
+private:
+    struct Mailbox {
+        uint32_t identifier;
+        Delivery delivery;
+        bool full;
+        Frame frame;
+        MailboxStatistics statistics;
+    };
+
+    Provider* m_provider;
+    Core::iLockStrategy* m_lock;
+    // Kept sorted by identifier so flushing follows bus priority
+    Mailbox m_mailboxes[CAN_TRANSMIT_MAILBOXES];
+    uint32_t m_count;
+
+    Mailbox* find(uint32_t identifier);
+    uint32_t flush_locked();
+};
+
+} // namespace CAN
+
+#endif // CAN_MAILBOX_H
@@ -3,17 +3,30 @@
 #define CAN_PROVIDER_H
 
 #include "service.h"
+#include <atomic>
 #include <stdint.h>
 
+#include "core/startup/milestones.h"
+
 namespace CAN {
 
 /*
  * Provider class for handling CAN operations.
+ *
+ * Templated on the service so the hot paths (transmit, receive, status_info) dispatch
+ * statically and inline when ServiceT is a concrete, final service such as
+ * ESP32S3CanService. `Provider` is the type-erased form over the virtual Service interface.
+ * The remaining operations are defined below the class, so any service type links.
+ *
+ * Safe to share between tasks: transmit and receive go straight to the driver, and the
+ * state transitions (begin, end, recover, restart) are serialized by an atomic flag.
+ * A transition attempted while another one is in progress fails instead of blocking.
  */
-class Provider {
+template<typename ServiceT>
+class BasicProvider {
 public:
     // Indicates whether the CAN provider is currently running.
-    bool is_running = false;
+    std::atomic<bool> is_running{false};
     // TWAI status information.
     PIN transmit_pin;
     // Receive pin for the CAN manager.
@@ -26,13 +39,20 @@ public:
     FilterConfig filter_config = FilterConfig(); // TWAI_FILTER_CONFIG_ACCEPT_ALL();
     // Timing configuration for the CAN manager.
     TimingConfig timing_config = TimingConfig(); // TWAI_TIMING_CONFIG_500KBITS();
-    // Status information for the CAN manager.
+    // Status information for the CAN manager, as of the last recover or restart.
     StatusInfo status;
+    // Alerts enabled when the driver is installed.
+    Alert alerts_enabled = Alerts::TX_SUCCESS | Alerts::TX_FAILED | Alerts::BUS_OFF;
+    // Marked on every received frame, e.g. the first valid frame of the boot timeline. Set before receiving.
+    Core::Startup::MilestoneHook received;
+
+    BasicProvider(ServiceT* service, PIN transmit_pin, PIN receive_pin) : transmit_pin(transmit_pin), receive_pin(receive_pin), service(service) {}
+    BasicProvider(ServiceT* service) : transmit_pin(UNUSED), receive_pin(UNUSED), service(service) {}
 
-    Provider(Service* service, PIN transmit_pin, PIN receive_pin) : service(service), transmit_pin(transmit_pin), receive_pin(receive_pin) {}
-    Provider(Service* service) : service(service), transmit_pin(UNUSED), receive_pin(UNUSED) {}
+    ~BasicProvider() = default;
 
-    ~Provider() = default;
+    BasicProvider(const BasicProvider&) = delete;
+    BasicProvider& operator=(const BasicProvider&) = delete;
 
     /*
      * Initializes the CAN provider.
@@ -64,7 +84,9 @@ public:
      * @param timeout The timeout for transmission in milliseconds.
      * @returns true if transmission was successful, false otherwise.
      */
-    bool transmit(const Frame& frame, uint32_t timeout = 1000);
+    bool transmit(const Frame& frame, uint32_t timeout = 1000) {
+        return service->transmit(&frame, timeout) == Result::OK;
+    }
     
     /*
      * Receives a CAN frame.
@@ -72,7 +94,37 @@ public:
      * @param timeout The timeout for reception in milliseconds.
      * @returns true if reception was successful, false otherwise.
      */
-    bool receive(Frame& frame, uint32_t timeout = 1000);
+    bool receive(Frame& frame, uint32_t timeout = 1000) {
+        if (service->receive(&frame, timeout) != Result::OK) {
+            return false;
+        }
+        received.mark();
+        return true;
+    }
+
+    /*
+     * Reads the alerts raised by the driver since the last read.
+     * @param alerts The raised alerts.
+     * @param timeout The time to wait for an alert in milliseconds.
+     * @returns true if any alert was read, false otherwise.
+     */
+    bool alerts(Alert& alerts, uint32_t timeout = 0);
+
+    /*
+     * Enables a new set of alerts, replacing `alerts_enabled`.
+     * @param alerts The alerts to enable.
+     * @returns true if the driver accepted the alerts, false otherwise.
+     */
+    bool reconfigure_alerts(Alert alerts);
+
+    /*
+     * Reads the current driver status without updating `status`.
+     * @param status_info The driver status.
+     * @returns true if the status was read, false otherwise.
+     */
+    bool status_info(StatusInfo& status_info) {
+        return service->status_info(&status_info) == Result::OK;
+    }
 
     /*
      * Installs the CAN driver.
@@ -88,7 +140,15 @@ public:
 
 private:
     // Provides a wrapped implementation of the TWAI interface
-    Service* service;
+    ServiceT* service;
+    // Set while a state transition is in progress.
+    std::atomic<bool> transitioning{false};
+
+    /*
+     * Stops and uninstalls the driver, the body of end().
+     * @returns true if both steps succeeded, false otherwise.
+     */
+    bool stop_driver();
 
     /*
      * Sets the current status of the CAN provider.
@@ -97,6 +157,183 @@ private:
     bool set_status();
 };
 
+// Provider over the virtual Service interface, works with any Service implementation.
+typedef BasicProvider<Service> Provider;
+
+namespace Detail {
+
+// Claims the provider for a state transition without blocking, concurrent callers fail fast
+class TransitionGuard {
+public:
+    explicit TransitionGuard(std::atomic<bool>& flag)
+        : flag(flag), owned(!flag.exchange(true, std::memory_order_acquire)) {}
+
+    ~TransitionGuard() {
+        if (owned) {
+            flag.store(false, std::memory_order_release);
+        }
+    }
+
+    std::atomic<bool>& flag;
+    const bool owned;
+};
+
+} // namespace Detail
+
+template<typename ServiceT>
+bool BasicProvider<ServiceT>::set_status() {
+    return service->status_info(&status) == Result::OK;
+}
+
+template<typename ServiceT>
+bool BasicProvider<ServiceT>::install_driver() {
+    // Reset GPIO pins
+    service->reset_pin(transmit_pin);
+    service->reset_pin(receive_pin);
+
+    // Configure TWAI driver
+    TimingConfig t_config = timing_config;
+    FilterConfig f_config = filter_config;
+    GeneralConfig g_config = GeneralConfig(transmit_pin, receive_pin, Mode::NORMAL);
+    g_config.alerts_enabled = alerts_enabled;
+
+    // Install and start TWAI driver
+    if (service->install_driver(&g_config, &t_config, &f_config) != Result::OK) {
+        // Failed to install TWAI driver
+        return false;
+    }
+
+    return true;
+}
+
+template<typename ServiceT>
+bool BasicProvider<ServiceT>::uninstall_driver() {
+    return service->uninstall_driver() == Result::OK;
+}
+
+template<typename ServiceT>
+bool BasicProvider<ServiceT>::begin() {
+    Detail::TransitionGuard guard(transitioning);
+    if (!guard.owned) {
+        // Another task is changing state
+        return false;
+    }
+
+    // If already running, restart first. Without an installed driver there is nothing to
+    // stop, and uninstalling would fail
+    if (is_running && !stop_driver()) {
+        // Failed to end previous session
+        return false;
+    }
+
+    if (!install_driver()) {
+        // Failed to install driver
+        return false;
+    }
+
+    // Start TWAI driver
+    if (service->start() != Result::OK) {
+        // Failed to start TWAI driver
+        stop_driver();
+        return false;
+    }
+
+    // Set running state
+    is_running = true;
+    return true;
+}
+
+template<typename ServiceT>
+bool BasicProvider<ServiceT>::recover() {
+    Detail::TransitionGuard guard(transitioning);
+    if (!guard.owned) {
+        // Another task is changing state
+        return false;
+    }
+
+    if (!set_status()) {
+        // Failed to get status
+        return false;
+    }
+
+    switch (status.state) {
+        case State::BUS_OFF:
+            return service->initiate_recovery() == Result::OK;
+        case State::STOPPED:
+            return true;
+        case State::RECOVERING:
+            return true;
+        default:
+            return false;
+    }
+}
+
+template<typename ServiceT>
+bool BasicProvider<ServiceT>::restart() {
+    Detail::TransitionGuard guard(transitioning);
+    if (!guard.owned) {
+        // Another task is changing state
+        return false;
+    }
+
+    if (!set_status()) {
+        // Failed to get status
+        return false;
+    }
+
+    switch (status.state) {
+        case State::STOPPED:
+            // If stopped, start the driver
+            if (service->start() != Result::OK) {
+                return false;
+            }
+            is_running = true;
+            return true;
+        default:
+            // For other states, restart is not applicable
+            return false;
+    }
+}
+
+template<typename ServiceT>
+bool BasicProvider<ServiceT>::end() {
+    Detail::TransitionGuard guard(transitioning);
+    if (!guard.owned) {
+        // Another task is changing state
+        return false;
+    }
+
+    return stop_driver();
+}
+
+template<typename ServiceT>
+bool BasicProvider<ServiceT>::stop_driver() {
+    // Stop and uninstall TWAI driver
+    bool did_stop = service->stop() == Result::OK;
+    bool did_uninstall = uninstall_driver();
+    is_running = false;
+    return did_stop && did_uninstall;
+}
+
+template<typename ServiceT>
+bool BasicProvider<ServiceT>::alerts(Alert& alerts, uint32_t timeout) {
+    alerts = Alerts::NONE;
+    if (service->alerts(&alerts, timeout) != Result::OK) {
+        return false;
+    }
+    return true;
+}
+
+template<typename ServiceT>
+bool BasicProvider<ServiceT>::reconfigure_alerts(Alert alerts) {
+    alerts_enabled = alerts;
+    if (!is_running) {
+        // Applied when the driver is installed
+        return true;
+    }
+    return service->reconfigure_alerts(alerts, nullptr) == Result::OK;
+}
+
 } // namespace CAN
 
 #endif // CAN_PROVIDER_H
@@ -0,0 +1,177 @@
+#include "supervisor.h"
+
+using namespace CAN;
+
+constexpr Alert Supervisor::ALERTS;
+
+Supervisor::Supervisor(std::shared_ptr<Provider> provider, Core::iClockStrategy* clock, std::unique_ptr<Core::iLockStrategy> lock_strategy, std::unique_ptr<Core::iThreadStrategy> thread_strategy) {
+    m_provider = provider;
+    m_clock = clock;
+    m_mutex = std::move(lock_strategy);
+    m_thread = std::move(thread_strategy);
+
+    m_started = false;
+    m_shouldStop = false;
+    m_listener_count = 0;
+    m_phase = Phase::NORMAL;
+    m_bus_off_at = 0;
+    m_phase_deadline = 0;
+
+    m_thread->setup("can.supervisor", // name
+                    0x28U, // priority - osPriorityHigh
+                    0x01U  // attributes - osThreadJoinable
+                   );
+}
+
+void Supervisor::start() {
+    if (m_started) return;
+
+    m_provider->reconfigure_alerts(m_provider->alerts_enabled | ALERTS);
+
+    // The bus may already be down, in which case no BUS_OFF alert will arrive
+    StatusInfo info;
+    if (m_provider->status_info(info) && info.state == State::BUS_OFF) {
+        Core::LockGuard guard(m_mutex.get());
+        on_bus_off(m_clock->micros());
+    }
+
+    m_shouldStop = false;
+    m_thread->create(Supervisor::supervise, this);
+
+    m_started = true;
+}
+
+void Supervisor::stop() {
+    m_mutex->lock();
+    m_shouldStop = true;
+    m_mutex->unlock();
+
+    m_thread->join();
+
+    m_started = false;
+}
+
+bool Supervisor::add_listener(AlertListener listener, void* context) {
+    Core::LockGuard guard(m_mutex.get());
+    if (m_listener_count >= CAN_SUPERVISOR_LISTENERS) {
+        return false;
+    }
+    m_listeners[m_listener_count].callback = listener;
+    m_listeners[m_listener_count].context = context;
+    m_listener_count++;
+    return true;
+}
+
+Supervisor::Phase Supervisor::phase() {
+    Core::LockGuard guard(m_mutex.get());
+    return m_phase;
+}
+
+Supervisor::Statistics Supervisor::statistics() {
+    Core::LockGuard guard(m_mutex.get());
+    return m_statistics;
+}
+
+void Supervisor::step(uint32_t timeout) {
+    Alert alerts;
+    bool has_alerts = m_provider->alerts(alerts, timeout);
+
+    Listener listeners[CAN_SUPERVISOR_LISTENERS];
+    uint32_t listener_count;
+    {
+        Core::LockGuard guard(m_mutex.get());
+        uint64_t now = m_clock->micros();
+        if (has_alerts) {
+            handle(alerts, now);
+        }
+        enforce_timeouts(now);
+
+        listener_count = m_listener_count;
+        for (uint32_t i = 0; i < listener_count; i++) {
+            listeners[i] = m_listeners[i];
+        }
+    }
+
+    if (!has_alerts || alerts == Alerts::NONE) {
+        return;
+    }
+    for (uint32_t i = 0; i < listener_count; i++) {
+        listeners[i].callback(alerts, listeners[i].context);
+    }
+}
+
+void Supervisor::handle(Alert alerts, uint64_t now) {
+    if (alerts & Alerts::ERR_PASS) {
+        m_statistics.error_passive_count++;
+    }
+
+    if (alerts & Alerts::BUS_OFF) {
+        on_bus_off(now);
+        // Anything else in this batch happened before the bus went down
+        return;
+    }
+
+    if ((alerts & Alerts::BUS_RECOVERED) && m_phase == Phase::RECOVERING) {
+        // A recovered controller sits in STOPPED until started again
+        m_phase = Phase::RESTARTING;
+        try_start();
+    }
+
+    if ((alerts & Alerts::TX_SUCCESS) && m_phase == Phase::CONFIRMING) {
+        uint32_t duration = (uint32_t)(now - m_bus_off_at);
+        m_statistics.recoveries++;
+        m_statistics.last_recovery_us = duration;
+        if (duration > m_statistics.max_recovery_us) {
+            m_statistics.max_recovery_us = duration;
+        }
+        m_phase = Phase::NORMAL;
+    }
+}
+
+void Supervisor::on_bus_off(uint64_t now) {
+    m_statistics.bus_off_count++;
+    m_bus_off_at = now;
+    m_phase = Phase::RECOVERING;
+    m_phase_deadline = now + (uint64_t)recovery_timeout * 1000;
+    m_provider->recover();
+}
+
+void Supervisor::try_start() {
+    if (m_provider->restart()) {
+        m_phase = Phase::CONFIRMING;
+    }
+}
+
+void Supervisor::enforce_timeouts(uint64_t now) {
+    if (m_phase == Phase::RESTARTING) {
+        // Starting can fail transiently, retry every cycle until the deadline
+        try_start();
+    }
+
+    if ((m_phase == Phase::RECOVERING || m_phase == Phase::RESTARTING) && now >= m_phase_deadline) {
+        // Recovery is taking too long, reinstall the driver from scratch.
+        // Stopping is refused while bus-off, but the uninstall still tears the driver down.
+        m_statistics.forced_restarts++;
+        m_phase_deadline = now + (uint64_t)recovery_timeout * 1000;
+        m_provider->end();
+        if (m_provider->install_driver()) {
+            m_phase = Phase::RESTARTING;
+            try_start();
+        }
+    }
+}
+
+// Blocks on driver alerts until asked to stop
+void Supervisor::supervise(void* s) {
+    Supervisor* self = (Supervisor*)s;
+    for (;;) {
+        self->m_mutex->lock();
+        if (self->m_shouldStop) {
+            self->m_mutex->unlock();
+            return;
+        }
+        self->m_mutex->unlock();
+
+        self->step(self->alert_timeout);
+    }
+}
@@ -0,0 +1,111 @@
+#ifndef CAN_SUPERVISOR_H
+#define CAN_SUPERVISOR_H
+
+#include <memory>
+#include <stdint.h>
+
+#include "core/core.h"
+#include "provider.h"
+
+// Number of alert listeners a supervisor can forward to.
+#ifndef CAN_SUPERVISOR_LISTENERS
+#define CAN_SUPERVISOR_LISTENERS 4
+#endif
+
+namespace CAN {
+
+/*
+ * Receives every alert batch the supervisor reads, after recovery handling.
+ */
+typedef void(*AlertListener)(Alert alerts, void* context);
+
+/*
+ * Alert-driven supervisor task for a Provider.
+ *
+ * Blocks on driver alerts and drives bus-off recovery without anyone polling:
+ * BUS_OFF -> initiate recovery, BUS_RECOVERED -> restart, first TX_SUCCESS -> back online.
+ * If recovery has not completed within `recovery_timeout` the driver is reinstalled.
+ * Alerts are forwarded to listeners (e.g. TransmitTracker::alert_listener) once handled.
+ */
+class Supervisor {
+public:
+    enum class Phase {
+        NORMAL,         /**< Bus is up, nothing in progress */
+        RECOVERING,     /**< Bus-off seen, waiting for the controller to recover */
+        RESTARTING,     /**< Recovered, waiting for the driver to start */
+        CONFIRMING,     /**< Started, waiting for the first successful transmission */
+    };
+
+    struct Statistics {
+        uint32_t bus_off_count = 0;         /**< Bus-off events seen */
+        uint32_t error_passive_count = 0;   /**< Error passive events seen */
+        uint32_t recoveries = 0;            /**< Completed bus-off to first TX cycles */
+        uint32_t forced_restarts = 0;       /**< Driver reinstalls after a recovery timeout */
+        uint32_t last_recovery_us = 0;      /**< Duration of the latest bus-off to first TX cycle */
+        uint32_t max_recovery_us = 0;       /**< Longest bus-off to first TX cycle */
+    };
+
+    // Alerts the supervisor enables on the provider when started.
+    static constexpr Alert ALERTS = Alerts::RX_DATA | Alerts::TX_SUCCESS | Alerts::TX_FAILED |
+                                    Alerts::ERR_PASS | Alerts::BUS_OFF | Alerts::BUS_RECOVERED;
+
+    // Longest time to block on alerts before checking for stop and timeouts, in milliseconds.
+    uint32_t alert_timeout = 10;
+    // Longest time a recovery or restart may take before the driver is reinstalled, in milliseconds.
+    uint32_t recovery_timeout = 500;
+
+    Supervisor(std::shared_ptr<Provider> provider, Core::iClockStrategy* clock, std::unique_ptr<Core::iLockStrategy> lock_strategy, std::unique_ptr<Core::iThreadStrategy> thread_strategy);
+
+    void start();
+    void stop();
+
+    bool started() { return m_started; }
+
+    /*
+     * Registers an alert listener.
+     * @returns true if the listener was added, false if the listener table is full.
+     */
+    bool add_listener(AlertListener listener, void* context);
+
+    /*
+     * Runs one supervision cycle: waits for alerts, handles them and enforces recovery timeouts.
+     * Called in a loop by the supervisor task, exposed so it can be driven directly.
+     * @param timeout The time to wait for alerts in milliseconds.
+     */
+    void step(uint32_t timeout);
+
+    Phase phase();
+    Statistics statistics();
+
+private:
+    struct Listener {
+        AlertListener callback;
+        void* context;
+    };
+
+    bool m_started;
+    bool m_shouldStop;
+    std::unique_ptr<Core::iLockStrategy> m_mutex;
+    std::unique_ptr<Core::iThreadStrategy> m_thread;
+    std::shared_ptr<Provider> m_provider;
+    Core::iClockStrategy* m_clock;
+
+    Listener m_listeners[CAN_SUPERVISOR_LISTENERS];
+    uint32_t m_listener_count;
+
+    Phase m_phase;
+    uint64_t m_bus_off_at;
+    uint64_t m_phase_deadline;
+    Statistics m_statistics;
+
+    void handle(Alert alerts, uint64_t now);
+    void enforce_timeouts(uint64_t now);
+    void on_bus_off(uint64_t now);
+    void try_start();
+
+    static void supervise(void* s);
+};
+
+} // namespace CAN
+
+#endif // CAN_SUPERVISOR_H
@@ -0,0 +1,76 @@
+#include "transmit_queue.h"
+
+using namespace CAN;
+
+TransmitQueue::TransmitQueue(std::shared_ptr<Provider> provider, std::unique_ptr<Core::iThreadStrategy> thread_strategy)
+    : m_shouldStop(false), m_submitted(0), m_dropped(0), m_sent(0) {
+    m_provider = provider;
+    m_thread = std::move(thread_strategy);
+
+    m_started = false;
+
+    m_thread->setup("can.transmit", // name
+                    0x20U, // priority - osPriorityAboveNormal
+                    0x01U  // attributes - osThreadJoinable
+                   );
+}
+
+void TransmitQueue::start() {
+    if (m_started) return;
+
+    m_shouldStop.store(false);
+    m_thread->create(TransmitQueue::transmit, this);
+
+    m_started = true;
+}
+
+void TransmitQueue::stop() {
+    m_shouldStop.store(true);
+    m_thread->join();
+
+    m_started = false;
+}
+
+bool TransmitQueue::submit(const Frame& frame) {
+    if (!m_queue.push(frame)) {
+        m_dropped.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    m_submitted.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+uint32_t TransmitQueue::drain(uint32_t timeout) {
+    uint32_t sent = 0;
+    for (Frame* frame = m_queue.front(); frame; frame = m_queue.front()) {
+        if (!m_provider->transmit(*frame, timeout)) {
+            // Keep the frame at the head so per-identifier order is preserved
+            break;
+        }
+        m_queue.pop();
+        sent++;
+    }
+    m_sent.fetch_add(sent, std::memory_order_relaxed);
+    return sent;
+}
+
+TransmitQueue::Statistics TransmitQueue::statistics() const {
+    Statistics statistics;
+    statistics.submitted = m_submitted.load(std::memory_order_relaxed);
+    statistics.dropped = m_dropped.load(std::memory_order_relaxed);
+    statistics.sent = m_sent.load(std::memory_order_relaxed);
+    return statistics;
+}
+
+// Drains submitted frames into the driver until asked to stop
+void TransmitQueue::transmit(void* s) {
+    TransmitQueue* self = (TransmitQueue*)s;
+    while (!self->m_shouldStop.load()) {
+        if (self->drain(self->transmit_timeout) == 0) {
+            // Nothing to send, or the driver is not taking frames
+            self->m_thread->sleep(1);
+        }
+    }
+    // Flush what was submitted before the stop
+    self->drain(0);
+}
@@ -0,0 +1,80 @@
+#ifndef CAN_TRANSMIT_QUEUE_H
+#define CAN_TRANSMIT_QUEUE_H
+
+#include <atomic>
+#include <memory>
+#include <stdint.h>
+
+#include "core/core.h"
+#include "provider.h"
+
+// Number of frames that can wait for the transmit task, must be a power of two.
+#ifndef CAN_TRANSMIT_QUEUE_DEPTH
+#define CAN_TRANSMIT_QUEUE_DEPTH 32
+#endif
+
+namespace CAN {
+
+/*
+ * Multi-producer transmit front end for a shared Provider.
+ *
+ * Any task can submit frames without blocking or locking, they land in a lock-free MPSC
+ * queue that a single transmit task drains into the driver in submission order. Since
+ * frames are never reordered or skipped, frames with the same identifier reach the bus in
+ * the order they were submitted. Only the transmit task ever blocks on the driver queue.
+ */
+class TransmitQueue {
+public:
+    struct Statistics {
+        uint32_t submitted;     /**< Frames accepted by submit() */
+        uint32_t dropped;       /**< Frames refused because the queue was full */
+        uint32_t sent;          /**< Frames accepted by the driver */
+    };
+
+    // Longest time the transmit task blocks on a full driver queue, in milliseconds.
+    uint32_t transmit_timeout = 10;
+
+    TransmitQueue(std::shared_ptr<Provider> provider, std::unique_ptr<Core::iThreadStrategy> thread_strategy);
+
+    void start();
+    void stop();
+
+    bool started() { return m_started; }
+
+    /*
+     * Queues a frame for the transmit task, safe to call from any task.
+     * @param frame The CAN frame to transmit.
+     * @returns true if the frame was queued, false if the queue is full.
+     */
+    bool submit(const Frame& frame);
+
+    /*
+     * Hands queued frames to the driver, transmit task only.
+     * Called in a loop by the transmit task, exposed so it can be driven directly.
+     * @param timeout The time to wait for room in the driver queue in milliseconds.
+     * @returns The number of frames the driver accepted.
+     */
+    uint32_t drain(uint32_t timeout);
+
+    // Frames waiting for the transmit task.
+    uint32_t depth() const { return m_queue.size(); }
+
+    Statistics statistics() const;
+
+private:
+    bool m_started;
+    std::atomic<bool> m_shouldStop;
+    std::unique_ptr<Core::iThreadStrategy> m_thread;
+    std::shared_ptr<Provider> m_provider;
+
+    Core::MpscQueue<Frame, CAN_TRANSMIT_QUEUE_DEPTH> m_queue;
+    std::atomic<uint32_t> m_submitted;
+    std::atomic<uint32_t> m_dropped;
+    std::atomic<uint32_t> m_sent;
+
+    static void transmit(void* s);
+};
+
+} // namespace CAN
+
+#endif // CAN_TRANSMIT_QUEUE_H
@@ -0,0 +1,216 @@
+#include "transmit_tracker.h"
+
+using namespace CAN;
+
+TransmitStatus TransmitHandle::status() const {
+    if (!tracker) {
+        return TransmitStatus::EXPIRED;
+    }
+    return tracker->status(*this);
+}
+
+bool TransmitHandle::done() const {
+    TransmitStatus current = status();
+    return current != TransmitStatus::PENDING && current != TransmitStatus::QUEUED;
+}
+
+bool TransmitHandle::result(TransmitResult& result) const {
+    if (!tracker) {
+        return false;
+    }
+    return tracker->result(*this, result);
+}
+
+bool TransmitHandle::wait(uint32_t timeout) const {
+    if (!tracker) {
+        return false;
+    }
+    return tracker->wait(*this, timeout);
+}
+
+TransmitTracker::TransmitTracker(Provider* provider, Core::iClockStrategy* clock, Core::iLockStrategy* lock)
+    : m_provider(provider), m_clock(clock), m_lock(lock), m_sleeper(nullptr),
+      m_completed(0), m_handed(0), m_submitted(0), m_tx_failed_count(0) {
+    for (uint32_t i = 0; i < CAN_TRANSMIT_TRACKER_SLOTS; i++) {
+        m_slots[i].generation = 0;
+        m_slots[i].result.status = TransmitStatus::EXPIRED;
+    }
+}
+
+uint64_t TransmitTracker::now() {
+    return m_clock ? m_clock->micros() : 0;
+}
+
+TransmitHandle TransmitTracker::submit(const Frame& frame, TransmitCallback callback, void* context) {
+    Core::LockGuard guard(m_lock);
+
+    if (m_submitted - m_completed >= CAN_TRANSMIT_TRACKER_SLOTS) {
+        // Every slot is pending or in the driver
+        m_statistics.rejected++;
+        return TransmitHandle();
+    }
+
+    uint16_t index = (uint16_t)(m_submitted % CAN_TRANSMIT_TRACKER_SLOTS);
+    Slot& slot = m_slots[index];
+    slot.generation++;
+    slot.frame = frame;
+    slot.callback = callback;
+    slot.context = context;
+    slot.result.status = TransmitStatus::PENDING;
+    slot.result.identifier = frame.identifier;
+    slot.result.enqueued_us = now();
+    slot.result.completed_us = 0;
+    m_submitted++;
+    m_statistics.submitted++;
+
+    hand_to_driver();
+
+    return TransmitHandle(this, index, slot.generation);
+}
+
+void TransmitTracker::hand_to_driver() {
+    while (m_handed != m_submitted) {
+        Slot& slot = m_slots[m_handed % CAN_TRANSMIT_TRACKER_SLOTS];
+        if (!m_provider->transmit(slot.frame, 0)) {
+            // Driver queue is full or the bus is down, try again on the next completion
+            return;
+        }
+        slot.result.status = TransmitStatus::QUEUED;
+        m_handed++;
+    }
+}
+
+void TransmitTracker::complete(TransmitStatus status, uint64_t now, Completion* completions, uint32_t& count) {
+    Slot& slot = m_slots[m_completed % CAN_TRANSMIT_TRACKER_SLOTS];
+    slot.result.status = status;
+    slot.result.completed_us = now;
+    m_completed++;
+
+    if (status == TransmitStatus::SUCCESS) {
+        uint32_t latency = slot.result.latency_us();
+        m_statistics.succeeded++;
+        m_statistics.last_latency_us = latency;
+        if (latency > m_statistics.max_latency_us) {
+            m_statistics.max_latency_us = latency;
+        }
+    } else {
+        m_statistics.failed++;
+    }
+
+    if (slot.callback) {
+        completions[count].callback = slot.callback;
+        completions[count].context = slot.context;
+        completions[count].result = slot.result;
+        count++;
+    }
+}
+
+bool TransmitTracker::poll(uint32_t timeout) {
+    Alert alerts;
+    if (!m_provider->alerts(alerts, timeout)) {
+        return false;
+    }
+    on_alerts(alerts);
+    return true;
+}
+
+void TransmitTracker::on_alerts(Alert alerts) {
+    // Callbacks run after the lock is released so they are free to submit again
+    Completion completions[CAN_TRANSMIT_TRACKER_SLOTS];
+    uint32_t count = 0;
+    {
+        Core::LockGuard guard(m_lock);
+        uint64_t timestamp = now();
+
+        if (alerts & Alerts::BUS_OFF) {
+            // The driver discards its transmit queue on bus-off
+            while (m_completed != m_handed) {
+                complete(TransmitStatus::FAILED, timestamp, completions, count);
+            }
+        } else if (alerts & (Alerts::TX_SUCCESS | Alerts::TX_FAILED)) {
+            StatusInfo info;
+            if (!m_provider->status_info(info)) {
+                return;
+            }
+
+            // The driver completes frames in FIFO order, so everything it no longer holds is done
+            uint32_t in_driver = m_handed - m_completed;
+            uint32_t finished = in_driver > info.msgs_to_tx ? in_driver - info.msgs_to_tx : 0;
+
+            // The failure counter restarts with the driver
+            uint32_t failed = info.tx_failed_count >= m_tx_failed_count
+                ? info.tx_failed_count - m_tx_failed_count
+                : info.tx_failed_count;
+            m_tx_failed_count = info.tx_failed_count;
+
+            // Alerts coalesce, so failures are attributed to the oldest frames in the batch
+            for (uint32_t i = 0; i < finished; i++) {
+                complete(i < failed ? TransmitStatus::FAILED : TransmitStatus::SUCCESS, timestamp, completions, count);
+            }
+        }
+
+        hand_to_driver();
+    }
+
+    for (uint32_t i = 0; i < count; i++) {
+        completions[i].callback(completions[i].result, completions[i].context);
+    }
+}
+
+TransmitStatus TransmitTracker::status(const TransmitHandle& handle) const {
+    TransmitResult current;
+    if (!result(handle, current)) {
+        return TransmitStatus::EXPIRED;
+    }
+    return current.status;
+}
+
+bool TransmitTracker::result(const TransmitHandle& handle, TransmitResult& result) const {
+    if (handle.tracker != this || handle.slot >= CAN_TRANSMIT_TRACKER_SLOTS) {
+        return false;
+    }
+
+    Core::LockGuard guard(m_lock);
+    const Slot& slot = m_slots[handle.slot];
+    if (slot.generation != handle.generation) {
+        // Slot has been reused by a newer frame
+        return false;
+    }
+    result = slot.result;
+    return true;
+}
+
+bool TransmitTracker::wait(const TransmitHandle& handle, uint32_t timeout) {
+    for (uint32_t waited = 0; ; waited++) {
+        TransmitStatus current = status(handle);
+        if (current != TransmitStatus::PENDING && current != TransmitStatus::QUEUED) {
+            return current == TransmitStatus::SUCCESS;
+        }
+        if (waited >= timeout) {
+            return false;
+        }
+        if (m_sleeper) {
+            m_sleeper->sleep(1);
+        } else {
+            poll(1);
+        }
+    }
+}
+
+void TransmitTracker::set_external_alerts(Core::iThreadStrategy* sleeper) {
+    m_sleeper = sleeper;
+}
+
+void TransmitTracker::alert_listener(Alert alerts, void* tracker) {
+    ((TransmitTracker*)tracker)->on_alerts(alerts);
+}
+
+uint32_t TransmitTracker::in_flight() const {
+    Core::LockGuard guard(m_lock);
+    return m_submitted - m_completed;
+}
+
+TransmitTracker::Statistics TransmitTracker::statistics() const {
+    Core::LockGuard guard(m_lock);
+    return m_statistics;
+}
@@ -0,0 +1,194 @@
+#ifndef CAN_TRANSMIT_TRACKER_H
+#define CAN_TRANSMIT_TRACKER_H
+
+#include <stdint.h>
+
+#include "core/clock.h"
+#include "core/lock.h"
+#include "core/thread.h"
+#include "provider.h"
+
+// Number of frames that can be in flight (pending or in the driver queue) at once.
+#ifndef CAN_TRANSMIT_TRACKER_SLOTS
+#define CAN_TRANSMIT_TRACKER_SLOTS 16
+#endif
+
+static_assert((CAN_TRANSMIT_TRACKER_SLOTS & (CAN_TRANSMIT_TRACKER_SLOTS - 1)) == 0,
+              "CAN_TRANSMIT_TRACKER_SLOTS must be a power of two so the ring cursors can wrap");
+
+namespace CAN {
+
+/*
+ * Lifecycle of an asynchronously submitted frame.
+ */
+enum class TransmitStatus {
+    EXPIRED,    /**< The handle is invalid or its slot has been reused */
+    PENDING,    /**< Waiting for room in the driver transmit queue */
+    QUEUED,     /**< Accepted by the driver, waiting to go out on the wire */
+    SUCCESS,    /**< Transmitted on the wire */
+    FAILED,     /**< Transmission failed or was dropped by a bus-off */
+};
+
+/*
+ * Outcome of an asynchronously submitted frame.
+ */
+struct TransmitResult {
+    TransmitStatus status;
+    uint32_t identifier;
+    uint64_t enqueued_us;   /**< Clock time the frame was submitted */
+    uint64_t completed_us;  /**< Clock time the completion alert was processed */
+
+    uint32_t latency_us() const { return (uint32_t)(completed_us - enqueued_us); }
+};
+
+/*
+ * Called once when a submitted frame completes. Runs on the task that processes alerts.
+ */
+typedef void(*TransmitCallback)(const TransmitResult& result, void* context);
+
+class TransmitTracker;
+
+/*
+ * Lightweight reference to a frame submitted to a TransmitTracker.
+ * Handles stay valid until CAN_TRANSMIT_TRACKER_SLOTS newer frames have been submitted.
+ */
+class TransmitHandle {
+public:
+    TransmitHandle() : tracker(nullptr), slot(0), generation(0) {}
+
+    // Whether the frame was accepted for transmission at all.
+    bool valid() const { return tracker != nullptr; }
+
+    TransmitStatus status() const;
+
+    // Whether the frame has completed, successfully or not.
+    bool done() const;
+
+    /*
+     * Copies the frame outcome.
+     * @returns true if the handle has not expired, false otherwise.
+     */
+    bool result(TransmitResult& result) const;
+
+    /*
+     * Blocks until the frame completes, processing alerts while waiting.
+     * @param timeout The maximum time to wait for alerts in milliseconds.
+     * @returns true if the frame was transmitted successfully, false otherwise.
+     */
+    bool wait(uint32_t timeout) const;
+
+private:
+    friend class TransmitTracker;
+
+    TransmitHandle(TransmitTracker* tracker, uint16_t slot, uint16_t generation)
+        : tracker(tracker), slot(slot), generation(generation) {}
+
+    TransmitTracker* tracker;
+    uint16_t slot;
+    uint16_t generation;
+};
+
+/*
+ * Non-blocking transmit front end for a Provider.
+ *
+ * Frames are copied into a fixed ring of slots and handed to the driver queue without waiting.
+ * Frames that do not fit in the driver queue stay pending and are handed over as completions
+ * free up room. Completions are resolved from TX_SUCCESS / TX_FAILED / BUS_OFF alerts, so the
+ * provider must have those alerts enabled (the default).
+ */
+class TransmitTracker {
+public:
+    struct Statistics {
+        uint32_t submitted = 0;         /**< Frames accepted by submit() */
+        uint32_t rejected = 0;          /**< Frames refused because every slot was in use */
+        uint32_t succeeded = 0;         /**< Frames confirmed on the wire */
+        uint32_t failed = 0;            /**< Frames that failed or were dropped */
+        uint32_t last_latency_us = 0;   /**< Enqueue to completion time of the latest success */
+        uint32_t max_latency_us = 0;    /**< Worst enqueue to completion time seen */
+    };
+
+    /*
+     * @param provider The provider frames are transmitted through.
+     * @param clock Time source for latency stamps (can be nullptr for no timestamps).
+     * @param lock Guards the slots when submit and alert processing run on different tasks (can be nullptr).
+     */
+    TransmitTracker(Provider* provider, Core::iClockStrategy* clock, Core::iLockStrategy* lock = nullptr);
+
+    /*
+     * Submits a frame for transmission without blocking.
+     * @param frame The CAN frame to transmit.
+     * @param callback Optional completion callback.
+     * @param context Passed to the callback untouched.
+     * @returns A handle to the frame, invalid if every slot is in use.
+     */
+    TransmitHandle submit(const Frame& frame, TransmitCallback callback = nullptr, void* context = nullptr);
+
+    /*
+     * Waits for driver alerts and resolves completed frames.
+     * @param timeout The time to wait for an alert in milliseconds.
+     * @returns true if alerts were read, false otherwise.
+     */
+    bool poll(uint32_t timeout = 0);
+
+    /*
+     * Resolves completed frames from alerts read elsewhere.
+     * @param alerts The alerts read from the driver.
+     */
+    void on_alerts(Alert alerts);
+
+    /*
+     * Marks the tracker as fed by another task's alert loop (see Supervisor).
+     * wait() then sleeps on `sleeper` between checks instead of reading alerts itself.
+     * @param sleeper Used to sleep while waiting (nullptr to read alerts directly again).
+     */
+    void set_external_alerts(Core::iThreadStrategy* sleeper);
+
+    // Alert listener adapter, pass the tracker as the context.
+    static void alert_listener(Alert alerts, void* tracker);
+
+    TransmitStatus status(const TransmitHandle& handle) const;
+    bool result(const TransmitHandle& handle, TransmitResult& result) const;
+    bool wait(const TransmitHandle& handle, uint32_t timeout);
+
+    // Frames submitted that have not completed yet.
+    uint32_t in_flight() const;
+
+    Statistics statistics() const;
+
+private:
+    struct Slot {
+        Frame frame;
+        TransmitResult result;
+        TransmitCallback callback;
+        void* context;
+        uint16_t generation;
+    };
+
+    struct Completion {
+        TransmitCallback callback;
+        void* context;
+        TransmitResult result;
+    };
+
+    Provider* m_provider;
+    Core::iClockStrategy* m_clock;
+    Core::iLockStrategy* m_lock;
+    Core::iThreadStrategy* m_sleeper;
+
+    Slot m_slots[CAN_TRANSMIT_TRACKER_SLOTS];
+    // Monotonic ring cursors: [m_completed, m_handed) are in the driver, [m_handed, m_submitted) are pending.
+    uint32_t m_completed;
+    uint32_t m_handed;
+    uint32_t m_submitted;
+    // Driver tx_failed_count at the last completion pass.
+    uint32_t m_tx_failed_count;
+    Statistics m_statistics;
+
+    uint64_t now();
+    void hand_to_driver();
+    void complete(TransmitStatus status, uint64_t now, Completion* completions, uint32_t& count);
+};
+
+} // namespace CAN
+
+#endif // CAN_TRANSMIT_TRACKER_H
@@ -9,6 +9,31 @@ namespace CAN {
 typedef uint32_t Tick;
 typedef uint32_t Alert;
 
+/*
+ * Alert bit flags, these mirror TWAI_ALERT_* from driver/twai.h.
+ */
+namespace Alerts {
+    constexpr Alert TX_IDLE              = 0x00000001; /**< No more messages to transmit */
+    constexpr Alert TX_SUCCESS           = 0x00000002; /**< The previous transmission was successful */
+    constexpr Alert RX_DATA              = 0x00000004; /**< A frame has been received and added to the RX queue */
+    constexpr Alert BELOW_ERR_WARN       = 0x00000008; /**< Both error counters have dropped below error warning limit */
+    constexpr Alert ERR_ACTIVE           = 0x00000010; /**< TWAI controller has become error active */
+    constexpr Alert RECOVERY_IN_PROGRESS = 0x00000020; /**< TWAI controller is undergoing bus recovery */
+    constexpr Alert BUS_RECOVERED        = 0x00000040; /**< TWAI controller has successfully completed bus recovery */
+    constexpr Alert ARB_LOST             = 0x00000080; /**< The previous transmission lost arbitration */
+    constexpr Alert ABOVE_ERR_WARN       = 0x00000100; /**< One of the error counters have exceeded the error warning limit */
+    constexpr Alert BUS_ERROR            = 0x00000200; /**< A (Bit, Stuff, CRC, Form, ACK) error has occurred on the bus */
+    constexpr Alert TX_FAILED            = 0x00000400; /**< The previous transmission has failed (for single shot transmission) */
+    constexpr Alert RX_QUEUE_FULL        = 0x00000800; /**< The RX queue is full causing a frame to be lost */
+    constexpr Alert ERR_PASS             = 0x00001000; /**< TWAI controller has become error passive */
+    constexpr Alert BUS_OFF              = 0x00002000; /**< Bus-off condition occurred. TWAI controller can no longer influence bus */
+    constexpr Alert RX_FIFO_OVERRUN      = 0x00004000; /**< An RX FIFO overrun has occurred */
+    constexpr Alert TX_RETRIED           = 0x00008000; /**< A message transmission was cancelled and retried due to an errata workaround */
+    constexpr Alert PERIPH_RESET         = 0x00010000; /**< The TWAI controller was reset */
+    constexpr Alert ALL                  = 0x0001FFFF; /**< Bit mask to enable all alerts during configuration */
+    constexpr Alert NONE                 = 0x00000000; /**< Bit mask to disable all alerts during configuration */
+}
+
 enum class Result {
     OK                      = 0,      /*!< esp_err_t value indicating success (no error) */
     FAIL                    = -1,     /*!< Generic esp_err_t code indicating failure */
@@ -114,12 +139,13 @@ struct Frame {
     uint8_t data_length_code;           /**< Data length code */
     uint8_t data[8];    /**< Data bytes (not relevant in RTR frame) */
 
-    Frame() {}
+    Frame() : flags(0) {}
 
     template<typename T>
     Frame(uint32_t identifier, T* message) {
         static_assert(sizeof(T) <= 8, "Message too large for CAN frame");
         
+        this->flags = 0;
         this->data_length_code = 8;
         this->identifier = identifier;
 
@@ -135,6 +161,7 @@ struct Frame {
     }
 
     Frame(uint32_t identifier, uint8_t (&data)[8]) {
+        this->flags = 0;
         this->data_length_code = 8;
         this->identifier = identifier;
         this->data[0] = data[0];
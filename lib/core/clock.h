@@ -0,0 +1,7 @@
+// This is an umbrella header for the clock library. It includes all the necessary headers for using the clock library.
+#ifndef CLOCK_H
+#define CLOCK_H
+
+#include "clock/i_clock_strategy.h"
+
+#endif // CLOCK_H
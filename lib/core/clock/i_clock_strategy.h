@@ -0,0 +1,21 @@
+#ifndef CORE_CLOCK_I_CLOCK_STRATEGY_H
+#define CORE_CLOCK_I_CLOCK_STRATEGY_H
+
+#include <stdint.h>
+
+namespace Core {
+
+/**
+ * @brief Monotonic time source abstract interface
+ *          On ESP32 this would be backed by esp_timer_get_time().
+ * @fn micros: Microseconds since an arbitrary, fixed point in time. Never goes backwards.
+ */
+class iClockStrategy {
+public:
+    virtual ~iClockStrategy() = default;
+    virtual uint64_t micros() = 0;
+};
+
+} // namespace Core
+
+#endif // CORE_CLOCK_I_CLOCK_STRATEGY_H
@@ -2,7 +2,16 @@
 #ifndef CORE_H
 #define CORE_H
 
+#include "clock.h"
+#include "dsp.h"
+#include "fsm.h"
 #include "lock.h"
+#include "lut.h"
+#include "memory.h"
+#include "metrics.h"
+#include "numeric.h"
+#include "queue.h"
+#include "startup.h"
 #include "thread.h"
 
 #endif // CORE_H
\ No newline at end of file
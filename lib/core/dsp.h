@@ -0,0 +1,11 @@
+// This is an umbrella header for the DSP library. It includes all the necessary headers for using the DSP library.
+#ifndef DSP_H
+#define DSP_H
+
+#include "dsp/biquad.h"
+#include "dsp/exponential.h"
+#include "dsp/fir.h"
+#include "dsp/fixed_point.h"
+#include "dsp/median.h"
+
+#endif // DSP_H
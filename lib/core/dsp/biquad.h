@@ -0,0 +1,106 @@
+#ifndef CORE_DSP_BIQUAD_H
+#define CORE_DSP_BIQUAD_H
+
+#include <stdint.h>
+
+#include "fixed_point.h"
+
+namespace Core {
+namespace DSP {
+
+/**
+ * @brief Second-order section coefficients in Q2.14, a0 normalised to one
+ *
+ * y[n] = b0 x[n] + b1 x[n-1] + b2 x[n-2] - a1 y[n-1] - a2 y[n-2]
+ */
+struct BiquadCoefficients {
+    int16_t b0;
+    int16_t b1;
+    int16_t b2;
+    int16_t a1;
+    int16_t a2;
+};
+
+/**
+ * @brief Cascade of fixed-point direct form I biquads
+ *
+ * Each section rounds and saturates into the sample type before feeding the next one. The
+ * recursion does not vectorize, the block API only saves the per-sample call and reload of
+ * the state.
+ *
+ * @tparam T Sample type
+ * @tparam Sections Number of cascaded second-order sections
+ * @tparam Acc Accumulator type, five products of a sample and a Q2.14 coefficient
+ */
+template<typename T, uint32_t Sections = 1, typename Acc = int64_t>
+class Biquad {
+    static_assert(Sections >= 1, "Biquad needs at least one section");
+
+public:
+    static constexpr uint32_t FRACTION_BITS = 14;
+
+    Biquad() {
+        for (uint32_t i = 0; i < Sections; i++) {
+            m_coefficients[i] = { (int16_t)(1 << FRACTION_BITS), 0, 0, 0, 0 };
+        }
+        reset();
+    }
+
+    explicit Biquad(const BiquadCoefficients (&coefficients)[Sections]) {
+        set(coefficients);
+        reset();
+    }
+
+    void set(const BiquadCoefficients (&coefficients)[Sections]) {
+        for (uint32_t i = 0; i < Sections; i++) {
+            m_coefficients[i] = coefficients[i];
+        }
+    }
+
+    void reset() {
+        for (uint32_t i = 0; i < Sections; i++) {
+            m_state[i] = { 0, 0, 0, 0 };
+        }
+    }
+
+    T process(T sample) {
+        T x = sample;
+        for (uint32_t i = 0; i < Sections; i++) {
+            const BiquadCoefficients& c = m_coefficients[i];
+            State& s = m_state[i];
+
+            Acc acc = (Acc)c.b0 * x + (Acc)c.b1 * s.x1 + (Acc)c.b2 * s.x2
+                    - (Acc)c.a1 * s.y1 - (Acc)c.a2 * s.y2;
+            T y = saturate<T>(round_shift<FRACTION_BITS>(acc));
+
+            s.x2 = s.x1;
+            s.x1 = x;
+            s.y2 = s.y1;
+            s.y1 = y;
+            x = y;
+        }
+        return x;
+    }
+
+    void process(const T* input, T* output, uint32_t count) {
+        for (uint32_t i = 0; i < count; i++) {
+            output[i] = process(input[i]);
+        }
+    }
+
+private:
+    struct State {
+        T x1;
+        T x2;
+        T y1;
+        T y2;
+    };
+
+    BiquadCoefficients m_coefficients[Sections];
+    State m_state[Sections];
+};
+
+} // namespace DSP
+} // namespace Core
+
+#endif // CORE_DSP_BIQUAD_H
@@ -0,0 +1,63 @@
+#ifndef CORE_DSP_EXPONENTIAL_H
+#define CORE_DSP_EXPONENTIAL_H
+
+#include <stdint.h>
+
+#include "fixed_point.h"
+
+namespace Core {
+namespace DSP {
+
+/**
+ * @brief First-order low-pass with a power-of-two smoothing factor alpha = 2^-Shift
+ *
+ * The state carries Shift extra fraction bits so small steps are not lost to truncation, an
+ * update is an add, a subtract and two shifts. The first sample initialises the output.
+ *
+ * @tparam T Sample type
+ * @tparam Shift Smoothing, the time constant is roughly 2^Shift samples
+ * @tparam Acc State type, needs Shift bits of headroom over the sample type
+ */
+template<typename T, uint32_t Shift, typename Acc = typename Widen<T>::type>
+class ExponentialFilter {
+    static_assert(Shift >= 1 && Shift < 16, "ExponentialFilter supports shifts of 1 to 15");
+
+public:
+    ExponentialFilter() {
+        reset();
+    }
+
+    void reset() {
+        m_state = 0;
+        m_primed = false;
+    }
+
+    T value() const {
+        return saturate<T>(round_shift<Shift>(m_state));
+    }
+
+    T process(T sample) {
+        if (!m_primed) {
+            m_state = (Acc)sample * ((Acc)1 << Shift);
+            m_primed = true;
+        } else {
+            m_state += (Acc)sample - round_shift<Shift>(m_state);
+        }
+        return value();
+    }
+
+    void process(const T* input, T* output, uint32_t count) {
+        for (uint32_t i = 0; i < count; i++) {
+            output[i] = process(input[i]);
+        }
+    }
+
+private:
+    Acc m_state;
+    bool m_primed;
+};
+
+} // namespace DSP
+} // namespace Core
+
+#endif // CORE_DSP_EXPONENTIAL_H
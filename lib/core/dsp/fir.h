@@ -0,0 +1,89 @@
+#ifndef CORE_DSP_FIR_H
+#define CORE_DSP_FIR_H
+
+#include <stdint.h>
+
+#include "fixed_point.h"
+
+namespace Core {
+namespace DSP {
+
+/**
+ * @brief Fixed-point FIR filter with Q15 coefficients
+ *
+ * The delay line is stored twice back to back, so the most recent Taps samples are always
+ * contiguous and the convolution is a straight dot product against the reversed coefficients,
+ * which the compiler vectorizes. Results are rounded and saturated to the sample type.
+ *
+ * @tparam T Sample type
+ * @tparam Taps Filter length
+ * @tparam Acc Accumulator type, see Widen for the default
+ */
+template<typename T, uint32_t Taps, typename Acc = typename Widen<T>::type>
+class FirFilter {
+    static_assert(Taps >= 1, "FirFilter needs at least one tap");
+
+public:
+    static constexpr uint32_t FRACTION_BITS = 15;
+
+    FirFilter() {
+        for (uint32_t i = 0; i < Taps; i++) {
+            m_reversed[i] = 0;
+        }
+        reset();
+    }
+
+    explicit FirFilter(const int16_t (&coefficients)[Taps]) {
+        set(coefficients);
+        reset();
+    }
+
+    /**
+     * @brief Loads the impulse response, coefficients[0] weighs the newest sample
+     */
+    void set(const int16_t (&coefficients)[Taps]) {
+        for (uint32_t i = 0; i < Taps; i++) {
+            m_reversed[i] = coefficients[Taps - 1 - i];
+        }
+    }
+
+    /**
+     * @brief Fills the delay line, e.g. with the first reading to skip the start-up transient
+     */
+    void reset(T value = 0) {
+        for (uint32_t i = 0; i < 2 * Taps; i++) {
+            m_history[i] = value;
+        }
+        m_head = 0;
+    }
+
+    T process(T sample) {
+        m_history[m_head] = sample;
+        m_history[m_head + Taps] = sample;
+
+        const T* window = &m_history[m_head + 1];
+        Acc acc = 0;
+        for (uint32_t i = 0; i < Taps; i++) {
+            acc += (Acc)window[i] * m_reversed[i];
+        }
+
+        m_head = m_head + 1 == Taps ? 0 : m_head + 1;
+        return saturate<T>(round_shift<FRACTION_BITS>(acc));
+    }
+
+    void process(const T* input, T* output, uint32_t count) {
+        for (uint32_t i = 0; i < count; i++) {
+            output[i] = process(input[i]);
+        }
+    }
+
+private:
+    int16_t m_reversed[Taps];
+    T m_history[2 * Taps];
+    uint32_t m_head;
+};
+
+} // namespace DSP
+} // namespace Core
+
+#endif // CORE_DSP_FIR_H
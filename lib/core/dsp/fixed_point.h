@@ -0,0 +1,44 @@
+#ifndef CORE_DSP_FIXED_POINT_H
+#define CORE_DSP_FIXED_POINT_H
+
+#include <stdint.h>
+
+#include "../numeric/saturate.h"
+
+namespace Core {
+namespace DSP {
+
+/**
+ * @brief Accumulator wide enough for sums of sample by Q15 coefficient products
+ *
+ * 16-bit signed samples accumulate in 32 bits as long as the absolute coefficient sum stays
+ * below 2.0, which keeps the FIR inner loop a 16x16->32 multiply-accumulate the compiler can
+ * vectorize. Unsigned 16-bit ADC readings and 32-bit samples need 64 bits.
+ */
+template<typename T> struct Widen;
+template<> struct Widen<int8_t> { typedef int32_t type; };
+template<> struct Widen<uint8_t> { typedef int32_t type; };
+template<> struct Widen<int16_t> { typedef int32_t type; };
+template<> struct Widen<uint16_t> { typedef int64_t type; };
+template<> struct Widen<int32_t> { typedef int64_t type; };
+
+/**
+ * @brief Clamps an accumulator into the range of the sample type, see Core::saturate_cast
+ */
+template<typename T, typename Acc>
+inline T saturate(Acc value) {
+    return saturate_cast<T>(value);
+}
+
+/**
+ * @brief Divides by 2^Bits rounding halves up
+ */
+template<uint32_t Bits, typename Acc>
+inline Acc round_shift(Acc value) {
+    return (value + ((Acc)1 << (Bits - 1))) >> Bits;
+}
+
+} // namespace DSP
+} // namespace Core
+
+#endif // CORE_DSP_FIXED_POINT_H
@@ -0,0 +1,76 @@
+#ifndef CORE_DSP_MEDIAN_H
+#define CORE_DSP_MEDIAN_H
+
+#include <stdint.h>
+
+namespace Core {
+namespace DSP {
+
+/**
+ * @brief Sliding-window median, rejects single-sample spikes without smearing edges
+ *
+ * Keeps the window both in arrival order and sorted; every sample removes the oldest value
+ * from the sorted copy and inserts the new one, O(Length) moves and no heap. Until the window
+ * has filled up the median of the samples seen so far is returned.
+ *
+ * @tparam T Sample type
+ * @tparam Length Window length, odd so the median is a sample
+ */
+template<typename T, uint32_t Length>
+class MovingMedian {
+    static_assert(Length >= 1 && Length % 2 == 1, "MovingMedian needs an odd window length");
+
+public:
+    MovingMedian() {
+        reset();
+    }
+
+    void reset() {
+        m_count = 0;
+        m_head = 0;
+    }
+
+    T process(T sample) {
+        uint32_t size = m_count;
+        if (m_count == Length) {
+            // Drop the oldest value from the sorted window
+            T oldest = m_window[m_head];
+            uint32_t i = 0;
+            while (m_sorted[i] != oldest) i++;
+            for (; i + 1 < size; i++) {
+                m_sorted[i] = m_sorted[i + 1];
+            }
+            size--;
+        } else {
+            m_count++;
+        }
+
+        uint32_t i = size;
+        while (i > 0 && m_sorted[i - 1] > sample) {
+            m_sorted[i] = m_sorted[i - 1];
+            i--;
+        }
+        m_sorted[i] = sample;
+
+        m_window[m_head] = sample;
+        m_head = m_head + 1 == Length ? 0 : m_head + 1;
+        return m_sorted[m_count / 2];
+    }
+
+    void process(const T* input, T* output, uint32_t count) {
+        for (uint32_t i = 0; i < count; i++) {
+            output[i] = process(input[i]);
+        }
+    }
+
+private:
+    T m_window[Length];
+    T m_sorted[Length];
+    uint32_t m_count;
+    uint32_t m_head;
+};
+
+} // namespace DSP
+} // namespace Core
+
+#endif // CORE_DSP_MEDIAN_H
@@ -0,0 +1,7 @@
+// This is an umbrella header for the state machine library. It includes all the necessary headers for using the state machine library.
+#ifndef FSM_H
+#define FSM_H
+
+#include "fsm/state_machine.h"
+
+#endif // FSM_H
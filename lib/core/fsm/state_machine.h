@@ -0,0 +1,220 @@
+#ifndef CORE_FSM_STATE_MACHINE_H
+#define CORE_FSM_STATE_MACHINE_H
+
+#include <stdint.h>
+
+#include "../clock/i_clock_strategy.h"
+#include "../lut/table.h"
+#include "../metrics/histogram.h"
+
+namespace Core {
+namespace Fsm {
+
+// Index entry of a state and event pair without a transition.
+constexpr uint8_t NO_TRANSITION = 0xFF;
+
+/**
+ * @brief Source state of a transition taken from every state
+ *          Rows for a specific state take precedence over these.
+ **/
+template<typename State>
+constexpr State any() { return (State)0xFF; }
+
+/**
+ * @brief Target of an internal transition, the action runs but the state is not left
+ **/
+template<typename State>
+constexpr State stay() { return (State)0xFE; }
+
+/**
+ * @brief One row of a transition table
+ * @param guard: Taken only if it returns true, nullptr always takes it
+ * @param action: Runs between the exit hook of the old and the entry hook of the new state, can be nullptr
+ **/
+template<typename Context, typename State, typename Event>
+struct Transition {
+    State from;
+    Event event;
+    State to;
+    bool (*guard)(const Context& context);
+    void (*action)(Context& context);
+};
+
+/**
+ * @brief Hooks run when a state is entered or left, either can be nullptr
+ **/
+template<typename Context>
+struct StateHooks {
+    void (*enter)(Context& context);
+    void (*exit)(Context& context);
+};
+
+namespace Detail {
+
+template<typename Row>
+constexpr uint8_t find(const Row* rows, uint32_t count, uint8_t from, uint8_t event, uint32_t i) {
+    return i >= count ? NO_TRANSITION
+         : (uint8_t)rows[i].from == from && (uint8_t)rows[i].event == event ? (uint8_t)i
+         : find(rows, count, from, event, i + 1);
+}
+
+// First row for the state and event, else the first wildcard row for the event
+template<typename Row>
+constexpr uint8_t lookup(const Row* rows, uint32_t count, uint8_t from, uint8_t event) {
+    return find(rows, count, from, event, 0) != NO_TRANSITION ? find(rows, count, from, event, 0)
+         : find(rows, count, 0xFF, event, 0);
+}
+
+template<typename Definition, typename Sequence>
+struct TransitionIndex;
+
+// Dense state by event table of the first matching row, computed by the compiler
+template<typename Definition, uint32_t... I>
+struct TransitionIndex<Definition, Lut::Indices<I...>> {
+    static constexpr uint32_t ROWS = sizeof(Definition::TRANSITIONS) / sizeof(Definition::TRANSITIONS[0]);
+    static constexpr uint8_t VALUES[sizeof...(I)] = {
+        lookup(Definition::TRANSITIONS, ROWS, (uint8_t)(I / Definition::EVENTS), (uint8_t)(I % Definition::EVENTS))...
+    };
+};
+
+template<typename Definition, uint32_t... I>
+constexpr uint8_t TransitionIndex<Definition, Lut::Indices<I...>>::VALUES[sizeof...(I)];
+
+} // namespace Detail
+
+/**
+ * @brief Table-driven state machine without heap or virtual calls
+ *
+ * The machine is described by a Definition type:
+ *     typedef ... Context, State, Event;      State and Event are uint8_t enums counted from 0
+ *     static constexpr uint8_t STATES, EVENTS;
+ *     static constexpr State INITIAL;
+ *     static constexpr Transition<Context, State, Event> TRANSITIONS[];
+ *     static constexpr StateHooks<Context> HOOKS[STATES];
+ *
+ * The compiler turns the transition rows into a state by event index, so dispatching an
+ * event is one table read. Rows for the same state and event are alternatives tried in
+ * order, keep them next to each other, the first one whose guard passes is taken.
+ * Hooks and actions must not dispatch themselves, feed follow-up events after dispatch()
+ * returns. The machine does no locking, its owner serializes the calls.
+ **/
+template<typename Definition>
+class StateMachine {
+public:
+    typedef typename Definition::Context Context;
+    typedef typename Definition::State State;
+    typedef typename Definition::Event Event;
+    typedef Log2Histogram<24> Histogram;
+
+    struct Statistics {
+        uint32_t dispatched;        /**< Events fed to the machine */
+        uint32_t transitions;       /**< Transitions taken, internal ones included */
+        uint32_t ignored;           /**< Events without a transition from the current state */
+        uint32_t rejected;          /**< Events whose transitions were all refused by their guards */
+    };
+
+    static constexpr uint32_t ROWS = sizeof(Definition::TRANSITIONS) / sizeof(Definition::TRANSITIONS[0]);
+
+    static_assert(Definition::STATES < 0xFE && Definition::EVENTS > 0, "State machines support up to 253 states");
+    static_assert(ROWS < NO_TRANSITION, "State machines support up to 254 transitions");
+
+    /**
+     * @param clock Time source for the transition latency, nullptr disables it
+     **/
+    StateMachine(Context* context, iClockStrategy* clock = nullptr) {
+        m_context = context;
+        m_clock = clock;
+        m_state = Definition::INITIAL;
+        m_entered_us = 0;
+        m_statistics = {};
+    }
+
+    /**
+     * @brief Enters the initial state, running its entry hook
+     **/
+    void start() {
+        m_state = Definition::INITIAL;
+        m_entered_us = now();
+        const StateHooks<Context>& hooks = Definition::HOOKS[(uint8_t)m_state];
+        if (hooks.enter != nullptr) hooks.enter(*m_context);
+    }
+
+    /**
+     * @brief Feeds an event
+     * @param observed_us When the event happened, the latency is measured from there
+     * @returns true if a transition was taken, false if the event was ignored or refused
+     **/
+    bool dispatch(Event event, uint64_t observed_us) {
+        m_statistics.dispatched++;
+        uint8_t e = (uint8_t)event;
+        uint8_t i = e < Definition::EVENTS ? Index::VALUES[(uint32_t)(uint8_t)m_state * Definition::EVENTS + e] : NO_TRANSITION;
+        if (i == NO_TRANSITION) {
+            m_statistics.ignored++;
+            return false;
+        }
+
+        uint8_t from = (uint8_t)Definition::TRANSITIONS[i].from;
+        for (; i < ROWS; i++) {
+            const Transition<Context, State, Event>& row = Definition::TRANSITIONS[i];
+            if ((uint8_t)row.from != from || (uint8_t)row.event != e) break;
+            if (row.guard == nullptr || row.guard(*m_context)) {
+                take(row, observed_us);
+                return true;
+            }
+        }
+        m_statistics.rejected++;
+        return false;
+    }
+
+    bool dispatch(Event event) {
+        return dispatch(event, now());
+    }
+
+    State state() const { return m_state; }
+    // Time the current state was entered.
+    uint64_t entered_us() const { return m_entered_us; }
+
+    // Microseconds from the event being observed to the end of its transition.
+    const Histogram& latency() const { return m_latency; }
+    Statistics statistics() const { return m_statistics; }
+
+private:
+    typedef Detail::TransitionIndex<Definition, typename Lut::MakeIndices<Definition::STATES * Definition::EVENTS>::type> Index;
+
+    Context* m_context;
+    iClockStrategy* m_clock;
+    State m_state;
+    uint64_t m_entered_us;
+    Statistics m_statistics;
+    Histogram m_latency;
+
+    uint64_t now() { return m_clock != nullptr ? m_clock->micros() : 0; }
+
+    void take(const Transition<Context, State, Event>& row, uint64_t observed_us) {
+        m_statistics.transitions++;
+        if ((uint8_t)row.to == (uint8_t)stay<State>()) {
+            if (row.action != nullptr) row.action(*m_context);
+        } else {
+            const StateHooks<Context>& old_hooks = Definition::HOOKS[(uint8_t)m_state];
+            if (old_hooks.exit != nullptr) old_hooks.exit(*m_context);
+            if (row.action != nullptr) row.action(*m_context);
+            m_state = row.to;
+            m_entered_us = now();
+            const StateHooks<Context>& new_hooks = Definition::HOOKS[(uint8_t)m_state];
+            if (new_hooks.enter != nullptr) new_hooks.enter(*m_context);
+        }
+
+        if (m_clock != nullptr) {
+            uint64_t done = m_clock->micros();
+            m_latency.record(done > observed_us ? (uint32_t)(done - observed_us) : 0);
+        }
+    }
+};
+
+template<typename Definition>
+constexpr uint32_t StateMachine<Definition>::ROWS;
+
+} // namespace Fsm
+} // namespace Core
+
+#endif // CORE_FSM_STATE_MACHINE_H
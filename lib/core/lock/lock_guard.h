@@ -40,8 +40,8 @@ public:
     LockGuard& operator=(const LockGuard&) = delete;
     LockGuard(LockGuard&&) = delete;
     LockGuard& operator=(LockGuard&&) = delete;
-
-#endif // CORE_LOCK_LOCK_GUARD_H
 };
 
-} // namespace Core
\ No newline at end of file
+} // namespace Core
+
+#endif // CORE_LOCK_LOCK_GUARD_H
\ No newline at end of file
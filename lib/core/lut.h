@@ -0,0 +1,8 @@
+// This is an umbrella header for the lookup table library. It includes all the necessary headers for using the lookup table library.
+#ifndef LUT_H
+#define LUT_H
+
+#include "lut/interpolate.h"
+#include "lut/table.h"
+
+#endif // LUT_H
@@ -0,0 +1,61 @@
+#ifndef CORE_LUT_INTERPOLATE_H
+#define CORE_LUT_INTERPOLATE_H
+
+#include <stdint.h>
+
+namespace Core {
+namespace Lut {
+
+/**
+ * @brief Finds the segment of a sorted axis that holds x
+ *
+ * Branch-light binary search, the loop runs log2(count) times whatever x is and the compare
+ * becomes a conditional move.
+ *
+ * @param axis Strictly increasing breakpoints
+ * @param count Number of breakpoints, at least two
+ * @returns Index i in [0, count - 2] of the last breakpoint not above x, 0 below the axis
+ */
+template<typename X>
+inline uint32_t segment(const X* axis, uint32_t count, X x) {
+    uint32_t base = 0;
+    uint32_t size = count - 1;
+    while (size > 1) {
+        uint32_t half = size / 2;
+        base = axis[base + half] <= x ? base + half : base;
+        size -= half;
+    }
+    return base;
+}
+
+/**
+ * @brief Piecewise-linear interpolation over a non-uniform axis, held flat beyond the ends
+ *
+ * The division truncates towards zero. The product of an axis span and a value span has to
+ * fit in 32 bits.
+ *
+ * @param axis Strictly increasing breakpoints
+ * @param values Value at each breakpoint
+ * @param count Number of breakpoints, at least two
+ */
+template<typename X, typename Y>
+inline Y interpolate(const X* axis, const Y* values, uint32_t count, X x) {
+    x = x < axis[0] ? axis[0] : x;
+    x = x > axis[count - 1] ? axis[count - 1] : x;
+    uint32_t i = segment(axis, count, x);
+    int32_t offset = (int32_t)(x - axis[i]) * ((int32_t)values[i + 1] - values[i]) / (int32_t)(axis[i + 1] - axis[i]);
+    return (Y)(values[i] + offset);
+}
+
+/**
+ * @brief Compile-time check that an axis is strictly increasing
+ */
+template<typename X, uint32_t N>
+constexpr bool increasing(const X (&axis)[N], uint32_t i = 1) {
+    return i >= N || (axis[i - 1] < axis[i] && increasing(axis, i + 1));
+}
+
+} // namespace Lut
+} // namespace Core
+
+#endif // CORE_LUT_INTERPOLATE_H
@@ -0,0 +1,146 @@
+#ifndef CORE_LUT_TABLE_H
+#define CORE_LUT_TABLE_H
+
+#include <stdint.h>
+
+#include "interpolate.h"
+
+namespace Core {
+namespace Lut {
+
+/**
+ * @brief 1-D table over a non-uniform axis
+ *
+ * An aggregate, so tables can be constexpr and checked with static_assert(table.valid()).
+ */
+template<typename X, typename Y, uint32_t N>
+struct Table {
+    static_assert(N >= 2, "Table needs at least two breakpoints");
+
+    X axis[N];
+    Y values[N];
+
+    constexpr bool valid() const {
+        return increasing(axis);
+    }
+
+    Y lookup(X x) const {
+        return interpolate(axis, values, N, x);
+    }
+};
+
+/**
+ * @brief 1-D table sampled every 2^Shift from an origin
+ *
+ * The segment is a shift and the fraction a mask, no search and no division. Interpolation
+ * rounds towards minus infinity, inputs outside the table are clamped to its ends.
+ *
+ * @tparam Y Value type, differences times the step have to fit in 32 bits
+ * @tparam N Number of samples
+ * @tparam Shift log2 of the axis step
+ */
+template<typename Y, uint32_t N, uint32_t Shift>
+struct UniformTable {
+    static_assert(N >= 2, "UniformTable needs at least two samples");
+    static_assert(Shift < 16, "UniformTable steps are limited to 2^15");
+
+    static constexpr int32_t STEP = 1 << Shift;
+    static constexpr int32_t SPAN = (int32_t)(N - 1) << Shift;
+
+    int32_t origin;
+    Y values[N];
+
+    constexpr int32_t axis(uint32_t i) const {
+        return origin + ((int32_t)i << Shift);
+    }
+
+    Y lookup(int32_t x) const {
+        int32_t offset = x - origin;
+        offset = offset < 0 ? 0 : offset;
+        offset = offset > SPAN ? SPAN : offset;
+        uint32_t i = (uint32_t)offset >> Shift;
+        i = i > N - 2 ? N - 2 : i;
+        int32_t fraction = offset - ((int32_t)i << Shift);
+        int32_t delta = (int32_t)values[i + 1] - values[i];
+        return (Y)(values[i] + ((delta * fraction) >> Shift));
+    }
+};
+
+/**
+ * @brief Compile-time index pack, std::index_sequence is not available in C++11
+ */
+template<uint32_t... I>
+struct Indices {};
+
+template<uint32_t N, uint32_t... I>
+struct MakeIndices : MakeIndices<N - 1, N - 1, I...> {};
+
+template<uint32_t... I>
+struct MakeIndices<0, I...> {
+    typedef Indices<I...> type;
+};
+
+template<typename Curve, typename Y, uint32_t N, uint32_t Shift, uint32_t... I>
+constexpr UniformTable<Y, N, Shift> generate(int32_t origin, Indices<I...>) {
+    return { origin, { Curve::value(origin + ((int32_t)I << Shift))... } };
+}
+
+/**
+ * @brief Samples a curve into a uniform table at compile time
+ *
+ * @tparam Curve Type with a static constexpr Y value(int32_t x)
+ */
+template<typename Curve, typename Y, uint32_t N, uint32_t Shift>
+constexpr UniformTable<Y, N, Shift> generate(int32_t origin) {
+    return generate<Curve, Y, N, Shift>(origin, typename MakeIndices<N>::type());
+}
+
+/**
+ * @brief 2-D table over two non-uniform axes with fixed-point bilinear interpolation
+ *
+ * The fractions along both axes are computed once in Q15, the four corners then blend with
+ * multiplies and shifts. Inputs outside the axes are clamped.
+ */
+template<typename X, typename Y, uint32_t Rows, uint32_t Columns>
+struct Table2D {
+    static_assert(Rows >= 2 && Columns >= 2, "Table2D needs at least two breakpoints per axis");
+
+    static constexpr uint32_t FRACTION_BITS = 15;
+
+    X rows[Rows];
+    X columns[Columns];
+    Y values[Rows][Columns];
+
+    constexpr bool valid() const {
+        return increasing(rows) && increasing(columns);
+    }
+
+    Y lookup(X row, X column) const {
+        int32_t fr;
+        int32_t fc;
+        uint32_t r = locate(rows, Rows, row, fr);
+        uint32_t c = locate(columns, Columns, column, fc);
+
+        int32_t top = blend(values[r][c], values[r][c + 1], fc);
+        int32_t bottom = blend(values[r + 1][c], values[r + 1][c + 1], fc);
+        return (Y)(top + (int32_t)(((int64_t)(bottom - top) * fr) >> FRACTION_BITS));
+    }
+
+private:
+    static uint32_t locate(const X* axis, uint32_t count, X x, int32_t& fraction) {
+        x = x < axis[0] ? axis[0] : x;
+        x = x > axis[count - 1] ? axis[count - 1] : x;
+        uint32_t i = segment(axis, count, x);
+        fraction = (int32_t)(((int64_t)(x - axis[i]) << FRACTION_BITS) / (axis[i + 1] - axis[i]));
+        return i;
+    }
+
+    static int32_t blend(int32_t a, int32_t b, int32_t fraction) {
+        return a + (int32_t)(((int64_t)(b - a) * fraction) >> FRACTION_BITS);
+    }
+};
+
+} // namespace Lut
+} // namespace Core
+
+#endif // CORE_LUT_TABLE_H
@@ -0,0 +1,9 @@
+// This is an umbrella header for the memory library. It includes all the necessary headers for using the memory library.
+#ifndef MEMORY_H
+#define MEMORY_H
+
+#include "memory/arena.h"
+#include "memory/object_pool.h"
+#include "memory/static_heap.h"
+
+#endif // MEMORY_H
@@ -0,0 +1,92 @@
+#ifndef CORE_MEMORY_ARENA_H
+#define CORE_MEMORY_ARENA_H
+
+#include <atomic>
+#include <cstddef>
+#include <new>
+#include <stdint.h>
+#include <utility>
+
+namespace Core {
+namespace Memory {
+
+/**
+ * @brief Bump allocator over a fixed buffer, for objects that live until the next reset
+ *
+ * Allocating is an aligned add on an offset, constant time and safe from any task, there
+ * is no per-allocation free. Meant for everything built once at init: the memory is never
+ * fragmented and the high water mark is the exact footprint.
+ *
+ * The constructor is constexpr so a static arena is ready before any constructor runs.
+ **/
+class Arena {
+public:
+    constexpr Arena(uint8_t* buffer, size_t size) : m_buffer(buffer), m_size(size), m_offset(0), m_failures(0) {}
+
+    Arena(const Arena&) = delete;
+    Arena& operator=(const Arena&) = delete;
+
+    /**
+     * @param alignment Power of two
+     * @returns The memory, nullptr if the arena cannot fit it
+     **/
+    void* allocate(size_t size, size_t alignment = alignof(std::max_align_t)) {
+        uintptr_t base = (uintptr_t)m_buffer;
+        size_t offset = m_offset.load(std::memory_order_relaxed);
+        for (;;) {
+            size_t start = ((base + offset + alignment - 1) & ~(uintptr_t)(alignment - 1)) - base;
+            if (start > m_size || size > m_size - start) {
+                m_failures.fetch_add(1, std::memory_order_relaxed);
+                return nullptr;
+            }
+            if (m_offset.compare_exchange_weak(offset, start + size, std::memory_order_relaxed)) {
+                return m_buffer + start;
+            }
+        }
+    }
+
+    /**
+     * @brief Constructs an object in the arena, its destructor is never run by the arena
+     * @returns The object, nullptr if the arena is full
+     **/
+    template<typename T, typename... Args>
+    T* create(Args&&... args) {
+        void* memory = allocate(sizeof(T), alignof(T));
+        return memory != nullptr ? new (memory) T(std::forward<Args>(args)...) : nullptr;
+    }
+
+    bool owns(const void* pointer) const {
+        return (const uint8_t*)pointer >= m_buffer && (const uint8_t*)pointer < m_buffer + m_size;
+    }
+
+    // Releases everything at once, nothing allocated from the arena may be in use.
+    void reset() { m_offset.store(0, std::memory_order_relaxed); }
+
+    size_t used() const { return m_offset.load(std::memory_order_relaxed); }
+    size_t capacity() const { return m_size; }
+    // Allocations refused because the arena was full.
+    uint32_t failures() const { return m_failures.load(std::memory_order_relaxed); }
+
+private:
+    uint8_t* m_buffer;
+    size_t m_size;
+    std::atomic<size_t> m_offset;
+    std::atomic<uint32_t> m_failures;
+};
+
+/**
+ * @brief Arena with its own storage, typically a static or a member
+ **/
+template<size_t Size>
+class StaticArena : public Arena {
+public:
+    StaticArena() : Arena(m_storage, Size) {}
+
+private:
+    alignas(std::max_align_t) uint8_t m_storage[Size];
+};
+
+} // namespace Memory
+} // namespace Core
+
+#endif // CORE_MEMORY_ARENA_H
@@ -0,0 +1,121 @@
+#ifndef CORE_MEMORY_OBJECT_POOL_H
+#define CORE_MEMORY_OBJECT_POOL_H
+
+#include <new>
+#include <stdint.h>
+#include <utility>
+
+#include "../lock/lock_guard.h"
+
+namespace Core {
+namespace Memory {
+
+/**
+ * @brief Fixed number of slots for objects of one type, created and destroyed in constant time
+ *
+ * Free slots form a list threaded through their own storage, so the pool has no overhead
+ * beyond one flag per slot, which also catches objects destroyed twice or from elsewhere.
+ *
+ * @tparam T Object type
+ * @tparam Capacity Number of objects alive at once
+ **/
+template<typename T, uint32_t Capacity>
+class ObjectPool {
+    static_assert(Capacity >= 1, "ObjectPool needs at least one slot");
+
+public:
+    /**
+     * @param lock Lock for pools shared between tasks, can be nullptr
+     **/
+    explicit ObjectPool(iLockStrategy* lock = nullptr) : m_lock(lock) {
+        for (uint32_t i = 0; i < Capacity; i++) {
+            m_slots[i].next = i + 1 < Capacity ? &m_slots[i + 1] : nullptr;
+            m_used[i] = false;
+        }
+        m_free = &m_slots[0];
+        m_in_use = 0;
+        m_high_water = 0;
+        m_exhausted = 0;
+    }
+
+    // Objects still in the pool are not destroyed.
+    ~ObjectPool() = default;
+
+    ObjectPool(const ObjectPool&) = delete;
+    ObjectPool& operator=(const ObjectPool&) = delete;
+
+    /**
+     * @brief Constructs an object in a free slot
+     * @returns The object, nullptr if every slot is in use
+     **/
+    template<typename... Args>
+    T* create(Args&&... args) {
+        Slot* slot;
+        {
+            LockGuard guard(m_lock);
+            slot = m_free;
+            if (slot == nullptr) {
+                m_exhausted++;
+                return nullptr;
+            }
+            m_free = slot->next;
+            m_used[slot - m_slots] = true;
+            if (++m_in_use > m_high_water) m_high_water = m_in_use;
+        }
+        return new (slot->storage) T(std::forward<Args>(args)...);
+    }
+
+    /**
+     * @brief Destroys an object and frees its slot
+     * @returns false if the object is not in use in this pool
+     **/
+    bool destroy(T* object) {
+        if (!owns(object)) return false;
+        Slot* slot = (Slot*)(void*)object;
+        uint32_t index = (uint32_t)(slot - m_slots);
+        {
+            LockGuard guard(m_lock);
+            if (!m_used[index]) return false;
+            m_used[index] = false;
+        }
+        object->~T();
+
+        LockGuard guard(m_lock);
+        slot->next = m_free;
+        m_free = slot;
+        m_in_use--;
+        return true;
+    }
+
+    // Whether the pointer is the start of one of the pool's slots.
+    bool owns(const T* object) const {
+        uintptr_t offset = (uintptr_t)object - (uintptr_t)m_slots;
+        return offset < sizeof(m_slots) && offset % sizeof(Slot) == 0;
+    }
+
+    uint32_t capacity() const { return Capacity; }
+    uint32_t in_use() { LockGuard guard(m_lock); return m_in_use; }
+    uint32_t available() { LockGuard guard(m_lock); return Capacity - m_in_use; }
+    uint32_t high_water() { LockGuard guard(m_lock); return m_high_water; }
+    // Creations refused because every slot was in use.
+    uint32_t exhausted() { LockGuard guard(m_lock); return m_exhausted; }
+
+private:
+    union Slot {
+        Slot* next;
+        alignas(T) uint8_t storage[sizeof(T)];
+    };
+
+    iLockStrategy* m_lock;
+    Slot m_slots[Capacity];
+    bool m_used[Capacity];
+    Slot* m_free;
+    uint32_t m_in_use;
+    uint32_t m_high_water;
+    uint32_t m_exhausted;
+};
+
+} // namespace Memory
+} // namespace Core
+
+#endif // CORE_MEMORY_OBJECT_POOL_H
@@ -0,0 +1,121 @@
+#include "static_heap.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+#include "arena.h"
+
+namespace Core {
+namespace Memory {
+
+namespace {
+
+// Heap allocation after Core::Memory::seal(), fatal in release builds too
+void abort_on_trip(size_t size) {
+    (void)size;
+    abort();
+}
+
+alignas(std::max_align_t) uint8_t storage[CORE_STATIC_HEAP_SIZE];
+// Constant initialized, usable by allocations from static constructors
+Arena arena(storage, CORE_STATIC_HEAP_SIZE);
+
+std::atomic<bool> is_sealed(false);
+std::atomic<HeapTripHandler> trip_handler(&abort_on_trip);
+std::atomic<uint32_t> allocations(0);
+std::atomic<uint32_t> frees(0);
+std::atomic<uint32_t> overflows(0);
+std::atomic<uint32_t> after_seal(0);
+
+} // namespace
+
+#if defined(CORE_STATIC_HEAP)
+
+static void* allocate(size_t size) {
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    if (is_sealed.load(std::memory_order_acquire)) {
+        after_seal.fetch_add(1, std::memory_order_relaxed);
+        trip_handler.load(std::memory_order_relaxed)(size);
+        return malloc(size > 0 ? size : 1);
+    }
+
+    void* memory = arena.allocate(size > 0 ? size : 1);
+    if (memory != nullptr) return memory;
+    overflows.fetch_add(1, std::memory_order_relaxed);
+    return malloc(size > 0 ? size : 1);
+}
+
+static void release(void* memory) {
+    if (memory == nullptr) return;
+    frees.fetch_add(1, std::memory_order_relaxed);
+    if (!arena.owns(memory)) free(memory);
+}
+
+bool static_heap_enabled() { return true; }
+
+#else
+
+bool static_heap_enabled() { return false; }
+
+#endif
+
+void seal() { is_sealed.store(true, std::memory_order_release); }
+void unseal() { is_sealed.store(false, std::memory_order_release); }
+bool sealed() { return is_sealed.load(std::memory_order_acquire); }
+
+void set_trip_handler(HeapTripHandler handler) {
+    trip_handler.store(handler != nullptr ? handler : &abort_on_trip, std::memory_order_relaxed);
+}
+
+HeapStatistics heap_statistics() {
+    HeapStatistics statistics;
+    statistics.allocations = allocations.load(std::memory_order_relaxed);
+    statistics.frees = frees.load(std::memory_order_relaxed);
+    statistics.overflows = overflows.load(std::memory_order_relaxed);
+    statistics.after_seal = after_seal.load(std::memory_order_relaxed);
+    statistics.used = arena.used();
+    statistics.capacity = arena.capacity();
+    return statistics;
+}
+
+} // namespace Memory
+} // namespace Core
+
+#if defined(CORE_STATIC_HEAP)
+
+void* operator new(size_t size) {
+    void* memory = Core::Memory::allocate(size);
+    if (memory == nullptr) abort();
+    return memory;
+}
+
+void* operator new[](size_t size) {
+    return operator new(size);
+}
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept {
+    return Core::Memory::allocate(size);
+}
+
+void* operator new[](size_t size, const std::nothrow_t&) noexcept {
+    return Core::Memory::allocate(size);
+}
+
+void operator delete(void* memory) noexcept {
+    Core::Memory::release(memory);
+}
+
+void operator delete[](void* memory) noexcept {
+    Core::Memory::release(memory);
+}
+
+void operator delete(void* memory, const std::nothrow_t&) noexcept {
+    Core::Memory::release(memory);
+}
+
+void operator delete[](void* memory, const std::nothrow_t&) noexcept {
+    Core::Memory::release(memory);
+}
+
+#endif
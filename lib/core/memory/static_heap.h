@@ -0,0 +1,58 @@
+#ifndef CORE_MEMORY_STATIC_HEAP_H
+#define CORE_MEMORY_STATIC_HEAP_H
+
+#include <cstddef>
+#include <stdint.h>
+
+/**
+ * Heap-free build mode, enabled by building with -D CORE_STATIC_HEAP.
+ *
+ * Global operator new and delete are replaced. Until seal() every allocation is carved out
+ * of a static arena of CORE_STATIC_HEAP_SIZE bytes, so the shared_ptr, unique_ptr and
+ * std::function objects the modules are built from at init live in static storage and
+ * never fragment the heap. Deleting them is accepted but does not reuse the memory.
+ * Once init is done, seal() makes every further allocation trip the trip handler, which
+ * aborts by default. Allocations that do not fit the arena fall back to malloc and are
+ * counted as overflows, raise the size until there are none.
+ *
+ * Without the flag operator new is left alone and the statistics stay at zero.
+ */
+#ifndef CORE_STATIC_HEAP_SIZE
+#define CORE_STATIC_HEAP_SIZE 32768
+#endif
+
+namespace Core {
+namespace Memory {
+
+/**
+ * @brief Called for an allocation after seal(), the allocation proceeds if it returns
+ **/
+typedef void(*HeapTripHandler)(size_t size);
+
+struct HeapStatistics {
+    uint32_t allocations;       /**< operator new calls */
+    uint32_t frees;             /**< operator delete calls with a pointer */
+    uint32_t overflows;         /**< Allocations before seal() that did not fit the arena */
+    uint32_t after_seal;        /**< Allocations after seal() */
+    size_t used;                /**< Bytes of the arena in use */
+    size_t capacity;            /**< CORE_STATIC_HEAP_SIZE */
+};
+
+// Whether the build replaces operator new.
+bool static_heap_enabled();
+
+// Ends init, any allocation from now on trips.
+void seal();
+// Allows allocations again, for tests and for a controlled re-init.
+void unseal();
+bool sealed();
+
+// Replaces the trip handler, nullptr restores the aborting default.
+void set_trip_handler(HeapTripHandler handler);
+
+HeapStatistics heap_statistics();
+
+} // namespace Memory
+} // namespace Core
+
+#endif // CORE_MEMORY_STATIC_HEAP_H
@@ -0,0 +1,7 @@
+// This is an umbrella header for the metrics library. It includes all the necessary headers for using the metrics library.
+#ifndef METRICS_H
+#define METRICS_H
+
+#include "metrics/histogram.h"
+
+#endif // METRICS_H
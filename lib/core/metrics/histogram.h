@@ -0,0 +1,90 @@
+#ifndef CORE_METRICS_HISTOGRAM_H
+#define CORE_METRICS_HISTOGRAM_H
+
+#include <stdint.h>
+
+namespace Core {
+
+/**
+ * @brief Fixed-size histogram with power-of-two buckets for latency measurements
+ *
+ * Bucket 0 counts zeros, bucket i counts values in [2^(i-1), 2^i). Recording is a count
+ * leading zeros and an increment, cheap enough for every control cycle, and needs no heap.
+ *
+ * @tparam Buckets Number of buckets, the last one also collects everything larger
+ */
+template<uint32_t Buckets = 24>
+class Log2Histogram {
+    static_assert(Buckets >= 2 && Buckets <= 33, "Log2Histogram supports 2 to 33 buckets");
+
+public:
+    Log2Histogram() {
+        reset();
+    }
+
+    void record(uint32_t value) {
+        uint32_t index = value == 0 ? 0 : 32 - (uint32_t)__builtin_clz(value);
+        if (index >= Buckets) {
+            index = Buckets - 1;
+        }
+        m_buckets[index]++;
+        m_count++;
+        m_sum += value;
+        if (value < m_min) m_min = value;
+        if (value > m_max) m_max = value;
+    }
+
+    void reset() {
+        for (uint32_t i = 0; i < Buckets; i++) {
+            m_buckets[i] = 0;
+        }
+        m_count = 0;
+        m_sum = 0;
+        m_min = UINT32_MAX;
+        m_max = 0;
+    }
+
+    uint32_t count() const { return m_count; }
+    uint32_t min() const { return m_count ? m_min : 0; }
+    uint32_t max() const { return m_max; }
+    uint32_t mean() const { return m_count ? (uint32_t)(m_sum / m_count) : 0; }
+    uint32_t bucket(uint32_t index) const { return index < Buckets ? m_buckets[index] : 0; }
+
+    /**
+     * @brief Largest value a bucket can hold
+     */
+    static uint32_t upper_bound(uint32_t index) {
+        return index == 0 ? 0 : index >= 32 ? UINT32_MAX : (1U << index) - 1;
+    }
+
+    /**
+     * @brief Upper bound of the bucket holding a percentile, capped at the observed maximum
+     * @param permille Percentile in tenths of a percent, e.g. 990 for p99
+     */
+    uint32_t percentile(uint32_t permille) const {
+        if (m_count == 0) {
+            return 0;
+        }
+        uint64_t target = ((uint64_t)m_count * permille + 999) / 1000;
+        uint64_t seen = 0;
+        for (uint32_t i = 0; i < Buckets; i++) {
+            seen += m_buckets[i];
+            if (seen >= target && seen > 0) {
+                uint32_t bound = upper_bound(i);
+                return bound < m_max ? bound : m_max;
+            }
+        }
+        return m_max;
+    }
+
+private:
+    uint32_t m_buckets[Buckets];
+    uint32_t m_count;
+    uint64_t m_sum;
+    uint32_t m_min;
+    uint32_t m_max;
+};
+
+} // namespace Core
+
+#endif // CORE_METRICS_HISTOGRAM_H
@@ -0,0 +1,8 @@
+// This is an umbrella header for the numeric library. It includes all the necessary headers for using the numeric library.
+#ifndef NUMERIC_H
+#define NUMERIC_H
+
+#include "numeric/fixed.h"
+#include "numeric/saturate.h"
+
+#endif // NUMERIC_H
@@ -0,0 +1,125 @@
+#ifndef CORE_NUMERIC_FIXED_H
+#define CORE_NUMERIC_FIXED_H
+
+#include <stdint.h>
+#include <limits>
+#include <type_traits>
+
+#include "saturate.h"
+
+namespace Core {
+
+constexpr int64_t gcd(int64_t a, int64_t b) {
+    return b == 0 ? a : gcd(b, a % b);
+}
+
+/**
+ * @brief Integer quantity with a compile-time scale, the value is raw / Scale units
+ *
+ * Fixed<int16_t, 10> holds tenths, the "multiply by 10 before sending" of the DTI commands, and
+ * Fixed<int32_t, 1000> holds thousandths such as the mV and mA of the Orion broadcasts. The
+ * type is an aggregate over its raw integer, so it has the size and layout of IntT, can sit in
+ * a CAN message struct and is brace-initialised with the wire value.
+ *
+ * Arithmetic saturates instead of wrapping and is only defined between equal scales, mixing
+ * units needs an explicit fixed_cast. Everything is constexpr integer math, no floats.
+ *
+ * @tparam IntT Storage type
+ * @tparam Scale Counts per unit
+ */
+template<typename IntT, int32_t Scale>
+struct Fixed {
+    static_assert(std::is_integral<IntT>::value, "Fixed needs an integer storage type");
+    static_assert(Scale > 0, "Fixed needs a positive scale");
+
+    typedef IntT Storage;
+    static constexpr int32_t SCALE = Scale;
+
+    IntT raw;
+
+    static constexpr Fixed from_raw(int64_t raw) {
+        return { saturate_cast<IntT>(raw) };
+    }
+
+    static constexpr Fixed from_units(int64_t units) {
+        return { saturate_cast<IntT>(units * Scale) };
+    }
+
+    static constexpr Fixed max() {
+        return { std::numeric_limits<IntT>::max() };
+    }
+
+    static constexpr Fixed min() {
+        return { std::numeric_limits<IntT>::min() };
+    }
+
+    /**
+     * @returns Whole units, truncated towards zero
+     */
+    constexpr int64_t units() const {
+        return (int64_t)raw / Scale;
+    }
+};
+
+/**
+ * @brief Converts between scales and storage types, truncating towards zero and saturating
+ *
+ * The scale ratio is reduced at compile time, so tenths to thousandths is a single multiply
+ * by 100 and thousandths to tenths a single divide by 100.
+ */
+template<typename ToT, typename IntT, int32_t Scale>
+constexpr ToT fixed_cast(Fixed<IntT, Scale> value) {
+    return ToT::from_raw((int64_t)value.raw * (ToT::SCALE / gcd(ToT::SCALE, Scale)) / (Scale / gcd(ToT::SCALE, Scale)));
+}
+
+template<typename IntT, int32_t Scale>
+constexpr Fixed<IntT, Scale> operator+(Fixed<IntT, Scale> a, Fixed<IntT, Scale> b) {
+    return Fixed<IntT, Scale>::from_raw((int64_t)a.raw + b.raw);
+}
+
+template<typename IntT, int32_t Scale>
+constexpr Fixed<IntT, Scale> operator-(Fixed<IntT, Scale> a, Fixed<IntT, Scale> b) {
+    return Fixed<IntT, Scale>::from_raw((int64_t)a.raw - b.raw);
+}
+
+template<typename IntT, int32_t Scale>
+constexpr Fixed<IntT, Scale> operator-(Fixed<IntT, Scale> a) {
+    return Fixed<IntT, Scale>::from_raw(-(int64_t)a.raw);
+}
+
+// Scaling by a plain number keeps the unit
+template<typename IntT, int32_t Scale>
+constexpr Fixed<IntT, Scale> operator*(Fixed<IntT, Scale> a, int32_t factor) {
+    return Fixed<IntT, Scale>::from_raw((int64_t)a.raw * factor);
+}
+
+template<typename IntT, int32_t Scale>
+constexpr Fixed<IntT, Scale> operator*(int32_t factor, Fixed<IntT, Scale> a) {
+    return a * factor;
+}
+
+template<typename IntT, int32_t Scale>
+constexpr Fixed<IntT, Scale> operator/(Fixed<IntT, Scale> a, int32_t divisor) {
+    return Fixed<IntT, Scale>::from_raw((int64_t)a.raw / divisor);
+}
+
+template<typename IntT, int32_t Scale>
+constexpr bool operator==(Fixed<IntT, Scale> a, Fixed<IntT, Scale> b) { return a.raw == b.raw; }
+template<typename IntT, int32_t Scale>
+constexpr bool operator!=(Fixed<IntT, Scale> a, Fixed<IntT, Scale> b) { return a.raw != b.raw; }
+template<typename IntT, int32_t Scale>
+constexpr bool operator<(Fixed<IntT, Scale> a, Fixed<IntT, Scale> b) { return a.raw < b.raw; }
+template<typename IntT, int32_t Scale>
+constexpr bool operator<=(Fixed<IntT, Scale> a, Fixed<IntT, Scale> b) { return a.raw <= b.raw; }
+template<typename IntT, int32_t Scale>
+constexpr bool operator>(Fixed<IntT, Scale> a, Fixed<IntT, Scale> b) { return a.raw > b.raw; }
+template<typename IntT, int32_t Scale>
+constexpr bool operator>=(Fixed<IntT, Scale> a, Fixed<IntT, Scale> b) { return a.raw >= b.raw; }
+
+template<typename IntT> using Deci = Fixed<IntT, 10>;
+template<typename IntT> using Centi = Fixed<IntT, 100>;
+template<typename IntT> using Milli = Fixed<IntT, 1000>;
+
+} // namespace Core
+
+#endif // CORE_NUMERIC_FIXED_H
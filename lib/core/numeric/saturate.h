@@ -0,0 +1,23 @@
+#ifndef CORE_NUMERIC_SATURATE_H
+#define CORE_NUMERIC_SATURATE_H
+
+#include <limits>
+
+namespace Core {
+
+/**
+ * @brief Clamps a wide intermediate into the range of an integer type
+ *
+ * The source type is deduced, so 32-bit accumulators compare in 32 bits. It must hold every
+ * value of IntT.
+ */
+template<typename IntT, typename WideT>
+constexpr IntT saturate_cast(WideT value) {
+    return value > (WideT)std::numeric_limits<IntT>::max() ? std::numeric_limits<IntT>::max()
+         : value < (WideT)std::numeric_limits<IntT>::min() ? std::numeric_limits<IntT>::min()
+         : (IntT)value;
+}
+
+} // namespace Core
+
+#endif // CORE_NUMERIC_SATURATE_H
@@ -0,0 +1,7 @@
+// This is an umbrella header for the queue library. It includes all the necessary headers for using the queue library.
+#ifndef QUEUE_H
+#define QUEUE_H
+
+#include "queue/mpsc_queue.h"
+
+#endif // QUEUE_H
@@ -0,0 +1,126 @@
+#ifndef CORE_QUEUE_MPSC_QUEUE_H
+#define CORE_QUEUE_MPSC_QUEUE_H
+
+#include <atomic>
+#include <stdint.h>
+#include <utility>
+
+namespace Core {
+
+/**
+ * @brief Bounded lock-free multi-producer, single-consumer FIFO
+ *
+ * Any number of tasks may push concurrently, only one task may pop. Each cell carries a
+ * sequence number that tells producers whether it is free and the consumer whether it is
+ * published, so no operation ever blocks or takes a lock. Capacity must be a power of two.
+ *
+ * @tparam T Element type, copied in and out
+ * @tparam Capacity Number of elements the queue can hold
+ */
+template<typename T, uint32_t Capacity>
+class MpscQueue {
+    static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0, "MpscQueue capacity must be a power of two");
+
+public:
+    MpscQueue() : m_tail(0), m_head(0) {
+        for (uint32_t i = 0; i < Capacity; i++) {
+            m_cells[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    MpscQueue(const MpscQueue&) = delete;
+    MpscQueue& operator=(const MpscQueue&) = delete;
+
+    /**
+     * @brief Append an element, safe to call from any task
+     * @return false if the queue is full
+     */
+    bool push(const T& value) {
+        uint32_t position = m_tail.load(std::memory_order_relaxed);
+        for (;;) {
+            Cell& cell = m_cells[position & (Capacity - 1)];
+            uint32_t sequence = cell.sequence.load(std::memory_order_acquire);
+            int32_t difference = (int32_t)(sequence - position);
+
+            if (difference == 0) {
+                // Cell is free for this position, claim it
+                if (m_tail.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                    cell.value = value;
+                    cell.sequence.store(position + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (difference < 0) {
+                // The consumer has not released this cell yet
+                return false;
+            } else {
+                // Another producer claimed the position first
+                position = m_tail.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    /**
+     * @brief Oldest element without removing it, consumer only
+     * @return nullptr if the queue is empty
+     */
+    T* front() {
+        uint32_t head = m_head.load(std::memory_order_relaxed);
+        Cell& cell = m_cells[head & (Capacity - 1)];
+        int32_t difference = (int32_t)(cell.sequence.load(std::memory_order_acquire) - (head + 1));
+        if (difference < 0) {
+            return nullptr;
+        }
+        return &cell.value;
+    }
+
+    /**
+     * @brief Release the element returned by front(), consumer only
+     */
+    void pop() {
+        uint32_t head = m_head.load(std::memory_order_relaxed);
+        Cell& cell = m_cells[head & (Capacity - 1)];
+        cell.sequence.store(head + Capacity, std::memory_order_release);
+        m_head.store(head + 1, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Remove the oldest element, consumer only
+     * @return false if the queue is empty
+     */
+    bool pop(T& value) {
+        T* oldest = front();
+        if (!oldest) {
+            return false;
+        }
+        value = std::move(*oldest);
+        pop();
+        return true;
+    }
+
+    /**
+     * @brief Number of claimed elements, exact only when producers and consumer are idle
+     */
+    uint32_t size() const {
+        uint32_t head = m_head.load(std::memory_order_relaxed);
+        int32_t difference = (int32_t)(m_tail.load(std::memory_order_acquire) - head);
+        // Seen from another task the head can be newer than the tail
+        return difference > 0 ? (uint32_t)difference : 0;
+    }
+
+    static constexpr uint32_t capacity() { return Capacity; }
+
+private:
+    struct Cell {
+        std::atomic<uint32_t> sequence;
+        T value;
+    };
+
+    Cell m_cells[Capacity];
+    std::atomic<uint32_t> m_tail;
+    // Written by the consumer only, atomic so size() can be read from any task
+    std::atomic<uint32_t> m_head;
+};
+
+} // namespace Core
+
+#endif // CORE_QUEUE_MPSC_QUEUE_H
@@ -0,0 +1,8 @@
+// This is an umbrella header for the startup library. It includes all the necessary headers for using the startup library.
+#ifndef STARTUP_H
+#define STARTUP_H
+
+#include "startup/milestones.h"
+#include "startup/orchestrator.h"
+
+#endif // STARTUP_H
@@ -0,0 +1,103 @@
+#ifndef CORE_STARTUP_MILESTONES_H
+#define CORE_STARTUP_MILESTONES_H
+
+#include <atomic>
+#include <stdint.h>
+
+#include "../clock/i_clock_strategy.h"
+
+namespace Core {
+namespace Startup {
+
+/**
+ * @brief Marks milestone id, see Milestones::marker
+ **/
+typedef void(*MilestoneMarker)(uint8_t id, void* context);
+
+/**
+ * @brief Where a module reports reaching a milestone, does nothing while unset
+ *
+ * Lets modules that know nothing of the application's milestone enum, such as the CAN
+ * provider or the shutdown sequence, feed the boot timeline. See Milestones::hook.
+ **/
+struct MilestoneHook {
+    MilestoneMarker marker;
+    void* context;
+    uint8_t id;
+
+    MilestoneHook() : marker(nullptr), context(nullptr), id(0) {}
+    MilestoneHook(MilestoneMarker marker, void* context, uint8_t id) : marker(marker), context(context), id(id) {}
+
+    void mark() const {
+        if (marker != nullptr) marker(id, context);
+    }
+};
+
+/**
+ * @brief Records when the car first reached each boot milestone, e.g. the first valid CAN
+ *          frame or ready to drive, in microseconds since power on
+ *
+ * Only the first mark() of a milestone counts and later ones are a single relaxed load, so
+ * it can stay on hot paths such as the receive task. Safe to mark from any task.
+ * CAN::BasicProvider::received and Pedals::ShutdownSequence::set_ready_milestone take a hook().
+ *
+ * @tparam Count Number of milestones, ids are 0 to Count - 1, typically an application enum
+ **/
+template<uint8_t Count>
+class Milestones {
+public:
+    static constexpr uint64_t NOT_REACHED = UINT64_MAX;
+
+    /**
+     * @param power_on_us Clock reading at power on, 0 for esp_timer
+     **/
+    explicit Milestones(iClockStrategy* clock, uint64_t power_on_us = 0) : m_clock(clock), m_power_on_us(power_on_us) {
+        reset();
+    }
+
+    /**
+     * @brief Marks a milestone as reached now
+     * @returns true if this was the first time, false if it was already reached or the id is out of range
+     **/
+    bool mark(uint8_t id) {
+        if (id >= Count || m_at[id].load(std::memory_order_relaxed) != NOT_REACHED) return false;
+        uint64_t time = m_clock->micros();
+        time = time > m_power_on_us ? time - m_power_on_us : 0;
+        uint64_t expected = NOT_REACHED;
+        return m_at[id].compare_exchange_strong(expected, time, std::memory_order_relaxed);
+    }
+
+    // Hook that marks id, for modules reporting the milestone.
+    MilestoneHook hook(uint8_t id) { return MilestoneHook(&Milestones::marker, this, id); }
+
+    // Marker adapter, pass the milestones as the context.
+    static void marker(uint8_t id, void* milestones) {
+        ((Milestones*)milestones)->mark(id);
+    }
+
+    bool reached(uint8_t id) const { return at_us(id) != NOT_REACHED; }
+
+    // Time since power on the milestone was reached, NOT_REACHED if it was not.
+    uint64_t at_us(uint8_t id) const {
+        return id < Count ? m_at[id].load(std::memory_order_relaxed) : NOT_REACHED;
+    }
+
+    void reset() {
+        for (uint8_t i = 0; i < Count; i++) {
+            m_at[i].store(NOT_REACHED, std::memory_order_relaxed);
+        }
+    }
+
+private:
+    iClockStrategy* m_clock;
+    uint64_t m_power_on_us;
+    std::atomic<uint64_t> m_at[Count];
+};
+
+template<uint8_t Count>
+constexpr uint64_t Milestones<Count>::NOT_REACHED;
+
+} // namespace Startup
+} // namespace Core
+
+#endif // CORE_STARTUP_MILESTONES_H
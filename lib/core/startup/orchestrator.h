@@ -0,0 +1,294 @@
+#ifndef CORE_STARTUP_ORCHESTRATOR_H
+#define CORE_STARTUP_ORCHESTRATOR_H
+
+#include <cstdio>
+#include <memory>
+#include <stdint.h>
+
+#include "../clock/i_clock_strategy.h"
+#include "../lock/lock_guard.h"
+#include "../thread/i_thread_strategy.h"
+
+namespace Core {
+namespace Startup {
+
+// Returned by add() when the orchestrator is full.
+constexpr uint8_t NO_STEP = 0xFF;
+
+/**
+ * @brief Initializes one module
+ * @returns true on success, false fails the step and skips everything depending on it
+ **/
+typedef bool(*StepFunc)(void* context);
+
+enum class StepStatus : uint8_t {
+    PENDING,
+    RUNNING,
+    DONE,
+    FAILED,
+    SKIPPED,        /**< Not run because a dependency failed or was skipped */
+};
+
+/**
+ * @brief One entry of the boot timeline, times in microseconds since power on
+ **/
+struct StepRecord {
+    const char* name;
+    StepStatus status;
+    uint8_t worker;         /**< 0 is the task calling run(), n the nth added worker */
+    uint64_t started_us;
+    uint64_t finished_us;
+
+    uint64_t duration_us() const { return finished_us - started_us; }
+};
+
+/**
+ * @brief Runs module init steps in dependency order, independent steps in parallel
+ *
+ * Steps are added with add() and ordered with after(), which only accepts steps added
+ * earlier, so the graph can never contain a cycle. run() starts every added worker and
+ * works along with them on the calling task: each picks the first pending step whose
+ * dependencies are done. Without workers the steps run one after the other in the order
+ * they were added, which is also the order ties are broken in with workers.
+ *
+ * A worker with nothing ready sleeps poll_ms on its own thread and looks again, boot steps
+ * take milliseconds so the poll costs little and keeps this to the plain iThreadStrategy
+ * interface. The calling task polls the same way through the strategy passed to run().
+ *
+ * Every step's start and finish are recorded against power on for the boot timeline.
+ *
+ * @tparam MaxSteps Number of steps, at most 32
+ * @tparam MaxWorkers Number of worker threads besides the calling task
+ **/
+template<uint8_t MaxSteps = 16, uint8_t MaxWorkers = 4>
+class Orchestrator {
+    static_assert(MaxSteps >= 1 && MaxSteps <= 32, "Orchestrator supports 1 to 32 steps");
+
+public:
+    // Idle poll period of a worker waiting on dependencies.
+    uint32_t poll_ms = 1;
+
+    /**
+     * @param lock Required once workers are added, can be nullptr otherwise
+     * @param power_on_us Clock reading at power on, 0 for esp_timer
+     **/
+    Orchestrator(iClockStrategy* clock, std::unique_ptr<iLockStrategy> lock, uint64_t power_on_us = 0)
+        : m_clock(clock), m_lock(std::move(lock)), m_power_on_us(power_on_us) {
+        m_count = 0;
+        m_worker_count = 0;
+        m_unresolved = 0;
+        m_done = 0;
+        m_broken = 0;
+        m_started_us = 0;
+        m_finished_us = 0;
+        m_caller = nullptr;
+    }
+
+    Orchestrator(const Orchestrator&) = delete;
+    Orchestrator& operator=(const Orchestrator&) = delete;
+
+    /**
+     * @brief Adds a step, run() calls step(context) once its dependencies are done
+     * @returns The step's id, NO_STEP if MaxSteps are already added
+     **/
+    uint8_t add(const char* name, StepFunc step, void* context = nullptr) {
+        if (m_count >= MaxSteps || step == nullptr) return NO_STEP;
+        Step& s = m_steps[m_count];
+        s.func = step;
+        s.context = context;
+        s.dependencies = 0;
+        s.record = { name, StepStatus::PENDING, 0, 0, 0 };
+        return m_count++;
+    }
+
+    /**
+     * @brief Makes a step wait for another one
+     * @returns false unless dependency was added before step
+     **/
+    bool after(uint8_t step, uint8_t dependency) {
+        if (step >= m_count || dependency >= step) return false;
+        m_steps[step].dependencies |= 1UL << dependency;
+        return true;
+    }
+
+    /**
+     * @brief Adds a worker thread, set up here and joined before run() returns
+     * @returns false if MaxWorkers are already added
+     **/
+    bool add_worker(std::unique_ptr<iThreadStrategy> thread) {
+        if (m_worker_count >= MaxWorkers || !thread) return false;
+        thread->setup("core.startup.worker", // name
+                      0x18U, // priority - osPriorityNormal
+                      0x01U  // attributes - osThreadJoinable
+                     );
+        m_workers[m_worker_count] = { this, (uint8_t)(m_worker_count + 1), std::move(thread) };
+        m_worker_count++;
+        return true;
+    }
+
+    /**
+     * @brief Runs every step, blocks until all are done, failed or skipped
+     * @param caller Sleeps the calling task while it waits on dependencies. Without it the
+     *          calling task stops taking steps the first time none is ready and leaves the
+     *          rest to the workers.
+     * @returns true if every step succeeded
+     **/
+    bool run(iThreadStrategy* caller = nullptr) {
+        m_caller = caller;
+        {
+            LockGuard guard(m_lock.get());
+            m_unresolved = m_count;
+            m_done = 0;
+            m_broken = 0;
+            for (uint8_t i = 0; i < m_count; i++) {
+                m_steps[i].record.status = StepStatus::PENDING;
+            }
+        }
+        m_started_us = now();
+
+        for (uint8_t i = 0; i < m_worker_count; i++) {
+            m_workers[i].thread->create(&Orchestrator::worker_task, &m_workers[i]);
+        }
+        work(0);
+        for (uint8_t i = 0; i < m_worker_count; i++) {
+            m_workers[i].thread->join();
+        }
+
+        m_finished_us = now();
+        return m_broken == 0;
+    }
+
+    uint8_t count() const { return m_count; }
+
+    // Read once run() has returned.
+    StepRecord record(uint8_t step) const { return m_steps[step].record; }
+    uint64_t started_us() const { return m_started_us; }
+    uint64_t finished_us() const { return m_finished_us; }
+    uint64_t elapsed_us() const { return m_finished_us - m_started_us; }
+
+    /**
+     * @brief Writes the boot timeline as text, one step per line
+     * @returns The length of the whole timeline, which was truncated if not below size
+     **/
+    size_t format(char* buffer, size_t size) const {
+        static const char* const STATUS[] = { "pending", "running", "done", "failed", "skipped" };
+        size_t length = 0;
+        for (uint8_t i = 0; i < m_count; i++) {
+            const StepRecord& r = m_steps[i].record;
+            // The columns always fit, only the appended line can be cut short
+            char columns[72];
+            snprintf(columns, sizeof(columns), "%8llu us +%7llu us  w%u  %-8s ", (unsigned long long)r.started_us,
+                (unsigned long long)r.duration_us(), (unsigned)r.worker, STATUS[(uint8_t)r.status]);
+            int written = snprintf(length < size ? buffer + length : nullptr, length < size ? size - length : 0,
+                "%s%s\n", columns, r.name ? r.name : "?");
+            if (written > 0) length += (size_t)written;
+        }
+        return length;
+    }
+
+private:
+    struct Step {
+        StepFunc func;
+        void* context;
+        uint32_t dependencies;
+        StepRecord record;
+    };
+
+    struct Worker {
+        Orchestrator* owner;
+        uint8_t index;
+        std::unique_ptr<iThreadStrategy> thread;
+    };
+
+    iClockStrategy* m_clock;
+    std::unique_ptr<iLockStrategy> m_lock;
+    uint64_t m_power_on_us;
+
+    Step m_steps[MaxSteps];
+    uint8_t m_count;
+    Worker m_workers[MaxWorkers == 0 ? 1 : MaxWorkers];
+    uint8_t m_worker_count;
+    iThreadStrategy* m_caller;
+
+    // Guarded by m_lock while running
+    uint8_t m_unresolved;
+    uint32_t m_done;
+    uint32_t m_broken;          /**< Failed and skipped steps */
+
+    uint64_t m_started_us;
+    uint64_t m_finished_us;
+
+    uint64_t now() {
+        uint64_t time = m_clock->micros();
+        return time > m_power_on_us ? time - m_power_on_us : 0;
+    }
+
+    static void worker_task(void* argument) {
+        Worker* worker = (Worker*)argument;
+        worker->owner->work(worker->index);
+    }
+
+    // First pending step whose dependencies are all done
+    uint8_t next_ready() const {
+        for (uint8_t i = 0; i < m_count; i++) {
+            const Step& s = m_steps[i];
+            if (s.record.status == StepStatus::PENDING && (s.dependencies & ~m_done) == 0) return i;
+        }
+        return NO_STEP;
+    }
+
+    // Skips every pending step that depends on a broken one
+    void skip_dependents() {
+        for (uint8_t i = 0; i < m_count; i++) {
+            Step& s = m_steps[i];
+            if (s.record.status != StepStatus::PENDING || (s.dependencies & m_broken) == 0) continue;
+            s.record.status = StepStatus::SKIPPED;
+            m_broken |= 1UL << i;
+            m_unresolved--;
+        }
+    }
+
+    void work(uint8_t worker) {
+        for (;;) {
+            uint8_t step;
+            {
+                LockGuard guard(m_lock.get());
+                if (m_unresolved == 0) return;
+                step = next_ready();
+                if (step != NO_STEP) {
+                    m_steps[step].record.status = StepStatus::RUNNING;
+                    m_steps[step].record.worker = worker;
+                    m_steps[step].record.started_us = now();
+                }
+            }
+
+            if (step == NO_STEP) {
+                // Everything left waits on steps running elsewhere
+                iThreadStrategy* thread = worker == 0 ? m_caller : m_workers[worker - 1].thread.get();
+                if (m_worker_count == 0 || thread == nullptr) return;
+                thread->sleep(poll_ms);
+                continue;
+            }
+
+            Step& s = m_steps[step];
+            bool ok = s.func(s.context);
+            uint64_t finished = now();
+
+            LockGuard guard(m_lock.get());
+            s.record.finished_us = finished;
+            s.record.status = ok ? StepStatus::DONE : StepStatus::FAILED;
+            m_unresolved--;
+            if (ok) {
+                m_done |= 1UL << step;
+            } else {
+                m_broken |= 1UL << step;
+                skip_dependents();
+            }
+        }
+    }
+};
+
+} // namespace Startup
+} // namespace Core
+
+#endif // CORE_STARTUP_ORCHESTRATOR_H
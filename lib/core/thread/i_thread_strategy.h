@@ -2,6 +2,8 @@
 #ifndef CORE_THREAD_I_THREAD_STRATEGY_H
 #define CORE_THREAD_I_THREAD_STRATEGY_H
 
+#include <stdint.h>
+
 typedef void(*taskFunc)(void*);
 
 namespace Core {
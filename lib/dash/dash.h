@@ -2,4 +2,16 @@
 #ifndef DASH_H
 #define DASH_H
 
-#endif // DASH_H
\ No newline at end of file
+#include "dirty_regions.h"
+#include "esp32_s3_display_backend.h"
+#include "font.h"
+#include "fonts/dash_5x7.h"
+#include "framebuffer.h"
+#include "headless_backend.h"
+#include "i_display_backend.h"
+#include "renderer.h"
+#include "text.h"
+#include "types.h"
+#include "widget.h"
+
+#endif // DASH_H
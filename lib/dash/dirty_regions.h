@@ -0,0 +1,86 @@
+#ifndef DASH_DIRTY_REGIONS_H
+#define DASH_DIRTY_REGIONS_H
+
+#include <stdint.h>
+
+#include "types.h"
+
+namespace Dash {
+
+/**
+ * @brief Bounded set of changed screen areas
+ *
+ * A new rectangle absorbs every region it overlaps or shares an edge with, which may redraw
+ * some unchanged pixels in the corners of the union but flushes overlaps once. When the set is
+ * full the pair whose union adds the fewest extra pixels is merged instead, so a frame with
+ * many scattered changes degrades into a few larger flushes rather than failing.
+ *
+ * @tparam Capacity Most regions kept at once
+ */
+template<uint32_t Capacity>
+class DirtyRegions {
+    static_assert(Capacity >= 1, "DirtyRegions needs room for one region");
+
+public:
+    DirtyRegions() : m_count(0) {}
+
+    void add(Rect area) {
+        if (area.empty()) return;
+
+        // Absorb everything the area touches, growing it may make it touch more
+        bool merged = true;
+        while (merged) {
+            merged = false;
+            for (uint32_t i = 0; i < m_count; i++) {
+                if (touches(area, m_regions[i])) {
+                    area = unite(area, m_regions[i]);
+                    remove(i);
+                    merged = true;
+                    break;
+                }
+            }
+        }
+
+        if (m_count == Capacity) {
+            uint32_t best = 0;
+            uint32_t best_growth = UINT32_MAX;
+            for (uint32_t i = 0; i < m_count; i++) {
+                uint32_t united = unite(area, m_regions[i]).area();
+                uint32_t growth = united - area.area() - m_regions[i].area() + intersect(area, m_regions[i]).area();
+                if (growth < best_growth) {
+                    best_growth = growth;
+                    best = i;
+                }
+            }
+            Rect united = unite(area, m_regions[best]);
+            remove(best);
+            add(united);
+            return;
+        }
+
+        m_regions[m_count++] = area;
+    }
+
+    void clear() { m_count = 0; }
+
+    uint32_t size() const { return m_count; }
+    const Rect& operator[](uint32_t index) const { return m_regions[index]; }
+
+    uint32_t area() const {
+        uint32_t total = 0;
+        for (uint32_t i = 0; i < m_count; i++) total += m_regions[i].area();
+        return total;
+    }
+
+private:
+    Rect m_regions[Capacity];
+    uint32_t m_count;
+
+    void remove(uint32_t index) {
+        m_regions[index] = m_regions[--m_count];
+    }
+};
+
+} // namespace Dash
+
+#endif // DASH_DIRTY_REGIONS_H
@@ -0,0 +1,74 @@
+#ifndef DASH_ESP32_S3_DISPLAY_BACKEND_H
+#define DASH_ESP32_S3_DISPLAY_BACKEND_H
+
+#if defined(ESP32)
+
+#include <esp_attr.h>
+#include <esp_lcd_panel_io.h>
+#include <esp_lcd_panel_ops.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+
+#include "i_display_backend.h"
+
+// Longest wait for a panel transfer before giving up, milliseconds.
+#ifndef DASH_TRANSFER_TIMEOUT_MS
+#define DASH_TRANSFER_TIMEOUT_MS 100
+#endif
+
+namespace Dash {
+
+// esp_lcd SPI panel, draw_bitmap queues a DMA transfer and the IO callback reports its end
+class ESP32S3DisplayBackend final : public iDisplayBackend {
+public:
+    /**
+     * @param io Panel IO created by the application, its transfer done callback is taken over
+     * @param panel Panel driver created on that IO
+     **/
+    ESP32S3DisplayBackend(esp_lcd_panel_io_handle_t io, esp_lcd_panel_handle_t panel)
+        : m_panel(panel), m_in_flight(false) {
+        m_done = xSemaphoreCreateBinaryStatic(&m_done_buffer);
+
+        esp_lcd_panel_io_callbacks_t callbacks = {};
+        callbacks.on_color_trans_done = on_transfer_done;
+        esp_lcd_panel_io_register_event_callbacks(io, &callbacks, this);
+    }
+
+    bool write(const Rect& area, const Color* pixels, uint32_t) override {
+        if (m_in_flight) return false;
+        m_in_flight = esp_lcd_panel_draw_bitmap(m_panel, area.x, area.y, area.right(), area.bottom(), pixels) == ESP_OK;
+        return m_in_flight;
+    }
+
+    bool wait() override {
+        if (!m_in_flight) return true;
+        // Still busy after a timeout, a later wait() takes the late completion
+        if (xSemaphoreTake(m_done, pdMS_TO_TICKS(DASH_TRANSFER_TIMEOUT_MS)) != pdTRUE) return false;
+        m_in_flight = false;
+        return true;
+    }
+
+    // SPI panels take RGB565 high byte first
+    bool swap_bytes() const override {
+        return true;
+    }
+
+private:
+    esp_lcd_panel_handle_t m_panel;
+    StaticSemaphore_t m_done_buffer;
+    SemaphoreHandle_t m_done;
+    bool m_in_flight;
+
+    static bool IRAM_ATTR on_transfer_done(esp_lcd_panel_io_handle_t, esp_lcd_panel_io_event_data_t*, void* context) {
+        ESP32S3DisplayBackend* self = (ESP32S3DisplayBackend*)context;
+        BaseType_t woken = pdFALSE;
+        xSemaphoreGiveFromISR(self->m_done, &woken);
+        return woken == pdTRUE;
+    }
+};
+
+} // namespace Dash
+
+#endif // ESP32
+
+#endif // DASH_ESP32_S3_DISPLAY_BACKEND_H
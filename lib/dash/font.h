@@ -0,0 +1,49 @@
+#ifndef DASH_FONT_H
+#define DASH_FONT_H
+
+#include <stdint.h>
+
+namespace Dash {
+
+// Index entry of a character that is not in the font subset.
+constexpr uint8_t NO_GLYPH = 0xFF;
+// Fonts cover printable ASCII only.
+constexpr char FIRST_CHARACTER = ' ';
+constexpr char LAST_CHARACTER = '~';
+
+/**
+ * @brief Position of one character in a glyph atlas
+ *
+ * The bitmap is one bit per pixel, most significant bit on the left, with (width + 7) / 8
+ * bytes per row and one row per font line.
+ **/
+struct Glyph {
+    uint8_t width;      /**< Pixels with ink, from the left of the cell */
+    uint8_t advance;    /**< Distance to the next character, the cell width */
+    uint16_t offset;    /**< First byte in the atlas bitmaps */
+};
+
+/**
+ * @brief Pre-rendered bitmap font
+ *          Atlases are generated at build time by .scripts/python/generate_glyphs.py as constexpr
+ *          arrays, so they live in flash and finding a glyph is a single table read.
+ **/
+struct Font {
+    uint8_t height;
+    const Glyph* glyphs;
+    const uint8_t* bitmaps;
+    const uint8_t* index;       /**< Glyph for each character from FIRST_CHARACTER to LAST_CHARACTER */
+
+    // nullptr if the character is not in the font
+    const Glyph* find(char character) const {
+        if (character < FIRST_CHARACTER || character > LAST_CHARACTER) return nullptr;
+        uint8_t i = index[character - FIRST_CHARACTER];
+        return i == NO_GLYPH ? nullptr : &glyphs[i];
+    }
+
+    const uint8_t* bitmap(const Glyph& glyph) const { return &bitmaps[glyph.offset]; }
+};
+
+} // namespace Dash
+
+#endif // DASH_FONT_H
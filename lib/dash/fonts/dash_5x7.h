@@ -0,0 +1,83 @@
+// Generated by .scripts/python/generate_glyphs.py from dash_5x7.bdf, do not edit.
+#ifndef DASH_FONTS_DASH_5X7_H
+#define DASH_FONTS_DASH_5X7_H
+
+#include <stdint.h>
+
+#include "../font.h"
+
+namespace Dash {
+namespace Fonts {
+
+constexpr uint8_t DASH_5X7_BITMAPS[] = {
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, // ' '
+    0xC0, 0xC8, 0x10, 0x20, 0x40, 0x98, 0x18, // '%'
+    0x00, 0x00, 0x00, 0xF8, 0x00, 0x00, 0x00, // '-'
+    0x00, 0x00, 0x00, 0x00, 0x00, 0xC0, 0xC0, // '.'
+    0x00, 0x08, 0x10, 0x20, 0x40, 0x80, 0x00, // '/'
+    0x70, 0x88, 0x98, 0xA8, 0xC8, 0x88, 0x70, // '0'
+    0x20, 0x60, 0x20, 0x20, 0x20, 0x20, 0x70, // '1'
+    0x70, 0x88, 0x08, 0x10, 0x20, 0x40, 0xF8, // '2'
+    0xF8, 0x10, 0x20, 0x10, 0x08, 0x88, 0x70, // '3'
+    0x10, 0x30, 0x50, 0x90, 0xF8, 0x10, 0x10, // '4'
+    0xF8, 0x80, 0xF0, 0x08, 0x08, 0x88, 0x70, // '5'
+    0x30, 0x40, 0x80, 0xF0, 0x88, 0x88, 0x70, // '6'
+    0xF8, 0x08, 0x10, 0x20, 0x40, 0x40, 0x40, // '7'
+    0x70, 0x88, 0x88, 0x70, 0x88, 0x88, 0x70, // '8'
+    0x70, 0x88, 0x88, 0x78, 0x08, 0x10, 0x60, // '9'
+    0x00, 0xC0, 0xC0, 0x00, 0xC0, 0xC0, 0x00, // ':'
+    0x70, 0x88, 0x88, 0xF8, 0x88, 0x88, 0x88, // 'A'
+    0x70, 0x88, 0x80, 0x80, 0x80, 0x88, 0x70, // 'C'
+    0xF8, 0x80, 0x80, 0xF0, 0x80, 0x80, 0xF8, // 'E'
+    0x70, 0x88, 0x88, 0x88, 0x88, 0x88, 0x70, // 'O'
+    0xF0, 0x88, 0x88, 0xF0, 0xA0, 0x90, 0x88, // 'R'
+    0x78, 0x80, 0x80, 0x70, 0x08, 0x08, 0xF0, // 'S'
+    0xF8, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, // 'T'
+    0x88, 0x88, 0x88, 0x88, 0x88, 0x50, 0x20, // 'V'
+    0x88, 0x88, 0x88, 0xA8, 0xA8, 0xA8, 0x50, // 'W'
+};
+
+constexpr Glyph DASH_5X7_GLYPHS[] = {
+    { 3, 4, 0 }, // ' '
+    { 5, 6, 7 }, // '%'
+    { 5, 6, 14 }, // '-'
+    { 2, 3, 21 }, // '.'
+    { 5, 6, 28 }, // '/'
+    { 5, 6, 35 }, // '0'
+    { 5, 6, 42 }, // '1'
+    { 5, 6, 49 }, // '2'
+    { 5, 6, 56 }, // '3'
+    { 5, 6, 63 }, // '4'
+    { 5, 6, 70 }, // '5'
+    { 5, 6, 77 }, // '6'
+    { 5, 6, 84 }, // '7'
+    { 5, 6, 91 }, // '8'
+    { 5, 6, 98 }, // '9'
+    { 2, 3, 105 }, // ':'
+    { 5, 6, 112 }, // 'A'
+    { 5, 6, 119 }, // 'C'
+    { 5, 6, 126 }, // 'E'
+    { 5, 6, 133 }, // 'O'
+    { 5, 6, 140 }, // 'R'
+    { 5, 6, 147 }, // 'S'
+    { 5, 6, 154 }, // 'T'
+    { 5, 6, 161 }, // 'V'
+    { 5, 6, 168 }, // 'W'
+};
+
+// Glyph index for each printable ASCII character, NO_GLYPH if it is not in the subset
+constexpr uint8_t DASH_5X7_INDEX[] = {
+    0, NO_GLYPH, NO_GLYPH, NO_GLYPH, NO_GLYPH, 1, NO_GLYPH, NO_GLYPH, NO_GLYPH, NO_GLYPH, NO_GLYPH, NO_GLYPH, NO_GLYPH, 2, 3, 4,
+    5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, NO_GLYPH, NO_GLYPH, NO_GLYPH, NO_GLYPH, NO_GLYPH,
+    NO_GLYPH, 16, NO_GLYPH, 17, NO_GLYPH, 18, NO_GLYPH, NO_GLYPH, NO_GLYPH, NO_GLYPH, NO_GLYPH, NO_GLYPH, NO_GLYPH, NO_GLYPH, NO_GLYPH, 19,
+    NO_GLYPH, NO_GLYPH, 20, 21, 22, NO_GLYPH, 23, 24, NO_GLYPH, NO_GLYPH, NO_GLYPH, NO_GLYPH, NO_GLYPH, NO_GLYPH, NO_GLYPH, NO_GLYPH,
+    NO_GLYPH, NO_GLYPH, NO_GLYPH, NO_GLYPH, NO_GLYPH, NO_GLYPH, NO_GLYPH, NO_GLYPH, NO_GLYPH, NO_GLYPH, NO_GLYPH, NO_GLYPH, NO_GLYPH, NO_GLYPH, NO_GLYPH, NO_GLYPH,
+    NO_GLYPH, NO_GLYPH, NO_GLYPH, NO_GLYPH, NO_GLYPH, NO_GLYPH, NO_GLYPH, NO_GLYPH, NO_GLYPH, NO_GLYPH, NO_GLYPH, NO_GLYPH, NO_GLYPH, NO_GLYPH, NO_GLYPH,
+};
+
+constexpr Font DASH_5X7 = { 7, DASH_5X7_GLYPHS, DASH_5X7_BITMAPS, DASH_5X7_INDEX };
+
+} // namespace Fonts
+} // namespace Dash
+
+#endif // DASH_FONTS_DASH_5X7_H
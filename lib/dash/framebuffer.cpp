@@ -0,0 +1,46 @@
+#include "framebuffer.h"
+
+#include <cstring>
+
+namespace Dash {
+
+Framebuffer::Framebuffer(Color* pixels, uint16_t width, uint16_t height) {
+    m_pixels = pixels;
+    m_width = width;
+    m_height = height;
+}
+
+Color Framebuffer::pixel(int16_t x, int16_t y) const {
+    if (x < 0 || y < 0 || x >= m_width || y >= m_height) return 0;
+    return m_pixels[(uint32_t)y * m_width + x];
+}
+
+void Framebuffer::set(int16_t x, int16_t y, Color color) {
+    if (x < 0 || y < 0 || x >= m_width || y >= m_height) return;
+    m_pixels[(uint32_t)y * m_width + x] = color;
+}
+
+Rect Framebuffer::fill(const Rect& area, Color color) {
+    Rect clipped = intersect(area, bounds());
+    for (uint16_t y = 0; y < clipped.h; y++) {
+        Color* pixels = row((uint16_t)(clipped.y + y)) + clipped.x;
+        for (uint16_t x = 0; x < clipped.w; x++) {
+            pixels[x] = color;
+        }
+    }
+    return clipped;
+}
+
+Rect Framebuffer::copy(int16_t x, int16_t y, const Color* pixels, uint16_t width, uint16_t height) {
+    Rect clipped = intersect({ x, y, width, height }, bounds());
+    if (clipped.empty()) return clipped;
+
+    const Color* source = &pixels[(uint32_t)(clipped.y - y) * width + (clipped.x - x)];
+    for (uint16_t line = 0; line < clipped.h; line++) {
+        memcpy(row((uint16_t)(clipped.y + line)) + clipped.x, source, clipped.w * sizeof(Color));
+        source += width;
+    }
+    return clipped;
+}
+
+} // namespace Dash
@@ -0,0 +1,51 @@
+#ifndef DASH_FRAMEBUFFER_H
+#define DASH_FRAMEBUFFER_H
+
+#include <stdint.h>
+
+#include "types.h"
+
+namespace Dash {
+
+/**
+ * @brief RGB565 image of the whole screen in memory supplied by the caller
+ *
+ * The pixel memory can be anywhere, PSRAM on the ESP32-S3, only the renderer's staging
+ * buffers have to be DMA capable. Drawing is clipped to the screen.
+ **/
+class Framebuffer {
+public:
+    Framebuffer(Color* pixels, uint16_t width, uint16_t height);
+
+    uint16_t width() const { return m_width; }
+    uint16_t height() const { return m_height; }
+    Rect bounds() const { return { 0, 0, m_width, m_height }; }
+
+    const Color* row(uint16_t y) const { return &m_pixels[(uint32_t)y * m_width]; }
+    Color* row(uint16_t y) { return &m_pixels[(uint32_t)y * m_width]; }
+
+    Color pixel(int16_t x, int16_t y) const;
+    void set(int16_t x, int16_t y, Color color);
+
+    /**
+     * @brief Fills a rectangle
+     * @returns The area actually written, clipped to the screen
+     **/
+    Rect fill(const Rect& area, Color color);
+
+    /**
+     * @brief Copies an image row by row
+     * @param pixels Image of width by height pixels, rows stored one after the other
+     * @returns The area actually written, clipped to the screen
+     **/
+    Rect copy(int16_t x, int16_t y, const Color* pixels, uint16_t width, uint16_t height);
+
+private:
+    Color* m_pixels;
+    uint16_t m_width;
+    uint16_t m_height;
+};
+
+} // namespace Dash
+
+#endif // DASH_FRAMEBUFFER_H
@@ -0,0 +1,71 @@
+#ifndef DASH_HEADLESS_BACKEND_H
+#define DASH_HEADLESS_BACKEND_H
+
+#include <stdint.h>
+
+#include "i_display_backend.h"
+
+namespace Dash {
+
+/**
+ * @brief Display backend that writes into a panel image in memory
+ *
+ * Transfers complete immediately, but an unfinished one is still tracked so a write before
+ * the previous wait() is counted as an overlap. Used to run the renderer natively and in
+ * simulators.
+ **/
+class HeadlessBackend : public iDisplayBackend {
+public:
+    struct Statistics {
+        uint32_t transfers;     /**< Writes accepted */
+        uint32_t pixels;        /**< Pixels written */
+        uint32_t overlaps;      /**< Writes started while the previous one was not waited for */
+    };
+
+    HeadlessBackend(Color* panel, uint16_t width, uint16_t height, bool big_endian = false)
+        : m_panel(panel), m_width(width), m_height(height), m_big_endian(big_endian), m_in_flight(false), m_statistics() {}
+
+    bool write(const Rect& area, const Color* pixels, uint32_t count) override {
+        if (area.x < 0 || area.y < 0 || area.right() > m_width || area.bottom() > m_height || count != area.area()) {
+            return false;
+        }
+        if (m_in_flight) {
+            m_statistics.overlaps++;
+        }
+
+        for (uint16_t y = 0; y < area.h; y++) {
+            Color* row = &m_panel[(uint32_t)(area.y + y) * m_width + area.x];
+            for (uint16_t x = 0; x < area.w; x++) {
+                row[x] = *pixels++;
+            }
+        }
+        m_in_flight = true;
+        m_statistics.transfers++;
+        m_statistics.pixels += count;
+        return true;
+    }
+
+    bool wait() override {
+        m_in_flight = false;
+        return true;
+    }
+
+    bool swap_bytes() const override {
+        return m_big_endian;
+    }
+
+    const Color* panel() const { return m_panel; }
+    Statistics statistics() const { return m_statistics; }
+
+private:
+    Color* m_panel;
+    uint16_t m_width;
+    uint16_t m_height;
+    bool m_big_endian;
+    bool m_in_flight;
+    Statistics m_statistics;
+};
+
+} // namespace Dash
+
+#endif // DASH_HEADLESS_BACKEND_H
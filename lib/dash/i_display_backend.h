@@ -0,0 +1,29 @@
+#ifndef DASH_I_DISPLAY_BACKEND_H
+#define DASH_I_DISPLAY_BACKEND_H
+
+#include <stdint.h>
+
+#include "types.h"
+
+namespace Dash {
+
+/**
+ * @brief Display panel abstract interface
+ *          On the ESP32-S3 this is an esp_lcd SPI panel with DMA, natively a headless copy of the panel memory.
+ * @fn write: Starts sending count pixels, row by row, into an area of the panel and returns without waiting.
+ *            The pixels must stay untouched until wait() returns. Returns false if the transfer did not start.
+ * @fn wait: Blocks until the transfer started last has finished. Returns false if it is still running, e.g.
+ *            after a timeout, its pixels then stay in use until a later wait() returns true.
+ * @fn swap_bytes: true if the panel expects RGB565 with the high byte first
+ */
+class iDisplayBackend {
+public:
+    virtual ~iDisplayBackend() = default;
+    virtual bool write(const Rect& area, const Color* pixels, uint32_t count) = 0;
+    virtual bool wait() = 0;
+    virtual bool swap_bytes() const { return false; }
+};
+
+} // namespace Dash
+
+#endif // DASH_I_DISPLAY_BACKEND_H
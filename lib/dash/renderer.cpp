@@ -0,0 +1,112 @@
+#include "renderer.h"
+
+namespace Dash {
+
+Renderer::Renderer(Framebuffer* framebuffer, iDisplayBackend* backend) {
+    m_framebuffer = framebuffer;
+    m_backend = backend;
+    m_count = 0;
+    m_invalid = true;
+    m_next = 0;
+    m_retry = { 0, 0, 0, 0 };
+    m_stalled = false;
+    m_statistics = {};
+}
+
+bool Renderer::add(Widget* widget) {
+    if (widget == nullptr || m_count == DASH_MAX_WIDGETS) {
+        return false;
+    }
+    m_widgets[m_count++] = widget;
+    m_invalid = true;
+    return true;
+}
+
+void Renderer::invalidate() {
+    m_invalid = true;
+}
+
+uint32_t Renderer::render() {
+    bool force = m_invalid;
+    m_invalid = false;
+    m_statistics.frames++;
+
+    m_dirty.clear();
+    // Areas a failed transfer left stale on the panel
+    m_dirty.add(m_retry);
+    m_retry = { 0, 0, 0, 0 };
+    if (force) {
+        m_dirty.add(m_framebuffer->fill(m_framebuffer->bounds(), background));
+    }
+
+    for (uint32_t i = 0; i < m_count; i++) {
+        Rect drawn = m_widgets[i]->render(*m_framebuffer, force);
+        if (!drawn.empty()) {
+            m_statistics.redraws++;
+            m_dirty.add(drawn);
+        }
+    }
+
+    uint32_t pixels = 0;
+    m_stalled = false;
+    for (uint32_t i = 0; i < m_dirty.size(); i++) {
+        if (m_stalled) {
+            m_retry = unite(m_retry, m_dirty[i]);
+            continue;
+        }
+        pixels += flush(m_dirty[i]);
+    }
+    m_statistics.regions += m_dirty.size();
+    m_statistics.pixels += pixels;
+    return pixels;
+}
+
+uint32_t Renderer::flush(const Rect& region) {
+    bool swap = m_backend->swap_bytes();
+    uint16_t columns = region.w < DASH_FLUSH_BUFFER_PIXELS ? region.w : DASH_FLUSH_BUFFER_PIXELS;
+    uint16_t rows = (uint16_t)(DASH_FLUSH_BUFFER_PIXELS / columns);
+    uint32_t sent = 0;
+
+    for (uint16_t y = 0; y < region.h; y += rows) {
+        for (uint16_t x = 0; x < region.w; x += columns) {
+            Rect chunk = { (int16_t)(region.x + x), (int16_t)(region.y + y),
+                           (uint16_t)(region.w - x < columns ? region.w - x : columns),
+                           (uint16_t)(region.h - y < rows ? region.h - y : rows) };
+
+            // Fill the idle buffer while the previous transfer may still be reading the other
+            Color* staging = m_staging[m_next];
+            uint32_t count = 0;
+            for (uint16_t row = 0; row < chunk.h; row++) {
+                const Color* source = m_framebuffer->row((uint16_t)(chunk.y + row)) + chunk.x;
+                if (swap) {
+                    for (uint16_t column = 0; column < chunk.w; column++) {
+                        staging[count++] = (Color)__builtin_bswap16(source[column]);
+                    }
+                } else {
+                    for (uint16_t column = 0; column < chunk.w; column++) {
+                        staging[count++] = source[column];
+                    }
+                }
+            }
+
+            if (!m_backend->wait()) {
+                // The last transfer may still read the other buffer, send nothing more this frame
+                m_retry = unite(m_retry, region);
+                m_stalled = true;
+                m_statistics.stalls++;
+                return sent;
+            }
+            if (m_backend->write(chunk, staging, count)) {
+                m_next ^= 1;
+                m_statistics.transfers++;
+                sent += count;
+            } else {
+                m_retry = unite(m_retry, chunk);
+                m_statistics.failures++;
+            }
+        }
+    }
+    return sent;
+}
+
+} // namespace Dash
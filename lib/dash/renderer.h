@@ -0,0 +1,90 @@
+#ifndef DASH_RENDERER_H
+#define DASH_RENDERER_H
+
+#include <stdint.h>
+
+#include "dirty_regions.h"
+#include "framebuffer.h"
+#include "i_display_backend.h"
+#include "types.h"
+#include "widget.h"
+
+// Maximum number of widgets on the screen.
+#ifndef DASH_MAX_WIDGETS
+#define DASH_MAX_WIDGETS 32
+#endif
+
+// Separate changed areas tracked per frame before they are merged.
+#ifndef DASH_DIRTY_REGIONS
+#define DASH_DIRTY_REGIONS 8
+#endif
+
+// Pixels per staging buffer, two of them are used alternately for DMA.
+#ifndef DASH_FLUSH_BUFFER_PIXELS
+#define DASH_FLUSH_BUFFER_PIXELS 4096
+#endif
+
+namespace Dash {
+
+/**
+ * @brief Draws changed widgets into the framebuffer and sends only the changed areas to the panel
+ *
+ * Each frame asks every widget to render, collects the areas they drew and streams each area
+ * to the backend in chunks through two staging buffers: while the panel DMA reads one, the
+ * next chunk is copied into the other. A frame with no changed signals sends nothing. The last
+ * transfer is left running when render() returns, the CPU goes back to the other tasks while
+ * the panel is written.
+ *
+ * The staging buffers are members, place the renderer in DMA capable memory on the ESP32-S3.
+ **/
+class Renderer {
+public:
+    struct Statistics {
+        uint32_t frames;        /**< render() calls */
+        uint32_t redraws;       /**< Widgets that drew something */
+        uint32_t regions;       /**< Merged areas flushed */
+        uint32_t pixels;        /**< Pixels sent to the panel */
+        uint32_t transfers;     /**< Backend writes */
+        uint32_t failures;      /**< Backend writes that did not start, retried next frame */
+        uint32_t stalls;        /**< Frames cut short by a transfer still running after wait(), retried next frame */
+    };
+
+    // Colour of the screen behind the widgets.
+    Color background = 0;
+
+    Renderer(Framebuffer* framebuffer, iDisplayBackend* backend);
+
+    bool add(Widget* widget);
+
+    // Clears the screen and redraws every widget with the next frame.
+    void invalidate();
+
+    /**
+     * @brief Renders changed widgets and flushes what they drew
+     * @returns The number of pixels sent
+     **/
+    uint32_t render();
+
+    Statistics statistics() const { return m_statistics; }
+
+private:
+    Framebuffer* m_framebuffer;
+    iDisplayBackend* m_backend;
+    Widget* m_widgets[DASH_MAX_WIDGETS];
+    uint32_t m_count;
+    bool m_invalid;
+
+    DirtyRegions<DASH_DIRTY_REGIONS> m_dirty;
+    Color m_staging[2][DASH_FLUSH_BUFFER_PIXELS];
+    uint8_t m_next;
+    Rect m_retry;
+    bool m_stalled;
+
+    Statistics m_statistics;
+
+    uint32_t flush(const Rect& region);
+};
+
+} // namespace Dash
+
+#endif // DASH_RENDERER_H
@@ -0,0 +1,171 @@
+#include "text.h"
+
+#include <cstring>
+
+namespace Dash {
+
+uint16_t text_width(const Font& font, const char* text, uint8_t scale) {
+    uint32_t width = 0;
+    for (const char* c = text; *c != '\0'; c++) {
+        const Glyph* glyph = font.find(*c);
+        if (glyph != nullptr) width += glyph->advance;
+    }
+    width *= scale;
+    return width > 0xFFFF ? 0xFFFF : (uint16_t)width;
+}
+
+// Draws the visible part of one cell, the cell starts at x and clipped lies inside it
+static void draw_glyph(Framebuffer& framebuffer, const Font& font, const Glyph& glyph, int32_t x, int16_t y,
+                       const Rect& clipped, Color color, Color background, uint8_t scale) {
+    const uint8_t* bits = font.bitmap(glyph);
+    uint8_t stride = (uint8_t)((glyph.width + 7) / 8);
+    uint16_t skip = (uint16_t)(clipped.x - x);
+
+    for (uint16_t line = 0; line < font.height; line++, bits += stride) {
+        int32_t top = (int32_t)y + line * scale;
+        int32_t first = top > clipped.y ? top : clipped.y;
+        int32_t last = top + scale < clipped.bottom() ? top + scale : clipped.bottom();
+        if (first >= last) continue;
+
+        // Expand the bits once, then copy the pixels to the other rows of the scaled line
+        Color* pixels = framebuffer.row((uint16_t)first) + clipped.x;
+        uint16_t column = skip / scale;
+        uint8_t repeat = (uint8_t)(skip % scale);
+        for (uint16_t i = 0; i < clipped.w; i++) {
+            bool ink = column < glyph.width && (bits[column >> 3] & (0x80 >> (column & 7))) != 0;
+            pixels[i] = ink ? color : background;
+            if (++repeat == scale) {
+                repeat = 0;
+                column++;
+            }
+        }
+        for (int32_t row = first + 1; row < last; row++) {
+            memcpy(framebuffer.row((uint16_t)row) + clipped.x, pixels, clipped.w * sizeof(Color));
+        }
+    }
+}
+
+Rect draw_text(Framebuffer& framebuffer, const Font& font, int16_t x, int16_t y, const char* text,
+               Color color, Color background, uint8_t scale) {
+    if (scale == 0) scale = 1;
+    uint16_t height = (uint16_t)(font.height * scale);
+    Rect drawn = { 0, 0, 0, 0 };
+    int32_t cursor = x;
+
+    for (const char* c = text; *c != '\0'; c++) {
+        const Glyph* glyph = font.find(*c);
+        if (glyph == nullptr) continue;
+
+        uint16_t advance = (uint16_t)(glyph->advance * scale);
+        if (cursor >= framebuffer.width()) break;
+        if (cursor + advance > 0) {
+            Rect cell = intersect({ (int16_t)cursor, y, advance, height }, framebuffer.bounds());
+            if (!cell.empty()) {
+                draw_glyph(framebuffer, font, *glyph, cursor, y, cell, color, background, scale);
+                drawn = unite(drawn, cell);
+            }
+        }
+        cursor += advance;
+    }
+    return drawn;
+}
+
+static const char DIGIT_CELLS[DigitCache::CELLS] = { '0', '1', '2', '3', '4', '5', '6', '7', '8', '9', ' ', '-' };
+
+constexpr uint8_t DigitCache::CELLS;
+
+DigitCache::DigitCache(const Font& font, uint8_t scale, Color color, Color background) {
+    if (scale == 0) scale = 1;
+
+    // Same cell width for every character, so numbers stay aligned whatever the font
+    uint16_t advance = 0;
+    for (uint8_t i = 0; i < CELLS; i++) {
+        const Glyph* glyph = font.find(DIGIT_CELLS[i]);
+        if (glyph != nullptr && glyph->advance > advance) advance = glyph->advance;
+    }
+    m_width = (uint16_t)(advance * scale);
+    m_height = (uint16_t)(font.height * scale);
+    m_valid = m_width != 0 && m_height != 0 && (uint32_t)m_width * m_height <= DASH_DIGIT_CELL_PIXELS;
+    if (!m_valid) return;
+
+    for (uint8_t i = 0; i < CELLS; i++) {
+        Framebuffer canvas(m_cells[i], m_width, m_height);
+        canvas.fill(canvas.bounds(), background);
+        const char text[2] = { DIGIT_CELLS[i], '\0' };
+        draw_text(canvas, font, 0, 0, text, color, background, scale);
+    }
+}
+
+uint8_t DigitCache::cell(char character) {
+    if (character >= '0' && character <= '9') return (uint8_t)(character - '0');
+    return character == '-' ? 11 : 10;
+}
+
+Rect DigitCache::draw(Framebuffer& framebuffer, int16_t x, int16_t y, char character) const {
+    if (!m_valid) return { 0, 0, 0, 0 };
+    return framebuffer.copy(x, y, m_cells[cell(character)], m_width, m_height);
+}
+
+Rect DigitCache::draw(Framebuffer& framebuffer, int16_t x, int16_t y, const char* text) const {
+    Rect drawn = { 0, 0, 0, 0 };
+    int32_t cursor = x;
+    for (const char* c = text; *c != '\0' && cursor < framebuffer.width(); c++) {
+        drawn = unite(drawn, draw(framebuffer, (int16_t)cursor, y, *c));
+        cursor += m_width;
+    }
+    return drawn;
+}
+
+static uint8_t number_width(uint8_t width) {
+    return width == 0 ? 1 : width > DASH_NUMBER_MAX_DIGITS ? DASH_NUMBER_MAX_DIGITS : width;
+}
+
+NumberWidget::NumberWidget(int16_t x, int16_t y, const Signal* signal, const DigitCache* digits, uint8_t width)
+    : Widget({ x, y, (uint16_t)(digits->cell_width() * number_width(width)), digits->cell_height() }) {
+    m_signal = signal;
+    m_digits = digits;
+    m_width = number_width(width);
+    m_drawn = false;
+    memset(m_shown, ' ', m_width);
+    m_shown[m_width] = '\0';
+}
+
+bool NumberWidget::format(int32_t value, char* text, uint8_t width) {
+    uint32_t magnitude = value < 0 ? 0U - (uint32_t)value : (uint32_t)value;
+    uint8_t i = width;
+    text[width] = '\0';
+
+    do {
+        if (i == 0) return false;
+        text[--i] = (char)('0' + magnitude % 10);
+        magnitude /= 10;
+    } while (magnitude != 0);
+
+    if (value < 0) {
+        if (i == 0) return false;
+        text[--i] = '-';
+    }
+    while (i > 0) {
+        text[--i] = ' ';
+    }
+    return true;
+}
+
+Rect NumberWidget::render(Framebuffer& framebuffer, bool force) {
+    char text[DASH_NUMBER_MAX_DIGITS + 1];
+    if (!format(m_signal->load(std::memory_order_relaxed), text, m_width)) {
+        memset(text, '-', m_width);
+    }
+
+    Rect drawn = { 0, 0, 0, 0 };
+    for (uint8_t i = 0; i < m_width; i++) {
+        if (!force && m_drawn && text[i] == m_shown[i]) continue;
+        int16_t x = (int16_t)(m_bounds.x + i * m_digits->cell_width());
+        drawn = unite(drawn, m_digits->draw(framebuffer, x, m_bounds.y, text[i]));
+        m_shown[i] = text[i];
+    }
+    m_drawn = true;
+    return drawn;
+}
+
+} // namespace Dash
@@ -0,0 +1,104 @@
+#ifndef DASH_TEXT_H
+#define DASH_TEXT_H
+
+#include <stdint.h>
+
+#include "font.h"
+#include "fonts/dash_5x7.h"
+#include "framebuffer.h"
+#include "types.h"
+#include "widget.h"
+
+// Largest digit cell in pixels, advance times height times scale squared. The default fits
+// the 5x7 font up to scale 4, 16 KB per cache.
+#ifndef DASH_DIGIT_CELL_PIXELS
+#define DASH_DIGIT_CELL_PIXELS 672
+#endif
+
+// Most characters a number widget shows, enough for any int32_t with its sign.
+#ifndef DASH_NUMBER_MAX_DIGITS
+#define DASH_NUMBER_MAX_DIGITS 11
+#endif
+
+namespace Dash {
+
+// Width of the text in pixels, characters missing from the font take no space.
+uint16_t text_width(const Font& font, const char* text, uint8_t scale = 1);
+
+/**
+ * @brief Draws text with an opaque background
+ *
+ * Every character fills its whole cell, advance by height, so the previous content never
+ * needs clearing first. Each glyph row is expanded once and copied for the other rows of the
+ * same scaled line.
+ * @param x, y Top left corner of the first cell
+ * @param scale Integer magnification, 1 draws the font at its native size
+ * @returns The area drawn, clipped to the screen
+ **/
+Rect draw_text(Framebuffer& framebuffer, const Font& font, int16_t x, int16_t y, const char* text,
+               Color color, Color background, uint8_t scale = 1);
+
+/**
+ * @brief Digits pre-rendered in one size and color pair
+ *
+ * '0' to '9', space and '-' are drawn once into RGB565 cells of the same width, after which
+ * a character is a row by row memcpy into the framebuffer, with no bit expansion at all.
+ * Changing the colors or the scale means building another cache.
+ **/
+class DigitCache {
+public:
+    static constexpr uint8_t CELLS = 12;
+
+    DigitCache(const Font& font, uint8_t scale, Color color, Color background);
+
+    // false if a cell does not fit DASH_DIGIT_CELL_PIXELS, nothing is drawn then
+    bool valid() const { return m_valid; }
+    uint16_t cell_width() const { return m_width; }
+    uint16_t cell_height() const { return m_height; }
+
+    /**
+     * @brief Draws one digit, space or '-', anything else as a space
+     * @returns The area drawn, clipped to the screen
+     **/
+    Rect draw(Framebuffer& framebuffer, int16_t x, int16_t y, char character) const;
+
+    // Draws the characters one cell apart and returns the area covered
+    Rect draw(Framebuffer& framebuffer, int16_t x, int16_t y, const char* text) const;
+
+private:
+    Color m_cells[CELLS][DASH_DIGIT_CELL_PIXELS];
+    uint16_t m_width;
+    uint16_t m_height;
+    bool m_valid;
+
+    static uint8_t cell(char character);
+};
+
+/**
+ * @brief Right aligned integer drawn from a digit cache
+ *          Only the cells whose character changed are redrawn, a value that does not fit
+ *          is shown as dashes.
+ **/
+class NumberWidget : public Widget {
+public:
+    NumberWidget(int16_t x, int16_t y, const Signal* signal, const DigitCache* digits, uint8_t width);
+
+    Rect render(Framebuffer& framebuffer, bool force) override;
+
+    // Characters currently on screen
+    const char* text() const { return m_shown; }
+
+    // Writes the value right aligned into width characters, returns false if it does not fit
+    static bool format(int32_t value, char* text, uint8_t width);
+
+private:
+    const Signal* m_signal;
+    const DigitCache* m_digits;
+    uint8_t m_width;
+    bool m_drawn;
+    char m_shown[DASH_NUMBER_MAX_DIGITS + 1];
+};
+
+} // namespace Dash
+
+#endif // DASH_TEXT_H
@@ -0,0 +1,62 @@
+#ifndef DASH_TYPES_H
+#define DASH_TYPES_H
+
+#include <atomic>
+#include <stdint.h>
+
+namespace Dash {
+
+// RGB565 pixel as stored in the framebuffer.
+typedef uint16_t Color;
+
+constexpr Color rgb565(uint8_t r, uint8_t g, uint8_t b) {
+    return (Color)(((r & 0xF8) << 8) | ((g & 0xFC) << 3) | (b >> 3));
+}
+
+// Vehicle value a widget is bound to, written by the receiving tasks and read by the renderer.
+typedef std::atomic<int32_t> Signal;
+
+/**
+ * @brief Screen area in pixels, empty when either side is zero
+ **/
+struct Rect {
+    int16_t x;
+    int16_t y;
+    uint16_t w;
+    uint16_t h;
+
+    bool empty() const { return w == 0 || h == 0; }
+    int32_t right() const { return (int32_t)x + w; }
+    int32_t bottom() const { return (int32_t)y + h; }
+    uint32_t area() const { return (uint32_t)w * h; }
+};
+
+// Smallest rectangle covering both, an empty side is ignored
+inline Rect unite(const Rect& a, const Rect& b) {
+    if (a.empty()) return b;
+    if (b.empty()) return a;
+    int32_t x = a.x < b.x ? a.x : b.x;
+    int32_t y = a.y < b.y ? a.y : b.y;
+    int32_t right = a.right() > b.right() ? a.right() : b.right();
+    int32_t bottom = a.bottom() > b.bottom() ? a.bottom() : b.bottom();
+    return { (int16_t)x, (int16_t)y, (uint16_t)(right - x), (uint16_t)(bottom - y) };
+}
+
+inline Rect intersect(const Rect& a, const Rect& b) {
+    int32_t x = a.x > b.x ? a.x : b.x;
+    int32_t y = a.y > b.y ? a.y : b.y;
+    int32_t right = a.right() < b.right() ? a.right() : b.right();
+    int32_t bottom = a.bottom() < b.bottom() ? a.bottom() : b.bottom();
+    if (right <= x || bottom <= y) return { 0, 0, 0, 0 };
+    return { (int16_t)x, (int16_t)y, (uint16_t)(right - x), (uint16_t)(bottom - y) };
+}
+
+// Overlapping or sharing at least part of an edge. Their union only stays exact when they
+// share a whole side or one contains the other, otherwise it also covers corner pixels of neither.
+inline bool touches(const Rect& a, const Rect& b) {
+    return !a.empty() && !b.empty() && a.x <= b.right() && b.x <= a.right() && a.y <= b.bottom() && b.y <= a.bottom();
+}
+
+} // namespace Dash
+
+#endif // DASH_TYPES_H
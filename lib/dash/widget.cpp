@@ -0,0 +1,57 @@
+#include "widget.h"
+
+namespace Dash {
+
+BarWidget::BarWidget(const Rect& bounds, const Signal* signal, int32_t minimum, int32_t maximum, Color fill, Color background)
+    : Widget(bounds) {
+    m_signal = signal;
+    m_minimum = minimum;
+    m_maximum = maximum > minimum ? maximum : minimum + 1;
+    m_fill = fill;
+    m_background = background;
+    m_length = 0;
+}
+
+Rect BarWidget::render(Framebuffer& framebuffer, bool force) {
+    int32_t value = m_signal->load(std::memory_order_relaxed);
+    value = value < m_minimum ? m_minimum : value > m_maximum ? m_maximum : value;
+    uint16_t length = (uint16_t)((int64_t)(value - m_minimum) * m_bounds.w / (m_maximum - m_minimum));
+
+    if (force) {
+        Rect filled = { m_bounds.x, m_bounds.y, length, m_bounds.h };
+        Rect empty = { (int16_t)(m_bounds.x + length), m_bounds.y, (uint16_t)(m_bounds.w - length), m_bounds.h };
+        framebuffer.fill(filled, m_fill);
+        framebuffer.fill(empty, m_background);
+        m_length = length;
+        return intersect(m_bounds, framebuffer.bounds());
+    }
+    if (length == m_length) {
+        return { 0, 0, 0, 0 };
+    }
+
+    uint16_t from = length < m_length ? length : m_length;
+    uint16_t to = length < m_length ? m_length : length;
+    Rect strip = { (int16_t)(m_bounds.x + from), m_bounds.y, (uint16_t)(to - from), m_bounds.h };
+    m_length = length;
+    return framebuffer.fill(strip, length > from ? m_fill : m_background);
+}
+
+IndicatorWidget::IndicatorWidget(const Rect& bounds, const Signal* signal, Color on, Color off) : Widget(bounds) {
+    m_signal = signal;
+    m_on = on;
+    m_off = off;
+    m_drawn = false;
+    m_lit = false;
+}
+
+Rect IndicatorWidget::render(Framebuffer& framebuffer, bool force) {
+    bool lit = m_signal->load(std::memory_order_relaxed) != 0;
+    if (!force && m_drawn && lit == m_lit) {
+        return { 0, 0, 0, 0 };
+    }
+    m_drawn = true;
+    m_lit = lit;
+    return framebuffer.fill(m_bounds, lit ? m_on : m_off);
+}
+
+} // namespace Dash
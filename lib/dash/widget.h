@@ -0,0 +1,74 @@
+#ifndef DASH_WIDGET_H
+#define DASH_WIDGET_H
+
+#include <stdint.h>
+
+#include "framebuffer.h"
+#include "types.h"
+
+namespace Dash {
+
+/**
+ * @brief Screen element bound to a vehicle signal
+ *
+ * render() reads the signal and only draws if what is shown would change. It returns the
+ * area it drew, which can be smaller than the widget, or an empty rectangle.
+ **/
+class Widget {
+public:
+    explicit Widget(const Rect& bounds) : m_bounds(bounds) {}
+    virtual ~Widget() = default;
+
+    const Rect& bounds() const { return m_bounds; }
+
+    /**
+     * @param force Draw the whole widget even if nothing changed, e.g. after the screen was cleared
+     * @returns The area drawn, empty if nothing was
+     **/
+    virtual Rect render(Framebuffer& framebuffer, bool force) = 0;
+
+protected:
+    Rect m_bounds;
+};
+
+/**
+ * @brief Horizontal bar filled from the left in proportion to a value
+ *          Only the strip between the old and the new fill length is redrawn.
+ **/
+class BarWidget : public Widget {
+public:
+    BarWidget(const Rect& bounds, const Signal* signal, int32_t minimum, int32_t maximum, Color fill, Color background);
+
+    Rect render(Framebuffer& framebuffer, bool force) override;
+
+    uint16_t length() const { return m_length; }
+
+private:
+    const Signal* m_signal;
+    int32_t m_minimum;
+    int32_t m_maximum;
+    Color m_fill;
+    Color m_background;
+    uint16_t m_length;
+};
+
+/**
+ * @brief Solid box showing whether a value is non-zero, e.g. a fault lamp
+ **/
+class IndicatorWidget : public Widget {
+public:
+    IndicatorWidget(const Rect& bounds, const Signal* signal, Color on, Color off);
+
+    Rect render(Framebuffer& framebuffer, bool force) override;
+
+private:
+    const Signal* m_signal;
+    Color m_on;
+    Color m_off;
+    bool m_drawn;
+    bool m_lit;
+};
+
+} // namespace Dash
+
+#endif // DASH_WIDGET_H
@@ -0,0 +1,152 @@
+#ifndef IMD_ESP32_S3_EDGE_SOURCE_H
+#define IMD_ESP32_S3_EDGE_SOURCE_H
+
+#if defined(ESP32)
+
+#include <atomic>
+#include <cstring>
+#include <driver/gpio.h>
+#include <driver/mcpwm_cap.h>
+#include <esp_attr.h>
+#include <esp_timer.h>
+
+#include "i_edge_source.h"
+
+// Edges buffered between the capture interrupt and poll(), a power of two.
+#ifndef IMD_EDGE_BUFFER
+#define IMD_EDGE_BUFFER 32
+#endif
+
+namespace IMD {
+
+// Both edges of one GPIO timestamped by the MCPWM capture unit, no polling of the pin
+class ESP32S3EdgeSource final : public iEdgeSource {
+    static_assert((IMD_EDGE_BUFFER & (IMD_EDGE_BUFFER - 1)) == 0, "IMD_EDGE_BUFFER must be a power of two");
+
+public:
+    explicit ESP32S3EdgeSource(gpio_num_t pin, int group = 0)
+        : m_pin(pin), m_group(group), m_timer(nullptr), m_channel(nullptr), m_resolution_hz(1),
+          m_anchored(false), m_origin_us(0), m_last_capture(0), m_ticks(0), m_head(0), m_tail(0) {}
+
+    ~ESP32S3EdgeSource() {
+        stop();
+    }
+
+    bool start() override {
+        if (m_timer != nullptr) return true;
+
+        mcpwm_capture_timer_config_t timer_config;
+        memset(&timer_config, 0, sizeof(timer_config));
+        timer_config.group_id = m_group;
+        timer_config.clk_src = MCPWM_CAPTURE_CLK_SRC_DEFAULT;
+        if (mcpwm_new_capture_timer(&timer_config, &m_timer) != ESP_OK) {
+            m_timer = nullptr;
+            return false;
+        }
+
+        mcpwm_capture_channel_config_t channel_config;
+        memset(&channel_config, 0, sizeof(channel_config));
+        channel_config.gpio_num = m_pin;
+        channel_config.prescale = 1;
+        channel_config.flags.pos_edge = true;
+        channel_config.flags.neg_edge = true;
+
+        mcpwm_capture_event_callbacks_t callbacks;
+        memset(&callbacks, 0, sizeof(callbacks));
+        callbacks.on_cap = on_capture;
+
+        m_anchored = false;
+        if (mcpwm_new_capture_channel(m_timer, &channel_config, &m_channel) != ESP_OK
+            || mcpwm_capture_channel_register_event_callbacks(m_channel, &callbacks, this) != ESP_OK
+            || mcpwm_capture_channel_enable(m_channel) != ESP_OK
+            || mcpwm_capture_timer_get_resolution(m_timer, &m_resolution_hz) != ESP_OK
+            || mcpwm_capture_timer_enable(m_timer) != ESP_OK
+            || mcpwm_capture_timer_start(m_timer) != ESP_OK) {
+            release();
+            return false;
+        }
+        return true;
+    }
+
+    void stop() override {
+        if (m_timer == nullptr) return;
+        mcpwm_capture_timer_stop(m_timer);
+        mcpwm_capture_timer_disable(m_timer);
+        release();
+    }
+
+    uint32_t read(Edge* edges, uint32_t capacity) override {
+        uint32_t tail = m_tail.load(std::memory_order_relaxed);
+        uint32_t head = m_head.load(std::memory_order_acquire);
+        uint32_t count = 0;
+        while (tail != head && count < capacity) {
+            edges[count++] = m_buffer[tail & (IMD_EDGE_BUFFER - 1)];
+            tail++;
+        }
+        m_tail.store(tail, std::memory_order_release);
+        return count;
+    }
+
+    bool level() override {
+        return gpio_get_level(m_pin) != 0;
+    }
+
+private:
+    gpio_num_t m_pin;
+    int m_group;
+    mcpwm_cap_timer_handle_t m_timer;
+    mcpwm_cap_channel_handle_t m_channel;
+    uint32_t m_resolution_hz;
+
+    // Extends the 32-bit capture counter to a 64-bit time line anchored on esp_timer
+    bool m_anchored;
+    int64_t m_origin_us;
+    uint32_t m_last_capture;
+    uint64_t m_ticks;
+
+    Edge m_buffer[IMD_EDGE_BUFFER];
+    std::atomic<uint32_t> m_head;
+    std::atomic<uint32_t> m_tail;
+
+    void release() {
+        if (m_channel != nullptr) {
+            mcpwm_capture_channel_disable(m_channel);
+            mcpwm_del_capture_channel(m_channel);
+            m_channel = nullptr;
+        }
+        if (m_timer != nullptr) {
+            mcpwm_del_capture_timer(m_timer);
+            m_timer = nullptr;
+        }
+    }
+
+    static bool IRAM_ATTR on_capture(mcpwm_cap_channel_handle_t, const mcpwm_capture_event_data_t* data, void* context) {
+        ESP32S3EdgeSource* self = (ESP32S3EdgeSource*)context;
+        int64_t now = esp_timer_get_time();
+
+        // Re-anchor after long silences, the capture counter wraps within a minute
+        if (!self->m_anchored || now - self->m_origin_us - (int64_t)(self->m_ticks * 1000000ULL / self->m_resolution_hz) > 10000000) {
+            self->m_anchored = true;
+            self->m_origin_us = now;
+            self->m_ticks = 0;
+        } else {
+            self->m_ticks += (uint32_t)(data->cap_value - self->m_last_capture);
+        }
+        self->m_last_capture = data->cap_value;
+
+        uint32_t head = self->m_head.load(std::memory_order_relaxed);
+        if (head - self->m_tail.load(std::memory_order_acquire) < IMD_EDGE_BUFFER) {
+            Edge& edge = self->m_buffer[head & (IMD_EDGE_BUFFER - 1)];
+            edge.timestamp_us = (uint64_t)self->m_origin_us + self->m_ticks * 1000000ULL / self->m_resolution_hz;
+            edge.rising = data->cap_edge == MCPWM_CAP_EDGE_POS;
+            self->m_head.store(head + 1, std::memory_order_release);
+        }
+        return false;
+    }
+};
+
+} // namespace IMD
+
+#endif // ESP32
+
+#endif // IMD_ESP32_S3_EDGE_SOURCE_H
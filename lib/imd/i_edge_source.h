@@ -0,0 +1,35 @@
+#ifndef IMD_I_EDGE_SOURCE_H
+#define IMD_I_EDGE_SOURCE_H
+
+#include <stdint.h>
+
+namespace IMD {
+
+/**
+ * @brief One captured transition of a digital input
+ **/
+struct Edge {
+    uint64_t timestamp_us;  /**< Capture time on the same time base as the clock strategy */
+    bool rising;
+};
+
+/**
+ * @brief Edge timestamp capture abstract interface
+ *          On the ESP32-S3 this is backed by the MCPWM capture unit, in tests by a synthetic source.
+ * @fn start: Starts capturing both edges. Returns false on failure.
+ * @fn stop: Stops capturing
+ * @fn read: Copies out edges captured so far, oldest first, without blocking. Returns the number copied.
+ * @fn level: Current input level, used when no edges arrive
+ */
+class iEdgeSource {
+public:
+    virtual ~iEdgeSource() = default;
+    virtual bool start() = 0;
+    virtual void stop() = 0;
+    virtual uint32_t read(Edge* edges, uint32_t capacity) = 0;
+    virtual bool level() = 0;
+};
+
+} // namespace IMD
+
+#endif // IMD_I_EDGE_SOURCE_H
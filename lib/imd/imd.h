@@ -2,4 +2,9 @@
 #ifndef IMD_H
 #define IMD_H   
 
-#endif // IMD_H
\ No newline at end of file
+#include "esp32_s3_edge_source.h"
+#include "i_edge_source.h"
+#include "ir155.h"
+#include "types.h"
+
+#endif // IMD_H
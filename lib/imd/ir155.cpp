@@ -0,0 +1,229 @@
+#include "ir155.h"
+
+namespace IMD {
+
+// Nominal M_HS periods of the 10, 20, 30, 40 and 50 Hz states, microseconds
+static const uint32_t PERIODS_US[] = { 100000, 50000, 33333, 25000, 20000 };
+static const ImdState STATES[] = { ImdState::NORMAL, ImdState::UNDERVOLTAGE, ImdState::SPEED_START,
+                                   ImdState::DEVICE_ERROR, ImdState::GROUND_FAULT };
+
+// Duty windows of the datasheet, widened by half a percent for timing tolerance
+static const uint16_t MEASUREMENT_MIN = 45;
+static const uint16_t MEASUREMENT_MAX = 955;
+static const uint16_t SPEED_GOOD_MAX = 105;
+static const uint16_t SPEED_BAD_MIN = 895;
+static const uint16_t FIXED_DUTY_MIN = 470;
+static const uint16_t FIXED_DUTY_MAX = 530;
+
+IR155::IR155(iEdgeSource* edges, Core::iClockStrategy* clock, Core::iLockStrategy* lock) {
+    m_edges = edges;
+    m_clock = clock;
+    m_lock = lock;
+    m_listener = nullptr;
+    m_context = nullptr;
+
+    m_have_rise = false;
+    m_have_fall = false;
+    m_last_rise = 0;
+    m_last_fall = 0;
+    m_last_edge = m_clock->micros();
+
+    m_candidate = { ImdState::UNKNOWN, ImdFault::PENDING, 0, 0, 0, 0 };
+    m_agreeing = 0;
+    m_status = m_candidate;
+    m_statistics = {};
+}
+
+bool IR155::start() {
+    {
+        Core::LockGuard guard(m_lock);
+        m_have_rise = false;
+        m_have_fall = false;
+        m_last_edge = m_clock->micros();
+    }
+    return m_edges->start();
+}
+
+void IR155::stop() {
+    m_edges->stop();
+}
+
+void IR155::set_listener(StatusListener listener, void* context) {
+    Core::LockGuard guard(m_lock);
+    m_listener = listener;
+    m_context = context;
+}
+
+void IR155::notify(const ImdStatus& status) {
+    StatusListener listener;
+    void* context;
+    {
+        Core::LockGuard guard(m_lock);
+        listener = m_listener;
+        context = m_context;
+    }
+    if (listener) {
+        listener(status, context);
+    }
+}
+
+uint32_t IR155::resistance_kohm(uint16_t duty_permille) {
+    // Rf = (90% * 1200 kOhm) / (duty - 5%) - 1200 kOhm
+    if (duty_permille <= 50) return RESISTANCE_INFINITE_KOHM;
+    if (duty_permille >= 950) return 0;
+    uint32_t resistance = 1080000U / (duty_permille - 50U);
+    resistance = resistance > 1200 ? resistance - 1200 : 0;
+    return resistance > RESISTANCE_INFINITE_KOHM ? RESISTANCE_INFINITE_KOHM : resistance;
+}
+
+ImdState IR155::classify(uint32_t period_us) const {
+    for (uint32_t i = 0; i < sizeof(PERIODS_US) / sizeof(PERIODS_US[0]); i++) {
+        uint32_t nominal = PERIODS_US[i];
+        uint32_t deviation = period_us > nominal ? period_us - nominal : nominal - period_us;
+        if ((uint64_t)deviation * 1000 <= (uint64_t)nominal * frequency_tolerance_permille) {
+            return STATES[i];
+        }
+    }
+    return ImdState::INVALID;
+}
+
+ImdFault IR155::fault(ImdState state, uint32_t resistance_kohm, uint16_t duty_permille) const {
+    switch (state) {
+        case ImdState::NORMAL:
+            return resistance_kohm < minimum_kohm ? ImdFault::INSULATION_LOW : ImdFault::NONE;
+        case ImdState::UNDERVOLTAGE:
+            return resistance_kohm < minimum_kohm ? ImdFault::INSULATION_LOW : ImdFault::UNDERVOLTAGE;
+        case ImdState::SPEED_START:
+            return duty_permille <= SPEED_GOOD_MAX ? ImdFault::NONE : ImdFault::INSULATION_LOW;
+        case ImdState::DEVICE_ERROR:
+            return ImdFault::DEVICE_ERROR;
+        case ImdState::GROUND_FAULT:
+            return ImdFault::GROUND_FAULT;
+        case ImdState::UNKNOWN:
+            return ImdFault::PENDING;
+        default:
+            return ImdFault::INVALID_SIGNAL;
+    }
+}
+
+ImdStatus IR155::measure(uint32_t period_us, uint32_t high_us) const {
+    ImdStatus status = { ImdState::INVALID, ImdFault::INVALID_SIGNAL, 0, 0, 0, 0 };
+    status.frequency_dhz = (uint16_t)(10000000U / period_us);
+    status.duty_permille = (uint16_t)((uint64_t)high_us * 1000 / period_us);
+
+    ImdState state = classify(period_us);
+    uint16_t duty = status.duty_permille;
+    bool valid = false;
+    switch (state) {
+        case ImdState::NORMAL:
+        case ImdState::UNDERVOLTAGE:
+            valid = duty >= MEASUREMENT_MIN && duty <= MEASUREMENT_MAX;
+            status.resistance_kohm = resistance_kohm(duty);
+            break;
+        case ImdState::SPEED_START:
+            valid = (duty >= MEASUREMENT_MIN && duty <= SPEED_GOOD_MAX) || (duty >= SPEED_BAD_MIN && duty <= MEASUREMENT_MAX);
+            break;
+        case ImdState::DEVICE_ERROR:
+        case ImdState::GROUND_FAULT:
+            valid = duty >= FIXED_DUTY_MIN && duty <= FIXED_DUTY_MAX;
+            break;
+        default:
+            break;
+    }
+
+    if (valid) {
+        status.state = state;
+        status.fault = fault(state, status.resistance_kohm, duty);
+    } else {
+        status.resistance_kohm = 0;
+    }
+    return status;
+}
+
+bool IR155::confirm(const ImdStatus& candidate, uint8_t required) {
+    if (candidate.state == m_candidate.state && candidate.fault == m_candidate.fault) {
+        if (m_agreeing < 255) m_agreeing++;
+    } else {
+        m_agreeing = 1;
+    }
+    m_candidate = candidate;
+    if (m_agreeing < required) {
+        return false;
+    }
+
+    bool changed = candidate.state != m_status.state || candidate.fault != m_status.fault;
+    m_status = candidate;
+    if (changed) {
+        m_statistics.changes++;
+    }
+    return changed;
+}
+
+bool IR155::poll() {
+    Edge edges[IMD_EDGE_READ_CHUNK];
+    bool changed = false;
+    ImdStatus published;
+    {
+        Core::LockGuard guard(m_lock);
+        for (;;) {
+            uint32_t count = m_edges->read(edges, IMD_EDGE_READ_CHUNK);
+            m_statistics.edges += count;
+
+            for (uint32_t i = 0; i < count; i++) {
+                const Edge& edge = edges[i];
+                m_last_edge = edge.timestamp_us;
+                if (!edge.rising) {
+                    m_have_fall = m_have_rise;
+                    m_last_fall = edge.timestamp_us;
+                    continue;
+                }
+
+                // A rising edge closes the period opened by the previous one
+                if (m_have_rise && m_have_fall && edge.timestamp_us > m_last_rise) {
+                    ImdStatus candidate = measure((uint32_t)(edge.timestamp_us - m_last_rise), (uint32_t)(m_last_fall - m_last_rise));
+                    candidate.timestamp_us = edge.timestamp_us;
+                    m_statistics.periods++;
+                    if (candidate.state == ImdState::INVALID) {
+                        m_statistics.invalid_periods++;
+                    }
+                    changed |= confirm(candidate, confirm_periods);
+                }
+                m_have_rise = true;
+                m_have_fall = false;
+                m_last_rise = edge.timestamp_us;
+            }
+
+            if (count < IMD_EDGE_READ_CHUNK) break;
+        }
+
+        // A static output is a state of its own, the timeout already confirms it
+        uint64_t now = m_clock->micros();
+        // Capture timestamps can run a few us ahead of the clock, such an edge is not a timeout
+        if (now > m_last_edge && now - m_last_edge > signal_timeout_us) {
+            bool high = m_edges->level();
+            ImdStatus candidate = { ImdState::NO_SIGNAL, high ? ImdFault::SHORT_TO_SUPPLY : ImdFault::OFF_OR_SHORT_TO_GROUND,
+                                    0, 0, (uint16_t)(high ? 1000 : 0), now };
+            changed |= confirm(candidate, 1);
+            m_have_rise = false;
+            m_have_fall = false;
+        }
+        published = m_status;
+    }
+
+    if (changed) {
+        notify(published);
+    }
+    return changed;
+}
+
+ImdStatus IR155::status() {
+    Core::LockGuard guard(m_lock);
+    return m_status;
+}
+
+IR155::Statistics IR155::statistics() {
+    Core::LockGuard guard(m_lock);
+    return m_statistics;
+}
+
+} // namespace IMD
@@ -0,0 +1,106 @@
+#ifndef IMD_IR155_H
+#define IMD_IR155_H
+
+#include <stdint.h>
+
+#include "core/core.h"
+#include "i_edge_source.h"
+#include "types.h"
+
+// Edges copied out of the capture source per read.
+#ifndef IMD_EDGE_READ_CHUNK
+#define IMD_EDGE_READ_CHUNK 16
+#endif
+
+namespace IMD {
+
+/**
+ * @brief Receives status changes, called without the decoder's lock held
+ **/
+typedef void(*StatusListener)(const ImdStatus& status, void* context);
+
+/**
+ * @brief Bender IR155-3203/3204 M_HS output decoder working on captured edge timestamps
+ *
+ * Every rising edge closes a PWM period: the time since the previous rising edge is the period
+ * and the falling edge in between gives the high time. The frequency selects the state, the
+ * duty the insulation resistance. A state is only published once confirm_periods consecutive
+ * periods agree, at 10 Hz the default settles two periods or 200 ms after the first edge, far inside
+ * the 30 s the rules allow for the IMD to open the shutdown circuit. Without edges for
+ * signal_timeout_us the output is static and the level tells a short to supply from an
+ * unpowered or grounded IMD.
+ *
+ * poll() never blocks, call it from any periodic task a few times per PWM period or less,
+ * the capture hardware keeps the timestamps.
+ **/
+class IR155 {
+public:
+    struct Statistics {
+        uint32_t edges;             /**< Edges read from the capture source */
+        uint32_t periods;           /**< Complete PWM periods measured */
+        uint32_t invalid_periods;   /**< Periods outside every frequency or duty band */
+        uint32_t changes;           /**< Published state or fault changes */
+    };
+
+    // Consecutive agreeing periods before a new state is published.
+    uint8_t confirm_periods = 2;
+    // Accepted frequency deviation from the nominal band, tenths of a percent.
+    uint16_t frequency_tolerance_permille = 100;
+    // Time without edges after which the output is considered static, microseconds.
+    uint32_t signal_timeout_us = 300000;
+    // Insulation resistance below which NORMAL and UNDERVOLTAGE report INSULATION_LOW, kOhm.
+    uint32_t minimum_kohm = 300;
+
+    /**
+     * @param lock Lock shared by the polling and reading tasks, can be nullptr
+     **/
+    IR155(iEdgeSource* edges, Core::iClockStrategy* clock, Core::iLockStrategy* lock = nullptr);
+
+    bool start();
+    void stop();
+
+    void set_listener(StatusListener listener, void* context);
+
+    /**
+     * @brief Drains captured edges and updates the status
+     * @returns true if the published status changed state or fault
+     **/
+    bool poll();
+
+    ImdStatus status();
+    Statistics statistics();
+
+    /**
+     * @returns The insulation resistance the IR155 encodes in a 10 or 20 Hz duty cycle, kOhm
+     **/
+    static uint32_t resistance_kohm(uint16_t duty_permille);
+
+private:
+    iEdgeSource* m_edges;
+    Core::iClockStrategy* m_clock;
+    Core::iLockStrategy* m_lock;
+    StatusListener m_listener;
+    void* m_context;
+
+    bool m_have_rise;
+    bool m_have_fall;
+    uint64_t m_last_rise;
+    uint64_t m_last_fall;
+    uint64_t m_last_edge;
+
+    ImdStatus m_candidate;
+    uint8_t m_agreeing;
+    ImdStatus m_status;
+    Statistics m_statistics;
+
+    ImdState classify(uint32_t period_us) const;
+    ImdStatus measure(uint32_t period_us, uint32_t high_us) const;
+    ImdFault fault(ImdState state, uint32_t resistance_kohm, uint16_t duty_permille) const;
+    // Publishes a candidate once it has been seen often enough, lock held
+    bool confirm(const ImdStatus& candidate, uint8_t required);
+    void notify(const ImdStatus& status);
+};
+
+} // namespace IMD
+
+#endif // IMD_IR155_H
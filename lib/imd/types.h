@@ -0,0 +1,54 @@
+#ifndef IMD_TYPES_H
+#define IMD_TYPES_H
+
+#include <stdint.h>
+
+namespace IMD {
+
+// Reported resistance when the IMD measures above its 50 MOhm range.
+static constexpr uint32_t RESISTANCE_INFINITE_KOHM = 50000;
+
+/**
+ * @brief IR155 operating condition, selected by the PWM frequency of the M_HS output
+ **/
+enum class ImdState : uint8_t {
+    UNKNOWN,            /**< No valid PWM measured yet */
+    NO_SIGNAL,          /**< 0 Hz, the output is stuck at a level */
+    NORMAL,             /**< 10 Hz, duty encodes the insulation resistance */
+    UNDERVOLTAGE,       /**< 20 Hz, HV below the configured minimum, duty encodes the insulation resistance */
+    SPEED_START,        /**< 30 Hz, fast good/bad estimate during the first measurement after power on */
+    DEVICE_ERROR,       /**< 40 Hz, IMD self test failed */
+    GROUND_FAULT,       /**< 50 Hz, earth connection (Kl. 31) lost */
+    INVALID,            /**< Frequency or duty outside every band */
+};
+
+/**
+ * @brief Fault category derived from the state and the measured resistance
+ **/
+enum class ImdFault : uint8_t {
+    NONE,
+    PENDING,            /**< Not settled yet, e.g. right after power on */
+    SHORT_TO_SUPPLY,    /**< Output stuck high */
+    OFF_OR_SHORT_TO_GROUND, /**< Output stuck low, IMD unpowered or shorted */
+    INSULATION_LOW,     /**< Resistance below the threshold or a bad speed start */
+    UNDERVOLTAGE,
+    DEVICE_ERROR,
+    GROUND_FAULT,
+    INVALID_SIGNAL,
+};
+
+/**
+ * @brief Decoded IMD output
+ **/
+struct ImdStatus {
+    ImdState state;
+    ImdFault fault;
+    uint32_t resistance_kohm;   /**< Insulation resistance, valid in NORMAL and UNDERVOLTAGE */
+    uint16_t frequency_dhz;     /**< Measured PWM frequency, tenths of a hertz */
+    uint16_t duty_permille;     /**< Measured high time over period */
+    uint64_t timestamp_us;      /**< When the status was last confirmed */
+};
+
+} // namespace IMD
+
+#endif // IMD_TYPES_H
@@ -2,8 +2,14 @@
 #ifndef DTIX50_H
 #define DTIX50_H
 
+#include "DTIX50/capture.h"
 #include "DTIX50/commands.h"
+#include "DTIX50/derating.h"
+#include "DTIX50/drive_enable_monitor.h"
 #include "DTIX50/heartbeat.h"
+#include "DTIX50/identifiers.h"
 #include "DTIX50/messages.h"
+#include "DTIX50/nodes.h"
+#include "DTIX50/telemetry.h"
 
 #endif // DTIX50_H
\ No newline at end of file
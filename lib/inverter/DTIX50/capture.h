@@ -0,0 +1,219 @@
+#ifndef INVERTER_DTIX50_CAPTURE_H
+#define INVERTER_DTIX50_CAPTURE_H
+
+#include <cstdint>
+#include <cstring>
+
+#include "core/core.h"
+#include "can/can.h"
+#include "identifiers.h"
+#include "messages.h"
+#include "telemetry.h"
+
+// Default number of broadcasts a capture holds, must be a power of two.
+#ifndef INVERTER_CAPTURE_DEPTH
+#define INVERTER_CAPTURE_DEPTH 512
+#endif
+
+namespace Inverter {
+namespace DTIX50 {
+
+/**
+ * @brief One inverter broadcast as received
+ * @param timestamp_us: Time the broadcast was recorded
+ * @param packet: Broadcast packet index, 0x1F-0x26
+ * @param data: Payload as sent on the wire
+ **/
+struct CaptureSample {
+    uint64_t timestamp_us;
+    uint8_t packet;
+    uint8_t data[8];
+};
+
+/**
+ * @brief Decides whether a broadcast triggers the capture
+ * @returns true to trigger, false otherwise
+ **/
+typedef bool(*CaptureTrigger)(const CaptureSample& sample, void* context);
+
+/**
+ * @brief Receives the frozen window in order with the state decoded up to each sample
+ **/
+typedef void(*CaptureVisitor)(const CaptureSample& sample, const InverterState& state, void* context);
+
+/**
+ * @returns true if the sample is general data 3 (0x22) with a fault code set, false otherwise
+ **/
+inline bool fault_trigger(const CaptureSample& sample, void*) {
+    if (sample.packet != Packet::GENERAL_DATA_3) {
+        return false;
+    }
+    Message22 message;
+    memcpy(&message, sample.data, sizeof(message));
+    return message.fault_code != FaultCodes::NONE;
+}
+
+/**
+ * @brief Oscilloscope style capture of one inverter's broadcasts
+ *
+ * While armed every broadcast goes into a preallocated ring, a copy and an index increment.
+ * When the trigger fires, pre_trigger samples before it are kept and post_trigger more are
+ * recorded, then the capture freezes until it is re-armed. Samples are stored as received
+ * and only decoded when the frozen window is replayed, so the armed path stays cheap.
+ *
+ * Not synchronized, record from the task that receives the broadcasts and read the window
+ * once frozen.
+ *
+ * @tparam Depth Capacity in samples, a power of two
+ **/
+template<uint32_t Depth = INVERTER_CAPTURE_DEPTH>
+class Capture {
+    static_assert(Depth >= 2 && (Depth & (Depth - 1)) == 0, "Capture depth must be a power of two");
+
+public:
+    enum class State : uint8_t {
+        ARMED,      /**< Recording, waiting for the trigger */
+        TRIGGERED,  /**< Recording the post-trigger window */
+        FROZEN,     /**< Window complete, recording stopped */
+    };
+
+    Capture(Core::iClockStrategy* clock, uint8_t node = DEFAULT_NODE) : m_clock(clock), m_node(node) {
+        m_trigger = fault_trigger;
+        m_context = nullptr;
+        m_pre_trigger = Depth / 2;
+        m_post_trigger = Depth / 2 - 1;
+        m_triggers = 0;
+        arm();
+    }
+
+    /**
+     * @brief Sets the window around the trigger, re-arms the capture
+     * @returns true if the window fits in the capture, false otherwise.
+     **/
+    bool configure(uint32_t pre_trigger, uint32_t post_trigger) {
+        if (pre_trigger + post_trigger + 1 > Depth) {
+            return false;
+        }
+        m_pre_trigger = pre_trigger;
+        m_post_trigger = post_trigger;
+        arm();
+        return true;
+    }
+
+    void set_trigger(CaptureTrigger trigger, void* context) {
+        m_trigger = trigger;
+        m_context = context;
+    }
+
+    // Discards the window and starts recording again.
+    void arm() {
+        m_state = State::ARMED;
+        m_head = 0;
+        m_start = 0;
+        m_trigger_position = 0;
+        m_remaining = 0;
+    }
+
+    /**
+     * @brief Records a frame if it is a broadcast from the captured node
+     * @returns true if the frame was recorded, false otherwise
+     **/
+    bool record(const CAN::Frame& frame) {
+        if (m_state == State::FROZEN || frame.identifier >> (NODE_BITS + 8) != 0 ||
+            node_of(frame.identifier) != m_node || !is_broadcast(packet_of(frame.identifier))) {
+            return false;
+        }
+
+        CaptureSample& sample = m_samples[m_head & (Depth - 1)];
+        sample.timestamp_us = m_clock->micros();
+        sample.packet = packet_of(frame.identifier);
+        memcpy(sample.data, frame.data, sizeof(sample.data));
+        m_head++;
+
+        if (m_state == State::ARMED) {
+            if (m_trigger != nullptr && m_trigger(sample, m_context)) {
+                begin_post_trigger();
+            }
+        } else if (--m_remaining == 0) {
+            m_state = State::FROZEN;
+        }
+        return true;
+    }
+
+    // Fires the trigger on the latest sample, e.g. from an external fault line.
+    void trigger() {
+        if (m_state == State::ARMED && m_head != 0) {
+            begin_post_trigger();
+        }
+    }
+
+    State state() const { return m_state; }
+
+    // Triggers since construction.
+    uint32_t triggers() const { return m_triggers; }
+
+    // Samples in the window so far, all of them once frozen.
+    uint32_t size() const {
+        return m_state == State::ARMED ? 0 : m_head - m_start;
+    }
+
+    // Index of the triggering sample in the window.
+    uint32_t trigger_index() const { return m_trigger_position - m_start; }
+
+    // Sample of the window in chronological order, index below size().
+    const CaptureSample& sample(uint32_t index) const {
+        return m_samples[(m_start + index) & (Depth - 1)];
+    }
+
+    /**
+     * @brief Decodes the window in order, the state carries over between samples
+     *          Broadcasts older than the window are not part of the state.
+     * @returns The number of samples visited
+     **/
+    uint32_t replay(CaptureVisitor visitor, void* context) const {
+        InverterState state = {};
+        uint32_t count = size();
+        for (uint32_t i = 0; i < count; i++) {
+            const CaptureSample& s = sample(i);
+            CAN::Frame frame;
+            frame.identifier = identifier(s.packet, m_node);
+            frame.extd = 1;
+            frame.data_length_code = 8;
+            memcpy(frame.data, s.data, sizeof(s.data));
+            decode(frame, state);
+            visitor(s, state, context);
+        }
+        return count;
+    }
+
+private:
+    CaptureSample m_samples[Depth];
+    Core::iClockStrategy* m_clock;
+    uint8_t m_node;
+    CaptureTrigger m_trigger;
+    void* m_context;
+
+    State m_state;
+    uint32_t m_pre_trigger;
+    uint32_t m_post_trigger;
+    // Positions count every sample ever recorded since arming, the ring index is the low bits
+    uint32_t m_head;
+    uint32_t m_start;
+    uint32_t m_trigger_position;
+    uint32_t m_remaining;
+    uint32_t m_triggers;
+
+    void begin_post_trigger() {
+        m_triggers++;
+        m_trigger_position = m_head - 1;
+        uint32_t before = m_trigger_position < m_pre_trigger ? m_trigger_position : m_pre_trigger;
+        m_start = m_trigger_position - before;
+        m_remaining = m_post_trigger;
+        m_state = m_remaining == 0 ? State::FROZEN : State::TRIGGERED;
+    }
+};
+
+} // namespace DTIX50
+} // namespace Inverter
+
+#endif // INVERTER_DTIX50_CAPTURE_H
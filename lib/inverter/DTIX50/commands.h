@@ -3,10 +3,18 @@
 
 #include <cstdint>
 
+#include "core/core.h"
+
 // Derived from
 // https://zapdrive.eu/docs/assets/common/can_docs/v25/DTI%20CAN%20manual%20V2.5.pdf
 
 namespace Inverter {
+
+// Wire units of the DTI commands, the "multiply by 10 before sending" is carried by the type
+typedef Core::Fixed<int16_t, 10> DeciAmps;
+typedef Core::Fixed<int16_t, 10> DeciPercent;
+typedef Core::Fixed<int16_t, 10> DeciDegrees;
+
 namespace Command {
 
 /**
@@ -22,7 +30,7 @@ namespace Command {
  * @param reserved: Not relevant to the command. Fill with FFs or use 2-byte DLC
  **/
 struct SetACCurrent {
-    uint64_t ac_current : 16;
+    DeciAmps ac_current;
     uint64_t reserved : 48;
 };
 
@@ -35,7 +43,7 @@ struct SetACCurrent {
  * @param reserved: Not relevant to the command. Fill with FFs or use 2-byte DLC. 
  **/
 struct SetBrakeCurrent {
-    uint64_t brake_current : 16;
+    DeciAmps brake_current;
     uint64_t reserved : 48;
 };
 
@@ -62,7 +70,7 @@ struct SetSpeed {
  * @param reserved: Not relevant to the command. Fill with FFs or use 2-byte DLC. 
  **/
 struct SetPosition {
-    uint64_t position : 16;
+    DeciDegrees position;
     uint64_t reserved : 48;
 };
 
@@ -79,7 +87,7 @@ struct SetPosition {
  * @param unused: Not relevant to the command. Fill with FFs or use 2-byte DLC. 
  **/
 struct SetRelativeACCurrent {
-    uint64_t relative_ac_current : 16;
+    DeciPercent relative_ac_current;
     uint64_t reserved : 48;
 };
 
@@ -95,7 +103,7 @@ struct SetRelativeACCurrent {
  * @param reserved: Not relevant to the command. Fill with FFs or use 2-byte DLC. 
  **/
 struct SetRelativeBrakeCurrent {
-    uint64_t relative_brake_current : 16;
+    DeciPercent relative_brake_current;
     uint64_t reserved : 48;
 };
 
@@ -124,7 +132,7 @@ struct SetDigitalOutput {
  * @param reserved: Not relevant to the command. Fill with FFs or use 2-byte DLC. 
  **/
 struct SetMaxACCurrent {
-    uint64_t max_ac_current : 16;
+    DeciAmps max_ac_current;
     uint64_t reserved : 48;
 };
 
@@ -137,7 +145,7 @@ struct SetMaxACCurrent {
  * @param reserved: Not relevant to the command. Fill with FFs or use 2-byte DLC. 
  **/
 struct SetMaxBrakeCurrent {
-    uint64_t max_brake_current : 16;
+    DeciAmps max_brake_current;
     uint64_t reserved : 48;
 };
 
@@ -150,7 +158,7 @@ struct SetMaxBrakeCurrent {
  * @param reserved: Not relevant to the command. Fill with FFs or use 2-byte DLC. 
  **/
 struct SetMaxDCCurrent {
-    uint64_t max_dc_current : 16;
+    DeciAmps max_dc_current;
     uint64_t reserved : 48;
 };
 
@@ -165,7 +173,7 @@ struct SetMaxDCCurrent {
  * @param reserved: Not relevant to the command. Fill with FFs or use 2-byte DLC. 
  **/
 struct SetMaxBrakeDCCurrent {
-    uint64_t max_brake_dc_current : 16;
+    DeciAmps max_brake_dc_current;
     uint64_t reserved : 48;
 };
 
@@ -182,6 +190,10 @@ struct SetDriveEnable {
     uint64_t reserved : 56;
 };
 
+// The typed fields share the first 16 bits with the reserved bit-field, as on the wire
+static_assert(sizeof(SetACCurrent) == 8, "SetACCurrent must stay one CAN payload");
+static_assert(sizeof(SetMaxBrakeDCCurrent) == 8, "SetMaxBrakeDCCurrent must stay one CAN payload");
+
 }; // Command
 }; // Inverter
 
@@ -0,0 +1,167 @@
+#include "derating.h"
+
+#include <cstring>
+
+namespace Inverter {
+namespace DTIX50 {
+
+constexpr uint16_t Derating::NO_LIMIT;
+
+// Orion limits are whole amps
+static constexpr uint16_t DA_PER_A = 10;
+
+Derating::Derating(std::shared_ptr<CAN::Provider> provider, const Config& config, uint8_t node) {
+    m_provider = provider;
+    m_config = config;
+    m_discharge_identifier = identifier(Packet::SET_MAX_DC_CURRENT, node);
+    m_charge_identifier = identifier(Packet::SET_MAX_BRAKE_DC_CURRENT, node);
+    m_temperature_identifier = identifier(Packet::GENERAL_DATA_3, node);
+
+    for (uint32_t i = 0; i < SOURCES; i++) {
+        m_bms_discharge_da[i] = NO_LIMIT;
+        m_bms_charge_da[i] = NO_LIMIT;
+    }
+    m_controller_temp = INT16_MIN;
+    m_motor_temp = INT16_MIN;
+
+    // Nothing has been sent, so the first computation goes out
+    m_sent = { NO_LIMIT, NO_LIMIT };
+    m_limits = { 0, 0 };
+    m_discharge_pending = false;
+    m_charge_pending = false;
+    m_statistics = {};
+
+    // Computed now, sent with the first input or flush()
+    recompute();
+    m_statistics.recomputes = 0;
+}
+
+void Derating::set_config(const Config& config) {
+    m_config = config;
+    recompute();
+    flush();
+}
+
+uint16_t Derating::factor(int16_t temperature, int16_t start, int16_t end) {
+    if (temperature <= start || end <= start) return 1000;
+    if (temperature >= end) return 0;
+    return (uint16_t)((int32_t)(end - temperature) * 1000 / (end - start));
+}
+
+uint16_t Derating::temperature_factor() const {
+    uint16_t controller = factor(m_controller_temp, m_config.controller_start, m_config.controller_end);
+    uint16_t motor = factor(m_motor_temp, m_config.motor_start, m_config.motor_end);
+    return controller < motor ? controller : motor;
+}
+
+void Derating::recompute() {
+    uint16_t discharge = m_config.max_discharge_da;
+    uint16_t charge = m_config.max_charge_da;
+    for (uint32_t i = 0; i < SOURCES; i++) {
+        if (m_bms_discharge_da[i] < discharge) discharge = m_bms_discharge_da[i];
+        if (m_bms_charge_da[i] < charge) charge = m_bms_charge_da[i];
+    }
+
+    uint32_t scale = temperature_factor();
+    discharge = (uint16_t)(discharge * scale / 1000);
+    charge = (uint16_t)(charge * scale / 1000);
+    if (m_config.resolution_da > 1) {
+        discharge -= discharge % m_config.resolution_da;
+        charge -= charge % m_config.resolution_da;
+    }
+
+    m_limits = { discharge, charge };
+    m_discharge_pending = m_limits.discharge_da != m_sent.discharge_da;
+    m_charge_pending = m_limits.charge_da != m_sent.charge_da;
+    m_statistics.recomputes++;
+}
+
+bool Derating::flush() {
+    if (m_discharge_pending) {
+        Command::SetMaxDCCurrent command = { DeciAmps::from_raw(m_limits.discharge_da), 0xFFFFFFFFFFFF };
+        CAN::Frame frame(m_discharge_identifier, &command);
+        frame.extd = 1;
+        if (m_provider->transmit(frame, 0)) {
+            m_sent.discharge_da = m_limits.discharge_da;
+            m_discharge_pending = false;
+            m_statistics.sent++;
+        } else {
+            m_statistics.transmit_failures++;
+        }
+    }
+
+    if (m_charge_pending) {
+        // The inverter only accepts negative brake currents
+        Command::SetMaxBrakeDCCurrent command = { -DeciAmps::from_raw(m_limits.charge_da), 0xFFFFFFFFFFFF };
+        CAN::Frame frame(m_charge_identifier, &command);
+        frame.extd = 1;
+        if (m_provider->transmit(frame, 0)) {
+            m_sent.charge_da = m_limits.charge_da;
+            m_charge_pending = false;
+            m_statistics.sent++;
+        } else {
+            m_statistics.transmit_failures++;
+        }
+    }
+
+    return !m_discharge_pending && !m_charge_pending;
+}
+
+void Derating::set_bms(Source source, uint16_t discharge_da, uint16_t charge_da) {
+    if (m_bms_discharge_da[source] == discharge_da && m_bms_charge_da[source] == charge_da) {
+        m_statistics.unchanged++;
+        flush();
+        return;
+    }
+    m_bms_discharge_da[source] = discharge_da;
+    m_bms_charge_da[source] = charge_da;
+    recompute();
+    flush();
+}
+
+void Derating::update(const Message6& message) {
+    set_bms(MESSAGE6, (uint16_t)(message.packDCL * DA_PER_A), (uint16_t)(message.packCCL * DA_PER_A));
+}
+
+void Derating::update(const Message202& message) {
+    set_bms(MESSAGE202, (uint16_t)(message.packDCL * DA_PER_A), (uint16_t)(message.packCCL * DA_PER_A));
+}
+
+void Derating::update(const Message351& message) {
+    // Only carries the discharge limit
+    set_bms(MESSAGE351, (uint16_t)(message.packDCL * DA_PER_A), NO_LIMIT);
+}
+
+void Derating::update(const Message22& message) {
+    int16_t controller = (int16_t)(uint16_t)message.controller_temp;
+    int16_t motor = (int16_t)(uint16_t)message.motor_temp;
+    if (controller == m_controller_temp && motor == m_motor_temp) {
+        m_statistics.unchanged++;
+        flush();
+        return;
+    }
+    m_controller_temp = controller;
+    m_motor_temp = motor;
+    recompute();
+    flush();
+}
+
+bool Derating::dispatch(const CAN::Frame& frame) {
+    if (frame.extd) {
+        if (frame.identifier != m_temperature_identifier) return false;
+        Message22 message;
+        memcpy(&message, frame.data, sizeof(message));
+        update(message);
+        return true;
+    }
+
+    switch (frame.identifier) {
+        case 0x006: { Message6 message; memcpy(&message, frame.data, 8); update(message); return true; }
+        case 0x202: { Message202 message; memcpy(&message, frame.data, 8); update(message); return true; }
+        case 0x351: { Message351 message; memcpy(&message, frame.data, 8); update(message); return true; }
+        default: return false;
+    }
+}
+
+} // namespace DTIX50
+} // namespace Inverter
@@ -0,0 +1,122 @@
+#ifndef INVERTER_DTIX50_DERATING_H
+#define INVERTER_DTIX50_DERATING_H
+
+#include <memory>
+#include <stdint.h>
+
+#include "can/can.h"
+#include "battery/messages.h"
+#include "commands.h"
+#include "identifiers.h"
+#include "messages.h"
+
+namespace Inverter {
+namespace DTIX50 {
+
+/**
+ * @brief Event-driven DC current derating from BMS limits and inverter temperatures
+ *
+ * Merges the discharge and charge limits the Orion BMS broadcasts (Message6, Message202 and
+ * Message351), a linear temperature derating from the inverter's own Message22 and the
+ * configured caps. Limits are only recomputed when an input value changes, and only sent
+ * when the result differs from what the inverter last accepted, so a DCL drop goes out on
+ * the frame that carries it while steady state adds no bus traffic.
+ *
+ * Outputs go to SetMaxDCCurrent (0x0A) and SetMaxBrakeDCCurrent (0x0B) without waiting for
+ * the driver, a refused command is retried on the next input or flush().
+ *
+ * Not synchronized, feed it from the task that receives the broadcasts.
+ **/
+class Derating {
+public:
+    /**
+     * @param max_discharge_da: Discharge cap, 0.1 A
+     * @param max_charge_da: Charge cap, 0.1 A
+     * @param controller_start/end: Controller temperature range over which limits fall to zero, 0.1 degrees C
+     * @param motor_start/end: Motor temperature range over which limits fall to zero, 0.1 degrees C
+     * @param resolution_da: Limits are rounded down to this step so small temperature changes do not cause traffic
+     **/
+    struct Config {
+        uint16_t max_discharge_da;
+        uint16_t max_charge_da;
+        int16_t controller_start;
+        int16_t controller_end;
+        int16_t motor_start;
+        int16_t motor_end;
+        uint16_t resolution_da;
+    };
+
+    /**
+     * @brief DC current limits, 0.1 A, both positive
+     **/
+    struct Limits {
+        uint16_t discharge_da;
+        uint16_t charge_da;
+    };
+
+    struct Statistics {
+        uint32_t recomputes;            /**< Inputs that changed and caused a recompute */
+        uint32_t unchanged;             /**< Inputs equal to the previous value, ignored */
+        uint32_t sent;                  /**< Limit commands accepted by the driver */
+        uint32_t transmit_failures;     /**< Limit commands refused by the driver */
+    };
+
+    Derating(std::shared_ptr<CAN::Provider> provider, const Config& config, uint8_t node = DEFAULT_NODE);
+
+    void set_config(const Config& config);
+
+    /**
+     * @brief Feeds a received frame to the engine
+     * @returns true if the frame was one of the inputs, false otherwise
+     **/
+    bool dispatch(const CAN::Frame& frame);
+
+    void update(const Message6& message);
+    void update(const Message202& message);
+    void update(const Message351& message);
+    void update(const Message22& message);
+
+    /**
+     * @brief Sends limits the driver refused earlier
+     * @returns true if the inverter is up to date, false otherwise
+     **/
+    bool flush();
+
+    // Latest computed limits.
+    Limits limits() const { return m_limits; }
+    // Temperature derating factor, 1000 is no derating.
+    uint16_t temperature_factor() const;
+
+    Statistics statistics() const { return m_statistics; }
+
+private:
+    // Index of each BMS source in the limit tables
+    enum Source : uint8_t { MESSAGE6, MESSAGE202, MESSAGE351, SOURCES };
+    static constexpr uint16_t NO_LIMIT = 0xFFFF;
+
+    std::shared_ptr<CAN::Provider> m_provider;
+    Config m_config;
+    uint32_t m_discharge_identifier;
+    uint32_t m_charge_identifier;
+    uint32_t m_temperature_identifier;
+
+    uint16_t m_bms_discharge_da[SOURCES];
+    uint16_t m_bms_charge_da[SOURCES];
+    int16_t m_controller_temp;
+    int16_t m_motor_temp;
+
+    Limits m_limits;
+    Limits m_sent;
+    bool m_discharge_pending;
+    bool m_charge_pending;
+    Statistics m_statistics;
+
+    void set_bms(Source source, uint16_t discharge_da, uint16_t charge_da);
+    void recompute();
+    static uint16_t factor(int16_t temperature, int16_t start, int16_t end);
+};
+
+} // namespace DTIX50
+} // namespace Inverter
+
+#endif // INVERTER_DTIX50_DERATING_H
@@ -0,0 +1,153 @@
+#include "drive_enable_monitor.h"
+
+namespace Inverter {
+namespace DTIX50 {
+
+DriveEnableMonitor::DriveEnableMonitor(Core::iClockStrategy* clock, Core::iLockStrategy* lock) {
+    m_clock = clock;
+    m_lock = lock;
+    m_listener = nullptr;
+    m_context = nullptr;
+
+    m_pending = false;
+    m_expected = false;
+    m_missed_reported = false;
+    m_sent_at = 0;
+    m_enabled = false;
+    m_statistics = {};
+}
+
+void DriveEnableMonitor::set_listener(AcknowledgeListener listener, void* context) {
+    Core::LockGuard guard(m_lock);
+    m_listener = listener;
+    m_context = context;
+}
+
+void DriveEnableMonitor::notify(AcknowledgeEvent event, uint32_t elapsed) {
+    AcknowledgeListener listener;
+    void* context;
+    {
+        Core::LockGuard guard(m_lock);
+        listener = m_listener;
+        context = m_context;
+    }
+    if (listener) {
+        listener(event, elapsed, context);
+    }
+}
+
+bool DriveEnableMonitor::check_deadline(uint64_t now, AcknowledgeEvent& event, uint32_t& elapsed) {
+    if (!m_pending || m_missed_reported || now - m_sent_at < deadline_us) {
+        return false;
+    }
+    m_missed_reported = true;
+    m_statistics.missed++;
+    event = AcknowledgeEvent::MISSED_DEADLINE;
+    elapsed = (uint32_t)(now - m_sent_at);
+    return true;
+}
+
+void DriveEnableMonitor::sent(bool enable, bool accepted) {
+    if (m_clock == nullptr) return;
+
+    uint64_t now = m_clock->micros();
+    bool missed = false;
+    AcknowledgeEvent event = AcknowledgeEvent::MISSED_DEADLINE;
+    uint32_t elapsed = 0;
+    {
+        Core::LockGuard guard(m_lock);
+        missed = check_deadline(now, event, elapsed);
+
+        if (!accepted) {
+            m_statistics.transmit_failures++;
+        } else {
+            m_statistics.sent++;
+            // Keep the first send of a state so the latency covers every heartbeat the inverter missed
+            if (!m_pending || m_expected != enable) {
+                m_pending = true;
+                m_expected = enable;
+                m_missed_reported = false;
+                m_sent_at = now;
+            }
+        }
+    }
+
+    if (missed) {
+        notify(event, elapsed);
+    }
+    if (!accepted) {
+        notify(AcknowledgeEvent::TRANSMIT_FAILED, 0);
+    }
+}
+
+bool DriveEnableMonitor::acknowledge(const Message24& message) {
+    if (m_clock == nullptr) return false;
+
+    uint64_t now = m_clock->micros();
+    bool reported = message.drive_enable != 0;
+    bool acknowledged = false;
+    bool missed = false;
+    bool refused = false;
+    AcknowledgeEvent event = AcknowledgeEvent::MISSED_DEADLINE;
+    uint32_t elapsed = 0;
+    {
+        Core::LockGuard guard(m_lock);
+        m_enabled = reported;
+
+        if (m_pending && reported == m_expected) {
+            m_latency.record((uint32_t)(now - m_sent_at));
+            m_statistics.acknowledged++;
+            m_pending = false;
+            acknowledged = true;
+        } else {
+            missed = check_deadline(now, event, elapsed);
+            if (m_pending && m_expected && message.drive_enable_limit) {
+                m_statistics.refused++;
+                refused = true;
+                elapsed = (uint32_t)(now - m_sent_at);
+            }
+        }
+    }
+
+    if (missed) {
+        notify(event, elapsed);
+    }
+    if (refused) {
+        notify(AcknowledgeEvent::REFUSED, elapsed);
+    }
+    return acknowledged;
+}
+
+void DriveEnableMonitor::poll() {
+    if (m_clock == nullptr) return;
+
+    uint64_t now = m_clock->micros();
+    bool missed;
+    AcknowledgeEvent event = AcknowledgeEvent::MISSED_DEADLINE;
+    uint32_t elapsed = 0;
+    {
+        Core::LockGuard guard(m_lock);
+        missed = check_deadline(now, event, elapsed);
+    }
+    if (missed) {
+        notify(event, elapsed);
+    }
+}
+
+bool DriveEnableMonitor::pending() {
+    Core::LockGuard guard(m_lock);
+    return m_pending;
+}
+
+bool DriveEnableMonitor::enabled() {
+    Core::LockGuard guard(m_lock);
+    return m_enabled;
+}
+
+DriveEnableMonitor::Statistics DriveEnableMonitor::statistics() {
+    Core::LockGuard guard(m_lock);
+    return m_statistics;
+}
+
+} // namespace DTIX50
+} // namespace Inverter
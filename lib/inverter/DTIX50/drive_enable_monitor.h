@@ -0,0 +1,104 @@
+#ifndef INVERTER_DTIX50_DRIVE_ENABLE_MONITOR_H
+#define INVERTER_DTIX50_DRIVE_ENABLE_MONITOR_H
+
+#include <stdint.h>
+
+#include "core/core.h"
+#include "messages.h"
+
+namespace Inverter {
+namespace DTIX50 {
+
+enum class AcknowledgeEvent : uint8_t {
+    MISSED_DEADLINE,    /**< No matching drive_enable report within the deadline */
+    REFUSED,            /**< Enable requested but the inverter reports its drive enable limit active */
+    TRANSMIT_FAILED,    /**< The driver did not accept the command */
+};
+
+/**
+ * @brief Receives acknowledgement problems, called without the monitor's lock held
+ * @param elapsed_us: Time since the unacknowledged command was first sent
+ **/
+typedef void(*AcknowledgeListener)(AcknowledgeEvent event, uint32_t elapsed_us, void* context);
+
+/**
+ * @brief Correlates drive enable commands with the drive_enable state the inverter reports
+ *
+ * A command is pending from the first send until a general data 5 broadcast (0x24) reports
+ * the requested state, the time in between is the round-trip latency. Repeated heartbeats
+ * for an unacknowledged state keep the first send time. Deadlines are checked whenever a
+ * command is sent, a broadcast arrives or poll() is called, and reported once per command.
+ * A late acknowledgement is still recorded so the histogram shows the full tail.
+ **/
+class DriveEnableMonitor {
+public:
+    struct Statistics {
+        uint32_t sent;                  /**< Commands accepted by the driver */
+        uint32_t acknowledged;          /**< Pending commands matched by a report */
+        uint32_t missed;                /**< Commands that missed the deadline */
+        uint32_t refused;               /**< Reports with the drive enable limit active while enabling */
+        uint32_t transmit_failures;     /**< Commands the driver did not accept */
+    };
+
+    typedef Core::Log2Histogram<24> Histogram;
+
+    // Longest accepted time from sending a command to the matching report, in microseconds.
+    uint32_t deadline_us = 100000;
+
+    /**
+     * @param clock Time source, nullptr disables monitoring
+     * @param lock Lock shared by the sending and receiving tasks, can be nullptr
+     **/
+    explicit DriveEnableMonitor(Core::iClockStrategy* clock = nullptr, Core::iLockStrategy* lock = nullptr);
+
+    void set_listener(AcknowledgeListener listener, void* context);
+
+    /**
+     * @brief Records a drive enable command handed to the driver
+     * @param enable true for drive enable, false for drive disable
+     * @param accepted The result of the transmit
+     **/
+    void sent(bool enable, bool accepted);
+
+    /**
+     * @brief Matches a general data 5 broadcast against the pending command
+     * @returns true if the broadcast acknowledged the pending command, false otherwise
+     **/
+    bool acknowledge(const Message24& message);
+
+    // Checks the deadline of the pending command.
+    void poll();
+
+    bool pending();
+    // Last drive_enable state reported by the inverter.
+    bool enabled();
+
+    // Written by the monitored tasks, read it once they are stopped.
+    const Histogram& latency() const { return m_latency; }
+
+    Statistics statistics();
+
+private:
+    Core::iClockStrategy* m_clock;
+    Core::iLockStrategy* m_lock;
+    AcknowledgeListener m_listener;
+    void* m_context;
+
+    bool m_pending;
+    bool m_expected;
+    bool m_missed_reported;
+    uint64_t m_sent_at;
+    bool m_enabled;
+
+    Statistics m_statistics;
+    Histogram m_latency;
+
+    // Sets event and elapsed if the pending command just missed its deadline, lock held
+    bool check_deadline(uint64_t now, AcknowledgeEvent& event, uint32_t& elapsed);
+    void notify(AcknowledgeEvent event, uint32_t elapsed);
+};
+
+} // namespace DTIX50
+} // namespace Inverter
+
+#endif // INVERTER_DTIX50_DRIVE_ENABLE_MONITOR_H
@@ -1,14 +1,22 @@
 #include "heartbeat.h"
 
+#include <cstring>
+
 using namespace CAN;
 
 namespace Inverter {
 namespace DTIX50 {
 
-Heartbeat::Heartbeat(std::shared_ptr<Provider> canProvider, std::unique_ptr<Core::iLockStrategy> lock_strategy, std::unique_ptr<Core::iThreadStrategy> thread_strategy) {
+Heartbeat::Heartbeat(std::shared_ptr<Provider> canProvider, std::unique_ptr<Core::iLockStrategy> lock_strategy, std::unique_ptr<Core::iThreadStrategy> thread_strategy, uint8_t node)
+    : Heartbeat(canProvider, std::move(lock_strategy), std::move(thread_strategy), node, nullptr) {}
+
+Heartbeat::Heartbeat(std::shared_ptr<Provider> canProvider, std::unique_ptr<Core::iLockStrategy> lock_strategy, std::unique_ptr<Core::iThreadStrategy> thread_strategy, uint8_t node, Core::iClockStrategy* clock) {
     m_canProvider = canProvider;
+    m_identifier = identifier(Packet::SET_DRIVE_ENABLE, node);
+    m_status_identifier = identifier(Packet::GENERAL_DATA_5, node);
     m_shouldStop_mut = std::move(lock_strategy);
     m_thread = std::move(thread_strategy);
+    m_monitor = DriveEnableMonitor(clock, m_shouldStop_mut.get());
 
     m_shouldStop = false;
     m_started = false;
@@ -44,6 +52,15 @@ void Heartbeat::stop() {
     m_started = false;
 }
 
+bool Heartbeat::acknowledge(const Frame& frame) {
+    if (frame.identifier != m_status_identifier) {
+        return false;
+    }
+    Message24 message;
+    memcpy(&message, frame.data, sizeof(message));
+    return m_monitor.acknowledge(message);
+}
+
 // Sends a drive enable every ~250 milliseconds so the car doesn't stop
 void Heartbeat::heartbeat(void* s) {
     Heartbeat* self = (Heartbeat*)s;
@@ -56,17 +73,19 @@ void Heartbeat::heartbeat(void* s) {
         {
             self->m_shouldStop_mut->unlock();
             // Send drive disable
-            Frame frame(0x0C52, &self->disable);
-            self->m_canProvider->transmit(frame, 1000);
+            Frame frame(self->m_identifier, &self->disable);
+            frame.extd = 1;
+            self->m_monitor.sent(false, self->m_canProvider->transmit(frame, 1000));
             return;
         }
         self->m_shouldStop_mut->unlock();
         
         // Send drive enable
-        Frame frame(0x0C52, &self->enable);
-        
-        self->m_canProvider->transmit(frame, 1000);
-        
+        Frame frame(self->m_identifier, &self->enable);
+        frame.extd = 1;
+
+        self->m_monitor.sent(true, self->m_canProvider->transmit(frame, 1000));
+
         self->m_thread->sleep(250U);
     }
 }
@@ -6,6 +6,8 @@
 #include "core/core.h"
 #include "can/can.h"
 #include "commands.h"
+#include "drive_enable_monitor.h"
+#include "identifiers.h"
 #include "messages.h"
 
 using namespace CAN;
@@ -20,16 +22,31 @@ private:
     std::unique_ptr<Core::iLockStrategy> m_shouldStop_mut;
     std::unique_ptr<Core::iThreadStrategy> m_thread;
     std::shared_ptr<Provider> m_canProvider;
+    uint32_t m_identifier;
+    uint32_t m_status_identifier;
+    DriveEnableMonitor m_monitor;
 
     Command::SetDriveEnable enable;
     Command::SetDriveEnable disable;
 public:
-    Heartbeat(std::shared_ptr<Provider> canProvider, std::unique_ptr<Core::iLockStrategy> lock_strategy, std::unique_ptr<Core::iThreadStrategy> thread_strategy);
+    Heartbeat(std::shared_ptr<Provider> canProvider, std::unique_ptr<Core::iLockStrategy> lock_strategy, std::unique_ptr<Core::iThreadStrategy> thread_strategy, uint8_t node = DEFAULT_NODE);
+    /**
+     * @param clock Time source for the acknowledgement monitor, see DriveEnableMonitor
+     **/
+    Heartbeat(std::shared_ptr<Provider> canProvider, std::unique_ptr<Core::iLockStrategy> lock_strategy, std::unique_ptr<Core::iThreadStrategy> thread_strategy, uint8_t node, Core::iClockStrategy* clock);
 
     void start();
     void stop();
 
     bool started() { return m_started; }
+
+    /**
+     * @brief Feeds a received frame to the acknowledgement monitor
+     * @returns true if the frame is this node's general data 5 and acknowledged the pending command, false otherwise
+     **/
+    bool acknowledge(const Frame& frame);
+
+    DriveEnableMonitor& monitor() { return m_monitor; }
 private:
     static void heartbeat(void* s);
 };
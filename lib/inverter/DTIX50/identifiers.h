@@ -0,0 +1,73 @@
+#ifndef INVERTER_DTIX50_IDENTIFIERS_H
+#define INVERTER_DTIX50_IDENTIFIERS_H
+
+#include <cstdint>
+
+// Derived from
+// https://zapdrive.eu/docs/assets/common/can_docs/v25/DTI%20CAN%20manual%20V2.5.pdf
+
+namespace Inverter {
+namespace DTIX50 {
+
+/**
+ * Packet indexes, the upper part of every DTI CAN2 identifier.
+ * Commands are sent to the inverter, general data is broadcast by it.
+ **/
+namespace Packet {
+    constexpr uint8_t SET_AC_CURRENT = 0x01;
+    constexpr uint8_t SET_BRAKE_CURRENT = 0x02;
+    constexpr uint8_t SET_SPEED = 0x03;
+    constexpr uint8_t SET_POSITION = 0x04;
+    constexpr uint8_t SET_RELATIVE_AC_CURRENT = 0x05;
+    constexpr uint8_t SET_RELATIVE_BRAKE_CURRENT = 0x06;
+    constexpr uint8_t SET_DIGITAL_OUTPUT = 0x07;
+    constexpr uint8_t SET_MAX_AC_CURRENT = 0x08;
+    constexpr uint8_t SET_MAX_BRAKE_CURRENT = 0x09;
+    constexpr uint8_t SET_MAX_DC_CURRENT = 0x0A;
+    constexpr uint8_t SET_MAX_BRAKE_DC_CURRENT = 0x0B;
+    constexpr uint8_t SET_DRIVE_ENABLE = 0x0C;
+
+    constexpr uint8_t GENERAL_DATA_6 = 0x1F;
+    constexpr uint8_t GENERAL_DATA_1 = 0x20;
+    constexpr uint8_t GENERAL_DATA_2 = 0x21;
+    constexpr uint8_t GENERAL_DATA_3 = 0x22;
+    constexpr uint8_t GENERAL_DATA_4 = 0x23;
+    constexpr uint8_t GENERAL_DATA_5 = 0x24;
+    constexpr uint8_t AC_CURRENT_LIMITS = 0x25;
+    constexpr uint8_t DC_CURRENT_LIMITS = 0x26;
+
+    // Range of packets the inverter broadcasts
+    constexpr uint8_t FIRST_BROADCAST = GENERAL_DATA_6;
+    constexpr uint8_t LAST_BROADCAST = DC_CURRENT_LIMITS;
+    constexpr uint8_t BROADCAST_COUNT = LAST_BROADCAST - FIRST_BROADCAST + 1;
+}
+
+// Node id configured on the inverter with the DTI CAN tool
+constexpr uint8_t DEFAULT_NODE = 0x52;
+
+// Width of the node id field below the packet index
+constexpr uint32_t NODE_BITS = 8;
+
+/**
+ * @returns The extended CAN identifier of a packet for a node, e.g. (0x0C, 0x52) -> 0x0C52
+ **/
+constexpr uint32_t identifier(uint8_t packet, uint8_t node) {
+    return ((uint32_t)packet << NODE_BITS) | node;
+}
+
+constexpr uint8_t packet_of(uint32_t identifier) {
+    return (uint8_t)(identifier >> NODE_BITS);
+}
+
+constexpr uint8_t node_of(uint32_t identifier) {
+    return (uint8_t)(identifier & ((1U << NODE_BITS) - 1));
+}
+
+constexpr bool is_broadcast(uint8_t packet) {
+    return packet >= Packet::FIRST_BROADCAST && packet <= Packet::LAST_BROADCAST;
+}
+
+} // namespace DTIX50
+} // namespace Inverter
+
+#endif // INVERTER_DTIX50_IDENTIFIERS_H
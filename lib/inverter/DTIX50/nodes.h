@@ -0,0 +1,198 @@
+#ifndef INVERTER_DTIX50_NODES_H
+#define INVERTER_DTIX50_NODES_H
+
+#include <cstdint>
+#include <cstring>
+
+#include "can/can.h"
+#include "identifiers.h"
+#include "messages.h"
+
+namespace Inverter {
+namespace DTIX50 {
+
+/**
+ * @brief Latest broadcasts received from one inverter node, as sent on the wire
+ * @param received: Bit (packet - 0x1F) is set once that packet has been received
+ * @param updates: Number of broadcasts received from the node
+ **/
+struct NodeTelemetry {
+    Message1F general6;
+    Message20 general1;
+    Message21 general2;
+    Message22 general3;
+    Message23 general4;
+    Message24 general5;
+    Message25 ac_limits;
+    Message26 dc_limits;
+    uint8_t received;
+    uint32_t updates;
+};
+
+namespace detail {
+
+constexpr bool nodes_unique(const uint8_t* nodes, uint32_t count, uint32_t i, uint32_t j) {
+    return i >= count ? true
+         : j >= count ? nodes_unique(nodes, count, i + 1, i + 2)
+         : nodes[i] == nodes[j] ? false
+         : nodes_unique(nodes, count, i, j + 1);
+}
+
+} // namespace detail
+
+/**
+ * @brief Command and telemetry layer for a fixed set of inverter nodes
+ *
+ * Identifiers for every node are computed at compile time. Commands go out to all nodes as
+ * one batch, and broadcasts 0x1F-0x26 are demultiplexed into per-node telemetry through a
+ * node lookup table, so dispatch is O(1) per frame and commands are O(N) per batch.
+ *
+ * @tparam Nodes Node ids in the order used for per-node commands and telemetry indexes
+ **/
+template<uint8_t... Nodes>
+class NodeGroup {
+public:
+    static constexpr uint32_t COUNT = sizeof...(Nodes);
+    static constexpr uint8_t NODES[COUNT] = { Nodes... };
+
+    static_assert(COUNT > 0, "A node group needs at least one node");
+    static_assert(detail::nodes_unique(NODES, COUNT, 0, 1), "Node ids must be unique");
+
+    /**
+     * @returns The identifier of a packet for the node at an index, usable in constant expressions
+     **/
+    static constexpr uint32_t identifier(uint8_t packet, uint32_t index) {
+        return DTIX50::identifier(packet, NODES[index]);
+    }
+
+    NodeGroup() {
+        memset(m_index, NO_NODE, sizeof(m_index));
+        memset(m_telemetry, 0, sizeof(m_telemetry));
+        for (uint32_t i = 0; i < COUNT; i++) {
+            m_index[NODES[i]] = (uint8_t)i;
+        }
+    }
+
+    /**
+     * @brief Builds the same command for every node
+     * @param packet Command packet index, e.g. Packet::SET_DRIVE_ENABLE
+     **/
+    template<typename T>
+    static void build(uint8_t packet, const T& command, CAN::Frame (&frames)[COUNT]) {
+        for (uint32_t i = 0; i < COUNT; i++) {
+            frames[i] = CAN::Frame(identifier(packet, i), &command);
+            frames[i].extd = 1;
+        }
+    }
+
+    /**
+     * @brief Builds one command per node, e.g. per-wheel torque requests
+     **/
+    template<typename T>
+    static void build(uint8_t packet, const T (&commands)[COUNT], CAN::Frame (&frames)[COUNT]) {
+        for (uint32_t i = 0; i < COUNT; i++) {
+            frames[i] = CAN::Frame(identifier(packet, i), &commands[i]);
+            frames[i].extd = 1;
+        }
+    }
+
+    /**
+     * @brief Sends the same command to every node
+     * @returns The number of nodes the command was sent to
+     **/
+    template<typename T>
+    static uint32_t send(CAN::Provider& provider, uint8_t packet, const T& command, uint32_t timeout = 0) {
+        CAN::Frame frames[COUNT];
+        build(packet, command, frames);
+        return transmit(provider, frames, timeout);
+    }
+
+    /**
+     * @brief Sends one command per node
+     * @returns The number of nodes the command was sent to
+     **/
+    template<typename T>
+    static uint32_t send(CAN::Provider& provider, uint8_t packet, const T (&commands)[COUNT], uint32_t timeout = 0) {
+        CAN::Frame frames[COUNT];
+        build(packet, commands, frames);
+        return transmit(provider, frames, timeout);
+    }
+
+    /**
+     * @brief Stores a broadcast in the telemetry of the node that sent it
+     * @returns true if the frame was a broadcast from a node in the group, false otherwise
+     **/
+    bool dispatch(const CAN::Frame& frame) {
+        uint8_t packet = packet_of(frame.identifier);
+        if (!is_broadcast(packet) || (frame.identifier >> (NODE_BITS + 8)) != 0) {
+            return false;
+        }
+
+        uint8_t index = m_index[node_of(frame.identifier)];
+        if (index == NO_NODE) {
+            return false;
+        }
+
+        NodeTelemetry& telemetry = m_telemetry[index];
+        void* destination = nullptr;
+        switch (packet) {
+            case Packet::GENERAL_DATA_6: destination = &telemetry.general6; break;
+            case Packet::GENERAL_DATA_1: destination = &telemetry.general1; break;
+            case Packet::GENERAL_DATA_2: destination = &telemetry.general2; break;
+            case Packet::GENERAL_DATA_3: destination = &telemetry.general3; break;
+            case Packet::GENERAL_DATA_4: destination = &telemetry.general4; break;
+            case Packet::GENERAL_DATA_5: destination = &telemetry.general5; break;
+            case Packet::AC_CURRENT_LIMITS: destination = &telemetry.ac_limits; break;
+            case Packet::DC_CURRENT_LIMITS: destination = &telemetry.dc_limits; break;
+        }
+        memcpy(destination, frame.data, 8);
+        telemetry.received |= (uint8_t)(1U << (packet - Packet::FIRST_BROADCAST));
+        telemetry.updates++;
+        return true;
+    }
+
+    /**
+     * @returns The telemetry of the node at an index (declaration order)
+     **/
+    const NodeTelemetry& telemetry(uint32_t index) const {
+        return m_telemetry[index];
+    }
+
+    /**
+     * @returns The index of a node id, or COUNT if the node is not in the group
+     **/
+    uint32_t index_of(uint8_t node) const {
+        return m_index[node] == NO_NODE ? COUNT : m_index[node];
+    }
+
+private:
+    static constexpr uint8_t NO_NODE = 0xFF;
+    static_assert(COUNT < NO_NODE, "Too many nodes for the lookup table");
+
+    uint8_t m_index[1U << NODE_BITS];
+    NodeTelemetry m_telemetry[COUNT];
+
+    static uint32_t transmit(CAN::Provider& provider, CAN::Frame (&frames)[COUNT], uint32_t timeout) {
+        uint32_t sent = 0;
+        for (uint32_t i = 0; i < COUNT; i++) {
+            if (provider.transmit(frames[i], timeout)) {
+                sent++;
+            }
+        }
+        return sent;
+    }
+};
+
+template<uint8_t... Nodes>
+constexpr uint32_t NodeGroup<Nodes...>::COUNT;
+
+template<uint8_t... Nodes>
+constexpr uint8_t NodeGroup<Nodes...>::NODES[];
+
+template<uint8_t... Nodes>
+constexpr uint8_t NodeGroup<Nodes...>::NO_NODE;
+
+} // namespace DTIX50
+} // namespace Inverter
+
+#endif // INVERTER_DTIX50_NODES_H
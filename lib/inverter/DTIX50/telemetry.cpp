@@ -0,0 +1,202 @@
+#include "telemetry.h"
+
+#include <cstring>
+
+namespace Inverter {
+namespace DTIX50 {
+
+// Frames gathered into raw columns per pass, keeps the columns on the stack
+static constexpr uint32_t BATCH = 32;
+
+template<typename T>
+static T message_of(const CAN::Frame& frame) {
+    T message;
+    memcpy(&message, frame.data, sizeof(T));
+    return message;
+}
+
+static void mark(InverterState& state, uint8_t packet) {
+    state.received |= (uint8_t)(1U << (packet - Packet::FIRST_BROADCAST));
+}
+
+void decode(const Message1F& message, InverterState& state) {
+    state.control_mode = message.control_mode;
+    state.target_iq = (int16_t)(uint16_t)message.target_iq * Scale::CURRENT;
+    state.motor_position = (int16_t)(uint16_t)message.motor_position * Scale::POSITION;
+    state.motor_still = message.is_motor_still;
+    mark(state, Packet::GENERAL_DATA_6);
+}
+
+void decode(const Message20& message, InverterState& state) {
+    state.erpm = Raw::erpm(message);
+    state.duty_cycle = Raw::duty_cycle(message) * Scale::DUTY_CYCLE;
+    state.input_voltage = Raw::input_voltage(message) * Scale::VOLTAGE;
+    mark(state, Packet::GENERAL_DATA_1);
+}
+
+void decode(const Message21& message, InverterState& state) {
+    state.ac_current = Raw::ac_current(message) * Scale::CURRENT;
+    state.dc_current = Raw::dc_current(message) * Scale::CURRENT;
+    mark(state, Packet::GENERAL_DATA_2);
+}
+
+void decode(const Message22& message, InverterState& state) {
+    state.controller_temp = Raw::controller_temp(message) * Scale::TEMPERATURE;
+    state.motor_temp = Raw::motor_temp(message) * Scale::TEMPERATURE;
+    state.fault_code = message.fault_code;
+    mark(state, Packet::GENERAL_DATA_3);
+}
+
+void decode(const Message23& message, InverterState& state) {
+    state.id = Raw::id(message) * Scale::FOC_CURRENT;
+    state.iq = Raw::iq(message) * Scale::FOC_CURRENT;
+    mark(state, Packet::GENERAL_DATA_4);
+}
+
+void decode(const Message24& message, InverterState& state) {
+    state.throttle = (uint8_t)message.throttle_signal;
+    state.brake = (uint8_t)message.brake_signal;
+    state.digital_inputs = (uint8_t)message.digital_inputs;
+    state.digital_outputs = (uint8_t)message.digital_outputs;
+    state.drive_enable = message.drive_enable != 0;
+    state.can_map_version = (uint8_t)message.can_map_version;
+    state.limits = (uint16_t)(
+        (message.capacitor_temp_limit ? Limit::CAPACITOR_TEMP : 0) |
+        (message.dc_current_limit ? Limit::DC_CURRENT : 0) |
+        (message.drive_enable_limit ? Limit::DRIVE_ENABLE : 0) |
+        (message.igbt_accel_limit ? Limit::IGBT_ACCEL : 0) |
+        (message.igbt_temp_limit ? Limit::IGBT_TEMP : 0) |
+        (message.input_voltage_limit ? Limit::INPUT_VOLTAGE : 0) |
+        (message.motor_accel_temp_limit ? Limit::MOTOR_ACCEL_TEMP : 0) |
+        (message.motor_temp_limit ? Limit::MOTOR_TEMP : 0) |
+        (message.rpm_min_limit ? Limit::RPM_MIN : 0) |
+        (message.rpm_max_limit ? Limit::RPM_MAX : 0) |
+        (message.power_limit ? Limit::POWER : 0));
+    mark(state, Packet::GENERAL_DATA_5);
+}
+
+void decode(const Message25& message, InverterState& state) {
+    state.max_ac_current = (int16_t)(uint16_t)message.max_ac_current * Scale::CURRENT;
+    state.available_max_ac_current = (int16_t)(uint16_t)message.av_max_ac_current * Scale::CURRENT;
+    state.min_ac_current = (int16_t)(uint16_t)message.min_ac_current * Scale::CURRENT;
+    state.available_min_ac_current = (int16_t)(uint16_t)message.av_min_ac_current * Scale::CURRENT;
+    mark(state, Packet::AC_CURRENT_LIMITS);
+}
+
+void decode(const Message26& message, InverterState& state) {
+    state.max_dc_current = (int16_t)(uint16_t)message.max_dc_current * Scale::CURRENT;
+    state.available_max_dc_current = (int16_t)(uint16_t)message.av_max_dc_current * Scale::CURRENT;
+    state.min_dc_current = (int16_t)(uint16_t)message.min_dc_current * Scale::CURRENT;
+    state.available_min_dc_current = (int16_t)(uint16_t)message.av_min_dc_current * Scale::CURRENT;
+    mark(state, Packet::DC_CURRENT_LIMITS);
+}
+
+bool decode(const CAN::Frame& frame, InverterState& state) {
+    // Other devices share the extended identifier space, only the packet and node fields may be set
+    if (!frame.extd || (frame.identifier >> (NODE_BITS + 8)) != 0) {
+        return false;
+    }
+    switch (packet_of(frame.identifier)) {
+        case Packet::GENERAL_DATA_6: decode(message_of<Message1F>(frame), state); return true;
+        case Packet::GENERAL_DATA_1: decode(message_of<Message20>(frame), state); return true;
+        case Packet::GENERAL_DATA_2: decode(message_of<Message21>(frame), state); return true;
+        case Packet::GENERAL_DATA_3: decode(message_of<Message22>(frame), state); return true;
+        case Packet::GENERAL_DATA_4: decode(message_of<Message23>(frame), state); return true;
+        case Packet::GENERAL_DATA_5: decode(message_of<Message24>(frame), state); return true;
+        case Packet::AC_CURRENT_LIMITS: decode(message_of<Message25>(frame), state); return true;
+        case Packet::DC_CURRENT_LIMITS: decode(message_of<Message26>(frame), state); return true;
+        default: return false;
+    }
+}
+
+void decode(const NodeTelemetry& telemetry, InverterState& state) {
+    const uint8_t received = telemetry.received;
+    if (received & (1U << (Packet::GENERAL_DATA_6 - Packet::FIRST_BROADCAST))) decode(telemetry.general6, state);
+    if (received & (1U << (Packet::GENERAL_DATA_1 - Packet::FIRST_BROADCAST))) decode(telemetry.general1, state);
+    if (received & (1U << (Packet::GENERAL_DATA_2 - Packet::FIRST_BROADCAST))) decode(telemetry.general2, state);
+    if (received & (1U << (Packet::GENERAL_DATA_3 - Packet::FIRST_BROADCAST))) decode(telemetry.general3, state);
+    if (received & (1U << (Packet::GENERAL_DATA_4 - Packet::FIRST_BROADCAST))) decode(telemetry.general4, state);
+    if (received & (1U << (Packet::GENERAL_DATA_5 - Packet::FIRST_BROADCAST))) decode(telemetry.general5, state);
+    if (received & (1U << (Packet::AC_CURRENT_LIMITS - Packet::FIRST_BROADCAST))) decode(telemetry.ac_limits, state);
+    if (received & (1U << (Packet::DC_CURRENT_LIMITS - Packet::FIRST_BROADCAST))) decode(telemetry.dc_limits, state);
+}
+
+void scale(const int16_t* __restrict raw, float* __restrict out, uint32_t count, float scale) {
+    for (uint32_t i = 0; i < count; i++) {
+        out[i] = (float)raw[i] * scale;
+    }
+}
+
+void scale(const int32_t* __restrict raw, float* __restrict out, uint32_t count, float scale) {
+    for (uint32_t i = 0; i < count; i++) {
+        out[i] = (float)raw[i] * scale;
+    }
+}
+
+uint32_t decode_general1(const CAN::Frame* frames, uint32_t count, int32_t* erpm, float* duty_cycle, float* input_voltage) {
+    int16_t duty[BATCH];
+    int16_t voltage[BATCH];
+    for (uint32_t base = 0; base < count; base += BATCH) {
+        uint32_t n = count - base < BATCH ? count - base : BATCH;
+        for (uint32_t i = 0; i < n; i++) {
+            Message20 message = message_of<Message20>(frames[base + i]);
+            erpm[base + i] = Raw::erpm(message);
+            duty[i] = Raw::duty_cycle(message);
+            voltage[i] = Raw::input_voltage(message);
+        }
+        scale(duty, duty_cycle + base, n, Scale::DUTY_CYCLE);
+        scale(voltage, input_voltage + base, n, Scale::VOLTAGE);
+    }
+    return count;
+}
+
+uint32_t decode_general2(const CAN::Frame* frames, uint32_t count, float* ac_current, float* dc_current) {
+    int16_t ac[BATCH];
+    int16_t dc[BATCH];
+    for (uint32_t base = 0; base < count; base += BATCH) {
+        uint32_t n = count - base < BATCH ? count - base : BATCH;
+        for (uint32_t i = 0; i < n; i++) {
+            Message21 message = message_of<Message21>(frames[base + i]);
+            ac[i] = Raw::ac_current(message);
+            dc[i] = Raw::dc_current(message);
+        }
+        scale(ac, ac_current + base, n, Scale::CURRENT);
+        scale(dc, dc_current + base, n, Scale::CURRENT);
+    }
+    return count;
+}
+
+uint32_t decode_general3(const CAN::Frame* frames, uint32_t count, float* controller_temp, float* motor_temp) {
+    int16_t controller[BATCH];
+    int16_t motor[BATCH];
+    for (uint32_t base = 0; base < count; base += BATCH) {
+        uint32_t n = count - base < BATCH ? count - base : BATCH;
+        for (uint32_t i = 0; i < n; i++) {
+            Message22 message = message_of<Message22>(frames[base + i]);
+            controller[i] = Raw::controller_temp(message);
+            motor[i] = Raw::motor_temp(message);
+        }
+        scale(controller, controller_temp + base, n, Scale::TEMPERATURE);
+        scale(motor, motor_temp + base, n, Scale::TEMPERATURE);
+    }
+    return count;
+}
+
+uint32_t decode_general4(const CAN::Frame* frames, uint32_t count, float* id, float* iq) {
+    int32_t raw_id[BATCH];
+    int32_t raw_iq[BATCH];
+    for (uint32_t base = 0; base < count; base += BATCH) {
+        uint32_t n = count - base < BATCH ? count - base : BATCH;
+        for (uint32_t i = 0; i < n; i++) {
+            Message23 message = message_of<Message23>(frames[base + i]);
+            raw_id[i] = Raw::id(message);
+            raw_iq[i] = Raw::iq(message);
+        }
+        scale(raw_id, id + base, n, Scale::FOC_CURRENT);
+        scale(raw_iq, iq + base, n, Scale::FOC_CURRENT);
+    }
+    return count;
+}
+
+} // namespace DTIX50
+} // namespace Inverter
@@ -0,0 +1,154 @@
+#ifndef INVERTER_DTIX50_TELEMETRY_H
+#define INVERTER_DTIX50_TELEMETRY_H
+
+#include <cstdint>
+
+#include "can/can.h"
+#include "identifiers.h"
+#include "messages.h"
+#include "nodes.h"
+
+namespace Inverter {
+namespace DTIX50 {
+
+/**
+ * Resolution of the scaled broadcast fields, engineering unit per raw count.
+ **/
+namespace Scale {
+    constexpr float CURRENT = 0.1f;         /**< AC and DC currents, A */
+    constexpr float FOC_CURRENT = 0.01f;    /**< FOC Id and Iq, A */
+    constexpr float TEMPERATURE = 0.1f;     /**< Controller and motor temperatures, degrees C */
+    constexpr float DUTY_CYCLE = 0.1f;      /**< Duty cycle, % */
+    constexpr float VOLTAGE = 1.0f;         /**< Input voltage, V */
+    constexpr float POSITION = 0.1f;        /**< Motor position, degrees */
+}
+
+/**
+ * Bits of InverterState::limits, one per limit flag of general data 5.
+ **/
+namespace Limit {
+    constexpr uint16_t CAPACITOR_TEMP = 1U << 0;
+    constexpr uint16_t DC_CURRENT = 1U << 1;
+    constexpr uint16_t DRIVE_ENABLE = 1U << 2;
+    constexpr uint16_t IGBT_ACCEL = 1U << 3;
+    constexpr uint16_t IGBT_TEMP = 1U << 4;
+    constexpr uint16_t INPUT_VOLTAGE = 1U << 5;
+    constexpr uint16_t MOTOR_ACCEL_TEMP = 1U << 6;
+    constexpr uint16_t MOTOR_TEMP = 1U << 7;
+    constexpr uint16_t RPM_MIN = 1U << 8;
+    constexpr uint16_t RPM_MAX = 1U << 9;
+    constexpr uint16_t POWER = 1U << 10;
+}
+
+/**
+ * @brief Inverter broadcasts in engineering units
+ *          Signed fields are sign extended, currents in A, temperatures in degrees C.
+ * @param received: Bit (packet - 0x1F) is set once that packet has been decoded
+ **/
+struct InverterState {
+    // General data 6 (0x1F)
+    ControlMode control_mode;
+    float target_iq;
+    float motor_position;
+    bool motor_still;
+
+    // General data 1 (0x20)
+    int32_t erpm;
+    float duty_cycle;
+    float input_voltage;
+
+    // General data 2 (0x21)
+    float ac_current;
+    float dc_current;
+
+    // General data 3 (0x22)
+    float controller_temp;
+    float motor_temp;
+    FaultCodes fault_code;
+
+    // General data 4 (0x23)
+    float id;
+    float iq;
+
+    // General data 5 (0x24)
+    uint8_t throttle;
+    uint8_t brake;
+    uint8_t digital_inputs;
+    uint8_t digital_outputs;
+    bool drive_enable;
+    uint16_t limits;
+    uint8_t can_map_version;
+
+    // Configured and available currents (0x25, 0x26)
+    float max_ac_current;
+    float available_max_ac_current;
+    float min_ac_current;
+    float available_min_ac_current;
+    float max_dc_current;
+    float available_max_dc_current;
+    float min_dc_current;
+    float available_min_dc_current;
+
+    uint8_t received;
+};
+
+/**
+ * Raw fields as signed integers. Every decoder goes through these, so the sign handling of
+ * each field is written once.
+ **/
+namespace Raw {
+    inline int32_t erpm(const Message20& m) { return (int32_t)(uint32_t)m.erpm; }
+    inline int16_t duty_cycle(const Message20& m) { return (int16_t)(uint16_t)m.duty_cycle; }
+    inline int16_t input_voltage(const Message20& m) { return (int16_t)(uint16_t)m.input_voltage; }
+    inline int16_t ac_current(const Message21& m) { return (int16_t)(uint16_t)m.ac_current; }
+    inline int16_t dc_current(const Message21& m) { return (int16_t)(uint16_t)m.dc_current; }
+    inline int16_t controller_temp(const Message22& m) { return (int16_t)(uint16_t)m.controller_temp; }
+    inline int16_t motor_temp(const Message22& m) { return (int16_t)(uint16_t)m.motor_temp; }
+    inline int32_t id(const Message23& m) { return (int32_t)(uint32_t)m.id; }
+    inline int32_t iq(const Message23& m) { return (int32_t)(uint32_t)m.iq; }
+}
+
+void decode(const Message1F& message, InverterState& state);
+void decode(const Message20& message, InverterState& state);
+void decode(const Message21& message, InverterState& state);
+void decode(const Message22& message, InverterState& state);
+void decode(const Message23& message, InverterState& state);
+void decode(const Message24& message, InverterState& state);
+void decode(const Message25& message, InverterState& state);
+void decode(const Message26& message, InverterState& state);
+
+/**
+ * @brief Decodes one broadcast frame into the state, frames from other devices are ignored
+ * @returns true if the frame was an inverter broadcast, false otherwise
+ **/
+bool decode(const CAN::Frame& frame, InverterState& state);
+
+/**
+ * @brief Decodes every broadcast received so far by a node group member
+ **/
+void decode(const NodeTelemetry& telemetry, InverterState& state);
+
+/**
+ * Batched decoders for logging and host analysis.
+ *
+ * Each takes frames of a single packet and writes one contiguous array per field. Frames
+ * are first gathered into raw integer columns, then scaled by plain loops over contiguous
+ * arrays that the compiler vectorizes, check with -fopt-info-vec-optimized.
+ *
+ * @returns The number of frames decoded, which is count.
+ **/
+uint32_t decode_general1(const CAN::Frame* frames, uint32_t count, int32_t* erpm, float* duty_cycle, float* input_voltage);
+uint32_t decode_general2(const CAN::Frame* frames, uint32_t count, float* ac_current, float* dc_current);
+uint32_t decode_general3(const CAN::Frame* frames, uint32_t count, float* controller_temp, float* motor_temp);
+uint32_t decode_general4(const CAN::Frame* frames, uint32_t count, float* id, float* iq);
+
+/**
+ * @brief Scales a column of raw counts to engineering units
+ **/
+void scale(const int16_t* raw, float* out, uint32_t count, float scale);
+void scale(const int32_t* raw, float* out, uint32_t count, float scale);
+
+} // namespace DTIX50
+} // namespace Inverter
+
+#endif // INVERTER_DTIX50_TELEMETRY_H
@@ -0,0 +1,88 @@
+#include "apps_sampler.h"
+
+namespace Pedals {
+
+// Accumulator slots
+static constexpr uint32_t APPS1 = 0;
+static constexpr uint32_t APPS2 = 1;
+static constexpr uint32_t BRAKE = 2;
+
+AppsSampler::AppsSampler(iAdcSource* adc, Core::iClockStrategy* clock, Channels channels, uint8_t oversampling) {
+    m_adc = adc;
+    m_clock = clock;
+    m_channels = channels;
+    m_oversampling = oversampling == 0 ? 1 : oversampling;
+
+    m_latest = {};
+    m_have_latest = false;
+    m_statistics = {};
+    reset_accumulators();
+}
+
+void AppsSampler::reset_accumulators() {
+    for (uint32_t i = 0; i < 3; i++) {
+        m_sum[i] = 0;
+        m_count[i] = 0;
+    }
+}
+
+bool AppsSampler::start() {
+    reset_accumulators();
+    m_have_latest = false;
+    return m_adc->start();
+}
+
+void AppsSampler::stop() {
+    m_adc->stop();
+}
+
+uint32_t AppsSampler::poll() {
+    AdcConversion conversions[PEDALS_ADC_READ_CHUNK];
+    uint32_t produced = 0;
+
+    for (;;) {
+        uint32_t count = m_adc->read(conversions, PEDALS_ADC_READ_CHUNK);
+        m_statistics.conversions += count;
+
+        for (uint32_t i = 0; i < count; i++) {
+            const AdcConversion& conversion = conversions[i];
+            uint32_t slot = conversion.channel == m_channels.apps1 ? APPS1
+                          : conversion.channel == m_channels.apps2 ? APPS2
+                          : conversion.channel == m_channels.brake ? BRAKE
+                          : 3;
+            if (slot == 3) continue;
+            m_sum[slot] += conversion.value;
+            m_count[slot]++;
+
+            // Both APPS complete, the brake is averaged over whatever arrived alongside
+            if (m_count[APPS1] >= m_oversampling && m_count[APPS2] >= m_oversampling) {
+                m_latest.apps1 = (uint16_t)(m_sum[APPS1] / m_count[APPS1]);
+                m_latest.apps2 = (uint16_t)(m_sum[APPS2] / m_count[APPS2]);
+                if (m_count[BRAKE] != 0) {
+                    m_latest.brake = (uint16_t)(m_sum[BRAKE] / m_count[BRAKE]);
+                }
+                m_latest.timestamp_us = m_clock->micros();
+                m_have_latest = true;
+                reset_accumulators();
+                produced++;
+            }
+        }
+
+        if (count < PEDALS_ADC_READ_CHUNK) break;
+    }
+
+    m_statistics.samples += produced;
+    return produced;
+}
+
+bool AppsSampler::sample(PedalSample& sample) {
+    poll();
+    if (!m_have_latest || m_clock->micros() - m_latest.timestamp_us > max_age_us) {
+        m_statistics.stale++;
+        return false;
+    }
+    sample = m_latest;
+    return true;
+}
+
+} // namespace Pedals
@@ -0,0 +1,81 @@
+#ifndef PEDALS_APPS_SAMPLER_H
+#define PEDALS_APPS_SAMPLER_H
+
+#include <stdint.h>
+
+#include "core/core.h"
+#include "i_adc_source.h"
+#include "i_pedal_source.h"
+#include "types.h"
+
+// Conversions copied out of the ADC per read.
+#ifndef PEDALS_ADC_READ_CHUNK
+#define PEDALS_ADC_READ_CHUNK 32
+#endif
+
+namespace Pedals {
+
+/**
+ * @brief Oversampled pedal source on top of a continuous ADC
+ *
+ * The ADC converts the APPS and brake channels back to back in one pattern, so both APPS
+ * are sampled within microseconds of each other. Each output sample averages `oversampling`
+ * conversions of both APPS channels. sample() drains whatever the ADC produced since the
+ * last call and returns the newest output without waiting, so it can run at the pipeline
+ * rate. An output older than max_age_us is refused, so a stalled ADC is reported as a
+ * missing sample rather than a frozen pedal.
+ **/
+class AppsSampler : public iPedalSource {
+public:
+    struct Channels {
+        uint8_t apps1;
+        uint8_t apps2;
+        uint8_t brake;
+    };
+
+    struct Statistics {
+        uint32_t conversions;   /**< Conversions read from the ADC */
+        uint32_t samples;       /**< Oversampled outputs produced */
+        uint32_t stale;         /**< sample() calls refused because the output was too old */
+    };
+
+    // Oldest output sample() will return, in microseconds.
+    uint32_t max_age_us = 2000;
+
+    AppsSampler(iAdcSource* adc, Core::iClockStrategy* clock, Channels channels, uint8_t oversampling = 8);
+
+    bool start();
+    void stop();
+
+    /**
+     * @brief Drains the ADC into the oversampling accumulators
+     * @returns The number of new output samples
+     **/
+    uint32_t poll();
+
+    /**
+     * @brief Polls and returns the newest output sample
+     * @returns true if a sample younger than max_age_us is available, false otherwise.
+     **/
+    bool sample(PedalSample& sample) override;
+
+    Statistics statistics() const { return m_statistics; }
+
+private:
+    iAdcSource* m_adc;
+    Core::iClockStrategy* m_clock;
+    Channels m_channels;
+    uint8_t m_oversampling;
+
+    uint32_t m_sum[3];
+    uint32_t m_count[3];
+    PedalSample m_latest;
+    bool m_have_latest;
+    Statistics m_statistics;
+
+    void reset_accumulators();
+};
+
+} // namespace Pedals
+
+#endif // PEDALS_APPS_SAMPLER_H
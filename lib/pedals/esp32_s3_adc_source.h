@@ -0,0 +1,116 @@
+#ifndef PEDALS_ESP32_S3_ADC_SOURCE_H
+#define PEDALS_ESP32_S3_ADC_SOURCE_H
+
+#if defined(ESP32)
+
+#include <cstring>
+#include <esp_adc/adc_continuous.h>
+
+#include "i_adc_source.h"
+
+// Attenuation of the pedal channels, 12 dB covers the full 0-3.1 V sensor range.
+#ifndef PEDALS_ADC_ATTENUATION
+#define PEDALS_ADC_ATTENUATION ADC_ATTEN_DB_12
+#endif
+
+// Bytes the DMA driver fills per conversion frame.
+#ifndef PEDALS_ADC_FRAME_BYTES
+#define PEDALS_ADC_FRAME_BYTES 128
+#endif
+
+namespace Pedals {
+
+// Continuous ADC1 conversion of a channel pattern, filled by DMA in the background
+class ESP32S3AdcSource final : public iAdcSource {
+public:
+    /**
+     * @param channels ADC1 channels converted back to back, in pattern order
+     * @param sample_rate_hz Conversions per second over all channels
+     **/
+    ESP32S3AdcSource(const uint8_t* channels, uint32_t count, uint32_t sample_rate_hz = 40000)
+        : m_handle(nullptr), m_count(count > SOC_ADC_PATT_LEN_MAX ? SOC_ADC_PATT_LEN_MAX : count), m_sample_rate_hz(sample_rate_hz) {
+        memcpy(m_channels, channels, m_count);
+    }
+
+    ~ESP32S3AdcSource() {
+        stop();
+    }
+
+    bool start() override {
+        if (m_handle != nullptr) return true;
+
+        adc_continuous_handle_cfg_t handle_config;
+        memset(&handle_config, 0, sizeof(handle_config));
+        handle_config.max_store_buf_size = PEDALS_ADC_FRAME_BYTES * 4;
+        handle_config.conv_frame_size = PEDALS_ADC_FRAME_BYTES;
+        if (adc_continuous_new_handle(&handle_config, &m_handle) != ESP_OK) {
+            m_handle = nullptr;
+            return false;
+        }
+
+        adc_digi_pattern_config_t pattern[SOC_ADC_PATT_LEN_MAX];
+        memset(pattern, 0, sizeof(pattern));
+        for (uint32_t i = 0; i < m_count; i++) {
+            pattern[i].atten = PEDALS_ADC_ATTENUATION;
+            pattern[i].channel = m_channels[i];
+            pattern[i].unit = ADC_UNIT_1;
+            pattern[i].bit_width = SOC_ADC_DIGI_MAX_BITWIDTH;
+        }
+
+        adc_continuous_config_t config;
+        memset(&config, 0, sizeof(config));
+        config.pattern_num = m_count;
+        config.adc_pattern = pattern;
+        config.sample_freq_hz = m_sample_rate_hz;
+        config.conv_mode = ADC_CONV_SINGLE_UNIT_1;
+        config.format = ADC_DIGI_OUTPUT_FORMAT_TYPE2;
+
+        if (adc_continuous_config(m_handle, &config) != ESP_OK || adc_continuous_start(m_handle) != ESP_OK) {
+            adc_continuous_deinit(m_handle);
+            m_handle = nullptr;
+            return false;
+        }
+        return true;
+    }
+
+    void stop() override {
+        if (m_handle == nullptr) return;
+        adc_continuous_stop(m_handle);
+        adc_continuous_deinit(m_handle);
+        m_handle = nullptr;
+    }
+
+    uint32_t read(AdcConversion* conversions, uint32_t capacity) override {
+        if (m_handle == nullptr) return 0;
+
+        uint32_t bytes = capacity * SOC_ADC_DIGI_RESULT_BYTES;
+        if (bytes > sizeof(m_buffer)) bytes = sizeof(m_buffer);
+
+        uint32_t length = 0;
+        if (adc_continuous_read(m_handle, m_buffer, bytes, &length, 0) != ESP_OK) {
+            return 0;
+        }
+
+        uint32_t count = 0;
+        for (uint32_t offset = 0; offset + SOC_ADC_DIGI_RESULT_BYTES <= length; offset += SOC_ADC_DIGI_RESULT_BYTES) {
+            const adc_digi_output_data_t* data = (const adc_digi_output_data_t*)&m_buffer[offset];
+            conversions[count].channel = (uint8_t)data->type2.channel;
+            conversions[count].value = (uint16_t)data->type2.data;
+            count++;
+        }
+        return count;
+    }
+
+private:
+    adc_continuous_handle_t m_handle;
+    uint8_t m_channels[SOC_ADC_PATT_LEN_MAX];
+    uint32_t m_count;
+    uint32_t m_sample_rate_hz;
+    uint8_t m_buffer[PEDALS_ADC_FRAME_BYTES];
+};
+
+} // namespace Pedals
+
+#endif // ESP32
+
+#endif // PEDALS_ESP32_S3_ADC_SOURCE_H
@@ -0,0 +1,33 @@
+#ifndef PEDALS_I_ADC_SOURCE_H
+#define PEDALS_I_ADC_SOURCE_H
+
+#include <stdint.h>
+
+namespace Pedals {
+
+/**
+ * @brief One ADC conversion as produced by a continuous conversion pattern
+ **/
+struct AdcConversion {
+    uint8_t channel;
+    uint16_t value;
+};
+
+/**
+ * @brief Continuous ADC abstract interface
+ *          On the ESP32-S3 this is backed by the DMA driven continuous ADC, in tests by a synthetic source.
+ * @fn start: Starts converting the configured channel pattern. Returns false on failure.
+ * @fn stop: Stops converting
+ * @fn read: Copies out conversions completed so far without blocking. Returns the number copied.
+ */
+class iAdcSource {
+public:
+    virtual ~iAdcSource() = default;
+    virtual bool start() = 0;
+    virtual void stop() = 0;
+    virtual uint32_t read(AdcConversion* conversions, uint32_t capacity) = 0;
+};
+
+} // namespace Pedals
+
+#endif // PEDALS_I_ADC_SOURCE_H
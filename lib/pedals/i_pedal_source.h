@@ -0,0 +1,21 @@
+#ifndef PEDALS_I_PEDAL_SOURCE_H
+#define PEDALS_I_PEDAL_SOURCE_H
+
+#include "types.h"
+
+namespace Pedals {
+
+/**
+ * @brief Pedal sensor source abstract interface
+ *          On the car this is backed by the ADC, in tests by a synthetic source.
+ * @fn sample: Reads every pedal sensor, must not block or allocate. Returns false if no reading is available.
+ */
+class iPedalSource {
+public:
+    virtual ~iPedalSource() = default;
+    virtual bool sample(PedalSample& sample) = 0;
+};
+
+} // namespace Pedals
+
+#endif // PEDALS_I_PEDAL_SOURCE_H
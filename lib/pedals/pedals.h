@@ -2,4 +2,14 @@
 #ifndef PEDALS_H
 #define PEDALS_H
 
-#endif // PEDALS_H
\ No newline at end of file
+#include "apps_sampler.h"
+#include "esp32_s3_adc_source.h"
+#include "i_adc_source.h"
+#include "i_pedal_source.h"
+#include "plausibility.h"
+#include "shutdown_sequence.h"
+#include "torque_map.h"
+#include "torque_pipeline.h"
+#include "types.h"
+
+#endif // PEDALS_H
@@ -0,0 +1,58 @@
+#include "plausibility.h"
+
+namespace Pedals {
+
+Plausibility::Plausibility() {
+    reset();
+}
+
+void Plausibility::reset() {
+    m_fault = PedalFault::NONE;
+    m_disagreeing = false;
+    m_disagreeing_since = 0;
+}
+
+bool Plausibility::in_range(int32_t travel) const {
+    return travel >= -(int32_t)range_margin && travel <= (int32_t)TRAVEL_FULL + range_margin;
+}
+
+PedalFault Plausibility::electrical(uint16_t raw, PedalFault open_or_ground, PedalFault short_to_supply, PedalFault range, int32_t travel) const {
+    if (raw <= ground_threshold) return open_or_ground;
+    if (raw >= supply_threshold) return short_to_supply;
+    if (!in_range(travel)) return range;
+    return PedalFault::NONE;
+}
+
+PedalFault Plausibility::check(const PedalSample& sample, uint16_t& travel) {
+    int32_t travel1 = Pedals::travel(sample.apps1, apps1);
+    int32_t travel2 = Pedals::travel(sample.apps2, apps2);
+    travel = 0;
+
+    PedalFault fault = electrical(sample.apps1, PedalFault::APPS1_OPEN_OR_GROUND, PedalFault::APPS1_SHORT_TO_SUPPLY, PedalFault::APPS1_RANGE, travel1);
+    if (fault == PedalFault::NONE) {
+        fault = electrical(sample.apps2, PedalFault::APPS2_OPEN_OR_GROUND, PedalFault::APPS2_SHORT_TO_SUPPLY, PedalFault::APPS2_RANGE, travel2);
+    }
+    if (fault != PedalFault::NONE) {
+        m_disagreeing = false;
+        return m_fault = fault;
+    }
+
+    int32_t difference = travel1 > travel2 ? travel1 - travel2 : travel2 - travel1;
+    if (difference > (int32_t)max_disagreement) {
+        if (!m_disagreeing) {
+            m_disagreeing = true;
+            m_disagreeing_since = sample.timestamp_us;
+        }
+        if (sample.timestamp_us - m_disagreeing_since >= persistence_us) {
+            return m_fault = PedalFault::DISAGREEMENT;
+        }
+    } else {
+        m_disagreeing = false;
+    }
+
+    int32_t mean = (travel1 + travel2) / 2;
+    travel = mean < 0 ? 0 : mean > (int32_t)TRAVEL_FULL ? TRAVEL_FULL : (uint16_t)mean;
+    return m_fault = PedalFault::NONE;
+}
+
+} // namespace Pedals
@@ -0,0 +1,59 @@
+#ifndef PEDALS_PLAUSIBILITY_H
+#define PEDALS_PLAUSIBILITY_H
+
+#include <stdint.h>
+
+#include "types.h"
+
+namespace Pedals {
+
+/**
+ * @brief Accelerator pedal plausibility check (EV 3.5.4)
+ *
+ * Each APPS must stay inside its calibrated range, give or take a margin, otherwise torque is
+ * cut at once. Readings at the rails are told apart, so an open circuit or short to ground
+ * (pulled down to 0 V) is reported differently from a short to the sensor supply.
+ * The two APPS must also agree, a disagreement is only reported once it has persisted, so
+ * noise on a single sample does not cut torque. Faults clear as soon as the cause is gone.
+ **/
+class Plausibility {
+public:
+    SensorRange apps1 = { 0, 4095 };
+    SensorRange apps2 = { 0, 4095 };
+
+    // Raw readings at or below this are at the ground rail, at or above supply_threshold at the supply rail.
+    uint16_t ground_threshold = 100;
+    uint16_t supply_threshold = 3995;
+
+    // Travel beyond either end of the range still accepted as valid, in tenths of a percent.
+    uint16_t range_margin = 50;
+    // Largest accepted difference between the two APPS, in tenths of a percent.
+    uint16_t max_disagreement = 100;
+    // Time a disagreement must persist before it is a fault, in microseconds.
+    uint32_t persistence_us = 100000;
+
+    Plausibility();
+
+    /**
+     * @brief Checks a sample and computes the pedal travel
+     * @param travel Set to the mean APPS travel clamped to [0, TRAVEL_FULL], or 0 on a fault
+     * @returns The active fault, PedalFault::NONE if torque may be requested
+     **/
+    PedalFault check(const PedalSample& sample, uint16_t& travel);
+
+    PedalFault fault() const { return m_fault; }
+
+    void reset();
+
+private:
+    bool in_range(int32_t travel) const;
+    PedalFault electrical(uint16_t raw, PedalFault open_or_ground, PedalFault short_to_supply, PedalFault range, int32_t travel) const;
+
+    PedalFault m_fault;
+    bool m_disagreeing;
+    uint64_t m_disagreeing_since;
+};
+
+} // namespace Pedals
+
+#endif // PEDALS_PLAUSIBILITY_H
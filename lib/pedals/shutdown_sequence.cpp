@@ -0,0 +1,257 @@
+#include "shutdown_sequence.h"
+
+#include <cstring>
+
+#include "battery/messages.h"
+
+using namespace Inverter::DTIX50;
+
+namespace Pedals {
+
+constexpr uint8_t ShutdownTable::STATES;
+constexpr uint8_t ShutdownTable::EVENTS;
+constexpr VehicleState ShutdownTable::INITIAL;
+constexpr ShutdownTable::Row ShutdownTable::TRANSITIONS[];
+constexpr ShutdownTable::Hooks ShutdownTable::HOOKS[];
+
+constexpr uint32_t ShutdownSequence::SOUND_MIN_US;
+constexpr uint32_t ShutdownSequence::SOUND_MAX_US;
+
+// Orion BMS pack voltage broadcast
+static constexpr uint32_t PACK_VOLTAGE_IDENTIFIER = 0x001;
+
+bool ShutdownTable::brake_pressed(const ShutdownSequence& sequence) {
+    return sequence.m_brake_pressed;
+}
+
+void ShutdownTable::enter_ready(ShutdownSequence& sequence) {
+    sequence.m_ready.store(true, std::memory_order_release);
+    sequence.m_sound.store(true, std::memory_order_relaxed);
+    sequence.m_sound_since = sequence.m_machine.entered_us();
+    sequence.m_statistics.sounds++;
+    sequence.m_ready_milestone.mark();
+}
+
+void ShutdownTable::exit_ready(ShutdownSequence& sequence) {
+    // Torque first, everything else can wait
+    sequence.m_ready.store(false, std::memory_order_release);
+    if (sequence.m_sound.load(std::memory_order_relaxed)) {
+        sequence.stop_sound(sequence.m_clock->micros());
+        sequence.m_statistics.sounds_cut++;
+    }
+}
+
+ShutdownSequence::ShutdownSequence(Core::iClockStrategy* clock, uint8_t node, Core::iLockStrategy* lock)
+    : m_machine(this, clock) {
+    m_clock = clock;
+    m_lock = lock;
+    m_voltage_identifier = identifier(Packet::GENERAL_DATA_1, node);
+
+    m_state_listener = nullptr;
+    m_state_context = nullptr;
+    m_sound_listener = nullptr;
+    m_sound_context = nullptr;
+
+    m_glv = false;
+    m_shutdown_closed = false;
+    m_start_pressed = false;
+    m_brake_pressed = false;
+
+    m_link_mv = 0;
+    m_link_at = 0;
+    m_pack_mv = 0;
+    m_pack_at = 0;
+
+    m_ready = false;
+    m_sound = false;
+    m_sound_since = 0;
+    m_statistics = {};
+}
+
+void ShutdownSequence::set_state_listener(VehicleStateListener listener, void* context) {
+    Core::LockGuard guard(m_lock);
+    m_state_listener = listener;
+    m_state_context = context;
+}
+
+void ShutdownSequence::set_sound_listener(SoundListener listener, void* context) {
+    Core::LockGuard guard(m_lock);
+    m_sound_listener = listener;
+    m_sound_context = context;
+}
+
+void ShutdownSequence::set_ready_milestone(Core::Startup::MilestoneHook hook) {
+    Core::LockGuard guard(m_lock);
+    m_ready_milestone = hook;
+}
+
+void ShutdownSequence::start() {
+    Core::LockGuard guard(m_lock);
+    m_glv = false;
+    m_shutdown_closed = false;
+    m_machine.start();
+}
+
+ShutdownSequence::Outcome ShutdownSequence::transition(VehicleEvent event, uint64_t observed_us) {
+    Outcome outcome = { false, m_machine.state(), m_machine.state(), m_sound.load(std::memory_order_relaxed) };
+    outcome.taken = m_machine.dispatch(event, observed_us);
+
+    // With all BRBs and the TSMS on, TS off leads straight back to precharge
+    if (outcome.taken && m_machine.state() == VehicleState::TS_OFF && m_shutdown_closed) {
+        m_machine.dispatch(VehicleEvent::SHUTDOWN_CLOSED, observed_us);
+    }
+    outcome.to = m_machine.state();
+    return outcome;
+}
+
+void ShutdownSequence::notify(const Outcome& outcome) {
+    VehicleStateListener state_listener;
+    void* state_context;
+    SoundListener sound_listener;
+    void* sound_context;
+    {
+        Core::LockGuard guard(m_lock);
+        state_listener = m_state_listener;
+        state_context = m_state_context;
+        sound_listener = m_sound_listener;
+        sound_context = m_sound_context;
+    }
+
+    if (outcome.from != outcome.to && state_listener != nullptr) {
+        state_listener(outcome.from, outcome.to, state_context);
+    }
+    bool sound = m_sound.load(std::memory_order_relaxed);
+    if (sound != outcome.sound_was && sound_listener != nullptr) {
+        sound_listener(sound, sound_context);
+    }
+}
+
+bool ShutdownSequence::dispatch(VehicleEvent event, uint64_t observed_us) {
+    Outcome outcome;
+    {
+        Core::LockGuard guard(m_lock);
+        outcome = transition(event, observed_us);
+    }
+    notify(outcome);
+    return outcome.taken;
+}
+
+bool ShutdownSequence::dispatch(VehicleEvent event) {
+    return dispatch(event, m_clock->micros());
+}
+
+void ShutdownSequence::set_glv(bool on) {
+    uint64_t now = m_clock->micros();
+    Outcome outcome;
+    {
+        Core::LockGuard guard(m_lock);
+        if (on == m_glv) return;
+        m_glv = on;
+        outcome = transition(on ? VehicleEvent::GLV_ON : VehicleEvent::GLV_OFF, now);
+    }
+    notify(outcome);
+}
+
+void ShutdownSequence::set_shutdown(bool closed) {
+    uint64_t now = m_clock->micros();
+    Outcome outcome;
+    {
+        Core::LockGuard guard(m_lock);
+        if (closed == m_shutdown_closed) return;
+        m_shutdown_closed = closed;
+        outcome = transition(closed ? VehicleEvent::SHUTDOWN_CLOSED : VehicleEvent::SHUTDOWN_OPENED, now);
+    }
+    notify(outcome);
+}
+
+void ShutdownSequence::set_start(bool pressed) {
+    uint64_t now = m_clock->micros();
+    Outcome outcome;
+    {
+        Core::LockGuard guard(m_lock);
+        bool rising = pressed && !m_start_pressed;
+        m_start_pressed = pressed;
+        if (!rising) return;
+
+        if (m_machine.state() == VehicleState::READY_TO_DRIVE) {
+            outcome = transition(VehicleEvent::STOP, now);
+        } else {
+            outcome = transition(VehicleEvent::START, now);
+            if (!outcome.taken) m_statistics.starts_refused++;
+        }
+    }
+    notify(outcome);
+}
+
+void ShutdownSequence::update(const PedalSample& sample) {
+    bool pressed = travel(sample.brake, brake) >= config.brake_threshold;
+    Core::LockGuard guard(m_lock);
+    m_brake_pressed = pressed;
+}
+
+bool ShutdownSequence::precharged(uint64_t now) const {
+    if (m_pack_mv <= 0) return false;
+    if (now - m_link_at > config.voltage_timeout_us || now - m_pack_at > config.voltage_timeout_us) return false;
+    return (int64_t)m_link_mv * 1000 >= (int64_t)m_pack_mv * config.precharge_permille;
+}
+
+bool ShutdownSequence::dispatch(const CAN::Frame& frame) {
+    uint64_t now = m_clock->micros();
+    Outcome outcome;
+    {
+        Core::LockGuard guard(m_lock);
+        if (frame.extd && frame.identifier == m_voltage_identifier) {
+            Inverter::Message20 message;
+            memcpy(&message, frame.data, sizeof(message));
+            m_link_mv = (int32_t)Raw::input_voltage(message) * 1000;
+            m_link_at = now;
+        } else if (!frame.extd && frame.identifier == PACK_VOLTAGE_IDENTIFIER) {
+            ::Message1 message;
+            memcpy(&message, frame.data, sizeof(message));
+            m_pack_mv = (int32_t)message.packVoltage * config.pack_mv_per_count;
+            m_pack_at = now;
+        } else {
+            return false;
+        }
+
+        if (m_machine.state() != VehicleState::PRECHARGE || !precharged(now)) return true;
+        outcome = transition(VehicleEvent::PRECHARGE_DONE, now);
+    }
+    notify(outcome);
+    return true;
+}
+
+uint32_t ShutdownSequence::sound_duration() const {
+    return config.sound_us < SOUND_MIN_US ? SOUND_MIN_US : config.sound_us > SOUND_MAX_US ? SOUND_MAX_US : config.sound_us;
+}
+
+void ShutdownSequence::stop_sound(uint64_t now) {
+    m_sound.store(false, std::memory_order_relaxed);
+    m_statistics.last_sound_us = (uint32_t)(now - m_sound_since);
+}
+
+void ShutdownSequence::poll() {
+    uint64_t now = m_clock->micros();
+    SoundListener listener = nullptr;
+    void* context = nullptr;
+    {
+        Core::LockGuard guard(m_lock);
+        if (!m_sound.load(std::memory_order_relaxed) || now - m_sound_since < sound_duration()) return;
+        stop_sound(now);
+        listener = m_sound_listener;
+        context = m_sound_context;
+    }
+    if (listener != nullptr) listener(false, context);
+}
+
+VehicleState ShutdownSequence::state() {
+    Core::LockGuard guard(m_lock);
+    return m_machine.state();
+}
+
+ShutdownSequence::Statistics ShutdownSequence::statistics() {
+    Core::LockGuard guard(m_lock);
+    return m_statistics;
+}
+
+} // namespace Pedals
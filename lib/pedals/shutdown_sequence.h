@@ -0,0 +1,255 @@
+#ifndef PEDALS_SHUTDOWN_SEQUENCE_H
+#define PEDALS_SHUTDOWN_SEQUENCE_H
+
+#include <atomic>
+#include <stdint.h>
+
+#include "core/core.h"
+#include "can/can.h"
+#include "inverter/DTIX50.h"
+#include "types.h"
+
+namespace Pedals {
+
+// States of the shutdown system state diagram (EV 7.8.1).
+enum class VehicleState : uint8_t {
+    GLV_OFF,
+    TS_OFF,             /**< GLV on, tractive system off */
+    PRECHARGE,
+    TS_ENERGIZED,       /**< Tractive system energized, not ready to drive */
+    READY_TO_DRIVE,
+    AMS_LOCKOUT,
+    IMD_LOCKOUT,
+    BRAKE_LOCKOUT,      /**< Brake overtravel lockout */
+};
+
+enum class VehicleEvent : uint8_t {
+    GLV_ON,             /**< GLVMS and both side BRBs on */
+    GLV_OFF,            /**< GLVMS off or a side BRB pressed */
+    SHUTDOWN_CLOSED,    /**< Cockpit BRB and TSMS on */
+    SHUTDOWN_OPENED,    /**< Cockpit BRB or TSMS off */
+    PRECHARGE_DONE,     /**< The inverter DC link reached the precharge threshold */
+    START,              /**< Start button pressed while not ready to drive */
+    STOP,               /**< Start button pressed while ready to drive */
+    AMS_FAULT,
+    IMD_FAULT,
+    BRAKE_OVERTRAVEL,
+    AMS_RESET,
+    IMD_RESET,
+    BRAKE_OVERTRAVEL_RESET,
+};
+
+/**
+ * @brief Receives state changes, called without the sequence's lock held
+ **/
+typedef void(*VehicleStateListener)(VehicleState from, VehicleState to, void* context);
+
+/**
+ * @brief Switches the ready-to-drive sound, called without the sequence's lock held
+ **/
+typedef void(*SoundListener)(bool on, void* context);
+
+class ShutdownSequence;
+
+/**
+ * @brief Transition table of the shutdown sequence, see Core::Fsm::StateMachine
+ **/
+struct ShutdownTable {
+    typedef ShutdownSequence Context;
+    typedef VehicleState State;
+    typedef VehicleEvent Event;
+    typedef Core::Fsm::Transition<Context, State, Event> Row;
+    typedef Core::Fsm::StateHooks<Context> Hooks;
+
+    static constexpr uint8_t STATES = 8;
+    static constexpr uint8_t EVENTS = 13;
+    static constexpr State INITIAL = VehicleState::GLV_OFF;
+
+    static bool brake_pressed(const ShutdownSequence& sequence);
+    static void enter_ready(ShutdownSequence& sequence);
+    static void exit_ready(ShutdownSequence& sequence);
+
+    static constexpr Row TRANSITIONS[] = {
+        { Core::Fsm::any<State>(), Event::GLV_OFF, State::GLV_OFF, nullptr, nullptr },
+        { State::GLV_OFF, Event::GLV_ON, State::TS_OFF, nullptr, nullptr },
+
+        { State::TS_OFF, Event::SHUTDOWN_CLOSED, State::PRECHARGE, nullptr, nullptr },
+        { State::TS_OFF, Event::AMS_FAULT, State::AMS_LOCKOUT, nullptr, nullptr },
+        { State::TS_OFF, Event::IMD_FAULT, State::IMD_LOCKOUT, nullptr, nullptr },
+        { State::TS_OFF, Event::BRAKE_OVERTRAVEL, State::BRAKE_LOCKOUT, nullptr, nullptr },
+
+        { State::PRECHARGE, Event::PRECHARGE_DONE, State::TS_ENERGIZED, nullptr, nullptr },
+        { State::PRECHARGE, Event::SHUTDOWN_OPENED, State::TS_OFF, nullptr, nullptr },
+        { State::PRECHARGE, Event::AMS_FAULT, State::AMS_LOCKOUT, nullptr, nullptr },
+        { State::PRECHARGE, Event::IMD_FAULT, State::IMD_LOCKOUT, nullptr, nullptr },
+        { State::PRECHARGE, Event::BRAKE_OVERTRAVEL, State::BRAKE_LOCKOUT, nullptr, nullptr },
+
+        { State::TS_ENERGIZED, Event::START, State::READY_TO_DRIVE, &brake_pressed, nullptr },
+        { State::TS_ENERGIZED, Event::SHUTDOWN_OPENED, State::TS_OFF, nullptr, nullptr },
+        { State::TS_ENERGIZED, Event::AMS_FAULT, State::AMS_LOCKOUT, nullptr, nullptr },
+        { State::TS_ENERGIZED, Event::IMD_FAULT, State::IMD_LOCKOUT, nullptr, nullptr },
+        { State::TS_ENERGIZED, Event::BRAKE_OVERTRAVEL, State::BRAKE_LOCKOUT, nullptr, nullptr },
+
+        { State::READY_TO_DRIVE, Event::STOP, State::TS_ENERGIZED, nullptr, nullptr },
+        { State::READY_TO_DRIVE, Event::SHUTDOWN_OPENED, State::TS_OFF, nullptr, nullptr },
+        { State::READY_TO_DRIVE, Event::AMS_FAULT, State::AMS_LOCKOUT, nullptr, nullptr },
+        { State::READY_TO_DRIVE, Event::IMD_FAULT, State::IMD_LOCKOUT, nullptr, nullptr },
+        { State::READY_TO_DRIVE, Event::BRAKE_OVERTRAVEL, State::BRAKE_LOCKOUT, nullptr, nullptr },
+
+        { State::AMS_LOCKOUT, Event::AMS_RESET, State::TS_OFF, nullptr, nullptr },
+        { State::IMD_LOCKOUT, Event::IMD_RESET, State::TS_OFF, nullptr, nullptr },
+        { State::BRAKE_LOCKOUT, Event::BRAKE_OVERTRAVEL_RESET, State::TS_OFF, nullptr, nullptr },
+    };
+
+    static constexpr Hooks HOOKS[STATES] = {
+        { nullptr, nullptr },           // GLV_OFF
+        { nullptr, nullptr },           // TS_OFF
+        { nullptr, nullptr },           // PRECHARGE
+        { nullptr, nullptr },           // TS_ENERGIZED
+        { &enter_ready, &exit_ready },  // READY_TO_DRIVE
+        { nullptr, nullptr },           // AMS_LOCKOUT
+        { nullptr, nullptr },           // IMD_LOCKOUT
+        { nullptr, nullptr },           // BRAKE_LOCKOUT
+    };
+};
+
+/**
+ * @brief Shutdown and ready-to-drive sequence (EV 7.7, EV 7.8, EV 9.2.1)
+ *
+ * A Core::Fsm table of the rules' state diagram, fed by the shutdown circuit inputs, the
+ * pedals and CAN. Precharge completes once the inverter's DC link voltage (general data 1,
+ * 0x20) reaches precharge_permille of the pack voltage reported by the BMS (0x001).
+ * Ready to drive needs a rising edge of the start button with the brake pressed, so a start
+ * button held through a shutdown never re-arms the car (EV 7.7.3). Faults move to their
+ * lockout from TS off or any tractive system state, and only their reset leaves it.
+ *
+ * The ready-to-drive sound starts with the transition and poll() stops it after sound_us,
+ * which is kept within the 1 to 3 second window. Leaving ready to drive stops it at once.
+ * Entering TS off with the shutdown circuit still closed goes straight on to precharge.
+ **/
+class ShutdownSequence {
+public:
+    struct Config {
+        uint16_t brake_threshold;       /**< Brake travel counted as pressed, tenths of a percent */
+        uint16_t precharge_permille;    /**< DC link voltage that completes precharge, per mille of the pack voltage */
+        uint16_t pack_mv_per_count;     /**< BMS packVoltage resolution, Orion sends 100 mV counts */
+        uint32_t voltage_timeout_us;    /**< Voltages older than this never complete precharge */
+        uint32_t sound_us;              /**< Ready-to-drive sound duration */
+    };
+
+    struct Statistics {
+        uint32_t sounds;                /**< Ready-to-drive sounds started */
+        uint32_t sounds_cut;            /**< Sounds stopped early because ready to drive was left */
+        uint32_t last_sound_us;         /**< Duration of the last finished sound */
+        uint32_t starts_refused;        /**< Start presses refused, e.g. without the brake */
+    };
+
+    typedef Core::Fsm::StateMachine<ShutdownTable> Machine;
+    typedef Machine::Histogram Histogram;
+
+    // EV 9.2.1 limits of the ready-to-drive sound.
+    static constexpr uint32_t SOUND_MIN_US = 1000000;
+    static constexpr uint32_t SOUND_MAX_US = 3000000;
+
+    SensorRange brake = { 0, 4095 };
+    Config config = { 100, 900, 100, 500000, 2000000 };
+
+    /**
+     * @param lock Lock shared by the tasks feeding the sequence, can be nullptr
+     **/
+    explicit ShutdownSequence(Core::iClockStrategy* clock, uint8_t node = Inverter::DTIX50::DEFAULT_NODE, Core::iLockStrategy* lock = nullptr);
+
+    void set_state_listener(VehicleStateListener listener, void* context);
+    void set_sound_listener(SoundListener listener, void* context);
+    // Marked on entering ready to drive, with the lock held.
+    void set_ready_milestone(Core::Startup::MilestoneHook hook);
+
+    // Enters GLV off.
+    void start();
+
+    /**
+     * @brief Feeds an event
+     * @param observed_us When the event happened, for the transition latency
+     * @returns true if it caused a transition, false otherwise
+     **/
+    bool dispatch(VehicleEvent event, uint64_t observed_us);
+    bool dispatch(VehicleEvent event);
+
+    // GLVMS and both side BRBs, dispatches on a change.
+    void set_glv(bool on);
+    // Cockpit BRB and TSMS, dispatches on a change.
+    void set_shutdown(bool closed);
+    // Start button level, a rising edge dispatches START or STOP.
+    void set_start(bool pressed);
+
+    // Tracks whether the brake is pressed.
+    void update(const PedalSample& sample);
+
+    /**
+     * @brief Feeds a received frame, ignores everything but the DC link and pack voltages
+     * @returns true if the frame was used, false otherwise
+     **/
+    bool dispatch(const CAN::Frame& frame);
+
+    // Stops the ready-to-drive sound once it has lasted long enough.
+    void poll();
+
+    VehicleState state();
+    // The motor controller may respond to the accelerator, read by the torque task.
+    bool ready() const { return m_ready.load(std::memory_order_acquire); }
+    bool sound() const { return m_sound.load(std::memory_order_relaxed); }
+
+    // Written by the feeding tasks, read it once they are stopped.
+    const Histogram& latency() const { return m_machine.latency(); }
+    Statistics statistics();
+
+private:
+    friend struct ShutdownTable;
+
+    Core::iClockStrategy* m_clock;
+    Core::iLockStrategy* m_lock;
+    uint32_t m_voltage_identifier;
+    Machine m_machine;
+
+    VehicleStateListener m_state_listener;
+    void* m_state_context;
+    SoundListener m_sound_listener;
+    void* m_sound_context;
+    Core::Startup::MilestoneHook m_ready_milestone;
+
+    bool m_glv;
+    bool m_shutdown_closed;
+    bool m_start_pressed;
+    bool m_brake_pressed;
+
+    int32_t m_link_mv;
+    uint64_t m_link_at;
+    int32_t m_pack_mv;
+    uint64_t m_pack_at;
+
+    std::atomic<bool> m_ready;
+    std::atomic<bool> m_sound;
+    uint64_t m_sound_since;
+
+    Statistics m_statistics;
+
+    // What feeding an event changed, reported once the lock is released
+    struct Outcome {
+        bool taken;
+        VehicleState from;
+        VehicleState to;
+        bool sound_was;
+    };
+
+    // Feeds an event with the lock held, follows up on TS off with the circuit still closed
+    Outcome transition(VehicleEvent event, uint64_t observed_us);
+    void notify(const Outcome& outcome);
+
+    bool precharged(uint64_t now) const;
+    uint32_t sound_duration() const;
+    void stop_sound(uint64_t now);
+};
+
+} // namespace Pedals
+
+#endif // PEDALS_SHUTDOWN_SEQUENCE_H
@@ -0,0 +1,35 @@
+#include "torque_map.h"
+
+namespace Pedals {
+
+TorqueMap::TorqueMap() {
+    m_travel[0] = 0;
+    m_torque[0] = 0;
+    m_travel[1] = TRAVEL_FULL;
+    m_torque[1] = TORQUE_FULL;
+    m_count = 2;
+}
+
+bool TorqueMap::set(const Point* points, uint32_t count) {
+    if (points == nullptr || count < 2 || count > PEDALS_TORQUE_MAP_POINTS) {
+        return false;
+    }
+    for (uint32_t i = 1; i < count; i++) {
+        if (points[i].travel <= points[i - 1].travel) {
+            return false;
+        }
+    }
+
+    for (uint32_t i = 0; i < count; i++) {
+        m_travel[i] = points[i].travel;
+        m_torque[i] = points[i].torque;
+    }
+    m_count = count;
+    return true;
+}
+
+int16_t TorqueMap::map(uint16_t travel) const {
+    return Core::Lut::interpolate(m_travel, m_torque, m_count, travel);
+}
+
+} // namespace Pedals
@@ -0,0 +1,52 @@
+#ifndef PEDALS_TORQUE_MAP_H
+#define PEDALS_TORQUE_MAP_H
+
+#include <stdint.h>
+
+#include "core/core.h"
+#include "types.h"
+
+// Maximum number of points in a torque map.
+#ifndef PEDALS_TORQUE_MAP_POINTS
+#define PEDALS_TORQUE_MAP_POINTS 8
+#endif
+
+namespace Pedals {
+
+/**
+ * @brief Piecewise-linear pedal travel to torque request map in integer math
+ *          Defaults to a straight line from no torque at rest to full torque at full travel.
+ **/
+class TorqueMap {
+public:
+    struct Point {
+        uint16_t travel;    /**< Pedal travel, tenths of a percent */
+        int16_t torque;     /**< Torque request, tenths of a percent */
+    };
+
+    TorqueMap();
+
+    /**
+     * @brief Replaces the map
+     * @param points Points sorted by strictly increasing travel
+     * @returns true if the map was replaced, false if the points are invalid.
+     **/
+    bool set(const Point* points, uint32_t count);
+
+    /**
+     * @returns The torque request for a pedal travel, held flat beyond the first and last point
+     **/
+    int16_t map(uint16_t travel) const;
+
+    uint32_t size() const { return m_count; }
+
+private:
+    // Split axis and values for the table search
+    uint16_t m_travel[PEDALS_TORQUE_MAP_POINTS];
+    int16_t m_torque[PEDALS_TORQUE_MAP_POINTS];
+    uint32_t m_count;
+};
+
+} // namespace Pedals
+
+#endif // PEDALS_TORQUE_MAP_H
@@ -0,0 +1,124 @@
+#include "torque_pipeline.h"
+
+using namespace Inverter::DTIX50;
+
+namespace Pedals {
+
+TorquePipeline::TorquePipeline(std::shared_ptr<CAN::Provider> provider, iPedalSource* source, Core::iClockStrategy* clock, std::unique_ptr<Core::iThreadStrategy> thread_strategy, uint8_t node) {
+    m_provider = provider;
+    m_source = source;
+    m_clock = clock;
+    m_thread = std::move(thread_strategy);
+    m_identifier = identifier(Packet::SET_RELATIVE_AC_CURRENT, node);
+
+    m_started = false;
+    m_shouldStop = false;
+    m_command = 0;
+    m_fault = PedalFault::NONE;
+    m_statistics = {};
+
+    m_thread->setup("pedals.torque", // name
+                    0x28U, // priority - osPriorityHigh
+                    0x01U  // attributes - osThreadJoinable
+                   );
+}
+
+void TorquePipeline::start() {
+    if (m_started) return;
+
+    m_shouldStop = false;
+    m_thread->create(TorquePipeline::pipeline, this);
+
+    m_started = true;
+}
+
+void TorquePipeline::stop() {
+    if (!m_started) return;
+
+    m_shouldStop = true;
+    m_thread->join();
+
+    m_started = false;
+}
+
+int16_t TorquePipeline::limit(int16_t request) const {
+    if (request > max_torque) {
+        request = max_torque;
+    }
+    if (request < 0) {
+        request = 0;
+    }
+    int16_t command = m_command.load(std::memory_order_relaxed);
+    if (request > command && request - command > max_step) {
+        request = (int16_t)(command + max_step);
+    }
+    return request;
+}
+
+bool TorquePipeline::cycle() {
+    PedalSample sample;
+    uint16_t travel = 0;
+    PedalFault fault;
+
+    if (m_source->sample(sample)) {
+        fault = plausibility.check(sample, travel);
+    } else {
+        sample.timestamp_us = m_clock->micros();
+        fault = PedalFault::NO_SAMPLE;
+    }
+    m_fault.store(fault, std::memory_order_relaxed);
+
+    int16_t request = 0;
+    if (fault == PedalFault::NONE) {
+        request = limit(torque_map.map(travel));
+    } else {
+        m_statistics.faults++;
+    }
+    m_command.store(request, std::memory_order_relaxed);
+
+    Inverter::Command::SetRelativeACCurrent command = { Inverter::DeciPercent::from_raw(request), 0xFFFFFFFFFFFF };
+    CAN::Frame frame(m_identifier, &command);
+    frame.extd = 1;
+
+    // Never wait on the driver, a late torque command is worse than a dropped one.
+    bool sent = m_provider->transmit(frame, 0);
+
+    uint64_t now = m_clock->micros();
+    m_latency.record(now > sample.timestamp_us ? (uint32_t)(now - sample.timestamp_us) : 0);
+    m_statistics.cycles++;
+    if (!sent) {
+        m_statistics.transmit_failures++;
+    }
+    return sent;
+}
+
+void TorquePipeline::pipeline(void* s) {
+    TorquePipeline* self = (TorquePipeline*)s;
+    uint64_t release = self->m_clock->micros();
+
+    while (!self->m_shouldStop) {
+        uint64_t now = self->m_clock->micros();
+        self->m_jitter.record(now > release ? (uint32_t)(now - release) : 0);
+
+        self->cycle();
+
+        release += self->period_us;
+        now = self->m_clock->micros();
+        if (now >= release + self->period_us) {
+            // Too far behind to catch up, skip the missed releases
+            self->m_statistics.overruns++;
+            release = now;
+        } else if (release > now) {
+            self->m_thread->sleep((uint32_t)((release - now + 999) / 1000));
+        }
+    }
+
+    // Leave the inverter with a zero torque request
+    Inverter::Command::SetRelativeACCurrent zero = { Inverter::DeciPercent::from_raw(0), 0xFFFFFFFFFFFF };
+    CAN::Frame frame(self->m_identifier, &zero);
+    frame.extd = 1;
+    self->m_provider->transmit(frame, 1000);
+    self->m_command.store(0, std::memory_order_relaxed);
+}
+
+} // namespace Pedals
@@ -0,0 +1,98 @@
+#ifndef PEDALS_TORQUE_PIPELINE_H
+#define PEDALS_TORQUE_PIPELINE_H
+
+#include <atomic>
+#include <memory>
+#include <stdint.h>
+
+#include "core/core.h"
+#include "can/can.h"
+#include "inverter/DTIX50.h"
+#include "i_pedal_source.h"
+#include "plausibility.h"
+#include "torque_map.h"
+#include "types.h"
+
+namespace Pedals {
+
+/**
+ * @brief Periodic pedal to torque command pipeline for a DTI X50 inverter
+ *
+ * Every cycle reads the pedals, checks plausibility, maps travel to a torque request, limits
+ * it and sends it as SetRelativeACCurrent without waiting for room in the driver queue. A
+ * fault commands zero torque. Cycles are released on a fixed schedule rather than a fixed
+ * sleep, so time spent in a cycle does not stretch the period.
+ *
+ * The hot path uses integer math only and never allocates. The time from sampling to the
+ * frame being handed to the driver and the lateness of each release are kept in histograms.
+ * Releases are never early, how late they can be depends on the sleep granularity of the
+ * thread strategy, one tick on FreeRTOS.
+ **/
+class TorquePipeline {
+public:
+    struct Statistics {
+        uint32_t cycles;                /**< Cycles run */
+        uint32_t faults;                /**< Cycles that commanded zero torque because of a fault */
+        uint32_t transmit_failures;     /**< Commands the driver did not accept */
+        uint32_t overruns;              /**< Releases missed by more than a full period */
+    };
+
+    typedef Core::Log2Histogram<24> Histogram;
+
+    // Cycle period in microseconds, 1 kHz by default.
+    uint32_t period_us = 1000;
+    // Largest torque request, tenths of a percent.
+    int16_t max_torque = TORQUE_FULL;
+    // Largest torque increase per cycle, tenths of a percent. Decreases are never limited.
+    int16_t max_step = TORQUE_FULL;
+
+    Plausibility plausibility;
+    TorqueMap torque_map;
+
+    TorquePipeline(std::shared_ptr<CAN::Provider> provider, iPedalSource* source, Core::iClockStrategy* clock, std::unique_ptr<Core::iThreadStrategy> thread_strategy, uint8_t node = Inverter::DTIX50::DEFAULT_NODE);
+
+    void start();
+    void stop();
+
+    bool started() { return m_started; }
+
+    /**
+     * @brief Runs one sample to transmit pass
+     *          Called by the pipeline task, exposed so the pipeline can be driven directly.
+     * @returns true if the command was handed to the driver, false otherwise.
+     **/
+    bool cycle();
+
+    // Last torque request sent, tenths of a percent, readable from any task.
+    int16_t command() const { return m_command.load(std::memory_order_relaxed); }
+    PedalFault fault() const { return m_fault.load(std::memory_order_relaxed); }
+
+    // Histograms are written by the pipeline task, read them while it is stopped.
+    const Histogram& latency() const { return m_latency; }
+    const Histogram& jitter() const { return m_jitter; }
+
+    Statistics statistics() const { return m_statistics; }
+
+private:
+    bool m_started;
+    std::atomic<bool> m_shouldStop;
+    std::unique_ptr<Core::iThreadStrategy> m_thread;
+    std::shared_ptr<CAN::Provider> m_provider;
+    iPedalSource* m_source;
+    Core::iClockStrategy* m_clock;
+    uint32_t m_identifier;
+
+    std::atomic<int16_t> m_command;
+    std::atomic<PedalFault> m_fault;
+    Statistics m_statistics;
+    Histogram m_latency;
+    Histogram m_jitter;
+
+    int16_t limit(int16_t request) const;
+
+    static void pipeline(void* s);
+};
+
+} // namespace Pedals
+
+#endif // PEDALS_TORQUE_PIPELINE_H
@@ -0,0 +1,61 @@
+#ifndef PEDALS_TYPES_H
+#define PEDALS_TYPES_H
+
+#include <stdint.h>
+
+namespace Pedals {
+
+// Full pedal travel and full torque request, both in tenths of a percent.
+constexpr uint16_t TRAVEL_FULL = 1000;
+constexpr int16_t TORQUE_FULL = 1000;
+
+/**
+ * @brief Raw readings of the pedal sensors taken at the same instant
+ * @param apps1: First accelerator pedal position sensor, in ADC counts
+ * @param apps2: Second accelerator pedal position sensor, in ADC counts
+ * @param brake: Brake pressure or position sensor, in ADC counts
+ * @param timestamp_us: Time the readings were taken, from the pipeline's clock
+ **/
+struct PedalSample {
+    uint16_t apps1;
+    uint16_t apps2;
+    uint16_t brake;
+    uint64_t timestamp_us;
+};
+
+/**
+ * @brief Calibrated end points of a pedal sensor in ADC counts
+ *          pressed may be below released for sensors wired in reverse.
+ **/
+struct SensorRange {
+    uint16_t released;
+    uint16_t pressed;
+};
+
+enum class PedalFault : uint8_t {
+    NONE,
+    APPS1_RANGE,    /**< APPS1 outside its calibrated range but not at a rail */
+    APPS2_RANGE,    /**< APPS2 outside its calibrated range but not at a rail */
+    APPS1_OPEN_OR_GROUND,   /**< APPS1 at the ground rail, open circuit or short to ground */
+    APPS2_OPEN_OR_GROUND,   /**< APPS2 at the ground rail, open circuit or short to ground */
+    APPS1_SHORT_TO_SUPPLY,  /**< APPS1 at the sensor supply rail */
+    APPS2_SHORT_TO_SUPPLY,  /**< APPS2 at the sensor supply rail */
+    DISAGREEMENT,   /**< The two APPS disagree for longer than the persistence time */
+    NO_SAMPLE,      /**< The pedal source did not deliver a reading */
+};
+
+/**
+ * @brief Converts a raw reading to pedal travel in tenths of a percent
+ * @returns Travel relative to the calibrated range, below 0 or above TRAVEL_FULL when outside it
+ **/
+inline int32_t travel(uint16_t raw, const SensorRange& range) {
+    int32_t span = (int32_t)range.pressed - (int32_t)range.released;
+    if (span == 0) {
+        return 0;
+    }
+    return ((int32_t)raw - (int32_t)range.released) * TRAVEL_FULL / span;
+}
+
+} // namespace Pedals
+
+#endif // PEDALS_TYPES_H
@@ -0,0 +1,176 @@
+#include "cooling_controller.h"
+
+#include <cstring>
+
+using namespace Inverter::DTIX50;
+
+namespace Pump {
+
+constexpr uint16_t CoolingController::FULL;
+constexpr uint16_t CoolingController::UNWRITTEN;
+
+CoolingController::CoolingController(iPwmOutput* pump, iPwmOutput* fan, Core::iClockStrategy* clock, std::unique_ptr<Core::iThreadStrategy> thread_strategy, uint8_t node, Core::iLockStrategy* lock) {
+    m_pump = pump;
+    m_fan = fan;
+    m_clock = clock;
+    m_lock = lock;
+    m_thread = std::move(thread_strategy);
+    m_identifier = identifier(Packet::GENERAL_DATA_3, node);
+
+    m_started = false;
+    m_shouldStop = false;
+
+    m_controller_temp = 0;
+    m_motor_temp = 0;
+    m_received_at = 0;
+    m_received = false;
+
+    m_stepped = false;
+    m_last_step = 0;
+    m_integral = 0;
+    m_error = 0;
+    m_pump_written = UNWRITTEN;
+    m_fan_written = UNWRITTEN;
+    m_statistics = {};
+
+    m_thread->setup("pump.cooling", // name
+                    0x10U, // priority - osPriorityBelowNormal
+                    0x01U  // attributes - osThreadJoinable
+                   );
+}
+
+void CoolingController::start() {
+    if (m_started) return;
+
+    m_shouldStop = false;
+    m_thread->create(CoolingController::controller, this);
+
+    m_started = true;
+}
+
+void CoolingController::stop() {
+    if (!m_started) return;
+
+    m_shouldStop = true;
+    m_thread->join();
+
+    m_started = false;
+}
+
+bool CoolingController::dispatch(const CAN::Frame& frame) {
+    if (!frame.extd || frame.identifier != m_identifier) return false;
+    Inverter::Message22 message;
+    memcpy(&message, frame.data, sizeof(message));
+    update(message);
+    return true;
+}
+
+void CoolingController::update(const Inverter::Message22& message) {
+    uint64_t now = m_clock->micros();
+    Core::LockGuard guard(m_lock);
+    m_controller_temp = Raw::controller_temp(message);
+    m_motor_temp = Raw::motor_temp(message);
+    m_received_at = now;
+    m_received = true;
+    m_statistics.updates++;
+}
+
+uint16_t CoolingController::pump_demand(int32_t error, uint32_t elapsed_ms) {
+    int64_t integral = m_integral + (int64_t)error * elapsed_ms;
+    if (config.ki != 0) {
+        // Never more integral than it takes to swing the output across its range
+        int64_t limit = (int64_t)FULL * 10000 / config.ki;
+        integral = integral > limit ? limit : integral < -limit ? -limit : integral;
+    }
+
+    int32_t p = (int32_t)config.kp * error / 10;
+    int32_t demand = config.pump_min + p + (int32_t)(config.ki * integral / 10000);
+
+    // Conditional integration, hold the integral while the output is pinned in the error's direction
+    bool pinned_high = demand >= FULL && error > 0;
+    bool pinned_low = demand <= config.pump_min && error < 0;
+    if (!pinned_high && !pinned_low) {
+        m_integral = integral;
+    }
+
+    return (uint16_t)(demand > FULL ? FULL : demand < config.pump_min ? config.pump_min : demand);
+}
+
+void CoolingController::drive(iPwmOutput* output, uint16_t& written, uint16_t demand) {
+    if (written != UNWRITTEN) {
+        uint16_t change = demand > written ? demand - written : written - demand;
+        // Full and off are always reached exactly, anything else waits for a full step
+        bool end = (demand == FULL || demand == 0) && demand != written;
+        if (change < config.resolution && !end) return;
+    }
+
+    if (output->write(demand)) {
+        written = demand;
+        m_statistics.writes++;
+    } else {
+        m_statistics.write_failures++;
+    }
+}
+
+void CoolingController::step() {
+    uint64_t now = m_clock->micros();
+    int16_t controller_temp;
+    int16_t motor_temp;
+    bool fresh;
+    {
+        Core::LockGuard guard(m_lock);
+        controller_temp = m_controller_temp;
+        motor_temp = m_motor_temp;
+        fresh = m_received && now - m_received_at <= config.input_timeout_us;
+    }
+
+    uint32_t elapsed_ms = m_stepped ? (uint32_t)((now - m_last_step) / 1000) : 0;
+    // A stalled task must not dump its whole absence into the integral
+    uint32_t longest_ms = 4 * period_us / 1000;
+    elapsed_ms = elapsed_ms > longest_ms ? longest_ms : elapsed_ms;
+    m_stepped = true;
+    m_last_step = now;
+    m_statistics.steps++;
+
+    uint16_t pump = FULL;
+    uint16_t fan = FULL;
+    if (fresh) {
+        int32_t controller_error = (int32_t)controller_temp - config.controller_target;
+        int32_t motor_error = (int32_t)motor_temp - config.motor_target;
+        m_error = controller_error > motor_error ? controller_error : motor_error;
+
+        pump = pump_demand(m_error, elapsed_ms);
+        int32_t curve = fan_curve.lookup((int16_t)(m_error > INT16_MAX ? INT16_MAX : m_error < INT16_MIN ? INT16_MIN : m_error));
+        fan = (uint16_t)(curve < 0 ? 0 : curve > FULL ? FULL : curve);
+    } else {
+        m_statistics.stale++;
+    }
+
+    drive(m_pump, m_pump_written, pump);
+    drive(m_fan, m_fan_written, fan);
+}
+
+void CoolingController::controller(void* s) {
+    CoolingController* self = (CoolingController*)s;
+    uint64_t release = self->m_clock->micros();
+
+    while (!self->m_shouldStop) {
+        self->step();
+
+        release += self->period_us;
+        uint64_t now = self->m_clock->micros();
+        if (release > now) {
+            self->m_thread->sleep((uint32_t)((release - now + 999) / 1000));
+        } else {
+            release = now;
+        }
+    }
+
+    // Leave the cooling running flat out
+    self->m_pump->write(FULL);
+    self->m_fan->write(FULL);
+    self->m_pump_written = FULL;
+    self->m_fan_written = FULL;
+}
+
+} // namespace Pump
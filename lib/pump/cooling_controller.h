@@ -0,0 +1,127 @@
+#ifndef PUMP_COOLING_CONTROLLER_H
+#define PUMP_COOLING_CONTROLLER_H
+
+#include <atomic>
+#include <memory>
+#include <stdint.h>
+
+#include "core/core.h"
+#include "can/can.h"
+#include "inverter/DTIX50.h"
+#include "i_pwm_output.h"
+
+namespace Pump {
+
+/**
+ * @brief Closed-loop coolant pump and radiator fan control from the inverter temperatures
+ *
+ * The temperatures come from the general data 3 broadcast (0x22) of one inverter. The error is
+ * the larger of the controller and motor temperature above their targets, so the component
+ * closest to its limit sets the cooling. The pump runs a fixed-point PI loop on that error
+ * above a minimum flow, with conditional integration against windup. The fan follows a curve
+ * of the same error. Without fresh temperatures both outputs run flat out, which is also what
+ * they are left at on stop.
+ *
+ * A step is a handful of integer operations. An output is only written once the demand has
+ * moved by at least `resolution` from what was last written, so a steady temperature causes
+ * no PWM updates at all.
+ **/
+class CoolingController {
+public:
+    struct Config {
+        int16_t controller_target;  /**< Inverter temperature the loop regulates to, tenths of a degree */
+        int16_t motor_target;       /**< Motor temperature the loop regulates to, tenths of a degree */
+        uint16_t kp;                /**< Pump duty per degree of error, tenths of a percent */
+        uint16_t ki;                /**< Pump duty per degree second of error, tenths of a percent */
+        uint16_t pump_min;          /**< Pump duty floor while temperatures are known, tenths of a percent */
+        uint16_t resolution;        /**< Smallest duty change written to an output, tenths of a percent */
+        uint32_t input_timeout_us;  /**< Temperatures older than this run both outputs flat out */
+    };
+
+    struct Statistics {
+        uint32_t steps;             /**< Control steps run */
+        uint32_t updates;           /**< Temperature broadcasts received */
+        uint32_t writes;            /**< Duty changes written to the outputs */
+        uint32_t write_failures;    /**< Writes the outputs did not take, retried next step */
+        uint32_t stale;             /**< Steps run without fresh temperatures */
+    };
+
+    // Fan duty in tenths of a percent over the error in tenths of a degree.
+    typedef Core::Lut::Table<int16_t, int16_t, 4> FanCurve;
+
+    static constexpr uint16_t FULL = 1000;
+
+    // Step period in microseconds, 10 Hz by default.
+    uint32_t period_us = 100000;
+
+    Config config = { 500, 800, 40, 5, 300, 10, 1000000 };
+    // Off until the hottest component reaches its target, full 15 degrees above it.
+    FanCurve fan_curve = { { 0, 50, 100, 150 }, { 0, 300, 700, 1000 } };
+
+    /**
+     * @param lock Lock shared by the receiving and controlling tasks, can be nullptr
+     **/
+    CoolingController(iPwmOutput* pump, iPwmOutput* fan, Core::iClockStrategy* clock, std::unique_ptr<Core::iThreadStrategy> thread_strategy,
+                      uint8_t node = Inverter::DTIX50::DEFAULT_NODE, Core::iLockStrategy* lock = nullptr);
+
+    void start();
+    void stop();
+
+    bool started() { return m_started; }
+
+    /**
+     * @brief Feeds a received frame, ignores everything but the inverter's temperature broadcast
+     * @returns true if the frame was used, false otherwise
+     **/
+    bool dispatch(const CAN::Frame& frame);
+    void update(const Inverter::Message22& message);
+
+    /**
+     * @brief Runs one control step
+     *          Called by the controller task, exposed so the controller can be driven directly.
+     **/
+    void step();
+
+    // Last duty written to each output, tenths of a percent.
+    uint16_t pump() const { return m_pump_written; }
+    uint16_t fan() const { return m_fan_written; }
+    // Error the last step acted on, tenths of a degree.
+    int32_t error() const { return m_error; }
+
+    Statistics statistics() const { return m_statistics; }
+
+private:
+    static constexpr uint16_t UNWRITTEN = 0xFFFF;
+
+    bool m_started;
+    std::atomic<bool> m_shouldStop;
+    std::unique_ptr<Core::iThreadStrategy> m_thread;
+    Core::iClockStrategy* m_clock;
+    Core::iLockStrategy* m_lock;
+    iPwmOutput* m_pump;
+    iPwmOutput* m_fan;
+    uint32_t m_identifier;
+
+    // Written by the receiving task
+    int16_t m_controller_temp;
+    int16_t m_motor_temp;
+    uint64_t m_received_at;
+    bool m_received;
+
+    bool m_stepped;
+    uint64_t m_last_step;
+    int64_t m_integral;
+    int32_t m_error;
+    uint16_t m_pump_written;
+    uint16_t m_fan_written;
+    Statistics m_statistics;
+
+    uint16_t pump_demand(int32_t error, uint32_t elapsed_ms);
+    void drive(iPwmOutput* output, uint16_t& written, uint16_t demand);
+
+    static void controller(void* s);
+};
+
+} // namespace Pump
+
+#endif // PUMP_COOLING_CONTROLLER_H
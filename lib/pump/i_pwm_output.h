@@ -0,0 +1,21 @@
+#ifndef PUMP_I_PWM_OUTPUT_H
+#define PUMP_I_PWM_OUTPUT_H
+
+#include <stdint.h>
+
+namespace Pump {
+
+/**
+ * @brief PWM output abstract interface
+ *          On the ESP32-S3 this would be an LEDC channel, in tests a recording mock.
+ * @fn write: Sets the duty cycle in tenths of a percent. Returns false if the output did not take it.
+ */
+class iPwmOutput {
+public:
+    virtual ~iPwmOutput() = default;
+    virtual bool write(uint16_t duty_permille) = 0;
+};
+
+} // namespace Pump
+
+#endif // PUMP_I_PWM_OUTPUT_H
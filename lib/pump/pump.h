@@ -2,4 +2,7 @@
 #ifndef PUMP_H
 #define PUMP_H
 
-#endif // PUMP_H
\ No newline at end of file
+#include "cooling_controller.h"
+#include "i_pwm_output.h"
+
+#endif // PUMP_H
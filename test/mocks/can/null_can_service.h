@@ -0,0 +1,57 @@
+#ifndef NULL_CAN_SERVICE_H
+#define NULL_CAN_SERVICE_H
+
+#include <cstdint>
+#include <can/service.h>
+
+using namespace CAN;
+
+namespace MOCKS {
+
+/**
+ * @brief Service that accepts everything and does no work
+ *
+ * Final and free of std::function so it measures the cost of the layers above the
+ * driver rather than the cost of the mock.
+ */
+class NullCanService final : public Service {
+public:
+    uint32_t transmitted = 0;
+    uint32_t received = 0;
+
+    const Result install_driver(const GeneralConfig*, const TimingConfig*, const FilterConfig*) override { return Result::OK; }
+    const Result uninstall_driver() override { return Result::OK; }
+    const Result start() override { return Result::OK; }
+    const Result stop() override { return Result::OK; }
+
+    const Result transmit(const Frame* frame, Tick) override {
+        transmitted += frame->data_length_code;
+        return Result::OK;
+    }
+
+    const Result receive(Frame* frame, Tick) override {
+        frame->identifier = received++;
+        return Result::OK;
+    }
+
+    const Result alerts(Alert* alerts, Tick) override {
+        *alerts = 0;
+        return Result::OK;
+    }
+
+    const Result reconfigure_alerts(Alert, Alert*) override { return Result::OK; }
+    const Result initiate_recovery() override { return Result::OK; }
+
+    const Result status_info(StatusInfo* status_info) override {
+        status_info->state = State::RUNNING;
+        return Result::OK;
+    }
+
+    const Result clear_transmit_queue() override { return Result::OK; }
+    const Result clear_receive_queue() override { return Result::OK; }
+    const Result reset_pin(const PIN) override { return Result::OK; }
+};
+
+}  // namespace MOCKS
+
+#endif // NULL_CAN_SERVICE_H
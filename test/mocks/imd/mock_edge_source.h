@@ -0,0 +1,64 @@
+#ifndef MOCK_EDGE_SOURCE_H
+#define MOCK_EDGE_SOURCE_H
+
+#include <cstdint>
+#include <deque>
+
+#include <imd/i_edge_source.h>
+
+namespace MOCKS {
+
+/**
+ * @brief Synthetic capture unit, hands out edges queued by the test
+ */
+class MockEdgeSource : public IMD::iEdgeSource {
+public:
+    bool started = false;
+    bool high = false;
+    std::deque<IMD::Edge> pending;
+
+    bool start() override {
+        started = true;
+        return true;
+    }
+
+    void stop() override {
+        started = false;
+    }
+
+    uint32_t read(IMD::Edge* edges, uint32_t capacity) override {
+        uint32_t count = 0;
+        while (count < capacity && !pending.empty()) {
+            edges[count++] = pending.front();
+            pending.pop_front();
+        }
+        return count;
+    }
+
+    bool level() override {
+        return high;
+    }
+
+    void push_back_rising(uint64_t timestamp_us) {
+        pending.push_back({ timestamp_us, true });
+    }
+
+    /**
+     * @brief Queues whole PWM periods starting with a rising edge
+     * @returns Time of the rising edge that would start the next period
+     */
+    uint64_t push_pwm(uint64_t start_us, uint32_t frequency_dhz, uint16_t duty_permille, uint32_t periods) {
+        uint64_t period = 10000000ULL / frequency_dhz;
+        uint64_t t = start_us;
+        for (uint32_t i = 0; i < periods; i++) {
+            pending.push_back({ t, true });
+            pending.push_back({ t + period * duty_permille / 1000, false });
+            t += period;
+        }
+        return t;
+    }
+};
+
+} // namespace MOCKS
+
+#endif // MOCK_EDGE_SOURCE_H
@@ -3,6 +3,13 @@
 #define MOCKS_H
 
 #include "can/mock_can_service.h"
+#include "can/null_can_service.h"
+#include "imd/mock_edge_source.h"
+#include "pedals/mock_adc_source.h"
+#include "pedals/mock_pedal_source.h"
+#include "pump/mock_pwm_output.h"
+#include "strategies/mock_clock_strategy.h"
+#include "strategies/native_clock_strategy.h"
 #include "strategies/native_lock_strategy.h"
 #include "strategies/native_thread_strategy.h"
 
@@ -0,0 +1,51 @@
+#ifndef MOCK_ADC_SOURCE_H
+#define MOCK_ADC_SOURCE_H
+
+#include <cstdint>
+#include <deque>
+
+#include <pedals/i_adc_source.h>
+
+namespace MOCKS {
+
+/**
+ * @brief Synthetic continuous ADC, hands out conversions queued by the test
+ */
+class MockAdcSource : public Pedals::iAdcSource {
+public:
+    bool started = false;
+    bool start_result = true;
+    std::deque<Pedals::AdcConversion> pending;
+
+    bool start() override {
+        started = start_result;
+        return start_result;
+    }
+
+    void stop() override {
+        started = false;
+    }
+
+    uint32_t read(Pedals::AdcConversion* conversions, uint32_t capacity) override {
+        uint32_t count = 0;
+        while (started && count < capacity && !pending.empty()) {
+            conversions[count++] = pending.front();
+            pending.pop_front();
+        }
+        return count;
+    }
+
+    // Queues one conversion of each channel in pattern order, repeated
+    void push_pattern(uint8_t apps1_channel, uint16_t apps1, uint8_t apps2_channel, uint16_t apps2,
+                      uint8_t brake_channel, uint16_t brake, uint32_t repeats = 1) {
+        for (uint32_t i = 0; i < repeats; i++) {
+            pending.push_back({ apps1_channel, apps1 });
+            pending.push_back({ apps2_channel, apps2 });
+            pending.push_back({ brake_channel, brake });
+        }
+    }
+};
+
+} // namespace MOCKS
+
+#endif // MOCK_ADC_SOURCE_H
@@ -0,0 +1,46 @@
+#ifndef MOCK_PEDAL_SOURCE_H
+#define MOCK_PEDAL_SOURCE_H
+
+#include <cstdint>
+
+#include <core/clock.h>
+#include <pedals/i_pedal_source.h>
+
+namespace MOCKS {
+
+/**
+ * @brief Synthetic pedal source returning fixed readings stamped with a clock
+ */
+class MockPedalSource : public Pedals::iPedalSource {
+public:
+    uint16_t apps1 = 0;
+    uint16_t apps2 = 0;
+    uint16_t brake = 0;
+    bool available = true;
+    uint32_t samples = 0;
+
+    explicit MockPedalSource(Core::iClockStrategy* clock) : m_clock(clock) {}
+
+    void set(uint16_t apps1, uint16_t apps2, uint16_t brake = 0) {
+        this->apps1 = apps1;
+        this->apps2 = apps2;
+        this->brake = brake;
+    }
+
+    bool sample(Pedals::PedalSample& sample) override {
+        if (!available) return false;
+        sample.apps1 = apps1;
+        sample.apps2 = apps2;
+        sample.brake = brake;
+        sample.timestamp_us = m_clock->micros();
+        samples++;
+        return true;
+    }
+
+private:
+    Core::iClockStrategy* m_clock;
+};
+
+} // namespace MOCKS
+
+#endif // MOCK_PEDAL_SOURCE_H
@@ -0,0 +1,32 @@
+#ifndef MOCK_PWM_OUTPUT_H
+#define MOCK_PWM_OUTPUT_H
+
+#include <cstdint>
+#include <vector>
+
+#include <pump/i_pwm_output.h>
+
+namespace MOCKS {
+
+/**
+ * @brief Records every duty written, can be told to refuse writes
+ */
+class MockPwmOutput : public Pump::iPwmOutput {
+public:
+    bool accept = true;
+    std::vector<uint16_t> writes;
+
+    bool write(uint16_t duty_permille) override {
+        if (!accept) return false;
+        writes.push_back(duty_permille);
+        return true;
+    }
+
+    uint16_t last() const {
+        return writes.empty() ? 0xFFFF : writes.back();
+    }
+};
+
+} // namespace MOCKS
+
+#endif // MOCK_PWM_OUTPUT_H
@@ -0,0 +1,30 @@
+#ifndef MOCK_CLOCK_STRATEGY_H
+#define MOCK_CLOCK_STRATEGY_H
+
+#include <cstdint>
+
+#include <core/clock.h>
+
+namespace MOCKS {
+
+/**
+ * @brief Manually driven clock for deterministic timing tests
+ *
+ * Time only moves when the test sets or advances it.
+ */
+class MockClockStrategy : public Core::iClockStrategy {
+public:
+    uint64_t now = 0;
+
+    uint64_t micros() override {
+        return now;
+    }
+
+    void advance(uint64_t us) {
+        now += us;
+    }
+};
+
+} // namespace MOCKS
+
+#endif // MOCK_CLOCK_STRATEGY_H
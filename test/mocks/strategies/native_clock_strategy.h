@@ -0,0 +1,29 @@
+#ifndef NATIVE_CLOCK_STRATEGY_H
+#define NATIVE_CLOCK_STRATEGY_H
+
+#include <chrono>
+#include <cstdint>
+
+#include <core/clock.h>
+
+namespace MOCKS {
+
+/**
+ * @brief Native clock strategy using std::chrono::steady_clock for timing on the host platform
+ */
+class NativeClockStrategy : public Core::iClockStrategy {
+public:
+    uint64_t micros() override {
+        return (uint64_t)std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    uint64_t nanos() {
+        return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+};
+
+} // namespace MOCKS
+
+#endif // NATIVE_CLOCK_STRATEGY_H
@@ -2,7 +2,6 @@
 #define NATIVE_LOCK_STRATEGY_H
 
 #include <mutex>
-#include <memory>
 
 #include <core/lock.h>
 
@@ -16,23 +15,19 @@ namespace MOCKS {
  */
 class NativeLockStrategy : public Core::iLockStrategy {
 private:
-    std::unique_ptr<std::mutex> mutex_;
+    std::mutex mutex_;
 
 public:
-    NativeLockStrategy() : mutex_(std::unique_ptr<std::mutex>(new std::mutex())) {}
+    NativeLockStrategy() = default;
     
     ~NativeLockStrategy() override = default;
     
     void lock() override {
-        if (mutex_) {
-            mutex_->lock();
-        }
+        mutex_.lock();
     }
     
     void unlock() override {
-        if (mutex_) {
-            mutex_->unlock();
-        }
+        mutex_.unlock();
     }
     
     // Disable copy and move for safety
@@ -0,0 +1,177 @@
+#include "test_main.h"
+#include <battery.h>
+#include <mocks.h>
+#include <cstdio>
+
+using namespace CAN;
+using namespace MOCKS;
+using namespace Battery;
+
+static Frame cell_frame(uint8_t cell, uint16_t voltage) {
+    uint8_t data[8] = { cell, (uint8_t)(voltage >> 8), (uint8_t)voltage, 0x80, 150, (uint8_t)(voltage >> 8), (uint8_t)voltage, 0 };
+    data[7] = cell_broadcast_checksum(data);
+    return Frame(CELL_BROADCAST_ID, data);
+}
+
+static Frame thermistor_frame(uint16_t thermistor, int8_t temperature) {
+    Message1838F380 message = { thermistor, (uint8_t)temperature, 0, 0, 0, 0, 0 };
+    Frame frame(THERMISTOR_BROADCAST_ID, &message);
+    frame.extd = 1;
+    return frame;
+}
+
+template<uint16_t Cells, uint16_t Thermistors>
+static void fill(Pack<Cells, Thermistors>& pack, uint16_t voltage, int8_t temperature) {
+    for (uint16_t i = 0; i < Cells; i++) {
+        TEST_ASSERT_TRUE(pack.dispatch(cell_frame((uint8_t)i, voltage)));
+    }
+    for (uint16_t i = 0; i < Thermistors; i++) {
+        TEST_ASSERT_TRUE(pack.dispatch(thermistor_frame(i, temperature)));
+    }
+}
+
+void test_kernels_statistics() {
+    const uint16_t voltages[] = { 37000, 36500, 37250, 36900, 37100 };
+    VoltageStatistics voltage;
+    statistics(voltages, 5, voltage);
+    TEST_ASSERT_EQUAL(36500, voltage.min);
+    TEST_ASSERT_EQUAL(37250, voltage.max);
+    TEST_ASSERT_EQUAL(36950, voltage.mean);
+    TEST_ASSERT_EQUAL(750, voltage.spread);
+
+    const int8_t temperatures[] = { -5, -3, -4 };
+    TemperatureStatistics temperature;
+    statistics(temperatures, 3, temperature);
+    TEST_ASSERT_EQUAL(-5, temperature.min);
+    TEST_ASSERT_EQUAL(-3, temperature.max);
+    TEST_ASSERT_EQUAL(-4, temperature.mean);
+    TEST_ASSERT_EQUAL(2, temperature.spread);
+
+    statistics(voltages, 0, voltage);
+    TEST_ASSERT_EQUAL(0, voltage.max);
+}
+
+void test_kernels_flags() {
+    const uint16_t values[] = { 10, 20, 30, 40 };
+    uint8_t flags[4];
+    TEST_ASSERT_EQUAL(2, flag_range(values, 4, 15, 35, 0x01, 0x02, flags));
+    TEST_ASSERT_EQUAL(0x01, flags[0]);
+    TEST_ASSERT_EQUAL(0x00, flags[1]);
+    TEST_ASSERT_EQUAL(0x02, flags[3]);
+
+    // Staleness is relative and survives the millisecond counter wrapping
+    const uint32_t seen[] = { 0xFFFFFF00, 0x00000010, 0x00000020, 0xFFFFFFFF };
+    TEST_ASSERT_EQUAL(1, flag_stale(seen, 4, 0x20, 0x30, 0x10, flags));
+    TEST_ASSERT_EQUAL(0x11, flags[0]);
+    TEST_ASSERT_EQUAL(0x00, flags[1]);
+    TEST_ASSERT_EQUAL(0x02, flags[3]);
+}
+
+void test_pack_demultiplexes_broadcasts() {
+    MockClockStrategy clock;
+    Pack<12, 4> pack(&clock);
+
+    TEST_ASSERT_TRUE(pack.dispatch(cell_frame(3, 36789)));
+    TEST_ASSERT_TRUE(pack.dispatch(thermistor_frame(2, -7)));
+    TEST_ASSERT_EQUAL(36789, pack.voltages()[3]);
+    TEST_ASSERT_EQUAL(150, pack.resistances()[3]);
+    TEST_ASSERT_EQUAL(-7, pack.temperatures()[2]);
+
+    // Out of range indexes and unrelated frames are ignored
+    TEST_ASSERT_FALSE(pack.dispatch(cell_frame(12, 36000)));
+    TEST_ASSERT_FALSE(pack.dispatch(thermistor_frame(4, 20)));
+    Message1 message = { 0, 0, 0, 0 };
+    TEST_ASSERT_FALSE(pack.dispatch(Frame(0x001, &message)));
+    TEST_ASSERT_EQUAL(0, pack.rejected());
+}
+
+void test_pack_rejects_corrupt_cell_broadcasts() {
+    MockClockStrategy clock;
+    Pack<12, 4> pack(&clock);
+
+    // Big-endian as sent by the BMS: cell 2, 3.7 V, 1.5 mOhm and shunting, checksum 0x86
+    uint8_t data[8] = { 0x02, 0x90, 0x88, 0x80, 0x96, 0x90, 0x88, 0x86 };
+    Frame frame(CELL_BROADCAST_ID, data);
+    TEST_ASSERT_TRUE(pack.dispatch(frame));
+    TEST_ASSERT_EQUAL(37000, pack.voltages()[2]);
+    TEST_ASSERT_EQUAL(150, pack.resistances()[2]);
+
+    Frame corrupt = cell_frame(4, 36000);
+    corrupt.data[1] ^= 0x01;
+    TEST_ASSERT_FALSE(pack.dispatch(corrupt));
+    Frame truncated = cell_frame(5, 36000);
+    truncated.data_length_code = 7;
+    TEST_ASSERT_FALSE(pack.dispatch(truncated));
+
+    TEST_ASSERT_EQUAL(2, pack.rejected());
+    TEST_ASSERT_EQUAL(0, pack.voltages()[4]);
+    TEST_ASSERT_EQUAL(0, pack.voltages()[5]);
+}
+
+void test_pack_scan_flags_cells() {
+    MockClockStrategy clock;
+    clock.now = 5000000;
+    Pack<12, 4> pack(&clock);
+
+    // Nothing received yet, everything is stale
+    PackSummary summary = pack.scan();
+    TEST_ASSERT_EQUAL(12, summary.cells_flagged);
+    TEST_ASSERT_EQUAL(4, summary.thermistors_flagged);
+    TEST_ASSERT_EQUAL(Flag::STALE | Flag::UNDER_VOLTAGE, pack.cell_flags(0));
+
+    fill(pack, 37000, 25);
+    summary = pack.scan();
+    TEST_ASSERT_TRUE(summary.ok());
+    TEST_ASSERT_EQUAL(37000, summary.voltage.mean);
+
+    pack.dispatch(cell_frame(5, 42500));
+    pack.dispatch(cell_frame(9, 27000));
+    pack.dispatch(thermistor_frame(1, 61));
+    summary = pack.scan();
+    TEST_ASSERT_FALSE(summary.ok());
+    TEST_ASSERT_EQUAL(2, summary.cells_flagged);
+    TEST_ASSERT_EQUAL(1, summary.thermistors_flagged);
+    TEST_ASSERT_EQUAL(Flag::OVER_VOLTAGE, pack.cell_flags(5));
+    TEST_ASSERT_EQUAL(Flag::UNDER_VOLTAGE, pack.cell_flags(9));
+    TEST_ASSERT_EQUAL(Flag::OVER_TEMPERATURE, pack.thermistor_flags(1));
+    TEST_ASSERT_EQUAL(9, summary.min_voltage_cell);
+    TEST_ASSERT_EQUAL(5, summary.max_voltage_cell);
+    TEST_ASSERT_EQUAL(15500, summary.voltage.spread);
+    TEST_ASSERT_EQUAL(1, summary.max_temperature_thermistor);
+
+    // Only cell 0 keeps reporting
+    clock.advance(1001000);
+    pack.dispatch(cell_frame(0, 37000));
+    summary = pack.scan();
+    TEST_ASSERT_EQUAL(11, summary.cells_flagged);
+    TEST_ASSERT_EQUAL(0, pack.cell_flags(0));
+    TEST_ASSERT_EQUAL(Flag::STALE, pack.cell_flags(1));
+}
+
+void test_pack_scan_cost() {
+    NativeClockStrategy clock;
+    static Pack<144, 60> pack(&clock);
+    fill(pack, 37000, 30);
+
+    const uint32_t SCANS = 10000;
+    uint32_t flagged = 0;
+    uint64_t start = clock.nanos();
+    for (uint32_t i = 0; i < SCANS; i++) {
+        flagged += pack.scan().cells_flagged;
+    }
+    uint64_t elapsed = clock.nanos() - start;
+    TEST_ASSERT_EQUAL(0, flagged);
+
+    char message[96];
+    snprintf(message, sizeof(message), "pack scan, 144 cells and 60 thermistors: %.2f us", (double)elapsed / SCANS / 1000.0);
+    TEST_MESSAGE(message);
+}
+
+void run_pack_tests() {
+    RUN_TEST(test_kernels_statistics);
+    RUN_TEST(test_kernels_flags);
+    RUN_TEST(test_pack_demultiplexes_broadcasts);
+    RUN_TEST(test_pack_rejects_corrupt_cell_broadcasts);
+    RUN_TEST(test_pack_scan_flags_cells);
+    RUN_TEST(test_pack_scan_cost);
+}
@@ -0,0 +1,176 @@
+#include "test_main.h"
+#include <battery.h>
+#include <mocks.h>
+
+using namespace CAN;
+using namespace MOCKS;
+using namespace Battery;
+
+static Frame pack_frame(uint16_t voltage_mv, int16_t current_ma) {
+    Message1 message = { voltage_mv, (uint16_t)current_ma, 0, 0 };
+    return Frame(0x001, &message);
+}
+
+static Frame limits_frame(int16_t current_ma) {
+    Message6 message = { 0, 0, (uint16_t)current_ma, (uint16_t)current_ma, 0 };
+    return Frame(0x006, &message);
+}
+
+static Frame bms_soc_frame(uint8_t soc) {
+    Message355 message = { soc, 100, 0 };
+    return Frame(0x355, &message);
+}
+
+static SocEstimator make_estimator(MockClockStrategy& clock) {
+    SocEstimator estimator(&clock);
+    // 10 cells of 1 Ah in mV and mA counts keep the numbers readable
+    estimator.config.capacity_mah = 1000;
+    estimator.config.mv_per_count = 1;
+    estimator.config.ma_per_count = 1;
+    estimator.config.cells_in_series = 10;
+    estimator.config.resistance_mohm = 0;
+    estimator.config.rest_current_ma = 100;
+    return estimator;
+}
+
+void test_soc_initializes_from_rest_voltage() {
+    MockClockStrategy clock;
+    SocEstimator estimator = make_estimator(clock);
+    TEST_ASSERT_FALSE(estimator.initialized());
+
+    // Under load the voltage says nothing about SOC
+    TEST_ASSERT_TRUE(estimator.dispatch(pack_frame(38000, 5000)));
+    TEST_ASSERT_FALSE(estimator.initialized());
+
+    TEST_ASSERT_TRUE(estimator.dispatch(pack_frame(38000, 0)));
+    TEST_ASSERT_TRUE(estimator.initialized());
+    TEST_ASSERT_EQUAL(5000, estimator.soc());
+    TEST_ASSERT_EQUAL(500, estimator.remaining_mah());
+}
+
+void test_soc_default_config_reads_orion_counts() {
+    MockClockStrategy clock;
+    SocEstimator estimator(&clock);
+
+    // 380.0 V at rest is 3958 mV per cell over 96 cells
+    TEST_ASSERT_TRUE(estimator.dispatch(pack_frame(3800, 0)));
+    TEST_ASSERT_EQUAL(7370, estimator.soc());
+    TEST_ASSERT_EQUAL(14740, estimator.remaining_mah());
+
+    // 200.0 A for 3.6 s is 200 mAh, beyond the 32 A a 1 mA count could carry
+    estimator.dispatch(limits_frame(2000));
+    for (uint32_t i = 0; i < 36; i++) {
+        clock.advance(100000);
+        estimator.dispatch(limits_frame(2000));
+    }
+    TEST_ASSERT_EQUAL(14540, estimator.remaining_mah());
+    TEST_ASSERT_EQUAL(0, estimator.statistics().gaps);
+}
+
+void test_soc_counts_coulombs_between_frames() {
+    MockClockStrategy clock;
+    SocEstimator estimator = make_estimator(clock);
+    estimator.reset(SOC_FULL);
+
+    // 3.6 A for one second in 10 ms steps is 1 mAh, split over both current broadcasts
+    estimator.dispatch(limits_frame(3600));
+    for (uint32_t i = 0; i < 100; i++) {
+        clock.advance(10000);
+        estimator.dispatch(i % 2 ? pack_frame(40000, 3600) : limits_frame(3600));
+    }
+    TEST_ASSERT_EQUAL(999, estimator.remaining_mah());
+    TEST_ASSERT_EQUAL(9990, estimator.soc());
+
+    // Charging goes the other way and stops at full
+    for (uint32_t i = 0; i < 200; i++) {
+        clock.advance(10000);
+        estimator.dispatch(limits_frame(-3600));
+    }
+    TEST_ASSERT_EQUAL(SOC_FULL, estimator.soc());
+    TEST_ASSERT_EQUAL(300, estimator.statistics().current_updates);
+}
+
+void test_soc_clamps_long_gaps() {
+    MockClockStrategy clock;
+    SocEstimator estimator = make_estimator(clock);
+    estimator.reset(5000);
+
+    estimator.dispatch(limits_frame(3600));
+    clock.advance(60000000);
+    estimator.dispatch(limits_frame(3600));
+
+    // Only max_gap_ms worth of current is integrated
+    TEST_ASSERT_EQUAL(1, estimator.statistics().gaps);
+    TEST_ASSERT_EQUAL(499, estimator.remaining_mah());
+}
+
+void test_soc_voltage_correction_is_gradual() {
+    MockClockStrategy clock;
+    SocEstimator estimator = make_estimator(clock);
+    estimator.config.correction_shift = 2;
+    estimator.reset(3000);
+
+    // Resting at the 50 % voltage pulls the estimate a quarter of the gap per frame
+    estimator.dispatch(pack_frame(38000, 0));
+    TEST_ASSERT_EQUAL(3500, estimator.soc());
+    estimator.dispatch(pack_frame(38000, 0));
+    TEST_ASSERT_EQUAL(3875, estimator.soc());
+    for (uint32_t i = 0; i < 40; i++) {
+        estimator.dispatch(pack_frame(38000, 0));
+    }
+    TEST_ASSERT_INT_WITHIN(1, 5000, estimator.soc());
+    TEST_ASSERT_EQUAL(42, estimator.statistics().voltage_corrections);
+}
+
+void test_soc_compensates_internal_resistance() {
+    MockClockStrategy clock;
+    SocEstimator estimator = make_estimator(clock);
+    estimator.config.resistance_mohm = 100;
+
+    // 50 mA through 100 mOhm hides 5 mV of open circuit voltage
+    estimator.dispatch(pack_frame(37995, 50));
+    TEST_ASSERT_EQUAL(5000, estimator.soc());
+}
+
+void test_soc_cross_checks_bms() {
+    MockClockStrategy clock;
+    SocEstimator estimator = make_estimator(clock);
+
+    // Without anything else the BMS value seeds the estimate
+    TEST_ASSERT_TRUE(estimator.dispatch(bms_soc_frame(80)));
+    TEST_ASSERT_TRUE(estimator.initialized());
+    TEST_ASSERT_EQUAL(8000, estimator.soc());
+    TEST_ASSERT_EQUAL(0, estimator.divergence());
+
+    estimator.dispatch(bms_soc_frame(74));
+    TEST_ASSERT_EQUAL(600, estimator.divergence());
+    TEST_ASSERT_EQUAL(1, estimator.statistics().divergences);
+
+    // The BMS never overrides the estimate once it runs
+    TEST_ASSERT_EQUAL(8000, estimator.soc());
+}
+
+void test_soc_ocv_table() {
+    MockClockStrategy clock;
+    SocEstimator estimator(&clock);
+    TEST_ASSERT_EQUAL(0, estimator.ocv_soc(2500));
+    TEST_ASSERT_EQUAL(4000, estimator.ocv_soc(3750));
+    TEST_ASSERT_EQUAL(SOC_FULL, estimator.ocv_soc(4300));
+
+    const SocEstimator::OcvPoint invalid[] = { { 3000, 5000 }, { 3100, 4000 } };
+    TEST_ASSERT_FALSE(estimator.set_ocv(invalid, 2));
+    const SocEstimator::OcvPoint linear[] = { { 3000, 0 }, { 4000, SOC_FULL } };
+    TEST_ASSERT_TRUE(estimator.set_ocv(linear, 2));
+    TEST_ASSERT_EQUAL(2500, estimator.ocv_soc(3250));
+}
+
+void run_soc_tests() {
+    RUN_TEST(test_soc_initializes_from_rest_voltage);
+    RUN_TEST(test_soc_default_config_reads_orion_counts);
+    RUN_TEST(test_soc_counts_coulombs_between_frames);
+    RUN_TEST(test_soc_clamps_long_gaps);
+    RUN_TEST(test_soc_voltage_correction_is_gradual);
+    RUN_TEST(test_soc_compensates_internal_resistance);
+    RUN_TEST(test_soc_cross_checks_bms);
+    RUN_TEST(test_soc_ocv_table);
+}
@@ -13,5 +13,7 @@ void tearDown(void) {
 int main() {
     UNITY_BEGIN();
     run_message_tests();
+    run_pack_tests();
+    run_soc_tests();
     return UNITY_END();
 }
\ No newline at end of file
@@ -4,5 +4,7 @@
 #include <unity.h>
 
 void run_message_tests();
+void run_pack_tests();
+void run_soc_tests();
 
 #endif // TEST_MAIN_H
\ No newline at end of file
@@ -0,0 +1,168 @@
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <can.h>
+#include <core.h>
+#include <mocks.h>
+
+#include "test_main.h"
+
+using namespace CAN;
+using namespace MOCKS;
+
+void test_frame_pool_fans_out_one_receive() {
+    MockCanService service;
+    service.on_receive = [](Frame* frame, Tick) {
+        frame->identifier = 0x20;
+        frame->data_length_code = 8;
+        frame->data[0] = 42;
+        return Result::OK;
+    };
+    Provider provider(&service);
+    FramePool pool;
+
+    Core::MpscQueue<FrameHandle, 4> logger;
+    Core::MpscQueue<FrameHandle, 4> dispatcher;
+    Core::MpscQueue<FrameHandle, 4> telemetry;
+    {
+        FrameHandle received = pool.receive(provider);
+        TEST_ASSERT_TRUE((bool)received);
+        TEST_ASSERT_TRUE(logger.push(received));
+        TEST_ASSERT_TRUE(dispatcher.push(received));
+        TEST_ASSERT_TRUE(telemetry.push(received));
+        TEST_ASSERT_EQUAL(4, received.use_count());
+    }
+    TEST_ASSERT_EQUAL(1, service.calls.receive);
+    TEST_ASSERT_EQUAL(CAN_FRAME_POOL_SIZE - 1, pool.available());
+
+    // Every consumer reads the same buffer
+    FrameHandle a, b, c;
+    logger.pop(a);
+    dispatcher.pop(b);
+    telemetry.pop(c);
+    TEST_ASSERT_EQUAL(a.get(), b.get());
+    TEST_ASSERT_EQUAL(a.get(), c.get());
+    TEST_ASSERT_EQUAL(0x20, a->identifier);
+    TEST_ASSERT_EQUAL(42, (*c).data[0]);
+    TEST_ASSERT_EQUAL(3, a.use_count());
+
+    a.reset();
+    b.reset();
+    TEST_ASSERT_EQUAL(CAN_FRAME_POOL_SIZE - 1, pool.available());
+    c.reset();
+    TEST_ASSERT_EQUAL(CAN_FRAME_POOL_SIZE, pool.available());
+    TEST_ASSERT_EQUAL(1, pool.statistics().acquired);
+}
+
+void test_frame_pool_exhaustion() {
+    MockCanService service;
+    Provider provider(&service);
+    FramePool pool;
+
+    std::vector<FrameHandle> held;
+    for (uint32_t i = 0; i < CAN_FRAME_POOL_SIZE; i++) {
+        held.push_back(pool.acquire());
+        TEST_ASSERT_TRUE((bool)held.back());
+    }
+    TEST_ASSERT_EQUAL(0, pool.available());
+
+    // Refused without touching the driver, the frame waits in its queue
+    TEST_ASSERT_FALSE((bool)pool.acquire());
+    TEST_ASSERT_FALSE((bool)pool.receive(provider));
+    TEST_ASSERT_EQUAL(0, service.calls.receive);
+
+    FramePoolStatistics statistics = pool.statistics();
+    TEST_ASSERT_EQUAL(2, statistics.exhausted);
+    TEST_ASSERT_EQUAL(CAN_FRAME_POOL_SIZE, statistics.in_use);
+    TEST_ASSERT_EQUAL(CAN_FRAME_POOL_SIZE, statistics.high_water);
+
+    held.pop_back();
+    TEST_ASSERT_TRUE((bool)pool.acquire());
+    held.clear();
+    TEST_ASSERT_EQUAL(0, pool.statistics().in_use);
+
+    // A failed receive hands its buffer straight back
+    service.on_receive = [](Frame*, Tick) { return Result::ERR_TIMEOUT; };
+    TEST_ASSERT_FALSE((bool)pool.receive(provider));
+    TEST_ASSERT_EQUAL(CAN_FRAME_POOL_SIZE, pool.available());
+    TEST_ASSERT_EQUAL(CAN_FRAME_POOL_SIZE + 1, pool.statistics().acquired);
+}
+
+void test_frame_handle_ownership() {
+    FramePool pool;
+    uint8_t data[8] = { 1, 2, 3, 4, 5, 6, 7, 8 };
+    FrameHandle first = pool.acquire(Frame(0x100, data));
+    TEST_ASSERT_EQUAL(8, first->data[7]);
+    TEST_ASSERT_NOT_NULL(first.edit());
+
+    // Shared frames are read only
+    FrameHandle second = first;
+    TEST_ASSERT_NULL(first.edit());
+    TEST_ASSERT_EQUAL(2, second.use_count());
+
+    FrameHandle moved(std::move(second));
+    TEST_ASSERT_FALSE((bool)second);
+    TEST_ASSERT_EQUAL(0, second.use_count());
+    TEST_ASSERT_EQUAL(2, moved.use_count());
+
+    moved = moved;
+    moved = first;
+    TEST_ASSERT_EQUAL(2, first.use_count());
+
+    FrameHandle other = pool.acquire();
+    moved = std::move(other);
+    TEST_ASSERT_EQUAL(1, first.use_count());
+    TEST_ASSERT_EQUAL(CAN_FRAME_POOL_SIZE - 2, pool.available());
+}
+
+void test_frame_pool_concurrent_consumers() {
+    const uint32_t frames = 50000;
+    const uint32_t consumers = 3;
+    NullCanService service;
+    BasicProvider<NullCanService> provider(&service);
+    FramePool pool;
+    Core::MpscQueue<FrameHandle, 16> queues[consumers];
+    std::atomic<uint32_t> out_of_order(0);
+
+    std::vector<std::thread> threads;
+    for (uint32_t c = 0; c < consumers; c++) {
+        threads.push_back(std::thread([&, c]() {
+            uint32_t expected = 0;
+            while (expected < frames) {
+                FrameHandle handle;
+                if (!queues[c].pop(handle)) {
+                    std::this_thread::yield();
+                    continue;
+                }
+                if (handle->identifier != expected) out_of_order++;
+                expected++;
+            }
+        }));
+    }
+
+    for (uint32_t i = 0; i < frames; i++) {
+        FrameHandle handle;
+        while (!(handle = pool.receive(provider))) {
+            std::this_thread::yield();
+        }
+        for (uint32_t c = 0; c < consumers; c++) {
+            while (!queues[c].push(handle)) {
+                std::this_thread::yield();
+            }
+        }
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    TEST_ASSERT_EQUAL(0, out_of_order.load());
+    TEST_ASSERT_EQUAL(frames, pool.statistics().acquired);
+    TEST_ASSERT_EQUAL(CAN_FRAME_POOL_SIZE, pool.available());
+}
+
+void run_frame_pool_tests() {
+    RUN_TEST(test_frame_pool_fans_out_one_receive);
+    RUN_TEST(test_frame_pool_exhaustion);
+    RUN_TEST(test_frame_handle_ownership);
+    RUN_TEST(test_frame_pool_concurrent_consumers);
+}
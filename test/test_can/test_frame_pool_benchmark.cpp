@@ -0,0 +1,124 @@
+#include <cstdint>
+#include <cstdio>
+#include <can.h>
+#include <core.h>
+#include <mocks.h>
+
+#include "test_main.h"
+
+using namespace CAN;
+using namespace MOCKS;
+
+static const uint32_t FAN_OUT_FRAMES = 200000;
+static const uint32_t QUEUE_DEPTH = 64;
+
+// Logger, dispatcher and telemetry each drain their own queue after every receive
+template<typename T>
+struct Consumers {
+    Core::MpscQueue<T, QUEUE_DEPTH> logger;
+    Core::MpscQueue<T, QUEUE_DEPTH> dispatcher;
+    Core::MpscQueue<T, QUEUE_DEPTH> telemetry;
+    uint32_t checksum = 0;
+
+    void push(const T& value) {
+        logger.push(value);
+        dispatcher.push(value);
+        telemetry.push(value);
+    }
+};
+
+static uint64_t fan_out_copies(BasicProvider<NullCanService>& provider, NativeClockStrategy& clock, uint32_t& checksum) {
+    Consumers<Frame>* consumers = new Consumers<Frame>();
+    Frame frame;
+    // Fully initialized, a failed pop leaves it as it was
+    uint8_t empty[8] = { 0 };
+    Frame copy(0, empty);
+
+    uint64_t start = clock.nanos();
+    for (uint32_t i = 0; i < FAN_OUT_FRAMES; i++) {
+        provider.receive(frame, 0);
+        consumers->push(frame);
+
+        consumers->logger.pop(copy);
+        consumers->checksum += copy.identifier;
+        consumers->dispatcher.pop(copy);
+        consumers->checksum += copy.identifier;
+        consumers->telemetry.pop(copy);
+        consumers->checksum += copy.identifier;
+    }
+    uint64_t elapsed = clock.nanos() - start;
+    checksum = consumers->checksum;
+    delete consumers;
+    return elapsed;
+}
+
+static uint64_t fan_out_handles(BasicProvider<NullCanService>& provider, FramePool& pool, NativeClockStrategy& clock, uint32_t& checksum) {
+    Consumers<FrameHandle>* consumers = new Consumers<FrameHandle>();
+
+    uint64_t start = clock.nanos();
+    for (uint32_t i = 0; i < FAN_OUT_FRAMES; i++) {
+        consumers->push(pool.receive(provider));
+
+        FrameHandle handle;
+        consumers->logger.pop(handle);
+        consumers->checksum += handle->identifier;
+        consumers->dispatcher.pop(handle);
+        consumers->checksum += handle->identifier;
+        consumers->telemetry.pop(handle);
+        consumers->checksum += handle->identifier;
+    }
+    uint64_t elapsed = clock.nanos() - start;
+    checksum = consumers->checksum;
+    delete consumers;
+    return elapsed;
+}
+
+// Queue sizes quoted for the ESP32, checked by any build with 32-bit pointers
+#if UINTPTR_MAX == 0xFFFFFFFF
+static_assert(sizeof(Core::MpscQueue<FrameHandle, 64>) == 520, "64 handles no longer take 8 bytes each");
+static_assert(sizeof(Core::MpscQueue<Frame, 64>) == 1544, "64 frames no longer take 24 bytes each");
+#endif
+
+void test_frame_pool_queue_entry_size() {
+    // An entry is a sequence number and one pointer instead of a frame
+    size_t handle_entry = (sizeof(Core::MpscQueue<FrameHandle, 64>) - sizeof(Core::MpscQueue<FrameHandle, 32>)) / 32;
+    size_t frame_entry = (sizeof(Core::MpscQueue<Frame, 64>) - sizeof(Core::MpscQueue<Frame, 32>)) / 32;
+    TEST_ASSERT_EQUAL(sizeof(void*) == 4 ? 8 : 16, handle_entry);
+    TEST_ASSERT_EQUAL(24, frame_entry);
+}
+
+void test_frame_pool_fan_out_benchmark() {
+    NativeClockStrategy clock;
+
+    NullCanService copy_service;
+    BasicProvider<NullCanService> copy_provider(&copy_service);
+    uint32_t copy_checksum = 0;
+    uint64_t copy_ns = fan_out_copies(copy_provider, clock, copy_checksum);
+
+    NullCanService pool_service;
+    BasicProvider<NullCanService> pool_provider(&pool_service);
+    FramePool pool;
+    uint32_t pool_checksum = 0;
+    uint64_t pool_ns = fan_out_handles(pool_provider, pool, clock, pool_checksum);
+
+    // Same frames reached the same consumers, and every buffer came back
+    TEST_ASSERT_EQUAL(copy_checksum, pool_checksum);
+    TEST_ASSERT_EQUAL(CAN_FRAME_POOL_SIZE, pool.available());
+    TEST_ASSERT_EQUAL(0, pool.statistics().exhausted);
+
+    // Queue storage for three consumers sized for QUEUE_DEPTH frames in flight
+    size_t copy_bytes = 3 * sizeof(Core::MpscQueue<Frame, QUEUE_DEPTH>);
+    size_t pool_bytes = 3 * sizeof(Core::MpscQueue<FrameHandle, QUEUE_DEPTH>) + sizeof(FramePool);
+
+    char message[192];
+    snprintf(message, sizeof(message),
+             "3-way fan-out per frame: copies %.2f ns, handles %.2f ns; queue memory: copies %u B, handles %u B with a %u-frame pool",
+             (double)copy_ns / FAN_OUT_FRAMES, (double)pool_ns / FAN_OUT_FRAMES,
+             (unsigned)copy_bytes, (unsigned)pool_bytes, (unsigned)CAN_FRAME_POOL_SIZE);
+    TEST_MESSAGE(message);
+}
+
+void run_frame_pool_benchmark_tests() {
+    RUN_TEST(test_frame_pool_queue_entry_size);
+    RUN_TEST(test_frame_pool_fan_out_benchmark);
+}
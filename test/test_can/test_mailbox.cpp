@@ -0,0 +1,114 @@
+#include <cstdint>
+#include <vector>
+#include <can.h>
+#include <mocks.h>
+
+#include "test_main.h"
+
+using namespace CAN;
+using namespace MOCKS;
+
+// Driver transmit queue that only accepts frames while `accepting` is set
+struct GatedDriver {
+    MockCanService service;
+    std::vector<Frame> sent;
+    bool accepting = true;
+
+    GatedDriver() {
+        service.on_transmit = [this](const Frame* frame, Tick) {
+            if (!accepting) {
+                return Result::ERR_TIMEOUT;
+            }
+            sent.push_back(*frame);
+            return Result::OK;
+        };
+    }
+};
+
+static Frame make_setpoint(uint32_t identifier, uint8_t value) {
+    uint8_t data[8] = { value, 0, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF };
+    return Frame(identifier, data);
+}
+
+void test_mailbox_sends_immediately_when_driver_has_room() {
+    GatedDriver driver;
+    Provider provider(&driver.service);
+    TransmitMailboxes mailboxes(&provider);
+    TEST_ASSERT_TRUE(mailboxes.configure(0x0552));
+
+    TEST_ASSERT_TRUE(mailboxes.post(make_setpoint(0x0552, 10)));
+
+    TEST_ASSERT_EQUAL(1, driver.sent.size());
+    TEST_ASSERT_EQUAL(0, mailboxes.pending());
+    TEST_ASSERT_EQUAL(1, driver.sent[0].ss);
+}
+
+void test_mailbox_latest_value_wins_when_congested() {
+    GatedDriver driver;
+    Provider provider(&driver.service);
+    TransmitMailboxes mailboxes(&provider);
+    mailboxes.configure(0x0552);
+
+    driver.accepting = false;
+    mailboxes.post(make_setpoint(0x0552, 10));
+    mailboxes.post(make_setpoint(0x0552, 20));
+    mailboxes.post(make_setpoint(0x0552, 30));
+    TEST_ASSERT_EQUAL(1, mailboxes.pending());
+
+    driver.accepting = true;
+    TEST_ASSERT_EQUAL(1, mailboxes.flush());
+
+    TEST_ASSERT_EQUAL(1, driver.sent.size());
+    TEST_ASSERT_EQUAL(30, driver.sent[0].data[0]);
+
+    MailboxStatistics stats;
+    TEST_ASSERT_TRUE(mailboxes.statistics(0x0552, stats));
+    TEST_ASSERT_EQUAL(3, stats.posted);
+    TEST_ASSERT_EQUAL(1, stats.sent);
+    TEST_ASSERT_EQUAL(2, stats.stale);
+    TEST_ASSERT_EQUAL(2, mailboxes.stale_count());
+}
+
+void test_mailbox_delivery_and_priority_order() {
+    GatedDriver driver;
+    Provider provider(&driver.service);
+    TransmitMailboxes mailboxes(&provider);
+    mailboxes.configure(0x0C52, Delivery::RETRY);
+    mailboxes.configure(0x0552, Delivery::SINGLE_SHOT);
+
+    driver.accepting = false;
+    mailboxes.post(make_setpoint(0x0C52, 1));
+    mailboxes.post(make_setpoint(0x0552, 2));
+
+    // Driver wakes up on a completion alert
+    driver.accepting = true;
+    TransmitMailboxes::alert_listener(Alerts::TX_SUCCESS, &mailboxes);
+
+    TEST_ASSERT_EQUAL(2, driver.sent.size());
+    TEST_ASSERT_EQUAL(0x0552, driver.sent[0].identifier);
+    TEST_ASSERT_EQUAL(1, driver.sent[0].ss);
+    TEST_ASSERT_EQUAL(0x0C52, driver.sent[1].identifier);
+    TEST_ASSERT_EQUAL(0, driver.sent[1].ss);
+}
+
+void test_mailbox_rejects_unknown_identifiers_and_overflow() {
+    GatedDriver driver;
+    Provider provider(&driver.service);
+    TransmitMailboxes mailboxes(&provider);
+
+    TEST_ASSERT_FALSE(mailboxes.post(make_setpoint(0x0552, 1)));
+    for (uint32_t i = 0; i < CAN_TRANSMIT_MAILBOXES; i++) {
+        TEST_ASSERT_TRUE(mailboxes.configure(0x100 + i));
+    }
+    TEST_ASSERT_FALSE(mailboxes.configure(0x200));
+    // Reconfiguring an existing mailbox does not need a free one
+    TEST_ASSERT_TRUE(mailboxes.configure(0x100, Delivery::RETRY));
+    TEST_ASSERT_EQUAL(0, driver.sent.size());
+}
+
+void run_mailbox_tests() {
+    RUN_TEST(test_mailbox_sends_immediately_when_driver_has_room);
+    RUN_TEST(test_mailbox_latest_value_wins_when_congested);
+    RUN_TEST(test_mailbox_delivery_and_priority_order);
+    RUN_TEST(test_mailbox_rejects_unknown_identifiers_and_overflow);
+}
@@ -15,5 +15,12 @@ int main() {
     UNITY_BEGIN();
     run_manager_can_tests();
     run_can_coding_tests();
+    run_transmit_tracker_tests();
+    run_supervisor_tests();
+    run_mailbox_tests();
+    run_transmit_queue_tests();
+    run_provider_benchmark_tests();
+    run_frame_pool_tests();
+    run_frame_pool_benchmark_tests();
     return UNITY_END();
 }
\ No newline at end of file
@@ -5,5 +5,12 @@
 
 void run_manager_can_tests();
 void run_can_coding_tests();
+void run_transmit_tracker_tests();
+void run_supervisor_tests();
+void run_mailbox_tests();
+void run_transmit_queue_tests();
+void run_provider_benchmark_tests();
+void run_frame_pool_tests();
+void run_frame_pool_benchmark_tests();
 
 #endif // TEST_MAIN_H
\ No newline at end of file
@@ -8,25 +8,55 @@ using namespace CAN;
 using namespace MOCKS;
 
 struct Bundle {
-    Provider provider;
-    MockCanService* service;
-};
-
-inline Bundle make_bundle() {
-    auto* service = new MockCanService();
-    Provider provider(service);
+    MockCanService* service = new MockCanService();
+    Provider provider{service};
 
-    return { provider, service };
-}
+    ~Bundle() {
+        delete service;
+    }
+};
 
 void test_can_begin() {
-    Bundle bundle = make_bundle();
+    Bundle bundle;
     bool result = bundle.provider.begin();
     TEST_ASSERT_TRUE(result);
 }
 
+void test_can_begin_without_installed_driver() {
+    Bundle bundle;
+    // The driver refuses to stop or uninstall when it was never installed
+    bundle.service->on_stop = []() { return Result::ERR_INVALID_STATE; };
+    bundle.service->on_uninstall_driver = []() { return Result::ERR_INVALID_STATE; };
+
+    TEST_ASSERT_TRUE(bundle.provider.begin());
+    TEST_ASSERT_EQUAL(0, bundle.service->calls.uninstall_driver);
+    TEST_ASSERT_EQUAL(1, bundle.service->calls.install_driver);
+    TEST_ASSERT_TRUE(bundle.provider.is_running);
+}
+
+void test_can_begin_restarts_a_running_driver() {
+    Bundle bundle;
+    TEST_ASSERT_TRUE(bundle.provider.begin());
+    TEST_ASSERT_TRUE(bundle.provider.begin());
+    TEST_ASSERT_EQUAL(1, bundle.service->calls.stop);
+    TEST_ASSERT_EQUAL(1, bundle.service->calls.uninstall_driver);
+    TEST_ASSERT_EQUAL(2, bundle.service->calls.install_driver);
+}
+
+void test_can_static_provider_state_transitions() {
+    // Out-of-line members are instantiated for any service, not just the virtual one
+    NullCanService service;
+    BasicProvider<NullCanService> provider(&service);
+    TEST_ASSERT_TRUE(provider.begin());
+    TEST_ASSERT_TRUE(provider.is_running);
+    // Already running, nothing to restart
+    TEST_ASSERT_FALSE(provider.restart());
+    TEST_ASSERT_TRUE(provider.end());
+    TEST_ASSERT_FALSE(provider.is_running);
+}
+
 void test_can_recover() {
-    Bundle bundle = make_bundle();
+    Bundle bundle;
 
     bundle.service->on_status_info = [](StatusInfo* status_info) { 
         status_info->state = State::BUS_OFF;
@@ -38,7 +68,7 @@ void test_can_recover() {
 }
 
 void test_can_restart() {
-    Bundle bundle = make_bundle();
+    Bundle bundle;
 
     bundle.service->on_status_info = [](StatusInfo* status_info) { 
         status_info->state = State::STOPPED;
@@ -50,30 +80,54 @@ void test_can_restart() {
 }
 
 void test_can_end() {
-    Bundle bundle = make_bundle();
+    Bundle bundle;
     bool result = bundle.provider.end();
     TEST_ASSERT_TRUE(result);
 }
 
 void test_can_transmit() {
-    Bundle bundle = make_bundle();
+    Bundle bundle;
     Frame frame;
     bool result = bundle.provider.transmit(frame);
     TEST_ASSERT_TRUE(result);
 }
 
 void test_can_receive() {
-    Bundle bundle = make_bundle();
+    Bundle bundle;
     Frame frame;
     bool result = bundle.provider.receive(frame);
     TEST_ASSERT_TRUE(result);
 }
 
+void test_can_receive_marks_first_frame() {
+    Bundle bundle;
+    MockClockStrategy clock;
+    clock.now = 250000;
+    Core::Startup::Milestones<1> milestones(&clock);
+    bundle.provider.received = milestones.hook(0);
+
+    Frame frame;
+    bundle.service->on_receive = [](Frame*, Tick) { return Result::ERR_TIMEOUT; };
+    TEST_ASSERT_FALSE(bundle.provider.receive(frame));
+    TEST_ASSERT_FALSE(milestones.reached(0));
+
+    bundle.service->on_receive = [](Frame*, Tick) { return Result::OK; };
+    clock.advance(1000);
+    TEST_ASSERT_TRUE(bundle.provider.receive(frame));
+    clock.advance(1000);
+    TEST_ASSERT_TRUE(bundle.provider.receive(frame));
+    TEST_ASSERT_EQUAL(251000, milestones.at_us(0));
+}
+
 void run_manager_can_tests() {
     RUN_TEST(test_can_begin);
+    RUN_TEST(test_can_begin_without_installed_driver);
+    RUN_TEST(test_can_begin_restarts_a_running_driver);
+    RUN_TEST(test_can_static_provider_state_transitions);
     RUN_TEST(test_can_recover);
     RUN_TEST(test_can_restart);
     RUN_TEST(test_can_end);
     RUN_TEST(test_can_transmit);
     RUN_TEST(test_can_receive);
+    RUN_TEST(test_can_receive_marks_first_frame);
 }
\ No newline at end of file
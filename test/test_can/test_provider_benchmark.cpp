@@ -0,0 +1,54 @@
+#include <cstdint>
+#include <cstdio>
+#include <can.h>
+#include <mocks.h>
+
+#include "test_main.h"
+
+using namespace CAN;
+using namespace MOCKS;
+
+static const uint32_t BENCHMARK_FRAMES = 200000;
+
+// Sends, receives and checks status once per frame, the provider's per-frame hot path
+template<typename ProviderT>
+static uint64_t run_hot_path(ProviderT& provider, NativeClockStrategy& clock) {
+    uint8_t data[8] = { 1, 2, 3, 4, 5, 6, 7, 8 };
+    Frame out(0x0552, data);
+    Frame in;
+    StatusInfo info;
+
+    uint64_t start = clock.nanos();
+    for (uint32_t i = 0; i < BENCHMARK_FRAMES; i++) {
+        provider.transmit(out, 0);
+        provider.receive(in, 0);
+        provider.status_info(info);
+    }
+    return clock.nanos() - start;
+}
+
+void test_provider_static_dispatch_benchmark() {
+    NativeClockStrategy clock;
+
+    NullCanService erased_service;
+    Provider erased(&erased_service);
+    uint64_t erased_ns = run_hot_path(erased, clock);
+
+    NullCanService static_service;
+    BasicProvider<NullCanService> dispatched(&static_service);
+    uint64_t static_ns = run_hot_path(dispatched, clock);
+
+    // Both paths reach the same service the same number of times
+    TEST_ASSERT_EQUAL(BENCHMARK_FRAMES * 8, erased_service.transmitted);
+    TEST_ASSERT_EQUAL(BENCHMARK_FRAMES * 8, static_service.transmitted);
+    TEST_ASSERT_EQUAL(BENCHMARK_FRAMES, static_service.received);
+
+    char message[128];
+    snprintf(message, sizeof(message), "per-frame overhead: virtual %.2f ns, static %.2f ns",
+             (double)erased_ns / BENCHMARK_FRAMES, (double)static_ns / BENCHMARK_FRAMES);
+    TEST_MESSAGE(message);
+}
+
+void run_provider_benchmark_tests() {
+    RUN_TEST(test_provider_static_dispatch_benchmark);
+}
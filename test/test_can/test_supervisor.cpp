@@ -0,0 +1,164 @@
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <thread>
+#include <chrono>
+#include <can.h>
+#include <mocks.h>
+
+#include "test_main.h"
+
+using namespace CAN;
+using namespace MOCKS;
+
+// Simulates the controller state and the alerts it raises
+struct FakeBus {
+    MockCanService* service = new MockCanService();
+    std::deque<Alert> alerts;
+    State state = State::RUNNING;
+    bool recovery_completes = true;
+
+    FakeBus() {
+        service->on_alerts = [this](Alert* out, Tick) {
+            if (alerts.empty()) {
+                return Result::ERR_TIMEOUT;
+            }
+            *out = alerts.front();
+            alerts.pop_front();
+            return Result::OK;
+        };
+        service->on_status_info = [this](StatusInfo* info) {
+            info->state = state;
+            info->msgs_to_tx = 0;
+            info->tx_failed_count = 0;
+            return Result::OK;
+        };
+        service->on_initiate_recovery = [this]() {
+            state = State::RECOVERING;
+            return Result::OK;
+        };
+        service->on_start = [this]() {
+            state = State::RUNNING;
+            return Result::OK;
+        };
+        service->on_install_driver = [this](const GeneralConfig*, const TimingConfig*, const FilterConfig*) {
+            state = State::STOPPED;
+            return Result::OK;
+        };
+    }
+
+    ~FakeBus() {
+        delete service;
+    }
+};
+
+static std::unique_ptr<Supervisor> make_supervisor(FakeBus& bus, MockClockStrategy& clock) {
+    std::shared_ptr<Provider> provider(new Provider(bus.service));
+    std::unique_ptr<Core::iLockStrategy> lock(new NativeLockStrategy());
+    std::unique_ptr<Core::iThreadStrategy> thread(new NativeThreadStrategy());
+    return std::unique_ptr<Supervisor>(new Supervisor(provider, &clock, std::move(lock), std::move(thread)));
+}
+
+void test_supervisor_recovers_from_bus_off() {
+    FakeBus bus;
+    MockClockStrategy clock;
+    auto supervisor = make_supervisor(bus, clock);
+
+    clock.now = 10000;
+    bus.state = State::BUS_OFF;
+    bus.alerts.push_back(Alerts::BUS_OFF);
+    supervisor->step(0);
+
+    TEST_ASSERT_EQUAL(Supervisor::Phase::RECOVERING, supervisor->phase());
+    TEST_ASSERT_EQUAL(1, bus.service->calls.initiate_recovery);
+
+    clock.now = 12000;
+    bus.state = State::STOPPED;
+    bus.alerts.push_back(Alerts::BUS_RECOVERED);
+    supervisor->step(0);
+
+    TEST_ASSERT_EQUAL(Supervisor::Phase::CONFIRMING, supervisor->phase());
+    TEST_ASSERT_EQUAL(1, bus.service->calls.start);
+
+    clock.now = 12500;
+    bus.alerts.push_back(Alerts::TX_SUCCESS);
+    supervisor->step(0);
+
+    Supervisor::Statistics stats = supervisor->statistics();
+    TEST_ASSERT_EQUAL(Supervisor::Phase::NORMAL, supervisor->phase());
+    TEST_ASSERT_EQUAL(1, stats.bus_off_count);
+    TEST_ASSERT_EQUAL(1, stats.recoveries);
+    TEST_ASSERT_EQUAL(2500, stats.last_recovery_us);
+    TEST_ASSERT_EQUAL(0, stats.forced_restarts);
+}
+
+void test_supervisor_reinstalls_driver_after_recovery_timeout() {
+    FakeBus bus;
+    MockClockStrategy clock;
+    auto supervisor = make_supervisor(bus, clock);
+    supervisor->recovery_timeout = 100;
+
+    bus.state = State::BUS_OFF;
+    bus.alerts.push_back(Alerts::BUS_OFF);
+    supervisor->step(0);
+
+    // No BUS_RECOVERED arrives before the deadline
+    clock.advance(99000);
+    supervisor->step(0);
+    TEST_ASSERT_EQUAL(0, supervisor->statistics().forced_restarts);
+
+    clock.advance(1000);
+    supervisor->step(0);
+
+    TEST_ASSERT_EQUAL(1, supervisor->statistics().forced_restarts);
+    TEST_ASSERT_EQUAL(1, bus.service->calls.uninstall_driver);
+    TEST_ASSERT_EQUAL(1, bus.service->calls.install_driver);
+    TEST_ASSERT_EQUAL(Supervisor::Phase::CONFIRMING, supervisor->phase());
+}
+
+void test_supervisor_forwards_alerts_to_listeners() {
+    FakeBus bus;
+    MockClockStrategy clock;
+    auto supervisor = make_supervisor(bus, clock);
+
+    Alert seen = Alerts::NONE;
+    AlertListener listener = [](Alert alerts, void* context) { *(Alert*)context |= alerts; };
+    TEST_ASSERT_TRUE(supervisor->add_listener(listener, &seen));
+
+    bus.alerts.push_back(Alerts::RX_DATA | Alerts::ERR_PASS);
+    supervisor->step(0);
+    // Timeouts are not forwarded
+    supervisor->step(0);
+
+    TEST_ASSERT_EQUAL(Alerts::RX_DATA | Alerts::ERR_PASS, seen);
+    TEST_ASSERT_EQUAL(1, supervisor->statistics().error_passive_count);
+}
+
+void test_supervisor_task_runs_until_stopped() {
+    FakeBus bus;
+    MockClockStrategy clock;
+    auto supervisor = make_supervisor(bus, clock);
+    bus.service->on_alerts = [](Alert* out, Tick) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        return Result::ERR_TIMEOUT;
+    };
+
+    // Starting while already bus-off begins recovery without waiting for an alert
+    bus.state = State::BUS_OFF;
+    supervisor->start();
+    TEST_ASSERT_TRUE(supervisor->started());
+    TEST_ASSERT_EQUAL(1, bus.service->calls.initiate_recovery);
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    supervisor->stop();
+
+    TEST_ASSERT_FALSE(supervisor->started());
+    TEST_ASSERT_GREATER_OR_EQUAL(2, bus.service->calls.alerts);
+}
+
+void run_supervisor_tests() {
+    RUN_TEST(test_supervisor_recovers_from_bus_off);
+    RUN_TEST(test_supervisor_reinstalls_driver_after_recovery_timeout);
+    RUN_TEST(test_supervisor_forwards_alerts_to_listeners);
+    RUN_TEST(test_supervisor_task_runs_until_stopped);
+}
@@ -0,0 +1,140 @@
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <thread>
+#include <vector>
+#include <can.h>
+#include <mocks.h>
+
+#include "test_main.h"
+
+using namespace CAN;
+using namespace MOCKS;
+
+static Frame make_sequenced_frame(uint32_t identifier, uint32_t sequence) {
+    uint8_t data[8] = { 0 };
+    memcpy(data, &sequence, sizeof(sequence));
+    return Frame(identifier, data);
+}
+
+void test_mpsc_queue_is_fifo_and_bounded() {
+    Core::MpscQueue<uint32_t, 4> queue;
+    for (uint32_t i = 0; i < 4; i++) {
+        TEST_ASSERT_TRUE(queue.push(i));
+    }
+    TEST_ASSERT_FALSE(queue.push(99));
+    TEST_ASSERT_EQUAL(4, queue.size());
+
+    uint32_t value;
+    for (uint32_t i = 0; i < 4; i++) {
+        TEST_ASSERT_TRUE(queue.pop(value));
+        TEST_ASSERT_EQUAL(i, value);
+    }
+    TEST_ASSERT_FALSE(queue.pop(value));
+    TEST_ASSERT_NULL(queue.front());
+
+    // Cells are reusable after wrapping
+    TEST_ASSERT_TRUE(queue.push(7));
+    TEST_ASSERT_EQUAL(7, *queue.front());
+}
+
+void test_transmit_queue_keeps_head_when_driver_is_full() {
+    MockCanService service;
+    std::vector<uint32_t> sent;
+    bool accepting = false;
+    service.on_transmit = [&](const Frame* frame, Tick) {
+        if (!accepting) return Result::ERR_TIMEOUT;
+        sent.push_back(frame->identifier);
+        return Result::OK;
+    };
+    std::shared_ptr<Provider> provider(new Provider(&service));
+    TransmitQueue queue(provider, std::unique_ptr<Core::iThreadStrategy>(new NativeThreadStrategy()));
+
+    TEST_ASSERT_TRUE(queue.submit(make_sequenced_frame(0x01, 0)));
+    TEST_ASSERT_TRUE(queue.submit(make_sequenced_frame(0x02, 0)));
+    TEST_ASSERT_EQUAL(0, queue.drain(0));
+    TEST_ASSERT_EQUAL(2, queue.depth());
+
+    accepting = true;
+    TEST_ASSERT_EQUAL(2, queue.drain(0));
+    TEST_ASSERT_EQUAL(0x01, sent[0]);
+    TEST_ASSERT_EQUAL(0x02, sent[1]);
+    TEST_ASSERT_EQUAL(2, queue.statistics().sent);
+}
+
+void test_transmit_queue_preserves_per_identifier_order_across_producers() {
+    const uint32_t producers = 4;
+    const uint32_t frames_per_producer = 2000;
+
+    MockCanService service;
+    std::vector<Frame> sent;
+    service.on_transmit = [&sent](const Frame* frame, Tick) {
+        sent.push_back(*frame);
+        return Result::OK;
+    };
+    std::shared_ptr<Provider> provider(new Provider(&service));
+    TransmitQueue queue(provider, std::unique_ptr<Core::iThreadStrategy>(new NativeThreadStrategy()));
+    queue.start();
+
+    std::vector<std::thread> threads;
+    for (uint32_t p = 0; p < producers; p++) {
+        threads.push_back(std::thread([&queue, p, frames_per_producer]() {
+            for (uint32_t i = 0; i < frames_per_producer; i++) {
+                // Each producer owns one identifier, retry while the queue is full
+                while (!queue.submit(make_sequenced_frame(0x100 + p, i))) {
+                    std::this_thread::yield();
+                }
+            }
+        }));
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    queue.stop();
+
+    TEST_ASSERT_EQUAL(producers * frames_per_producer, sent.size());
+    TEST_ASSERT_EQUAL(producers * frames_per_producer, queue.statistics().submitted);
+
+    uint32_t next[producers] = { 0 };
+    for (const Frame& frame : sent) {
+        uint32_t producer = frame.identifier - 0x100;
+        uint32_t sequence;
+        memcpy(&sequence, frame.data, sizeof(sequence));
+        TEST_ASSERT_EQUAL(next[producer], sequence);
+        next[producer]++;
+    }
+}
+
+void test_provider_transitions_do_not_interleave() {
+    MockCanService service;
+    std::shared_ptr<Provider> provider(new Provider(&service));
+    std::atomic<int> in_start(0);
+    std::atomic<int> overlaps(0);
+    service.on_start = [&]() {
+        if (in_start.fetch_add(1) != 0) overlaps++;
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+        in_start.fetch_sub(1);
+        return Result::OK;
+    };
+
+    std::vector<std::thread> threads;
+    for (int i = 0; i < 4; i++) {
+        threads.push_back(std::thread([provider]() {
+            for (int j = 0; j < 5; j++) provider->begin();
+        }));
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    TEST_ASSERT_EQUAL(0, overlaps.load());
+}
+
+void run_transmit_queue_tests() {
+    RUN_TEST(test_mpsc_queue_is_fifo_and_bounded);
+    RUN_TEST(test_transmit_queue_keeps_head_when_driver_is_full);
+    RUN_TEST(test_transmit_queue_preserves_per_identifier_order_across_producers);
+    RUN_TEST(test_provider_transitions_do_not_interleave);
+}
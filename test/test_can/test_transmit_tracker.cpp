@@ -0,0 +1,175 @@
+#include <cstdint>
+#include <deque>
+#include <can.h>
+#include <mocks.h>
+
+#include "test_main.h"
+
+using namespace CAN;
+using namespace MOCKS;
+
+// Simulates the driver transmit queue so completions can be driven by the test
+struct FakeDriver {
+    MockCanService service;
+    std::deque<Frame> queue;
+    uint32_t capacity = 2;
+    uint32_t tx_failed_count = 0;
+
+    FakeDriver() {
+        service.on_transmit = [this](const Frame* frame, Tick) {
+            if (queue.size() >= capacity) {
+                return Result::ERR_TIMEOUT;
+            }
+            queue.push_back(*frame);
+            return Result::OK;
+        };
+        service.on_status_info = [this](StatusInfo* info) {
+            info->state = State::RUNNING;
+            info->msgs_to_tx = (uint32_t)queue.size();
+            info->tx_failed_count = tx_failed_count;
+            return Result::OK;
+        };
+    }
+
+    // Puts the oldest queued frames on the wire
+    void send(uint32_t count) {
+        for (uint32_t i = 0; i < count && !queue.empty(); i++) {
+            queue.pop_front();
+        }
+    }
+};
+
+static Frame make_frame(uint32_t identifier) {
+    uint8_t data[8] = { 0 };
+    return Frame(identifier, data);
+}
+
+void test_transmit_tracker_submit_does_not_block_on_full_queue() {
+    FakeDriver driver;
+    Provider provider(&driver.service);
+    MockClockStrategy clock;
+    TransmitTracker tracker(&provider, &clock);
+
+    TransmitHandle a = tracker.submit(make_frame(0x01));
+    TransmitHandle b = tracker.submit(make_frame(0x02));
+    TransmitHandle c = tracker.submit(make_frame(0x03));
+
+    TEST_ASSERT_TRUE(c.valid());
+    TEST_ASSERT_EQUAL(TransmitStatus::QUEUED, a.status());
+    TEST_ASSERT_EQUAL(TransmitStatus::QUEUED, b.status());
+    TEST_ASSERT_EQUAL(TransmitStatus::PENDING, c.status());
+    TEST_ASSERT_EQUAL(3, tracker.in_flight());
+}
+
+void test_transmit_tracker_completes_from_alerts() {
+    FakeDriver driver;
+    Provider provider(&driver.service);
+    MockClockStrategy clock;
+    TransmitTracker tracker(&provider, &clock);
+
+    clock.now = 1000;
+    TransmitHandle a = tracker.submit(make_frame(0x01));
+    TransmitHandle b = tracker.submit(make_frame(0x02));
+    TransmitHandle c = tracker.submit(make_frame(0x03));
+
+    clock.now = 1250;
+    driver.send(1);
+    tracker.on_alerts(Alerts::TX_SUCCESS);
+
+    TEST_ASSERT_EQUAL(TransmitStatus::SUCCESS, a.status());
+    TEST_ASSERT_EQUAL(TransmitStatus::QUEUED, b.status());
+    // The freed driver slot is refilled from the pending frames
+    TEST_ASSERT_EQUAL(TransmitStatus::QUEUED, c.status());
+
+    TransmitResult result;
+    TEST_ASSERT_TRUE(a.result(result));
+    TEST_ASSERT_EQUAL(0x01, result.identifier);
+    TEST_ASSERT_EQUAL(250, result.latency_us());
+    TEST_ASSERT_EQUAL(250, tracker.statistics().max_latency_us);
+}
+
+void test_transmit_tracker_invokes_callback() {
+    FakeDriver driver;
+    Provider provider(&driver.service);
+    MockClockStrategy clock;
+    TransmitTracker tracker(&provider, &clock);
+
+    struct Seen { int calls = 0; uint32_t identifier = 0; TransmitStatus status = TransmitStatus::EXPIRED; } seen;
+    TransmitCallback callback = [](const TransmitResult& result, void* context) {
+        Seen* seen = (Seen*)context;
+        seen->calls++;
+        seen->identifier = result.identifier;
+        seen->status = result.status;
+    };
+
+    tracker.submit(make_frame(0x0C52), callback, &seen);
+    TEST_ASSERT_EQUAL(0, seen.calls);
+
+    driver.service.on_alerts = [&driver](Alert* alerts, Tick) {
+        driver.send(1);
+        *alerts = Alerts::TX_SUCCESS;
+        return Result::OK;
+    };
+    TEST_ASSERT_TRUE(tracker.poll());
+
+    TEST_ASSERT_EQUAL(1, seen.calls);
+    TEST_ASSERT_EQUAL(0x0C52, seen.identifier);
+    TEST_ASSERT_EQUAL(TransmitStatus::SUCCESS, seen.status);
+}
+
+void test_transmit_tracker_reports_failures() {
+    FakeDriver driver;
+    Provider provider(&driver.service);
+    TransmitTracker tracker(&provider, nullptr);
+
+    TransmitHandle a = tracker.submit(make_frame(0x01));
+    TransmitHandle b = tracker.submit(make_frame(0x02));
+
+    driver.send(2);
+    driver.tx_failed_count = 1;
+    tracker.on_alerts(Alerts::TX_SUCCESS | Alerts::TX_FAILED);
+
+    TEST_ASSERT_EQUAL(TransmitStatus::FAILED, a.status());
+    TEST_ASSERT_EQUAL(TransmitStatus::SUCCESS, b.status());
+
+    TransmitHandle c = tracker.submit(make_frame(0x03));
+    tracker.on_alerts(Alerts::BUS_OFF);
+
+    TEST_ASSERT_EQUAL(TransmitStatus::FAILED, c.status());
+    TEST_ASSERT_FALSE(c.wait(0));
+    TEST_ASSERT_EQUAL(2, tracker.statistics().failed);
+    TEST_ASSERT_EQUAL(1, tracker.statistics().succeeded);
+}
+
+void test_transmit_tracker_rejects_when_full_and_expires_handles() {
+    FakeDriver driver;
+    driver.capacity = CAN_TRANSMIT_TRACKER_SLOTS;
+    Provider provider(&driver.service);
+    TransmitTracker tracker(&provider, nullptr);
+
+    TransmitHandle first = tracker.submit(make_frame(0x00));
+    for (uint32_t i = 1; i < CAN_TRANSMIT_TRACKER_SLOTS; i++) {
+        TEST_ASSERT_TRUE(tracker.submit(make_frame(i)).valid());
+    }
+
+    TransmitHandle rejected = tracker.submit(make_frame(0xFF));
+    TEST_ASSERT_FALSE(rejected.valid());
+    TEST_ASSERT_EQUAL(TransmitStatus::EXPIRED, rejected.status());
+    TEST_ASSERT_EQUAL(1, tracker.statistics().rejected);
+
+    driver.send(1);
+    tracker.on_alerts(Alerts::TX_SUCCESS);
+    TEST_ASSERT_EQUAL(TransmitStatus::SUCCESS, first.status());
+
+    // Reusing the slot invalidates the old handle
+    TEST_ASSERT_TRUE(tracker.submit(make_frame(0x10)).valid());
+    TEST_ASSERT_EQUAL(TransmitStatus::EXPIRED, first.status());
+}
+
+void run_transmit_tracker_tests() {
+    RUN_TEST(test_transmit_tracker_submit_does_not_block_on_full_queue);
+    RUN_TEST(test_transmit_tracker_completes_from_alerts);
+    RUN_TEST(test_transmit_tracker_invokes_callback);
+    RUN_TEST(test_transmit_tracker_reports_failures);
+    RUN_TEST(test_transmit_tracker_rejects_when_full_and_expires_handles);
+}
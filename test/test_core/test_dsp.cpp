@@ -0,0 +1,135 @@
+#include <core.h>
+
+#include "test_main.h"
+
+using namespace Core::DSP;
+
+// Deterministic pseudo-random samples spanning the full int16 range
+static int16_t noise(uint32_t& state) {
+    state = state * 1664525U + 1013904223U;
+    return (int16_t)(state >> 16);
+}
+
+void test_fir_step_and_impulse_response() {
+    const int16_t average[4] = { 8192, 8192, 8192, 8192 };
+    FirFilter<int16_t, 4> fir(average);
+    TEST_ASSERT_EQUAL(250, fir.process(1000));
+    TEST_ASSERT_EQUAL(500, fir.process(1000));
+    TEST_ASSERT_EQUAL(750, fir.process(1000));
+    TEST_ASSERT_EQUAL(1000, fir.process(1000));
+    TEST_ASSERT_EQUAL(1000, fir.process(1000));
+
+    // The impulse response is the coefficients, rounded half up
+    const int16_t taps[3] = { 16384, -8192, 4096 };
+    FirFilter<int16_t, 3> impulse(taps);
+    TEST_ASSERT_EQUAL(16384, impulse.process(32767));
+    TEST_ASSERT_EQUAL(-8192, impulse.process(0));
+    TEST_ASSERT_EQUAL(4096, impulse.process(0));
+    TEST_ASSERT_EQUAL(0, impulse.process(0));
+
+    // Prefilled delay line starts at steady state
+    fir.reset(2000);
+    TEST_ASSERT_EQUAL(2000, fir.process(2000));
+}
+
+void test_fir_saturates_and_block_matches_samples() {
+    const int16_t gain[2] = { 32767, 32767 };
+    FirFilter<int16_t, 2> loud(gain);
+    TEST_ASSERT_EQUAL(29999, loud.process(30000));
+    TEST_ASSERT_EQUAL(32767, loud.process(30000));
+    TEST_ASSERT_EQUAL(0, loud.process(-30000));
+    TEST_ASSERT_EQUAL(-32768, loud.process(-30000));
+
+    const int16_t taps[7] = { 1200, -3400, 5600, 20000, 5600, -3400, 1200 };
+    FirFilter<int16_t, 7> single(taps);
+    FirFilter<int16_t, 7> block(taps);
+    int16_t input[257];
+    int16_t output[257];
+    uint32_t state = 1;
+    for (uint32_t i = 0; i < 257; i++) {
+        input[i] = noise(state);
+    }
+    block.process(input, output, 100);
+    block.process(input + 100, output + 100, 157);
+    for (uint32_t i = 0; i < 257; i++) {
+        TEST_ASSERT_EQUAL(single.process(input[i]), output[i]);
+    }
+
+    // Unsigned 12-bit readings use a 64-bit accumulator, no overflow at full scale
+    const int16_t half[2] = { 16384, 16384 };
+    FirFilter<uint16_t, 2> adc(half);
+    adc.process(65535);
+    TEST_ASSERT_EQUAL(65535, adc.process(65535));
+}
+
+void test_biquad_lowpass_step_response() {
+    // Unity DC gain low-pass, the reference values come from an integer model of the same arithmetic
+    const BiquadCoefficients lowpass[1] = { { 846, 1692, 846, -20000, 7000 } };
+    Biquad<int16_t> biquad(lowpass);
+    const int16_t expected[8] = { 52, 218, 450, 663, 824, 929, 989, 1017 };
+    for (uint32_t i = 0; i < 8; i++) {
+        TEST_ASSERT_EQUAL(expected[i], biquad.process(1000));
+    }
+    for (uint32_t i = 0; i < 52; i++) {
+        biquad.process(1000);
+    }
+    TEST_ASSERT_EQUAL(1000, biquad.process(1000));
+
+    // A pass-through second section leaves the cascade output unchanged
+    const BiquadCoefficients cascade[2] = { { 846, 1692, 846, -20000, 7000 }, { 16384, 0, 0, 0, 0 } };
+    Biquad<int16_t, 2> twice(cascade);
+    int16_t input[8] = { 1000, 1000, 1000, 1000, 1000, 1000, 1000, 1000 };
+    int16_t output[8];
+    twice.process(input, output, 8);
+    TEST_ASSERT_EQUAL_INT16_ARRAY(expected, output, 8);
+
+    twice.reset();
+    TEST_ASSERT_EQUAL(52, twice.process(1000));
+}
+
+void test_moving_median_rejects_spikes() {
+    MovingMedian<int16_t, 5> median;
+    // Window still filling, median of what has arrived
+    TEST_ASSERT_EQUAL(10, median.process(10));
+    TEST_ASSERT_EQUAL(12, median.process(12));
+    TEST_ASSERT_EQUAL(12, median.process(4000));
+    TEST_ASSERT_EQUAL(12, median.process(11));
+    TEST_ASSERT_EQUAL(11, median.process(-4000));
+    // Oldest sample leaves the window
+    TEST_ASSERT_EQUAL(12, median.process(13));
+    TEST_ASSERT_EQUAL(13, median.process(14));
+
+    // A step survives once it fills half the window
+    MovingMedian<uint16_t, 3> edge;
+    uint16_t input[6] = { 0, 0, 0, 500, 500, 500 };
+    uint16_t output[6];
+    edge.process(input, output, 6);
+    const uint16_t expected[6] = { 0, 0, 0, 0, 500, 500 };
+    TEST_ASSERT_EQUAL_UINT16_ARRAY(expected, output, 6);
+}
+
+void test_exponential_filter_step_response() {
+    ExponentialFilter<int16_t, 2> filter;
+    TEST_ASSERT_EQUAL(0, filter.process(0));
+    const int16_t expected[6] = { 250, 438, 578, 684, 763, 822 };
+    for (uint32_t i = 0; i < 6; i++) {
+        TEST_ASSERT_EQUAL(expected[i], filter.process(1000));
+    }
+    TEST_ASSERT_EQUAL(366, filter.process(-1000));
+
+    // First sample primes the output, then it converges without a truncation offset
+    ExponentialFilter<uint16_t, 4> adc;
+    TEST_ASSERT_EQUAL(3000, adc.process(3000));
+    for (uint32_t i = 0; i < 400; i++) {
+        adc.process(3001);
+    }
+    TEST_ASSERT_EQUAL(3001, adc.value());
+}
+
+void run_dsp_tests() {
+    RUN_TEST(test_fir_step_and_impulse_response);
+    RUN_TEST(test_fir_saturates_and_block_matches_samples);
+    RUN_TEST(test_biquad_lowpass_step_response);
+    RUN_TEST(test_moving_median_rejects_spikes);
+    RUN_TEST(test_exponential_filter_step_response);
+}
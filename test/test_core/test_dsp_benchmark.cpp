@@ -0,0 +1,61 @@
+#include <cstdint>
+#include <cstdio>
+#include <core.h>
+#include <mocks.h>
+
+#include "test_main.h"
+
+using namespace Core::DSP;
+using namespace MOCKS;
+
+static const uint32_t BENCHMARK_BLOCK = 256;
+static const uint32_t BENCHMARK_BLOCKS = 2000;
+
+// Runs a filter over blocks of samples and reports the throughput
+template<typename FilterT>
+static void report_throughput(const char* name, FilterT& filter, NativeClockStrategy& clock) {
+    int16_t input[BENCHMARK_BLOCK];
+    int16_t output[BENCHMARK_BLOCK];
+    for (uint32_t i = 0; i < BENCHMARK_BLOCK; i++) {
+        input[i] = (int16_t)((i * 2654435761U) >> 20);
+    }
+
+    int32_t checksum = 0;
+    uint64_t start = clock.nanos();
+    for (uint32_t block = 0; block < BENCHMARK_BLOCKS; block++) {
+        filter.process(input, output, BENCHMARK_BLOCK);
+        checksum += output[block % BENCHMARK_BLOCK];
+    }
+    uint64_t elapsed = clock.nanos() - start;
+
+    double samples = (double)BENCHMARK_BLOCK * BENCHMARK_BLOCKS;
+    char message[128];
+    snprintf(message, sizeof(message), "%s: %.1f Msamples/s (checksum %ld)", name,
+             samples * 1000.0 / (double)(elapsed ? elapsed : 1), (long)checksum);
+    TEST_MESSAGE(message);
+}
+
+void test_dsp_throughput_benchmark() {
+    NativeClockStrategy clock;
+
+    int16_t taps[16];
+    for (uint32_t i = 0; i < 16; i++) {
+        taps[i] = 2048;
+    }
+    FirFilter<int16_t, 16> fir(taps);
+    report_throughput("fir16", fir, clock);
+
+    const BiquadCoefficients lowpass[2] = { { 846, 1692, 846, -20000, 7000 }, { 846, 1692, 846, -20000, 7000 } };
+    Biquad<int16_t, 2> biquad(lowpass);
+    report_throughput("biquad x2", biquad, clock);
+
+    MovingMedian<int16_t, 5> median;
+    report_throughput("median5", median, clock);
+
+    ExponentialFilter<int16_t, 3> exponential;
+    report_throughput("exponential", exponential, clock);
+}
+
+void run_dsp_benchmark_tests() {
+    RUN_TEST(test_dsp_throughput_benchmark);
+}
@@ -0,0 +1,56 @@
+#include <core.h>
+
+#include "test_main.h"
+
+using namespace Core;
+
+typedef Fixed<int16_t, 10> DeciAmps;
+typedef Fixed<int32_t, 1000> MilliAmps;
+typedef Fixed<int32_t, 1000> MilliVolts;
+
+// Conversions between scales fold to constants
+static_assert(fixed_cast<MilliAmps>(DeciAmps::from_units(12)).raw == 12000, "tenths to thousandths multiply");
+static_assert(fixed_cast<DeciAmps>(MilliAmps::from_raw(-12345)).raw == -123, "thousandths to tenths truncate");
+static_assert(sizeof(DeciAmps) == sizeof(int16_t), "no storage beyond the raw value");
+
+void test_fixed_scales_and_converts() {
+    DeciAmps current = DeciAmps::from_units(25);
+    TEST_ASSERT_EQUAL(250, current.raw);
+    TEST_ASSERT_EQUAL(25, current.units());
+    TEST_ASSERT_EQUAL(-2, DeciAmps::from_raw(-25).units());
+
+    // Orion reports mA, the inverter takes tenths of an ampere
+    MilliAmps bms = MilliAmps::from_raw(187654);
+    TEST_ASSERT_EQUAL(1876, fixed_cast<DeciAmps>(bms).raw);
+    TEST_ASSERT_EQUAL(187600, fixed_cast<MilliAmps>(fixed_cast<DeciAmps>(bms)).raw);
+
+    // Scales that do not divide each other go through the reduced ratio
+    Fixed<int32_t, 4> quarters = { 7 };
+    TEST_ASSERT_EQUAL(17, fixed_cast<DeciAmps>(quarters).raw);
+}
+
+void test_fixed_arithmetic_saturates() {
+    DeciAmps a = DeciAmps::from_units(3000);
+    DeciAmps b = DeciAmps::from_units(500);
+    TEST_ASSERT_EQUAL(32767, (a + b).raw);
+    TEST_ASSERT_EQUAL(25000, (a - b).raw);
+    TEST_ASSERT_EQUAL(-32768, (-a - b - b).raw);
+    TEST_ASSERT_EQUAL(32767, (-DeciAmps::min()).raw);
+    TEST_ASSERT_EQUAL(10000, (b * 2).raw);
+    TEST_ASSERT_EQUAL(32767, (4 * a).raw);
+    TEST_ASSERT_EQUAL(1666, (b / 3).raw);
+
+    // Conversion into a narrower type saturates too
+    TEST_ASSERT_EQUAL(32767, fixed_cast<DeciAmps>(MilliAmps::from_units(4000)).raw);
+    TEST_ASSERT_EQUAL(-32768, DeciAmps::from_units(-5000).raw);
+
+    TEST_ASSERT_TRUE(b < a);
+    TEST_ASSERT_TRUE(a >= a);
+    TEST_ASSERT_TRUE(DeciAmps::from_raw(50) == DeciAmps::from_units(5));
+    TEST_ASSERT_TRUE(MilliVolts::from_units(3) != MilliVolts::from_raw(3));
+}
+
+void run_fixed_tests() {
+    RUN_TEST(test_fixed_scales_and_converts);
+    RUN_TEST(test_fixed_arithmetic_saturates);
+}
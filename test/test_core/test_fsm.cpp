@@ -0,0 +1,196 @@
+#include <cstdio>
+#include <string>
+#include <core.h>
+#include <mocks.h>
+
+#include "test_main.h"
+
+using namespace Core::Fsm;
+using namespace MOCKS;
+
+// Coin operated turnstile with a service mode reachable from anywhere
+enum class Gate : uint8_t { LOCKED, UNLOCKED, SERVICE };
+enum class Input : uint8_t { COIN, PUSH, SERVICE, RESUME, COUNT_UP };
+
+struct Turnstile {
+    std::string trace;
+    uint32_t coins = 0;
+    bool free_entry = false;
+    bool quiet = false;
+
+    void log(const char* step) { if (!quiet) trace += step; }
+};
+
+struct TurnstileTable {
+    typedef Turnstile Context;
+    typedef Gate State;
+    typedef Input Event;
+
+    static constexpr uint8_t STATES = 3;
+    static constexpr uint8_t EVENTS = 5;
+    static constexpr State INITIAL = Gate::LOCKED;
+
+    static bool free(const Turnstile& t) { return t.free_entry; }
+    static bool paid(const Turnstile& t) { return t.coins > 0; }
+    static void take_coin(Turnstile& t) { t.coins++; t.log("coin "); }
+    static void spend_coin(Turnstile& t) { t.coins--; t.log("spend "); }
+    static void count(Turnstile& t) { t.log("count "); }
+    static void enter_locked(Turnstile& t) { t.log("+locked "); }
+    static void exit_locked(Turnstile& t) { t.log("-locked "); }
+    static void enter_unlocked(Turnstile& t) { t.log("+unlocked "); }
+    static void exit_unlocked(Turnstile& t) { t.log("-unlocked "); }
+
+    static constexpr Transition<Turnstile, Gate, Input> TRANSITIONS[] = {
+        { Gate::LOCKED, Input::COIN, Gate::UNLOCKED, nullptr, &take_coin },
+        // Alternatives, tried in order
+        { Gate::LOCKED, Input::PUSH, Gate::UNLOCKED, &free, nullptr },
+        { Gate::LOCKED, Input::PUSH, Gate::UNLOCKED, &paid, &spend_coin },
+        { Gate::UNLOCKED, Input::PUSH, Gate::LOCKED, nullptr, nullptr },
+        { Gate::UNLOCKED, Input::COIN, stay<Gate>(), nullptr, &take_coin },
+        { any<Gate>(), Input::SERVICE, Gate::SERVICE, nullptr, nullptr },
+        { any<Gate>(), Input::COUNT_UP, stay<Gate>(), nullptr, &count },
+        // A specific row wins over the wildcard
+        { Gate::SERVICE, Input::COUNT_UP, Gate::SERVICE, nullptr, nullptr },
+        { Gate::SERVICE, Input::RESUME, Gate::LOCKED, nullptr, nullptr },
+    };
+
+    static constexpr StateHooks<Turnstile> HOOKS[STATES] = {
+        { &enter_locked, &exit_locked },
+        { &enter_unlocked, &exit_unlocked },
+        { nullptr, nullptr },
+    };
+};
+
+constexpr Transition<Turnstile, Gate, Input> TurnstileTable::TRANSITIONS[];
+constexpr StateHooks<Turnstile> TurnstileTable::HOOKS[];
+constexpr Gate TurnstileTable::INITIAL;
+
+typedef StateMachine<TurnstileTable> TurnstileMachine;
+
+// The index is built by the compiler
+typedef Detail::TransitionIndex<TurnstileTable, Core::Lut::MakeIndices<15>::type> TurnstileIndex;
+static_assert(TurnstileIndex::VALUES[0 * 5 + (uint8_t)Input::PUSH] == 1, "first alternative row");
+static_assert(TurnstileIndex::VALUES[1 * 5 + (uint8_t)Input::SERVICE] == 5, "wildcard row");
+static_assert(TurnstileIndex::VALUES[2 * 5 + (uint8_t)Input::COUNT_UP] == 7, "specific row before the wildcard");
+static_assert(TurnstileIndex::VALUES[1 * 5 + (uint8_t)Input::RESUME] == NO_TRANSITION, "no transition");
+
+void test_fsm_hooks_and_actions_order() {
+    Turnstile turnstile;
+    TurnstileMachine machine(&turnstile);
+    machine.start();
+    TEST_ASSERT_EQUAL_STRING("+locked ", turnstile.trace.c_str());
+
+    turnstile.trace.clear();
+    TEST_ASSERT_TRUE(machine.dispatch(Input::COIN));
+    TEST_ASSERT_EQUAL(Gate::UNLOCKED, machine.state());
+    TEST_ASSERT_EQUAL_STRING("-locked coin +unlocked ", turnstile.trace.c_str());
+
+    // Internal transition, no exit or entry
+    turnstile.trace.clear();
+    TEST_ASSERT_TRUE(machine.dispatch(Input::COIN));
+    TEST_ASSERT_EQUAL(Gate::UNLOCKED, machine.state());
+    TEST_ASSERT_EQUAL_STRING("coin ", turnstile.trace.c_str());
+    TEST_ASSERT_EQUAL(2, turnstile.coins);
+}
+
+void test_fsm_guards_pick_the_first_passing_row() {
+    Turnstile turnstile;
+    TurnstileMachine machine(&turnstile);
+    machine.start();
+
+    // Neither alternative passes
+    TEST_ASSERT_FALSE(machine.dispatch(Input::PUSH));
+    TEST_ASSERT_EQUAL(Gate::LOCKED, machine.state());
+
+    turnstile.free_entry = true;
+    turnstile.coins = 1;
+    TEST_ASSERT_TRUE(machine.dispatch(Input::PUSH));
+    TEST_ASSERT_EQUAL(1, turnstile.coins);
+
+    machine.dispatch(Input::PUSH);
+    turnstile.free_entry = false;
+    TEST_ASSERT_TRUE(machine.dispatch(Input::PUSH));
+    TEST_ASSERT_EQUAL(0, turnstile.coins);
+
+    TurnstileMachine::Statistics statistics = machine.statistics();
+    TEST_ASSERT_EQUAL(4, statistics.dispatched);
+    TEST_ASSERT_EQUAL(3, statistics.transitions);
+    TEST_ASSERT_EQUAL(1, statistics.rejected);
+    TEST_ASSERT_EQUAL(0, statistics.ignored);
+}
+
+void test_fsm_wildcard_rows() {
+    Turnstile turnstile;
+    TurnstileMachine machine(&turnstile);
+    machine.start();
+
+    // Counted from any state without leaving it
+    TEST_ASSERT_TRUE(machine.dispatch(Input::COUNT_UP));
+    TEST_ASSERT_EQUAL(Gate::LOCKED, machine.state());
+
+    machine.dispatch(Input::COIN);
+    TEST_ASSERT_TRUE(machine.dispatch(Input::SERVICE));
+    TEST_ASSERT_EQUAL(Gate::SERVICE, machine.state());
+
+    // The service row for COUNT_UP replaces the wildcard one
+    turnstile.trace.clear();
+    TEST_ASSERT_TRUE(machine.dispatch(Input::COUNT_UP));
+    TEST_ASSERT_EQUAL_STRING("", turnstile.trace.c_str());
+
+    // No transition at all, and an event outside the table
+    TEST_ASSERT_FALSE(machine.dispatch(Input::COIN));
+    TEST_ASSERT_FALSE(machine.dispatch((Input)42));
+    TEST_ASSERT_EQUAL(2, machine.statistics().ignored);
+
+    TEST_ASSERT_TRUE(machine.dispatch(Input::RESUME));
+    TEST_ASSERT_EQUAL(Gate::LOCKED, machine.state());
+}
+
+void test_fsm_latency_and_entry_time() {
+    MockClockStrategy clock;
+    clock.now = 1000;
+    Turnstile turnstile;
+    TurnstileMachine machine(&turnstile, &clock);
+    machine.start();
+    TEST_ASSERT_EQUAL(1000, machine.entered_us());
+
+    // Observed 250 us before it was dispatched
+    clock.advance(500);
+    machine.dispatch(Input::COIN, 1250);
+    TEST_ASSERT_EQUAL(1500, machine.entered_us());
+    TEST_ASSERT_EQUAL(1, machine.latency().count());
+    TEST_ASSERT_EQUAL(250, machine.latency().max());
+
+    // Ignored events are not measured
+    machine.dispatch(Input::RESUME);
+    TEST_ASSERT_EQUAL(1, machine.latency().count());
+}
+
+void test_fsm_dispatch_benchmark() {
+    NativeClockStrategy clock;
+    Turnstile turnstile;
+    TurnstileMachine machine(&turnstile);
+    machine.start();
+    turnstile.free_entry = true;
+    turnstile.quiet = true;
+
+    const uint32_t rounds = 200000;
+    uint64_t start = clock.nanos();
+    for (uint32_t i = 0; i < rounds; i++) {
+        machine.dispatch(Input::PUSH);
+    }
+    uint64_t elapsed = clock.nanos() - start;
+    TEST_ASSERT_EQUAL(rounds, machine.statistics().transitions);
+
+    char message[96];
+    snprintf(message, sizeof(message), "%.1f ns per transition with exit and entry hooks", (double)elapsed / rounds);
+    TEST_MESSAGE(message);
+}
+
+void run_fsm_tests() {
+    RUN_TEST(test_fsm_hooks_and_actions_order);
+    RUN_TEST(test_fsm_guards_pick_the_first_passing_row);
+    RUN_TEST(test_fsm_wildcard_rows);
+    RUN_TEST(test_fsm_latency_and_entry_time);
+    RUN_TEST(test_fsm_dispatch_benchmark);
+}
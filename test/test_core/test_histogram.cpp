@@ -0,0 +1,47 @@
+#include <core.h>
+
+#include "test_main.h"
+
+void test_histogram_buckets_by_power_of_two() {
+    Core::Log2Histogram<8> histogram;
+    histogram.record(0);
+    histogram.record(1);
+    histogram.record(2);
+    histogram.record(3);
+    histogram.record(100);
+    // Larger than the last bucket, collected by it
+    histogram.record(100000);
+
+    TEST_ASSERT_EQUAL(1, histogram.bucket(0));
+    TEST_ASSERT_EQUAL(1, histogram.bucket(1));
+    TEST_ASSERT_EQUAL(2, histogram.bucket(2));
+    // 100 falls in [64, 128), the last bucket
+    TEST_ASSERT_EQUAL(2, histogram.bucket(7));
+    TEST_ASSERT_EQUAL(6, histogram.count());
+    TEST_ASSERT_EQUAL(0, histogram.min());
+    TEST_ASSERT_EQUAL(100000, histogram.max());
+}
+
+void test_histogram_percentiles() {
+    Core::Log2Histogram<> histogram;
+    TEST_ASSERT_EQUAL(0, histogram.percentile(500));
+
+    for (uint32_t i = 0; i < 99; i++) {
+        histogram.record(10);
+    }
+    histogram.record(5000);
+
+    TEST_ASSERT_EQUAL(15, histogram.percentile(500));
+    TEST_ASSERT_EQUAL(15, histogram.percentile(990));
+    TEST_ASSERT_EQUAL(5000, histogram.percentile(999));
+    TEST_ASSERT_EQUAL(59, histogram.mean());
+
+    histogram.reset();
+    TEST_ASSERT_EQUAL(0, histogram.count());
+    TEST_ASSERT_EQUAL(0, histogram.max());
+}
+
+void run_histogram_tests() {
+    RUN_TEST(test_histogram_buckets_by_power_of_two);
+    RUN_TEST(test_histogram_percentiles);
+}
@@ -0,0 +1,90 @@
+#include <core.h>
+
+#include "test_main.h"
+
+using namespace Core::Lut;
+
+// Fan duty in tenths of a percent against coolant temperature in tenths of a degree, smoothstep from 30 to 80 degrees
+struct FanCurve {
+    static constexpr int16_t value(int32_t t) {
+        return t <= 300 ? 0 : t >= 800 ? 1000 : (int16_t)((t - 300) * (t - 300) * (1500 - 2 * (t - 300)) / 125000);
+    }
+};
+
+static constexpr Table<int16_t, int16_t, 4> DERATING = { { -400, 600, 900, 1200 }, { 1000, 1000, 400, 0 } };
+static_assert(DERATING.valid(), "derating axis must increase");
+
+static constexpr Table<int16_t, int16_t, 3> UNSORTED = { { 0, 10, 10 }, { 0, 1, 2 } };
+static_assert(!UNSORTED.valid(), "repeated breakpoints are rejected");
+
+static constexpr UniformTable<int16_t, 17, 6> FAN = generate<FanCurve, int16_t, 17, 6>(0);
+static_assert(FAN.values[8] == FanCurve::value(512), "generated at compile time");
+
+void test_lut_segment_matches_linear_scan() {
+    const int32_t axis[9] = { -50, -10, 0, 3, 4, 20, 100, 101, 500 };
+    for (uint32_t count = 2; count <= 9; count++) {
+        for (int32_t x = -60; x <= 510; x++) {
+            uint32_t expected = 0;
+            while (expected + 2 < count && axis[expected + 1] <= x) expected++;
+            TEST_ASSERT_EQUAL(expected, segment(axis, count, x));
+        }
+    }
+}
+
+void test_lut_non_uniform_table() {
+    TEST_ASSERT_EQUAL(1000, DERATING.lookup(-1000));
+    TEST_ASSERT_EQUAL(1000, DERATING.lookup(600));
+    TEST_ASSERT_EQUAL(700, DERATING.lookup(750));
+    TEST_ASSERT_EQUAL(400, DERATING.lookup(900));
+    // Truncates towards zero like the integer formula
+    TEST_ASSERT_EQUAL(266, DERATING.lookup(1001));
+    TEST_ASSERT_EQUAL(0, DERATING.lookup(1200));
+    TEST_ASSERT_EQUAL(0, DERATING.lookup(32000));
+}
+
+void test_lut_generated_uniform_table() {
+    for (uint32_t i = 0; i < 17; i++) {
+        TEST_ASSERT_EQUAL(FanCurve::value(FAN.axis(i)), FAN.lookup(FAN.axis(i)));
+    }
+    // Between 320 and 384, 4 and 75 at the knots
+    TEST_ASSERT_EQUAL(4, FanCurve::value(320));
+    TEST_ASSERT_EQUAL(75, FanCurve::value(384));
+    TEST_ASSERT_EQUAL(39, FAN.lookup(352));
+    TEST_ASSERT_EQUAL(0, FAN.lookup(-100));
+    TEST_ASSERT_EQUAL(1000, FAN.lookup(1024));
+    TEST_ASSERT_EQUAL(1000, FAN.lookup(5000));
+
+    // Falling segments round towards minus infinity
+    const UniformTable<int16_t, 2, 2> falling = { 0, { 10, 7 } };
+    TEST_ASSERT_EQUAL(10, falling.lookup(0));
+    TEST_ASSERT_EQUAL(9, falling.lookup(1));
+    TEST_ASSERT_EQUAL(8, falling.lookup(2));
+    TEST_ASSERT_EQUAL(7, falling.lookup(3));
+    TEST_ASSERT_EQUAL(7, falling.lookup(4));
+}
+
+void test_lut_bilinear_table() {
+    // A plane is reproduced exactly, including on the clamped edges
+    static constexpr Table2D<int16_t, int16_t, 3, 4> plane = {
+        { 0, 100, 300 }, { -200, 0, 50, 1000 },
+        { { -400, 0, 100, 2000 }, { -100, 300, 400, 2300 }, { 500, 900, 1000, 2900 } }
+    };
+    static_assert(plane.valid(), "plane axes must increase");
+    TEST_ASSERT_EQUAL(0, plane.lookup(0, 0));
+    TEST_ASSERT_EQUAL(150, plane.lookup(50, 0));
+    TEST_ASSERT_EQUAL(650, plane.lookup(200, 25));
+    TEST_ASSERT_EQUAL(2900, plane.lookup(300, 1000));
+    TEST_ASSERT_EQUAL(-400, plane.lookup(-50, -500));
+
+    // Fixed-point blend of four different corners
+    const Table2D<int16_t, int16_t, 2, 2> corners = { { 0, 10 }, { 0, 10 }, { { 0, 100 }, { 100, 1000 } } };
+    TEST_ASSERT_EQUAL(300, corners.lookup(5, 5));
+    TEST_ASSERT_EQUAL(50, corners.lookup(0, 5));
+}
+
+void run_lut_tests() {
+    RUN_TEST(test_lut_segment_matches_linear_scan);
+    RUN_TEST(test_lut_non_uniform_table);
+    RUN_TEST(test_lut_generated_uniform_table);
+    RUN_TEST(test_lut_bilinear_table);
+}
@@ -0,0 +1,113 @@
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <core.h>
+#include <mocks.h>
+
+#include "test_main.h"
+
+using namespace Core::Lut;
+using namespace MOCKS;
+
+static const uint32_t BENCHMARK_ROUNDS = 200;
+
+// Same smoothstep fan curve as the LUT tests, evaluated directly in float
+static float fan_formula(int32_t t) {
+    if (t <= 300) return 0.0f;
+    if (t >= 800) return 1000.0f;
+    float s = (float)(t - 300) / 500.0f;
+    return 1000.0f * s * s * (3.0f - 2.0f * s);
+}
+
+struct BenchmarkFanCurve {
+    static constexpr int16_t value(int32_t t) {
+        return t <= 300 ? 0 : t >= 800 ? 1000 : (int16_t)((t - 300) * (t - 300) * (1500 - 2 * (t - 300)) / 125000);
+    }
+};
+
+// 10k NTC with beta 3435 on the low side of a 10k divider, tenths of a degree from 12-bit ADC counts
+static float ntc_formula(int32_t adc) {
+    float resistance = 10000.0f * (float)adc / (float)(4095 - adc);
+    float kelvin = 1.0f / (1.0f / 298.15f + std::log(resistance / 10000.0f) / 3435.0f);
+    return (kelvin - 273.15f) * 10.0f;
+}
+
+static void report(const char* name, uint64_t direct_ns, uint64_t table_ns, uint32_t lookups, int32_t error) {
+    char message[160];
+    snprintf(message, sizeof(message), "%s: direct %.2f ns, table %.2f ns per lookup, max error %ld",
+             name, (double)direct_ns / lookups, (double)table_ns / lookups, (long)error);
+    TEST_MESSAGE(message);
+}
+
+void test_lut_polynomial_benchmark() {
+    NativeClockStrategy clock;
+    static constexpr UniformTable<int16_t, 17, 6> table = generate<BenchmarkFanCurve, int16_t, 17, 6>(0);
+
+    volatile float sink_direct = 0;
+    volatile int32_t sink_table = 0;
+    uint64_t start = clock.nanos();
+    for (uint32_t round = 0; round < BENCHMARK_ROUNDS; round++) {
+        for (int32_t t = 0; t < 1024; t++) sink_direct = sink_direct + fan_formula(t);
+    }
+    uint64_t direct_ns = clock.nanos() - start;
+
+    start = clock.nanos();
+    for (uint32_t round = 0; round < BENCHMARK_ROUNDS; round++) {
+        for (int32_t t = 0; t < 1024; t++) sink_table = sink_table + table.lookup(t);
+    }
+    uint64_t table_ns = clock.nanos() - start;
+
+    int32_t error = 0;
+    for (int32_t t = 0; t < 1024; t++) {
+        int32_t delta = (int32_t)std::lround(fan_formula(t)) - table.lookup(t);
+        if (delta < 0) delta = -delta;
+        if (delta > error) error = delta;
+    }
+    // 17 samples of a cubic, the chord error stays within one percent
+    TEST_ASSERT_LESS_OR_EQUAL(10, error);
+    report("fan smoothstep", direct_ns, table_ns, BENCHMARK_ROUNDS * 1024, error);
+}
+
+void test_lut_logarithm_benchmark() {
+    NativeClockStrategy clock;
+
+    // Breakpoints denser towards the rails where the curve bends, filled once at start-up
+    Table<int32_t, int16_t, 24> table;
+    const int32_t axis[24] = { 40, 60, 90, 130, 180, 250, 350, 500, 700, 950, 1250, 1600,
+                               2000, 2400, 2750, 3050, 3300, 3500, 3660, 3790, 3890, 3960, 4010, 4050 };
+    for (uint32_t i = 0; i < 24; i++) {
+        table.axis[i] = axis[i];
+        table.values[i] = (int16_t)std::lround(ntc_formula(axis[i]));
+    }
+    TEST_ASSERT_TRUE(table.valid());
+
+    volatile float sink_direct = 0;
+    volatile int32_t sink_table = 0;
+    uint64_t start = clock.nanos();
+    for (uint32_t round = 0; round < BENCHMARK_ROUNDS / 4; round++) {
+        for (int32_t adc = 40; adc <= 4050; adc++) sink_direct = sink_direct + ntc_formula(adc);
+    }
+    uint64_t direct_ns = clock.nanos() - start;
+
+    start = clock.nanos();
+    for (uint32_t round = 0; round < BENCHMARK_ROUNDS / 4; round++) {
+        for (int32_t adc = 40; adc <= 4050; adc++) sink_table = sink_table + table.lookup(adc);
+    }
+    uint64_t table_ns = clock.nanos() - start;
+
+    // Error over the range a coolant sensor actually sees, -20 to 120 degrees
+    int32_t error = 0;
+    for (int32_t adc = 40; adc <= 4050; adc++) {
+        int32_t exact = (int32_t)std::lround(ntc_formula(adc));
+        if (exact < -200 || exact > 1200) continue;
+        int32_t delta = exact - table.lookup(adc);
+        if (delta < 0) delta = -delta;
+        if (delta > error) error = delta;
+    }
+    report("ntc logarithm", direct_ns, table_ns, (BENCHMARK_ROUNDS / 4) * 4011, error);
+}
+
+void run_lut_benchmark_tests() {
+    RUN_TEST(test_lut_polynomial_benchmark);
+    RUN_TEST(test_lut_logarithm_benchmark);
+}
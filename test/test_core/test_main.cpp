@@ -17,5 +17,14 @@ void test_basic() {
 int main() {
     UNITY_BEGIN();
     RUN_TEST(test_basic);
+    run_histogram_tests();
+    run_dsp_tests();
+    run_dsp_benchmark_tests();
+    run_lut_tests();
+    run_lut_benchmark_tests();
+    run_fixed_tests();
+    run_fsm_tests();
+    run_startup_tests();
+    run_memory_tests();
     return UNITY_END();
 }
\ No newline at end of file
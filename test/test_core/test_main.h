@@ -3,4 +3,14 @@
 
 #include <unity.h>
 
+void run_histogram_tests();
+void run_dsp_tests();
+void run_dsp_benchmark_tests();
+void run_lut_tests();
+void run_lut_benchmark_tests();
+void run_fixed_tests();
+void run_fsm_tests();
+void run_startup_tests();
+void run_memory_tests();
+
 #endif // TEST_MAIN_H
\ No newline at end of file
@@ -0,0 +1,151 @@
+#include <memory>
+#include <core.h>
+#include <can.h>
+#include <pedals.h>
+#include <mocks.h>
+
+#include "test_main.h"
+
+using namespace Core::Memory;
+using namespace MOCKS;
+
+struct Tracked {
+    static int alive;
+    uint32_t value;
+
+    explicit Tracked(uint32_t value) : value(value) { alive++; }
+    ~Tracked() { alive--; }
+};
+
+int Tracked::alive = 0;
+
+static uint32_t trips = 0;
+static size_t tripped_size = 0;
+
+static void count_trip(size_t size) {
+    trips++;
+    tripped_size = size;
+}
+
+void test_arena_aligns_and_refuses_when_full() {
+    StaticArena<64> arena;
+    uint8_t* byte = (uint8_t*)arena.allocate(1, 1);
+    uint64_t* word = (uint64_t*)arena.allocate(sizeof(uint64_t), alignof(uint64_t));
+    TEST_ASSERT_NOT_NULL(byte);
+    TEST_ASSERT_EQUAL(0, (uintptr_t)word % alignof(uint64_t));
+    TEST_ASSERT_EQUAL(16, arena.used());
+    TEST_ASSERT_TRUE(arena.owns(word));
+
+    Tracked* tracked = arena.create<Tracked>(7);
+    TEST_ASSERT_EQUAL(7, tracked->value);
+    TEST_ASSERT_EQUAL(1, Tracked::alive);
+    tracked->~Tracked();
+
+    TEST_ASSERT_NULL(arena.allocate(64));
+    TEST_ASSERT_EQUAL(1, arena.failures());
+    TEST_ASSERT_NOT_NULL(arena.allocate(64 - arena.used(), 1));
+    TEST_ASSERT_EQUAL(64, arena.used());
+
+    arena.reset();
+    TEST_ASSERT_EQUAL(0, arena.used());
+    TEST_ASSERT_EQUAL(byte, arena.allocate(1, 1));
+}
+
+void test_object_pool_reuses_slots() {
+    ObjectPool<Tracked, 3> pool;
+    Tracked* a = pool.create(1);
+    Tracked* b = pool.create(2);
+    Tracked* c = pool.create(3);
+    TEST_ASSERT_NULL(pool.create(4));
+    TEST_ASSERT_EQUAL(1, pool.exhausted());
+    TEST_ASSERT_EQUAL(3, Tracked::alive);
+    TEST_ASSERT_EQUAL(0, pool.available());
+
+    TEST_ASSERT_TRUE(pool.destroy(b));
+    TEST_ASSERT_EQUAL(2, Tracked::alive);
+    // Twice, or not from the pool
+    TEST_ASSERT_FALSE(pool.destroy(b));
+    Tracked outside(5);
+    TEST_ASSERT_FALSE(pool.destroy(&outside));
+    TEST_ASSERT_FALSE(pool.destroy((Tracked*)((uint8_t*)a + 1)));
+
+    // The freed slot is handed out again
+    Tracked* d = pool.create(6);
+    TEST_ASSERT_EQUAL(b, d);
+    TEST_ASSERT_EQUAL(6, d->value);
+    TEST_ASSERT_EQUAL(3, pool.high_water());
+
+    pool.destroy(a);
+    pool.destroy(c);
+    pool.destroy(d);
+    TEST_ASSERT_EQUAL(0, pool.in_use());
+    TEST_ASSERT_EQUAL(1, Tracked::alive);
+}
+
+void test_static_heap_counts_allocations() {
+    if (!static_heap_enabled()) {
+        TEST_IGNORE_MESSAGE("built without CORE_STATIC_HEAP");
+    }
+
+    // Calls rather than new-expressions, which the optimizer may elide
+    HeapStatistics before = heap_statistics();
+    void* value = ::operator new(sizeof(int));
+    ::operator delete(value);
+    HeapStatistics after = heap_statistics();
+    TEST_ASSERT_EQUAL(1, after.allocations - before.allocations);
+    TEST_ASSERT_EQUAL(1, after.frees - before.frees);
+    TEST_ASSERT_EQUAL(CORE_STATIC_HEAP_SIZE, after.capacity);
+}
+
+void test_static_heap_steady_state_is_allocation_free() {
+    if (!static_heap_enabled()) {
+        TEST_IGNORE_MESSAGE("built without CORE_STATIC_HEAP");
+    }
+
+    // Init, everything the loop needs is built here
+    MockClockStrategy clock;
+    NullCanService service;
+    std::shared_ptr<CAN::BasicProvider<NullCanService>> provider = std::make_shared<CAN::BasicProvider<NullCanService>>(&service);
+    Pedals::ShutdownSequence sequence(&clock);
+    ObjectPool<Tracked, 4> pool;
+    sequence.start();
+    sequence.set_glv(true);
+    sequence.set_shutdown(true);
+    CAN::Frame frame;
+
+    trips = 0;
+    set_trip_handler(&count_trip);
+    seal();
+    HeapStatistics before = heap_statistics();
+
+    for (uint32_t i = 0; i < 1000; i++) {
+        clock.advance(1000);
+        provider->transmit(frame);
+        provider->receive(frame);
+        sequence.dispatch(frame);
+        sequence.poll();
+        pool.destroy(pool.create(i));
+    }
+    HeapStatistics loop = heap_statistics();
+
+    // A stray allocation trips
+    void* stray = ::operator new(sizeof(int));
+    HeapStatistics tripped = heap_statistics();
+    unseal();
+    set_trip_handler(nullptr);
+    ::operator delete(stray);
+
+    TEST_ASSERT_EQUAL(0, loop.after_seal - before.after_seal);
+    TEST_ASSERT_EQUAL(0, loop.allocations - before.allocations);
+    TEST_ASSERT_EQUAL(1, tripped.after_seal - before.after_seal);
+    TEST_ASSERT_EQUAL(1, trips);
+    TEST_ASSERT_EQUAL(sizeof(int), tripped_size);
+    TEST_ASSERT_FALSE(sealed());
+}
+
+void run_memory_tests() {
+    RUN_TEST(test_arena_aligns_and_refuses_when_full);
+    RUN_TEST(test_object_pool_reuses_slots);
+    RUN_TEST(test_static_heap_counts_allocations);
+    RUN_TEST(test_static_heap_steady_state_is_allocation_free);
+}
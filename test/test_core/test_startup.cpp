@@ -0,0 +1,225 @@
+#include <atomic>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <chrono>
+#include <core.h>
+#include <mocks.h>
+
+#include "test_main.h"
+
+using namespace Core::Startup;
+using namespace MOCKS;
+
+typedef Orchestrator<8, 2> Boot;
+
+// Init step that takes a fixed time on a mock clock and logs its name
+struct MockStep {
+    MockClockStrategy* clock;
+    std::string* trace;
+    const char* name;
+    uint64_t duration_us;
+    bool ok;
+
+    static bool run(void* context) {
+        MockStep* step = (MockStep*)context;
+        step->clock->advance(step->duration_us);
+        *step->trace += step->name;
+        *step->trace += " ";
+        return step->ok;
+    }
+};
+
+// Thread strategy that counts how often its task is set up and put to sleep
+struct CountingThreadStrategy : public NativeThreadStrategy {
+    const char* name = nullptr;
+    uint32_t priority = 0;
+    std::atomic<uint32_t> sleeps;
+
+    CountingThreadStrategy() : sleeps(0) {}
+
+    void setup(const char* name, const uint32_t priority, const uint32_t attributes) override {
+        this->name = name;
+        this->priority = priority;
+    }
+
+    void sleep(const uint32_t millis) override {
+        sleeps++;
+        NativeThreadStrategy::sleep(millis);
+    }
+};
+
+// Init step that really sleeps, for the parallel run
+static bool sleep_20ms(void*) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    return true;
+}
+
+void test_startup_runs_steps_in_dependency_order() {
+    MockClockStrategy clock;
+    clock.now = 5000;
+    std::string trace;
+    MockStep can = { &clock, &trace, "can", 300, true };
+    MockStep pedals = { &clock, &trace, "pedals", 200, true };
+    MockStep heartbeat = { &clock, &trace, "heartbeat", 100, true };
+
+    Boot boot(&clock, nullptr, 1000);
+    uint8_t heartbeat_id = boot.add("heartbeat", &MockStep::run, &heartbeat);
+    uint8_t can_id = boot.add("can", &MockStep::run, &can);
+    uint8_t pedals_id = boot.add("pedals", &MockStep::run, &pedals);
+
+    // Only steps added earlier can be waited on
+    TEST_ASSERT_FALSE(boot.after(heartbeat_id, can_id));
+    TEST_ASSERT_FALSE(boot.after(can_id, can_id));
+    TEST_ASSERT_TRUE(boot.after(pedals_id, can_id));
+
+    TEST_ASSERT_TRUE(boot.run());
+    TEST_ASSERT_EQUAL_STRING("heartbeat can pedals ", trace.c_str());
+
+    // Times are since power on
+    StepRecord record = boot.record(pedals_id);
+    TEST_ASSERT_EQUAL(StepStatus::DONE, record.status);
+    TEST_ASSERT_EQUAL(0, record.worker);
+    TEST_ASSERT_EQUAL(4400, record.started_us);
+    TEST_ASSERT_EQUAL(200, record.duration_us());
+    TEST_ASSERT_EQUAL(4000, boot.started_us());
+    TEST_ASSERT_EQUAL(600, boot.elapsed_us());
+}
+
+void test_startup_failure_skips_dependents() {
+    MockClockStrategy clock;
+    std::string trace;
+    MockStep can = { &clock, &trace, "can", 100, false };
+    MockStep heartbeat = { &clock, &trace, "heartbeat", 100, true };
+    MockStep telemetry = { &clock, &trace, "telemetry", 100, true };
+    MockStep pedals = { &clock, &trace, "pedals", 100, true };
+
+    Boot boot(&clock, nullptr);
+    uint8_t can_id = boot.add("can", &MockStep::run, &can);
+    uint8_t heartbeat_id = boot.add("heartbeat", &MockStep::run, &heartbeat);
+    uint8_t pedals_id = boot.add("pedals", &MockStep::run, &pedals);
+    uint8_t telemetry_id = boot.add("telemetry", &MockStep::run, &telemetry);
+    boot.after(heartbeat_id, can_id);
+    boot.after(telemetry_id, heartbeat_id);
+
+    TEST_ASSERT_FALSE(boot.run());
+    TEST_ASSERT_EQUAL_STRING("can pedals ", trace.c_str());
+    TEST_ASSERT_EQUAL(StepStatus::FAILED, boot.record(can_id).status);
+    TEST_ASSERT_EQUAL(StepStatus::SKIPPED, boot.record(heartbeat_id).status);
+    TEST_ASSERT_EQUAL(StepStatus::SKIPPED, boot.record(telemetry_id).status);
+    TEST_ASSERT_EQUAL(StepStatus::DONE, boot.record(pedals_id).status);
+
+    char timeline[256];
+    size_t length = boot.format(timeline, sizeof(timeline));
+    TEST_ASSERT_EQUAL(strlen(timeline), length);
+    TEST_ASSERT_NOT_NULL(strstr(timeline, "       0 us +    100 us  w0  failed   can\n"));
+    TEST_ASSERT_NOT_NULL(strstr(timeline, "skipped  telemetry\n"));
+
+    // Truncated, but the full length is still reported
+    char short_timeline[16];
+    TEST_ASSERT_EQUAL(length, boot.format(short_timeline, sizeof(short_timeline)));
+    TEST_ASSERT_EQUAL(15, strlen(short_timeline));
+}
+
+void test_startup_capacity() {
+    MockClockStrategy clock;
+    Orchestrator<2, 1> boot(&clock, nullptr);
+    TEST_ASSERT_EQUAL(0, boot.add("a", &sleep_20ms));
+    TEST_ASSERT_EQUAL(NO_STEP, boot.add("b", nullptr));
+    TEST_ASSERT_EQUAL(1, boot.add("b", &sleep_20ms));
+    TEST_ASSERT_EQUAL(NO_STEP, boot.add("c", &sleep_20ms));
+
+    TEST_ASSERT_TRUE(boot.add_worker(std::unique_ptr<Core::iThreadStrategy>(new NativeThreadStrategy())));
+    TEST_ASSERT_FALSE(boot.add_worker(std::unique_ptr<Core::iThreadStrategy>(new NativeThreadStrategy())));
+}
+
+void test_startup_runs_independent_steps_in_parallel() {
+    NativeClockStrategy clock;
+    Boot boot(&clock, std::unique_ptr<Core::iLockStrategy>(new NativeLockStrategy()), clock.micros());
+    boot.add_worker(std::unique_ptr<Core::iThreadStrategy>(new NativeThreadStrategy()));
+    boot.add_worker(std::unique_ptr<Core::iThreadStrategy>(new NativeThreadStrategy()));
+
+    uint8_t can = boot.add("can", &sleep_20ms);
+    uint8_t pedals = boot.add("pedals", &sleep_20ms);
+    uint8_t dash = boot.add("dash", &sleep_20ms);
+    uint8_t heartbeat = boot.add("heartbeat", &sleep_20ms);
+    uint8_t pipeline = boot.add("torque pipeline", &sleep_20ms);
+    boot.after(heartbeat, can);
+    boot.after(pipeline, pedals);
+
+    NativeThreadStrategy caller;
+    TEST_ASSERT_TRUE(boot.run(&caller));
+    TEST_ASSERT_TRUE(boot.record(heartbeat).started_us >= boot.record(can).finished_us);
+    TEST_ASSERT_TRUE(boot.record(pipeline).started_us >= boot.record(pedals).finished_us);
+    // Two levels of 20 ms steps on three tasks, where one after the other takes 100 ms
+    TEST_ASSERT_TRUE(boot.elapsed_us() < 80000);
+    TEST_ASSERT_TRUE(boot.record(can).worker != boot.record(pedals).worker);
+    // The independent step does not wait for the first level
+    TEST_ASSERT_TRUE(boot.record(dash).started_us < boot.record(heartbeat).started_us);
+
+    char timeline[512];
+    boot.format(timeline, sizeof(timeline));
+    char message[600];
+    snprintf(message, sizeof(message), "boot took %llu us, 100000 us one step after the other\n%s",
+        (unsigned long long)boot.elapsed_us(), timeline);
+    TEST_MESSAGE(message);
+}
+
+void test_startup_tasks_sleep_on_their_own_thread() {
+    NativeClockStrategy clock;
+    Orchestrator<2, 1> boot(&clock, std::unique_ptr<Core::iLockStrategy>(new NativeLockStrategy()), clock.micros());
+    CountingThreadStrategy* worker = new CountingThreadStrategy();
+    boot.add_worker(std::unique_ptr<Core::iThreadStrategy>(worker));
+    TEST_ASSERT_EQUAL_STRING("core.startup.worker", worker->name);
+    TEST_ASSERT_EQUAL(0x18U, worker->priority);
+
+    uint8_t can = boot.add("can", &sleep_20ms);
+    uint8_t heartbeat = boot.add("heartbeat", &sleep_20ms);
+    boot.after(heartbeat, can);
+
+    // Whichever task did not take the first step polls through its own thread
+    CountingThreadStrategy caller;
+    TEST_ASSERT_TRUE(boot.run(&caller));
+    CountingThreadStrategy& idle = boot.record(can).worker == 0 ? *worker : caller;
+    TEST_ASSERT_GREATER_THAN(0, idle.sleeps.load());
+    TEST_ASSERT_NULL(caller.name);
+}
+
+void test_startup_milestones() {
+    enum Milestone : uint8_t { FIRST_FRAME, READY_TO_DRIVE, COUNT };
+    MockClockStrategy clock;
+    clock.now = 1000;
+    Milestones<COUNT> milestones(&clock, 1000);
+    TEST_ASSERT_FALSE(milestones.reached(FIRST_FRAME));
+    TEST_ASSERT_EQUAL(Milestones<COUNT>::NOT_REACHED, milestones.at_us(READY_TO_DRIVE));
+
+    clock.advance(45000);
+    TEST_ASSERT_TRUE(milestones.mark(FIRST_FRAME));
+    clock.advance(1000);
+    TEST_ASSERT_FALSE(milestones.mark(FIRST_FRAME));
+    TEST_ASSERT_FALSE(milestones.mark(COUNT));
+    TEST_ASSERT_EQUAL(45000, milestones.at_us(FIRST_FRAME));
+
+    clock.advance(2000000);
+    milestones.mark(READY_TO_DRIVE);
+    TEST_ASSERT_EQUAL(2046000, milestones.at_us(READY_TO_DRIVE));
+
+    milestones.reset();
+    TEST_ASSERT_FALSE(milestones.reached(FIRST_FRAME));
+
+    // Modules mark through a hook, an unset one does nothing
+    Core::Startup::MilestoneHook hook = milestones.hook(FIRST_FRAME);
+    Core::Startup::MilestoneHook unset;
+    unset.mark();
+    hook.mark();
+    TEST_ASSERT_EQUAL(2046000, milestones.at_us(FIRST_FRAME));
+}
+
+void run_startup_tests() {
+    RUN_TEST(test_startup_runs_steps_in_dependency_order);
+    RUN_TEST(test_startup_failure_skips_dependents);
+    RUN_TEST(test_startup_capacity);
+    RUN_TEST(test_startup_runs_independent_steps_in_parallel);
+    RUN_TEST(test_startup_tasks_sleep_on_their_own_thread);
+    RUN_TEST(test_startup_milestones);
+}
@@ -0,0 +1,50 @@
+#include <dash.h>
+
+#include "test_main.h"
+
+using namespace Dash;
+
+void test_dirty_regions_merge_touching_areas() {
+    DirtyRegions<4> dirty;
+    dirty.add({ 0, 0, 10, 10 });
+    // Overlapping
+    dirty.add({ 5, 5, 10, 10 });
+    TEST_ASSERT_EQUAL(1, dirty.size());
+    TEST_ASSERT_EQUAL(15, dirty[0].w);
+
+    // Sharing an edge
+    dirty.add({ 15, 0, 5, 15 });
+    TEST_ASSERT_EQUAL(1, dirty.size());
+    TEST_ASSERT_EQUAL(20, dirty[0].w);
+    TEST_ASSERT_EQUAL(15, dirty[0].h);
+
+    // Apart, and empty areas are ignored
+    dirty.add({ 100, 100, 4, 4 });
+    dirty.add({ 50, 50, 0, 4 });
+    TEST_ASSERT_EQUAL(2, dirty.size());
+    TEST_ASSERT_EQUAL(300 + 16, dirty.area());
+
+    // Bridging both collapses them into one
+    dirty.add({ 10, 10, 95, 95 });
+    TEST_ASSERT_EQUAL(1, dirty.size());
+    TEST_ASSERT_EQUAL(0, dirty[0].x);
+    TEST_ASSERT_EQUAL(105, dirty[0].right());
+
+    dirty.clear();
+    TEST_ASSERT_EQUAL(0, dirty.size());
+}
+
+void test_dirty_regions_merge_cheapest_when_full() {
+    DirtyRegions<2> dirty;
+    dirty.add({ 0, 0, 4, 4 });
+    dirty.add({ 200, 0, 4, 4 });
+    // Full, joins the region it adds the fewest pixels to
+    dirty.add({ 8, 0, 4, 4 });
+    TEST_ASSERT_EQUAL(2, dirty.size());
+    TEST_ASSERT_EQUAL(48 + 16, dirty.area());
+}
+
+void run_dirty_regions_tests() {
+    RUN_TEST(test_dirty_regions_merge_touching_areas);
+    RUN_TEST(test_dirty_regions_merge_cheapest_when_full);
+}
@@ -17,5 +17,9 @@ void test_dash_basic() {
 int main() {
     UNITY_BEGIN();
     RUN_TEST(test_dash_basic);
+    run_dirty_regions_tests();
+    run_renderer_tests();
+    run_text_tests();
+    run_text_benchmark_tests();
     return UNITY_END();
 }
\ No newline at end of file
@@ -3,4 +3,9 @@
 
 #include <unity.h>
 
+void run_dirty_regions_tests();
+void run_renderer_tests();
+void run_text_tests();
+void run_text_benchmark_tests();
+
 #endif // TEST_MAIN_H
\ No newline at end of file
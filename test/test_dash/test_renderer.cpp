@@ -0,0 +1,139 @@
+#include <algorithm>
+#include <cstring>
+#include <vector>
+#include <dash.h>
+
+#include "test_main.h"
+
+using namespace Dash;
+
+static const uint16_t WIDTH = 160;
+static const uint16_t HEIGHT = 120;
+static const Color GREEN = rgb565(0, 255, 0);
+static const Color RED = rgb565(255, 0, 0);
+static const Color GREY = rgb565(32, 32, 32);
+
+// Headless panel whose transfers can be held past the wait timeout
+struct StallingBackend : public HeadlessBackend {
+    bool stalled = false;
+
+    StallingBackend(Color* panel, uint16_t width, uint16_t height, bool big_endian)
+        : HeadlessBackend(panel, width, height, big_endian) {}
+
+    bool wait() override {
+        return stalled ? false : HeadlessBackend::wait();
+    }
+};
+
+struct Screen {
+    std::vector<Color> pixels;
+    std::vector<Color> panel;
+    Framebuffer framebuffer;
+    StallingBackend backend;
+    Renderer renderer;
+
+    Signal speed;
+    Signal fault;
+    BarWidget bar;
+    IndicatorWidget lamp;
+
+    explicit Screen(bool big_endian = false)
+        : pixels(WIDTH * HEIGHT), panel(WIDTH * HEIGHT, 0x1234),
+          framebuffer(pixels.data(), WIDTH, HEIGHT), backend(panel.data(), WIDTH, HEIGHT, big_endian),
+          renderer(&framebuffer, &backend), speed(0), fault(0),
+          bar({ 10, 10, 100, 8 }, &speed, 0, 1000, GREEN, GREY), lamp({ 120, 10, 16, 16 }, &fault, RED, GREY) {
+        renderer.add(&bar);
+        renderer.add(&lamp);
+    }
+
+    bool matches() const {
+        return memcmp(pixels.data(), panel.data(), pixels.size() * sizeof(Color)) == 0;
+    }
+};
+
+void test_renderer_first_frame_sends_whole_screen() {
+    Screen screen;
+    TEST_ASSERT_EQUAL(WIDTH * HEIGHT, screen.renderer.render());
+    TEST_ASSERT_TRUE(screen.matches());
+    TEST_ASSERT_EQUAL(GREY, screen.panel[10 * WIDTH + 10]);
+    TEST_ASSERT_EQUAL(0, screen.panel[0]);
+
+    // Bigger than one staging buffer, so it went out in chunks, never two in flight
+    TEST_ASSERT_GREATER_THAN(1, screen.backend.statistics().transfers);
+    TEST_ASSERT_EQUAL(0, screen.backend.statistics().overlaps);
+}
+
+void test_renderer_sends_only_changed_areas() {
+    Screen screen;
+    screen.renderer.render();
+    uint32_t transfers = screen.backend.statistics().transfers;
+
+    // Nothing changed, nothing sent
+    TEST_ASSERT_EQUAL(0, screen.renderer.render());
+    TEST_ASSERT_EQUAL(transfers, screen.backend.statistics().transfers);
+
+    // A quarter of the bar fills, only that strip goes out
+    screen.speed = 250;
+    TEST_ASSERT_EQUAL(25 * 8, screen.renderer.render());
+    TEST_ASSERT_EQUAL(25, screen.bar.length());
+    TEST_ASSERT_TRUE(screen.matches());
+    TEST_ASSERT_EQUAL(GREEN, screen.panel[10 * WIDTH + 34]);
+    TEST_ASSERT_EQUAL(GREY, screen.panel[10 * WIDTH + 35]);
+
+    // A value change below one pixel does not redraw
+    screen.speed = 251;
+    TEST_ASSERT_EQUAL(0, screen.renderer.render());
+
+    // Shrinking clears the strip, the lamp flushes as a separate region
+    screen.speed = 100;
+    screen.fault = 1;
+    TEST_ASSERT_EQUAL(15 * 8 + 16 * 16, screen.renderer.render());
+    TEST_ASSERT_TRUE(screen.matches());
+    TEST_ASSERT_EQUAL(RED, screen.panel[10 * WIDTH + 120]);
+
+    Renderer::Statistics statistics = screen.renderer.statistics();
+    TEST_ASSERT_EQUAL(5, statistics.frames);
+    TEST_ASSERT_EQUAL(5, statistics.redraws);
+    TEST_ASSERT_EQUAL(0, screen.backend.statistics().overlaps);
+}
+
+void test_renderer_invalidate_and_byte_order() {
+    Screen screen(true);
+    screen.speed = 1000;
+    screen.renderer.render();
+    TEST_ASSERT_EQUAL(__builtin_bswap16(GREEN), screen.panel[10 * WIDTH + 109]);
+
+    // The panel lost its contents, e.g. after a reset
+    std::fill(screen.panel.begin(), screen.panel.end(), 0);
+    screen.renderer.invalidate();
+    TEST_ASSERT_EQUAL(WIDTH * HEIGHT, screen.renderer.render());
+    TEST_ASSERT_EQUAL(__builtin_bswap16(GREY), screen.panel[10 * WIDTH + 120]);
+}
+
+void test_renderer_retries_after_stalled_transfer() {
+    Screen screen;
+    screen.renderer.render();
+    uint32_t transfers = screen.backend.statistics().transfers;
+
+    // The last transfer never reported its end, nothing may be written over it
+    screen.backend.stalled = true;
+    screen.speed = 500;
+    screen.fault = 1;
+    TEST_ASSERT_EQUAL(0, screen.renderer.render());
+    TEST_ASSERT_EQUAL(transfers, screen.backend.statistics().transfers);
+    TEST_ASSERT_EQUAL(1, screen.renderer.statistics().stalls);
+    TEST_ASSERT_FALSE(screen.matches());
+
+    // Once it finishes the box around both stale areas goes out with the next frame
+    screen.backend.stalled = false;
+    TEST_ASSERT_EQUAL((136 - 10) * (26 - 10), screen.renderer.render());
+    TEST_ASSERT_TRUE(screen.matches());
+    TEST_ASSERT_EQUAL(0, screen.backend.statistics().overlaps);
+}
+
+void run_renderer_tests() {
+    RUN_TEST(test_renderer_first_frame_sends_whole_screen);
+    RUN_TEST(test_renderer_sends_only_changed_areas);
+    RUN_TEST(test_renderer_invalidate_and_byte_order);
+    RUN_TEST(test_renderer_retries_after_stalled_transfer);
+}
@@ -0,0 +1,213 @@
+#include <algorithm>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <dash.h>
+
+#include "test_main.h"
+
+using namespace Dash;
+
+static const uint16_t WIDTH = 64;
+static const uint16_t HEIGHT = 32;
+static const Color WHITE = rgb565(255, 255, 255);
+static const Color BLACK = rgb565(0, 0, 0);
+static const Color GREY = rgb565(32, 32, 32);
+
+// Ink of the pixel as '#', background as '.', for comparing against the font art
+static std::string line(const Framebuffer& framebuffer, int16_t x, int16_t y, uint16_t width) {
+    std::string text;
+    for (uint16_t i = 0; i < width; i++) {
+        text += framebuffer.pixel((int16_t)(x + i), y) == WHITE ? '#' : '.';
+    }
+    return text;
+}
+
+void test_font_atlas_lookup() {
+    const Font& font = Fonts::DASH_5X7;
+    TEST_ASSERT_EQUAL(7, font.height);
+
+    const Glyph* zero = font.find('0');
+    TEST_ASSERT_NOT_NULL(zero);
+    TEST_ASSERT_EQUAL(5, zero->width);
+    TEST_ASSERT_EQUAL(6, zero->advance);
+    const uint8_t expected[] = { 0x70, 0x88, 0x98, 0xA8, 0xC8, 0x88, 0x70 };
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(expected, font.bitmap(*zero), 7);
+
+    // Outside the subset, or outside printable ASCII
+    TEST_ASSERT_NULL(font.find('Z'));
+    TEST_ASSERT_NULL(font.find('\n'));
+    TEST_ASSERT_NULL(font.find((char)0x80));
+
+    // All digits share one advance, a narrow period does not
+    for (char c = '0'; c <= '9'; c++) {
+        TEST_ASSERT_EQUAL(6, font.find(c)->advance);
+    }
+    TEST_ASSERT_EQUAL(3, font.find('.')->advance);
+    TEST_ASSERT_EQUAL(6 + 3 + 6, text_width(font, "1.5"));
+    TEST_ASSERT_EQUAL(2 * 12, text_width(font, "4Z2", 2));
+}
+
+void test_draw_text_native_size() {
+    std::vector<Color> pixels(WIDTH * HEIGHT, GREY);
+    Framebuffer framebuffer(pixels.data(), WIDTH, HEIGHT);
+
+    Rect drawn = draw_text(framebuffer, Fonts::DASH_5X7, 2, 3, "17", WHITE, BLACK);
+    TEST_ASSERT_EQUAL(2, drawn.x);
+    TEST_ASSERT_EQUAL(3, drawn.y);
+    TEST_ASSERT_EQUAL(12, drawn.w);
+    TEST_ASSERT_EQUAL(7, drawn.h);
+
+    TEST_ASSERT_EQUAL_STRING("..#...#####.", line(framebuffer, 2, 3, 12).c_str());
+    TEST_ASSERT_EQUAL_STRING(".##.......#.", line(framebuffer, 2, 4, 12).c_str());
+    TEST_ASSERT_EQUAL_STRING(".###...#....", line(framebuffer, 2, 9, 12).c_str());
+
+    // The whole cell is opaque, the spacing column included, nothing outside is touched
+    TEST_ASSERT_EQUAL(BLACK, framebuffer.pixel(13, 3));
+    TEST_ASSERT_EQUAL(GREY, framebuffer.pixel(14, 3));
+    TEST_ASSERT_EQUAL(GREY, framebuffer.pixel(2, 10));
+}
+
+void test_draw_text_scaled_and_clipped() {
+    std::vector<Color> pixels(WIDTH * HEIGHT, GREY);
+    Framebuffer framebuffer(pixels.data(), WIDTH, HEIGHT);
+
+    // Every font pixel becomes a 3x3 block
+    Rect drawn = draw_text(framebuffer, Fonts::DASH_5X7, 0, 0, "-", WHITE, BLACK, 3);
+    TEST_ASSERT_EQUAL(18, drawn.w);
+    TEST_ASSERT_EQUAL(21, drawn.h);
+    for (int16_t y = 0; y < 21; y++) {
+        const char* expected = y >= 9 && y < 12 ? "###############..." : "..................";
+        TEST_ASSERT_EQUAL_STRING(expected, line(framebuffer, 0, y, 18).c_str());
+    }
+
+    // Half off the left and bottom edges, the visible part still lines up with the font
+    std::fill(pixels.begin(), pixels.end(), GREY);
+    drawn = draw_text(framebuffer, Fonts::DASH_5X7, -4, 20, "7", WHITE, BLACK, 2);
+    TEST_ASSERT_EQUAL(0, drawn.x);
+    TEST_ASSERT_EQUAL(20, drawn.y);
+    TEST_ASSERT_EQUAL(8, drawn.w);
+    TEST_ASSERT_EQUAL(12, drawn.h);
+    TEST_ASSERT_EQUAL_STRING("######..", line(framebuffer, 0, 20, 8).c_str());
+    TEST_ASSERT_EQUAL_STRING("....##..", line(framebuffer, 0, 23, 8).c_str());
+    TEST_ASSERT_EQUAL_STRING("........", line(framebuffer, 0, 31, 8).c_str());
+    TEST_ASSERT_EQUAL(GREY, framebuffer.pixel(8, 20));
+
+    // Entirely off screen
+    TEST_ASSERT_TRUE(draw_text(framebuffer, Fonts::DASH_5X7, WIDTH, 0, "8", WHITE, BLACK).empty());
+}
+
+void test_digit_cache_matches_draw_text() {
+    static DigitCache digits(Fonts::DASH_5X7, 2, WHITE, BLACK);
+    TEST_ASSERT_TRUE(digits.valid());
+    TEST_ASSERT_EQUAL(12, digits.cell_width());
+    TEST_ASSERT_EQUAL(14, digits.cell_height());
+
+    std::vector<Color> expected(WIDTH * HEIGHT, GREY);
+    std::vector<Color> cached(WIDTH * HEIGHT, GREY);
+    Framebuffer reference(expected.data(), WIDTH, HEIGHT);
+    Framebuffer framebuffer(cached.data(), WIDTH, HEIGHT);
+
+    draw_text(reference, Fonts::DASH_5X7, 1, 2, "-3904", WHITE, BLACK, 2);
+    Rect drawn = digits.draw(framebuffer, 1, 2, "-3904");
+    TEST_ASSERT_EQUAL(60, drawn.w);
+    TEST_ASSERT_EQUAL(14, drawn.h);
+    TEST_ASSERT_EQUAL_MEMORY(expected.data(), cached.data(), expected.size() * sizeof(Color));
+
+    // Space is narrower in the font but takes a full cell, anything unknown draws as a space
+    drawn = digits.draw(framebuffer, 1, 2, 'x');
+    TEST_ASSERT_EQUAL(12, drawn.w);
+    TEST_ASSERT_EQUAL(BLACK, framebuffer.pixel(4, 2));
+
+    // Clipped at the right edge
+    drawn = digits.draw(framebuffer, WIDTH - 5, 0, '8');
+    TEST_ASSERT_EQUAL(5, drawn.w);
+
+    // Too big for the cell storage
+    DigitCache* huge = new DigitCache(Fonts::DASH_5X7, 8, WHITE, BLACK);
+    TEST_ASSERT_FALSE(huge->valid());
+    TEST_ASSERT_TRUE(huge->draw(framebuffer, 0, 0, '1').empty());
+    delete huge;
+}
+
+void test_number_format() {
+    char text[DASH_NUMBER_MAX_DIGITS + 1];
+    TEST_ASSERT_TRUE(NumberWidget::format(42, text, 4));
+    TEST_ASSERT_EQUAL_STRING("  42", text);
+    TEST_ASSERT_TRUE(NumberWidget::format(-7, text, 3));
+    TEST_ASSERT_EQUAL_STRING(" -7", text);
+    TEST_ASSERT_TRUE(NumberWidget::format(0, text, 1));
+    TEST_ASSERT_EQUAL_STRING("0", text);
+    TEST_ASSERT_TRUE(NumberWidget::format(INT32_MIN, text, 11));
+    TEST_ASSERT_EQUAL_STRING("-2147483648", text);
+
+    TEST_ASSERT_FALSE(NumberWidget::format(1000, text, 3));
+    TEST_ASSERT_FALSE(NumberWidget::format(-10, text, 2));
+}
+
+void test_number_widget_redraws_changed_digits() {
+    static DigitCache digits(Fonts::DASH_5X7, 1, WHITE, BLACK);
+    std::vector<Color> pixels(WIDTH * HEIGHT, GREY);
+    Framebuffer framebuffer(pixels.data(), WIDTH, HEIGHT);
+
+    Signal erpm(1234);
+    NumberWidget number(10, 4, &erpm, &digits, 5);
+    TEST_ASSERT_EQUAL(30, number.bounds().w);
+    TEST_ASSERT_EQUAL(7, number.bounds().h);
+
+    // First frame draws every cell
+    Rect drawn = number.render(framebuffer, false);
+    TEST_ASSERT_EQUAL(10, drawn.x);
+    TEST_ASSERT_EQUAL(30, drawn.w);
+    TEST_ASSERT_EQUAL_STRING(" 1234", number.text());
+
+    TEST_ASSERT_TRUE(number.render(framebuffer, false).empty());
+
+    // Only the last digit changed
+    erpm = 1235;
+    drawn = number.render(framebuffer, false);
+    TEST_ASSERT_EQUAL(34, drawn.x);
+    TEST_ASSERT_EQUAL(6, drawn.w);
+
+    // The last three digits changed, one region covers their cells
+    erpm = 1346;
+    drawn = number.render(framebuffer, false);
+    TEST_ASSERT_EQUAL(22, drawn.x);
+    TEST_ASSERT_EQUAL(18, drawn.w);
+
+    // Does not fit, dashes
+    erpm = -100000;
+    number.render(framebuffer, false);
+    TEST_ASSERT_EQUAL_STRING("-----", number.text());
+
+    // Force redraws everything
+    TEST_ASSERT_EQUAL(30, number.render(framebuffer, true).w);
+}
+
+void test_number_widget_in_renderer() {
+    static DigitCache digits(Fonts::DASH_5X7, 2, WHITE, BLACK);
+    std::vector<Color> pixels(WIDTH * HEIGHT);
+    std::vector<Color> panel(WIDTH * HEIGHT);
+    Framebuffer framebuffer(pixels.data(), WIDTH, HEIGHT);
+    HeadlessBackend backend(panel.data(), WIDTH, HEIGHT, false);
+    Renderer renderer(&framebuffer, &backend);
+
+    Signal soc(87);
+    NumberWidget number(0, 0, &soc, &digits, 3);
+    renderer.add(&number);
+    renderer.render();
+
+    soc = 86;
+    TEST_ASSERT_EQUAL(12 * 14, renderer.render());
+    TEST_ASSERT_EQUAL_MEMORY(pixels.data(), panel.data(), pixels.size() * sizeof(Color));
+}
+
+void run_text_tests() {
+    RUN_TEST(test_font_atlas_lookup);
+    RUN_TEST(test_draw_text_native_size);
+    RUN_TEST(test_draw_text_scaled_and_clipped);
+    RUN_TEST(test_digit_cache_matches_draw_text);
+    RUN_TEST(test_number_format);
+    RUN_TEST(test_number_widget_redraws_changed_digits);
+    RUN_TEST(test_number_widget_in_renderer);
+}
@@ -0,0 +1,75 @@
+#include <cstdio>
+#include <vector>
+#include <dash.h>
+#include <mocks.h>
+
+#include "test_main.h"
+
+using namespace Dash;
+using namespace MOCKS;
+
+static const uint16_t WIDTH = 320;
+static const uint16_t HEIGHT = 240;
+static const uint32_t BENCHMARK_ROUNDS = 2000;
+static const Color WHITE = rgb565(255, 255, 255);
+static const Color BLACK = rgb565(0, 0, 0);
+
+// A page of numbers, SOC, temperatures and ERPM
+static const char* const VALUES[] = { "  87", "  42", "  63", "12804", " -15", "  350" };
+static const uint32_t VALUE_COUNT = sizeof(VALUES) / sizeof(VALUES[0]);
+
+static uint32_t glyphs_per_page() {
+    uint32_t glyphs = 0;
+    for (uint32_t i = 0; i < VALUE_COUNT; i++) {
+        for (const char* c = VALUES[i]; *c != '\0'; c++) glyphs++;
+    }
+    return glyphs;
+}
+
+static void report(const char* name, uint64_t elapsed_ns, uint32_t glyphs) {
+    char message[160];
+    snprintf(message, sizeof(message), "%s: %.2f M glyphs/s, %.1f ns per glyph",
+             name, glyphs * 1000.0 / (double)elapsed_ns, (double)elapsed_ns / glyphs);
+    TEST_MESSAGE(message);
+}
+
+void test_text_glyphs_per_second() {
+    NativeClockStrategy clock;
+    std::vector<Color> pixels(WIDTH * HEIGHT);
+    Framebuffer framebuffer(pixels.data(), WIDTH, HEIGHT);
+    static DigitCache digits(Fonts::DASH_5X7, 3, WHITE, BLACK);
+    uint32_t glyphs = glyphs_per_page() * BENCHMARK_ROUNDS;
+
+    const uint8_t scales[] = { 1, 3 };
+    uint64_t blit_ns[2] = { 0, 0 };
+    for (uint32_t s = 0; s < 2; s++) {
+        uint64_t start = clock.nanos();
+        for (uint32_t round = 0; round < BENCHMARK_ROUNDS; round++) {
+            for (uint32_t i = 0; i < VALUE_COUNT; i++) {
+                draw_text(framebuffer, Fonts::DASH_5X7, 4, (int16_t)(i * 24), VALUES[i], WHITE, BLACK, scales[s]);
+            }
+        }
+        blit_ns[s] = clock.nanos() - start;
+    }
+
+    uint64_t start = clock.nanos();
+    for (uint32_t round = 0; round < BENCHMARK_ROUNDS; round++) {
+        for (uint32_t i = 0; i < VALUE_COUNT; i++) {
+            digits.draw(framebuffer, 160, (int16_t)(i * 24), VALUES[i]);
+        }
+    }
+    uint64_t cached_ns = clock.nanos() - start;
+
+    report("atlas blit, scale 1", blit_ns[0], glyphs);
+    report("atlas blit, scale 3", blit_ns[1], glyphs);
+    report("digit cache, scale 3", cached_ns, glyphs);
+
+    // Both paths put the same pixels on screen, the ERPM line has no narrow spaces
+    for (uint16_t y = 72; y < 72 + 21; y++) {
+        TEST_ASSERT_EQUAL_MEMORY(framebuffer.row(y) + 4, framebuffer.row(y) + 160, 5 * 18 * sizeof(Color));
+    }
+}
+
+void run_text_benchmark_tests() {
+    RUN_TEST(test_text_glyphs_per_second);
+}
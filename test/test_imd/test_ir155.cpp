@@ -0,0 +1,164 @@
+#include <vector>
+#include <imd.h>
+#include <mocks.h>
+
+#include "test_main.h"
+
+using namespace IMD;
+using namespace MOCKS;
+
+// Queues periods of a PWM, moves the clock to the last edge and polls once
+static uint64_t feed(IR155& imd, MockEdgeSource& edges, MockClockStrategy& clock, uint64_t start_us,
+                     uint32_t frequency_dhz, uint16_t duty_permille, uint32_t periods) {
+    uint64_t next = edges.push_pwm(start_us, frequency_dhz, duty_permille, periods);
+    clock.now = edges.pending.back().timestamp_us;
+    imd.poll();
+    return next;
+}
+
+static void record(const ImdStatus& status, void* context) {
+    ((std::vector<ImdStatus>*)context)->push_back(status);
+}
+
+void test_ir155_resistance_formula() {
+    TEST_ASSERT_EQUAL(RESISTANCE_INFINITE_KOHM, IR155::resistance_kohm(50));
+    TEST_ASSERT_EQUAL(RESISTANCE_INFINITE_KOHM, IR155::resistance_kohm(60));
+    TEST_ASSERT_EQUAL(1200, IR155::resistance_kohm(500));
+    TEST_ASSERT_EQUAL(240, IR155::resistance_kohm(800));
+    TEST_ASSERT_EQUAL(0, IR155::resistance_kohm(950));
+    TEST_ASSERT_EQUAL(0, IR155::resistance_kohm(1000));
+}
+
+void test_ir155_settles_on_normal_condition() {
+    MockEdgeSource edges;
+    MockClockStrategy clock;
+    IR155 imd(&edges, &clock);
+    std::vector<ImdStatus> changes;
+    imd.set_listener(record, &changes);
+    TEST_ASSERT_TRUE(imd.start());
+    TEST_ASSERT_TRUE(edges.started);
+    TEST_ASSERT_EQUAL(ImdFault::PENDING, imd.status().fault);
+
+    // 10 Hz at 50 %, one period is not enough to publish
+    uint64_t next = feed(imd, edges, clock, 1000, 100, 500, 2);
+    TEST_ASSERT_EQUAL(ImdState::UNKNOWN, imd.status().state);
+
+    // The third rising edge closes the second agreeing period
+    next = feed(imd, edges, clock, next, 100, 500, 1);
+
+    ImdStatus status = imd.status();
+    TEST_ASSERT_EQUAL(ImdState::NORMAL, status.state);
+    TEST_ASSERT_EQUAL(ImdFault::NONE, status.fault);
+    TEST_ASSERT_EQUAL(1200, status.resistance_kohm);
+    TEST_ASSERT_EQUAL(100, status.frequency_dhz);
+    TEST_ASSERT_EQUAL(500, status.duty_permille);
+    // Settled two periods after the first edge, far inside the 30 s the rules allow
+    TEST_ASSERT_EQUAL(201000, status.timestamp_us);
+    TEST_ASSERT_EQUAL(1, changes.size());
+
+    // Further identical periods refresh the reading without notifying
+    feed(imd, edges, clock, next, 100, 520, 3);
+    TEST_ASSERT_EQUAL(1, changes.size());
+    TEST_ASSERT_EQUAL(1097, imd.status().resistance_kohm);
+    TEST_ASSERT_EQUAL(0, imd.statistics().invalid_periods);
+}
+
+void test_ir155_reports_fault_categories() {
+    struct Case {
+        uint32_t frequency_dhz;
+        uint16_t duty_permille;
+        ImdState state;
+        ImdFault fault;
+    };
+    const Case cases[] = {
+        { 100, 800, ImdState::NORMAL, ImdFault::INSULATION_LOW },
+        { 200, 300, ImdState::UNDERVOLTAGE, ImdFault::UNDERVOLTAGE },
+        { 200, 900, ImdState::UNDERVOLTAGE, ImdFault::INSULATION_LOW },
+        { 300, 70, ImdState::SPEED_START, ImdFault::NONE },
+        { 300, 920, ImdState::SPEED_START, ImdFault::INSULATION_LOW },
+        { 400, 500, ImdState::DEVICE_ERROR, ImdFault::DEVICE_ERROR },
+        { 500, 500, ImdState::GROUND_FAULT, ImdFault::GROUND_FAULT },
+        // Between bands, and a duty the 40 Hz state never uses
+        { 150, 500, ImdState::INVALID, ImdFault::INVALID_SIGNAL },
+        { 400, 200, ImdState::INVALID, ImdFault::INVALID_SIGNAL },
+    };
+
+    for (uint32_t i = 0; i < sizeof(cases) / sizeof(cases[0]); i++) {
+        MockEdgeSource edges;
+        MockClockStrategy clock;
+        IR155 imd(&edges, &clock);
+        imd.start();
+        uint64_t next = feed(imd, edges, clock, 0, cases[i].frequency_dhz, cases[i].duty_permille, 3);
+        edges.push_back_rising(next);
+        clock.now = next;
+        imd.poll();
+
+        TEST_ASSERT_EQUAL_MESSAGE(cases[i].state, imd.status().state, "state");
+        TEST_ASSERT_EQUAL_MESSAGE(cases[i].fault, imd.status().fault, "fault");
+    }
+}
+
+void test_ir155_detects_static_output() {
+    MockEdgeSource edges;
+    MockClockStrategy clock;
+    IR155 imd(&edges, &clock);
+    imd.start();
+
+    // Never toggled since start, IMD unpowered
+    clock.advance(imd.signal_timeout_us + 1);
+    TEST_ASSERT_TRUE(imd.poll());
+    TEST_ASSERT_EQUAL(ImdState::NO_SIGNAL, imd.status().state);
+    TEST_ASSERT_EQUAL(ImdFault::OFF_OR_SHORT_TO_GROUND, imd.status().fault);
+
+    // Recovers to a normal reading
+    uint64_t next = feed(imd, edges, clock, clock.now, 100, 300, 4);
+    TEST_ASSERT_EQUAL(ImdFault::NONE, imd.status().fault);
+
+    // Output stuck high after the last edge
+    edges.push_back_rising(next);
+    edges.high = true;
+    clock.now = next + imd.signal_timeout_us + 1;
+    TEST_ASSERT_TRUE(imd.poll());
+    TEST_ASSERT_EQUAL(ImdFault::SHORT_TO_SUPPLY, imd.status().fault);
+    TEST_ASSERT_EQUAL(1000, imd.status().duty_permille);
+    TEST_ASSERT_EQUAL(3, imd.statistics().changes);
+}
+
+void test_ir155_edge_ahead_of_clock_is_not_a_timeout() {
+    MockEdgeSource edges;
+    MockClockStrategy clock;
+    IR155 imd(&edges, &clock);
+    imd.start();
+    uint64_t next = feed(imd, edges, clock, 1000, 100, 500, 3);
+    TEST_ASSERT_EQUAL(ImdState::NORMAL, imd.status().state);
+
+    // The capture unit stamped the last edge after the clock reading of this poll
+    edges.push_pwm(next, 100, 500, 1);
+    clock.now = edges.pending.back().timestamp_us - 5;
+    TEST_ASSERT_FALSE(imd.poll());
+    TEST_ASSERT_EQUAL(ImdState::NORMAL, imd.status().state);
+    TEST_ASSERT_EQUAL(ImdFault::NONE, imd.status().fault);
+}
+
+void test_ir155_drains_edges_in_chunks() {
+    MockEdgeSource edges;
+    MockClockStrategy clock;
+    IR155 imd(&edges, &clock);
+    imd.start();
+
+    // A second of 50 Hz, more edges than one read returns
+    feed(imd, edges, clock, 0, 500, 500, 50);
+    TEST_ASSERT_TRUE(edges.pending.empty());
+    TEST_ASSERT_EQUAL(100, imd.statistics().edges);
+    TEST_ASSERT_EQUAL(49, imd.statistics().periods);
+    TEST_ASSERT_EQUAL(ImdState::GROUND_FAULT, imd.status().state);
+}
+
+void run_ir155_tests() {
+    RUN_TEST(test_ir155_resistance_formula);
+    RUN_TEST(test_ir155_settles_on_normal_condition);
+    RUN_TEST(test_ir155_reports_fault_categories);
+    RUN_TEST(test_ir155_detects_static_output);
+    RUN_TEST(test_ir155_edge_ahead_of_clock_is_not_a_timeout);
+    RUN_TEST(test_ir155_drains_edges_in_chunks);
+}
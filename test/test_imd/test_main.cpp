@@ -17,5 +17,6 @@ void test_imd_basic() {
 int main() {
     UNITY_BEGIN();
     RUN_TEST(test_imd_basic);
+    run_ir155_tests();
     return UNITY_END();
 }
\ No newline at end of file
@@ -3,4 +3,6 @@
 
 #include <unity.h>
 
+void run_ir155_tests();
+
 #endif // TEST_MAIN_H
\ No newline at end of file
@@ -0,0 +1,158 @@
+#include <unity.h>
+
+#include <cstdio>
+#include <vector>
+
+#include <DTIX50.h>
+#include <mocks.h>
+
+using namespace Inverter;
+using namespace Inverter::DTIX50;
+using namespace MOCKS;
+
+static Frame current_frame(int16_t ac_current, uint8_t node = DEFAULT_NODE) {
+    Message21 message = { (uint16_t)ac_current, 0, 0xFFFFFFFF };
+    Frame frame(identifier(Packet::GENERAL_DATA_2, node), &message);
+    frame.extd = 1;
+    return frame;
+}
+
+static Frame fault_frame(FaultCodes fault) {
+    Message22 message = { 400, 300, fault, 0xFFFFFF };
+    Frame frame(identifier(Packet::GENERAL_DATA_3, DEFAULT_NODE), &message);
+    frame.extd = 1;
+    return frame;
+}
+
+static bool overcurrent_trigger(const CaptureSample& sample, void* context) {
+    if (sample.packet != Packet::GENERAL_DATA_2) return false;
+    Message21 message;
+    memcpy(&message, sample.data, sizeof(message));
+    return Raw::ac_current(message) > *(int16_t*)context;
+}
+
+struct Replayed {
+    std::vector<float> ac_current;
+    std::vector<FaultCodes> faults;
+};
+
+static void collect(const CaptureSample& sample, const InverterState& state, void* context) {
+    Replayed* replayed = (Replayed*)context;
+    replayed->ac_current.push_back(state.ac_current);
+    replayed->faults.push_back(state.fault_code);
+}
+
+void test_capture_freezes_around_fault() {
+    MockClockStrategy clock;
+    Capture<16> capture(&clock);
+    TEST_ASSERT_TRUE(capture.configure(4, 3));
+
+    // Wraps the ring several times while armed
+    for (int16_t i = 0; i < 40; i++) {
+        clock.advance(1000);
+        TEST_ASSERT_TRUE(capture.record(current_frame(i)));
+    }
+    TEST_ASSERT_EQUAL(Capture<16>::State::ARMED, capture.state());
+    TEST_ASSERT_EQUAL(0, capture.size());
+
+    TEST_ASSERT_TRUE(capture.record(fault_frame(FaultCodes::ABS_OVERCURRENT)));
+    TEST_ASSERT_EQUAL(Capture<16>::State::TRIGGERED, capture.state());
+
+    for (int16_t i = 40; i < 50; i++) {
+        clock.advance(1000);
+        capture.record(current_frame(i));
+    }
+    TEST_ASSERT_EQUAL(Capture<16>::State::FROZEN, capture.state());
+    TEST_ASSERT_FALSE(capture.record(current_frame(99)));
+
+    TEST_ASSERT_EQUAL(8, capture.size());
+    TEST_ASSERT_EQUAL(4, capture.trigger_index());
+    TEST_ASSERT_EQUAL(Packet::GENERAL_DATA_3, capture.sample(4).packet);
+    TEST_ASSERT_EQUAL(37000, capture.sample(0).timestamp_us);
+    TEST_ASSERT_EQUAL(43000, capture.sample(7).timestamp_us);
+
+    Replayed replayed;
+    TEST_ASSERT_EQUAL(8, capture.replay(collect, &replayed));
+    TEST_ASSERT_EQUAL_FLOAT(3.6f, replayed.ac_current[0]);
+    TEST_ASSERT_EQUAL(FaultCodes::NONE, replayed.faults[3]);
+    TEST_ASSERT_EQUAL(FaultCodes::ABS_OVERCURRENT, replayed.faults[4]);
+    TEST_ASSERT_EQUAL_FLOAT(4.2f, replayed.ac_current[7]);
+
+    capture.arm();
+    TEST_ASSERT_EQUAL(Capture<16>::State::ARMED, capture.state());
+    TEST_ASSERT_EQUAL(1, capture.triggers());
+}
+
+void test_capture_short_history_and_filtering() {
+    MockClockStrategy clock;
+    Capture<8> capture(&clock);
+    TEST_ASSERT_FALSE(capture.configure(5, 3));
+    TEST_ASSERT_TRUE(capture.configure(5, 2));
+
+    // Other nodes and commands are ignored
+    TEST_ASSERT_FALSE(capture.record(current_frame(1, 0x53)));
+    Frame command = current_frame(1);
+    command.identifier = identifier(Packet::SET_DRIVE_ENABLE, DEFAULT_NODE);
+    TEST_ASSERT_FALSE(capture.record(command));
+
+    // Fewer samples than the pre-trigger window before the fault
+    capture.record(current_frame(1));
+    capture.record(current_frame(2));
+    capture.record(fault_frame(FaultCodes::DRV));
+    capture.record(current_frame(3));
+    capture.record(current_frame(4));
+
+    TEST_ASSERT_EQUAL(Capture<8>::State::FROZEN, capture.state());
+    TEST_ASSERT_EQUAL(5, capture.size());
+    TEST_ASSERT_EQUAL(2, capture.trigger_index());
+}
+
+void test_capture_custom_and_manual_trigger() {
+    MockClockStrategy clock;
+    Capture<32> capture(&clock);
+    capture.configure(2, 0);
+    int16_t threshold = 2000;
+    capture.set_trigger(overcurrent_trigger, &threshold);
+
+    capture.record(fault_frame(FaultCodes::OVERVOLTAGE));
+    capture.record(current_frame(1999));
+    TEST_ASSERT_EQUAL(Capture<32>::State::ARMED, capture.state());
+    capture.record(current_frame(2001));
+    TEST_ASSERT_EQUAL(Capture<32>::State::FROZEN, capture.state());
+    TEST_ASSERT_EQUAL(3, capture.size());
+
+    capture.set_trigger(nullptr, nullptr);
+    capture.arm();
+    capture.trigger();
+    TEST_ASSERT_EQUAL(Capture<32>::State::ARMED, capture.state());
+    capture.record(current_frame(5));
+    capture.trigger();
+    TEST_ASSERT_EQUAL(Capture<32>::State::FROZEN, capture.state());
+    TEST_ASSERT_EQUAL(1, capture.size());
+}
+
+void test_capture_armed_cost() {
+    NativeClockStrategy clock;
+    static Capture<> capture(&clock);
+    capture.set_trigger(nullptr, nullptr);
+
+    const uint32_t SAMPLES = 100000;
+    Frame frame = current_frame(123);
+    uint64_t start = clock.nanos();
+    for (uint32_t i = 0; i < SAMPLES; i++) {
+        capture.record(frame);
+    }
+    uint64_t elapsed = clock.nanos() - start;
+    TEST_ASSERT_EQUAL(Capture<>::State::ARMED, capture.state());
+
+    char message[96];
+    snprintf(message, sizeof(message), "armed capture: %.1f ns/sample including the clock read", (double)elapsed / SAMPLES);
+    TEST_MESSAGE(message);
+}
+
+void run_DTIX50_capture_tests() {
+    RUN_TEST(test_capture_freezes_around_fault);
+    RUN_TEST(test_capture_short_history_and_filtering);
+    RUN_TEST(test_capture_custom_and_manual_trigger);
+    RUN_TEST(test_capture_armed_cost);
+}
@@ -22,6 +22,21 @@ void test_SetACCurrent_command() {
     TEST_ASSERT_EQUAL(0xFF, frame.data[7]);
 }
 
+void test_SetACCurrent_typed_current() {
+    // -15.0 A, the scale by 10 comes from the field type
+    SetACCurrent command = { Inverter::DeciAmps::from_units(-15), 0xFFFFFFFFFFFF };
+
+    Frame frame(0x01, &command);
+
+    TEST_ASSERT_EQUAL(0x6A, frame.data[0]);
+    TEST_ASSERT_EQUAL(0xFF, frame.data[1]);
+    TEST_ASSERT_EQUAL(0xFF, frame.data[2]);
+
+    auto decoded = frame.decode<SetACCurrent>();
+    TEST_ASSERT_EQUAL(-150, decoded->ac_current.raw);
+    TEST_ASSERT_EQUAL(-15, decoded->ac_current.units());
+}
+
 void test_SetBrakeCurrent_command() {
     SetBrakeCurrent command = { 0x0064, 0xFFFFFFFFFFFF };
 
@@ -189,6 +204,7 @@ void test_SetDriveEnable_command() {
 
 void run_DTIX50_command_tests() {
     RUN_TEST(test_SetACCurrent_command);
+    RUN_TEST(test_SetACCurrent_typed_current);
     RUN_TEST(test_SetBrakeCurrent_command);
     RUN_TEST(test_SetSpeed_command);
     RUN_TEST(test_SetPosition_command);
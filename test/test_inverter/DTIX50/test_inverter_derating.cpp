@@ -0,0 +1,152 @@
+#include <unity.h>
+
+#include <cstring>
+#include <memory>
+#include <vector>
+
+#include <DTIX50.h>
+#include <mocks.h>
+
+using namespace Inverter;
+using namespace Inverter::DTIX50;
+using namespace MOCKS;
+
+struct DeratingBundle {
+    MockCanService service;
+    std::shared_ptr<Provider> provider{new Provider(&service)};
+    std::vector<Frame> sent;
+    bool accepting = true;
+
+    DeratingBundle() {
+        service.on_transmit = [this](const Frame* frame, Tick timeout) {
+            TEST_ASSERT_EQUAL(0, timeout);
+            if (!accepting) return Result::ERR_TIMEOUT;
+            sent.push_back(*frame);
+            return Result::OK;
+        };
+    }
+};
+
+static Derating::Config make_config() {
+    // 300 A discharge and 100 A charge caps, derating from 60 to 80 C in the controller and 100 to 120 C in the motor
+    Derating::Config config = { 3000, 1000, 600, 800, 1000, 1200, 10 };
+    return config;
+}
+
+static int16_t command_value(const Frame& frame) {
+    uint16_t value;
+    memcpy(&value, frame.data, sizeof(value));
+    return (int16_t)value;
+}
+
+static Frame bms_limits(uint8_t dcl, uint8_t ccl) {
+    Message6 message = { dcl, ccl, 0, 0, 0 };
+    return Frame(0x006, &message);
+}
+
+static Frame temperatures(int16_t controller, int16_t motor, uint8_t node = DEFAULT_NODE) {
+    Message22 message = { (uint16_t)controller, (uint16_t)motor, FaultCodes::NONE, 0xFFFFFF };
+    Frame frame(identifier(Packet::GENERAL_DATA_3, node), &message);
+    frame.extd = 1;
+    return frame;
+}
+
+void test_derating_sends_bms_limits_on_change_only() {
+    DeratingBundle bundle;
+    Derating derating(bundle.provider, make_config());
+    TEST_ASSERT_EQUAL(0, bundle.sent.size());
+
+    TEST_ASSERT_TRUE(derating.dispatch(bms_limits(200, 50)));
+    TEST_ASSERT_EQUAL(2, bundle.sent.size());
+    TEST_ASSERT_EQUAL_HEX32(0x0A52, bundle.sent[0].identifier);
+    TEST_ASSERT_EQUAL(1, bundle.sent[0].extd);
+    TEST_ASSERT_EQUAL(2000, command_value(bundle.sent[0]));
+    TEST_ASSERT_EQUAL_HEX32(0x0B52, bundle.sent[1].identifier);
+    TEST_ASSERT_EQUAL(-500, command_value(bundle.sent[1]));
+
+    // Repeats of the same broadcast cost nothing
+    for (int i = 0; i < 10; i++) {
+        derating.dispatch(bms_limits(200, 50));
+    }
+    TEST_ASSERT_EQUAL(2, bundle.sent.size());
+    TEST_ASSERT_EQUAL(10, derating.statistics().unchanged);
+
+    // A DCL drop goes out on the frame that carries it, the unchanged CCL does not
+    derating.dispatch(bms_limits(120, 50));
+    TEST_ASSERT_EQUAL(3, bundle.sent.size());
+    TEST_ASSERT_EQUAL_HEX32(0x0A52, bundle.sent[2].identifier);
+    TEST_ASSERT_EQUAL(1200, command_value(bundle.sent[2]));
+}
+
+void test_derating_merges_sources_and_caps() {
+    DeratingBundle bundle;
+    Derating derating(bundle.provider, make_config());
+
+    // Above the caps, the caps win
+    derating.dispatch(bms_limits(250, 200));
+    TEST_ASSERT_EQUAL(2500, derating.limits().discharge_da);
+    TEST_ASSERT_EQUAL(1000, derating.limits().charge_da);
+
+    // The most restrictive BMS source wins
+    Message351 pack = { 0, 180, 0, 0 };
+    derating.dispatch(Frame(0x351, &pack));
+    TEST_ASSERT_EQUAL(1800, derating.limits().discharge_da);
+    Message202 dynamic = { 220, 40, 0 };
+    derating.dispatch(Frame(0x202, &dynamic));
+    TEST_ASSERT_EQUAL(1800, derating.limits().discharge_da);
+    TEST_ASSERT_EQUAL(400, derating.limits().charge_da);
+}
+
+void test_derating_follows_inverter_temperatures() {
+    DeratingBundle bundle;
+    Derating derating(bundle.provider, make_config());
+    derating.dispatch(bms_limits(255, 100));
+    bundle.sent.clear();
+
+    // Other nodes are not our inverter
+    TEST_ASSERT_FALSE(derating.dispatch(temperatures(700, 200, 0x53)));
+
+    // Halfway through the controller range halves both limits
+    TEST_ASSERT_TRUE(derating.dispatch(temperatures(700, 200)));
+    TEST_ASSERT_EQUAL(500, derating.temperature_factor());
+    TEST_ASSERT_EQUAL(1270, derating.limits().discharge_da);
+    TEST_ASSERT_EQUAL(500, derating.limits().charge_da);
+    TEST_ASSERT_EQUAL(2, bundle.sent.size());
+
+    // A temperature change that does not move the limits causes no traffic
+    derating.dispatch(temperatures(700, 300));
+    TEST_ASSERT_EQUAL(2, bundle.sent.size());
+
+    // The motor is the hotter one now
+    derating.dispatch(temperatures(500, 1150));
+    TEST_ASSERT_EQUAL(250, derating.temperature_factor());
+    TEST_ASSERT_EQUAL(630, derating.limits().discharge_da);
+
+    derating.dispatch(temperatures(500, 1300));
+    TEST_ASSERT_EQUAL(0, derating.limits().discharge_da);
+    TEST_ASSERT_EQUAL(0, derating.limits().charge_da);
+}
+
+void test_derating_retries_refused_commands() {
+    DeratingBundle bundle;
+    Derating derating(bundle.provider, make_config());
+
+    bundle.accepting = false;
+    derating.dispatch(bms_limits(100, 30));
+    TEST_ASSERT_EQUAL(2, derating.statistics().transmit_failures);
+    TEST_ASSERT_FALSE(derating.flush());
+
+    // The next input, even an unchanged one, retries
+    bundle.accepting = true;
+    derating.dispatch(bms_limits(100, 30));
+    TEST_ASSERT_EQUAL(2, bundle.sent.size());
+    TEST_ASSERT_TRUE(derating.flush());
+    TEST_ASSERT_EQUAL(2, derating.statistics().sent);
+}
+
+void run_DTIX50_derating_tests() {
+    RUN_TEST(test_derating_sends_bms_limits_on_change_only);
+    RUN_TEST(test_derating_merges_sources_and_caps);
+    RUN_TEST(test_derating_follows_inverter_temperatures);
+    RUN_TEST(test_derating_retries_refused_commands);
+}
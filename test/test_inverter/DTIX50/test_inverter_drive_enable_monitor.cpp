@@ -0,0 +1,183 @@
+#include <unity.h>
+
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include <DTIX50.h>
+#include <mocks.h>
+
+using namespace Inverter;
+using namespace Inverter::DTIX50;
+using namespace MOCKS;
+
+struct Event {
+    AcknowledgeEvent event;
+    uint32_t elapsed_us;
+};
+
+static void record_event(AcknowledgeEvent event, uint32_t elapsed_us, void* context) {
+    ((std::vector<Event>*)context)->push_back({ event, elapsed_us });
+}
+
+static Message24 status(bool drive_enable, bool drive_enable_limit = false) {
+    Message24 message = {};
+    message.drive_enable = drive_enable ? 1 : 0;
+    message.drive_enable_limit = drive_enable_limit ? 1 : 0;
+    return message;
+}
+
+void test_monitor_measures_round_trip() {
+    MockClockStrategy clock;
+    DriveEnableMonitor monitor(&clock);
+
+    monitor.sent(true, true);
+    TEST_ASSERT_TRUE(monitor.pending());
+
+    // A report of the old state does not acknowledge
+    clock.advance(4000);
+    TEST_ASSERT_FALSE(monitor.acknowledge(status(false)));
+
+    // Repeated heartbeats keep the first send time
+    clock.advance(3000);
+    monitor.sent(true, true);
+    clock.advance(5000);
+    TEST_ASSERT_TRUE(monitor.acknowledge(status(true)));
+    TEST_ASSERT_FALSE(monitor.pending());
+    TEST_ASSERT_TRUE(monitor.enabled());
+
+    TEST_ASSERT_EQUAL(1, monitor.latency().count());
+    TEST_ASSERT_EQUAL(12000, monitor.latency().max());
+
+    DriveEnableMonitor::Statistics statistics = monitor.statistics();
+    TEST_ASSERT_EQUAL(2, statistics.sent);
+    TEST_ASSERT_EQUAL(1, statistics.acknowledged);
+    TEST_ASSERT_EQUAL(0, statistics.missed);
+}
+
+void test_monitor_reports_missed_deadline_once() {
+    MockClockStrategy clock;
+    DriveEnableMonitor monitor(&clock);
+    monitor.deadline_us = 50000;
+    std::vector<Event> events;
+    monitor.set_listener(record_event, &events);
+
+    monitor.sent(true, true);
+    clock.advance(49999);
+    monitor.poll();
+    TEST_ASSERT_EQUAL(0, events.size());
+
+    clock.advance(1);
+    monitor.poll();
+    monitor.poll();
+    TEST_ASSERT_EQUAL(1, events.size());
+    TEST_ASSERT_EQUAL(AcknowledgeEvent::MISSED_DEADLINE, events[0].event);
+    TEST_ASSERT_EQUAL(50000, events[0].elapsed_us);
+
+    // The late acknowledgement still lands in the histogram
+    clock.advance(30000);
+    TEST_ASSERT_TRUE(monitor.acknowledge(status(true)));
+    TEST_ASSERT_EQUAL(80000, monitor.latency().max());
+    TEST_ASSERT_EQUAL(1, monitor.statistics().missed);
+
+    // A new state gets a new deadline
+    monitor.sent(false, true);
+    clock.advance(60000);
+    TEST_ASSERT_FALSE(monitor.acknowledge(status(true)));
+    TEST_ASSERT_EQUAL(2, events.size());
+    TEST_ASSERT_EQUAL(2, monitor.statistics().missed);
+}
+
+void test_monitor_reports_refusal_and_transmit_failure() {
+    MockClockStrategy clock;
+    DriveEnableMonitor monitor(&clock);
+    std::vector<Event> events;
+    monitor.set_listener(record_event, &events);
+
+    monitor.sent(true, false);
+    TEST_ASSERT_FALSE(monitor.pending());
+    TEST_ASSERT_EQUAL(1, events.size());
+    TEST_ASSERT_EQUAL(AcknowledgeEvent::TRANSMIT_FAILED, events[0].event);
+
+    monitor.sent(true, true);
+    clock.advance(2000);
+    TEST_ASSERT_FALSE(monitor.acknowledge(status(false, true)));
+    TEST_ASSERT_EQUAL(2, events.size());
+    TEST_ASSERT_EQUAL(AcknowledgeEvent::REFUSED, events[1].event);
+    TEST_ASSERT_EQUAL(2000, events[1].elapsed_us);
+
+    DriveEnableMonitor::Statistics statistics = monitor.statistics();
+    TEST_ASSERT_EQUAL(1, statistics.transmit_failures);
+    TEST_ASSERT_EQUAL(1, statistics.refused);
+}
+
+void test_monitor_without_clock_is_inert() {
+    DriveEnableMonitor monitor;
+    monitor.sent(true, true);
+    TEST_ASSERT_FALSE(monitor.pending());
+    TEST_ASSERT_FALSE(monitor.acknowledge(status(true)));
+}
+
+void test_heartbeat_feeds_monitor() {
+    MockCanService service;
+    std::shared_ptr<Provider> provider(new Provider(&service));
+    NativeClockStrategy clock;
+
+    DTIX50::Heartbeat heartbeat(provider,
+                                std::unique_ptr<Core::iLockStrategy>(new NativeLockStrategy()),
+                                std::unique_ptr<Core::iThreadStrategy>(new NativeThreadStrategy()),
+                                DEFAULT_NODE, &clock);
+    heartbeat.start();
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+
+    // Only this node's general data 5 counts
+    Message24 enabled = status(true);
+    Frame other(identifier(Packet::GENERAL_DATA_5, 0x53), &enabled);
+    TEST_ASSERT_FALSE(heartbeat.acknowledge(other));
+    Frame frame(identifier(Packet::GENERAL_DATA_5, DEFAULT_NODE), &enabled);
+    TEST_ASSERT_TRUE(heartbeat.acknowledge(frame));
+
+    heartbeat.stop();
+
+    TEST_ASSERT_EQUAL(1, heartbeat.monitor().latency().count());
+    TEST_ASSERT_GREATER_OR_EQUAL(2, heartbeat.monitor().statistics().sent);
+    // The drive disable sent on stop waits for its report
+    TEST_ASSERT_TRUE(heartbeat.monitor().pending());
+}
+
+void test_heartbeat_node_zero() {
+    MockCanService service;
+    std::shared_ptr<Provider> provider(new Provider(&service));
+    MockClockStrategy clock;
+
+    DTIX50::Heartbeat plain(provider,
+                            std::unique_ptr<Core::iLockStrategy>(new NativeLockStrategy()),
+                            std::unique_ptr<Core::iThreadStrategy>(new NativeThreadStrategy()),
+                            0);
+    DTIX50::Heartbeat monitored(provider,
+                                std::unique_ptr<Core::iLockStrategy>(new NativeLockStrategy()),
+                                std::unique_ptr<Core::iThreadStrategy>(new NativeThreadStrategy()),
+                                0, &clock);
+    TEST_ASSERT_FALSE(plain.started());
+
+    // Node 0 listens for its own general data 5 only
+    Message24 enabled = status(true);
+    Frame frame(identifier(Packet::GENERAL_DATA_5, 0), &enabled);
+    Frame other(identifier(Packet::GENERAL_DATA_5, DEFAULT_NODE), &enabled);
+    monitored.monitor().sent(true, true);
+    TEST_ASSERT_FALSE(monitored.acknowledge(other));
+    TEST_ASSERT_TRUE(monitored.acknowledge(frame));
+    // Without a clock nothing is tracked
+    plain.monitor().sent(true, true);
+    TEST_ASSERT_FALSE(plain.acknowledge(frame));
+}
+
+void run_DTIX50_drive_enable_monitor_tests() {
+    RUN_TEST(test_monitor_measures_round_trip);
+    RUN_TEST(test_monitor_reports_missed_deadline_once);
+    RUN_TEST(test_monitor_reports_refusal_and_transmit_failure);
+    RUN_TEST(test_monitor_without_clock_is_inert);
+    RUN_TEST(test_heartbeat_feeds_monitor);
+    RUN_TEST(test_heartbeat_node_zero);
+}
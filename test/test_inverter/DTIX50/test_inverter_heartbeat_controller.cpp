@@ -42,7 +42,7 @@ void test_Heartbeat() {
 
     TEST_ASSERT_EQUAL(1, drive_type[1]); // Verify that only one drive disable has been sent
 
-    free(canService);
+    delete canService;
 }
 
 void run_DTIX50_controller_tests() {
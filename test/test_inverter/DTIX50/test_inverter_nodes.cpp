@@ -0,0 +1,91 @@
+#include <unity.h>
+#include <vector>
+
+#include <DTIX50.h>
+#include <mocks.h>
+
+using namespace Inverter;
+using namespace Inverter::DTIX50;
+using namespace MOCKS;
+
+typedef NodeGroup<0x52, 0x53, 0x54, 0x55> QuadMotor;
+
+// Identifiers are constant expressions
+static_assert(identifier(Packet::SET_DRIVE_ENABLE, DEFAULT_NODE) == 0x0C52, "Heartbeat identifier");
+static_assert(QuadMotor::identifier(Packet::GENERAL_DATA_1, 3) == 0x2055, "Per-node identifier");
+
+void test_identifier_round_trip() {
+    TEST_ASSERT_EQUAL(0x0552, identifier(Packet::SET_RELATIVE_AC_CURRENT, 0x52));
+    TEST_ASSERT_EQUAL(0x26, packet_of(0x2653));
+    TEST_ASSERT_EQUAL(0x53, node_of(0x2653));
+    TEST_ASSERT_TRUE(is_broadcast(Packet::GENERAL_DATA_3));
+    TEST_ASSERT_FALSE(is_broadcast(Packet::SET_DRIVE_ENABLE));
+}
+
+void test_node_group_sends_command_batch() {
+    MockCanService service;
+    std::vector<Frame> sent;
+    service.on_transmit = [&sent](const Frame* frame, Tick) {
+        sent.push_back(*frame);
+        return Result::OK;
+    };
+    Provider provider(&service);
+
+    Command::SetDriveEnable enable = { 0x01, 0xFFFFFFFFFFFFFF };
+    TEST_ASSERT_EQUAL(4, QuadMotor::send(provider, Packet::SET_DRIVE_ENABLE, enable));
+
+    TEST_ASSERT_EQUAL(4, sent.size());
+    for (uint32_t i = 0; i < 4; i++) {
+        TEST_ASSERT_EQUAL(0x0C52 + i, sent[i].identifier);
+        TEST_ASSERT_EQUAL(1, sent[i].extd);
+        TEST_ASSERT_EQUAL(0x01, sent[i].data[0]);
+    }
+
+    // Per-node setpoints, e.g. torque vectoring
+    Command::SetRelativeACCurrent torque[4] = {
+        { 100, 0xFFFFFFFFFFFF }, { 200, 0xFFFFFFFFFFFF }, { 300, 0xFFFFFFFFFFFF }, { 400, 0xFFFFFFFFFFFF }
+    };
+    Frame frames[QuadMotor::COUNT];
+    QuadMotor::build(Packet::SET_RELATIVE_AC_CURRENT, torque, frames);
+    TEST_ASSERT_EQUAL(0x0554, frames[2].identifier);
+    TEST_ASSERT_EQUAL(300 & 0xFF, frames[2].data[0]);
+    TEST_ASSERT_EQUAL(300 >> 8, frames[2].data[1]);
+}
+
+void test_node_group_demultiplexes_broadcasts() {
+    QuadMotor group;
+
+    Message20 general1 = { 12000, 0x0100, 600 };
+    Frame from_third(identifier(Packet::GENERAL_DATA_1, 0x54), &general1);
+    TEST_ASSERT_TRUE(group.dispatch(from_third));
+
+    Message22 general3 = { 450, 620, FaultCodes::NONE, 0xFFFFFF };
+    Frame from_first(identifier(Packet::GENERAL_DATA_3, 0x52), &general3);
+    TEST_ASSERT_TRUE(group.dispatch(from_first));
+
+    TEST_ASSERT_EQUAL(12000, group.telemetry(2).general1.erpm);
+    TEST_ASSERT_EQUAL(600, group.telemetry(2).general1.input_voltage);
+    TEST_ASSERT_EQUAL(1 << 1, group.telemetry(2).received);
+    TEST_ASSERT_EQUAL(620, group.telemetry(0).general3.motor_temp);
+    TEST_ASSERT_EQUAL(1, group.telemetry(0).updates);
+    TEST_ASSERT_EQUAL(0, group.telemetry(1).updates);
+}
+
+void test_node_group_ignores_foreign_frames() {
+    QuadMotor group;
+    uint8_t data[8] = { 0 };
+
+    // Unknown node, command packet, and a BMS identifier
+    TEST_ASSERT_FALSE(group.dispatch(Frame(identifier(Packet::GENERAL_DATA_1, 0x60), data)));
+    TEST_ASSERT_FALSE(group.dispatch(Frame(identifier(Packet::SET_AC_CURRENT, 0x52), data)));
+    TEST_ASSERT_FALSE(group.dispatch(Frame(0x1806E5F4, data)));
+    TEST_ASSERT_EQUAL(QuadMotor::COUNT, group.index_of(0x60));
+    TEST_ASSERT_EQUAL(1, group.index_of(0x53));
+}
+
+void run_DTIX50_node_tests() {
+    RUN_TEST(test_identifier_round_trip);
+    RUN_TEST(test_node_group_sends_command_batch);
+    RUN_TEST(test_node_group_demultiplexes_broadcasts);
+    RUN_TEST(test_node_group_ignores_foreign_frames);
+}
@@ -0,0 +1,164 @@
+#include <unity.h>
+#include <cstring>
+
+#include <DTIX50.h>
+#include <can.h>
+
+using namespace Inverter;
+using namespace Inverter::DTIX50;
+using namespace CAN;
+
+template<typename T>
+static Frame broadcast(uint8_t packet, T message) {
+    Frame frame(identifier(packet, DEFAULT_NODE), &message);
+    frame.extd = 1;
+    return frame;
+}
+
+void test_telemetry_sign_extends_and_scales() {
+    InverterState state = {};
+
+    // -1234 ERPM, -12.5 % duty cycle, 400 V
+    Message20 general1 = { (uint32_t)-1234, (uint16_t)-125, 400 };
+    TEST_ASSERT_TRUE(decode(broadcast(Packet::GENERAL_DATA_1, general1), state));
+    TEST_ASSERT_EQUAL(-1234, state.erpm);
+    TEST_ASSERT_EQUAL_FLOAT(-12.5f, state.duty_cycle);
+    TEST_ASSERT_EQUAL_FLOAT(400.0f, state.input_voltage);
+
+    // Regenerating: -150.3 A AC, -20.0 A DC
+    Message21 general2 = { (uint16_t)-1503, (uint16_t)-200, 0xFFFFFFFF };
+    TEST_ASSERT_TRUE(decode(broadcast(Packet::GENERAL_DATA_2, general2), state));
+    TEST_ASSERT_EQUAL_FLOAT(-150.3f, state.ac_current);
+    TEST_ASSERT_EQUAL_FLOAT(-20.0f, state.dc_current);
+
+    Message22 general3 = { 655, (uint16_t)-52, FaultCodes::MOTOR_OVERTEMP, 0xFFFFFF };
+    TEST_ASSERT_TRUE(decode(broadcast(Packet::GENERAL_DATA_3, general3), state));
+    TEST_ASSERT_EQUAL_FLOAT(65.5f, state.controller_temp);
+    TEST_ASSERT_EQUAL_FLOAT(-5.2f, state.motor_temp);
+    TEST_ASSERT_EQUAL(FaultCodes::MOTOR_OVERTEMP, state.fault_code);
+
+    // FOC components have two decimals
+    Message23 general4 = { (uint32_t)-1234, 56789 };
+    TEST_ASSERT_TRUE(decode(broadcast(Packet::GENERAL_DATA_4, general4), state));
+    TEST_ASSERT_EQUAL_FLOAT(-12.34f, state.id);
+    TEST_ASSERT_EQUAL_FLOAT(567.89f, state.iq);
+
+    TEST_ASSERT_EQUAL_HEX8(0x1E, state.received);
+}
+
+void test_telemetry_decodes_flags_and_limits() {
+    InverterState state = {};
+
+    Message24 general5 = {};
+    general5.throttle_signal = 87;
+    general5.drive_enable = 1;
+    general5.dc_current_limit = 1;
+    general5.motor_temp_limit = 1;
+    general5.can_map_version = 25;
+    TEST_ASSERT_TRUE(decode(broadcast(Packet::GENERAL_DATA_5, general5), state));
+    TEST_ASSERT_EQUAL(87, state.throttle);
+    TEST_ASSERT_TRUE(state.drive_enable);
+    TEST_ASSERT_EQUAL_HEX16(Limit::DC_CURRENT | Limit::MOTOR_TEMP, state.limits);
+    TEST_ASSERT_EQUAL(25, state.can_map_version);
+
+    Message25 ac_limits = { 3000, 2500, (uint16_t)-3000, (uint16_t)-1000 };
+    TEST_ASSERT_TRUE(decode(broadcast(Packet::AC_CURRENT_LIMITS, ac_limits), state));
+    TEST_ASSERT_EQUAL_FLOAT(250.0f, state.available_max_ac_current);
+    TEST_ASSERT_EQUAL_FLOAT(-100.0f, state.available_min_ac_current);
+
+    // Commands are not telemetry
+    Frame command = broadcast(Packet::SET_DRIVE_ENABLE, general5);
+    TEST_ASSERT_FALSE(decode(command, state));
+}
+
+void test_telemetry_rejects_foreign_frames() {
+    InverterState state = {};
+    Message21 general2 = { 100, 50, 0xFFFFFFFF };
+
+    // Another device's extended frame whose bits 8 to 15 look like general data 2
+    Frame foreign = broadcast(Packet::GENERAL_DATA_2, general2);
+    foreign.identifier |= 0x1830000;
+    TEST_ASSERT_FALSE(decode(foreign, state));
+
+    // A standard frame with the same identifier
+    Frame standard = broadcast(Packet::GENERAL_DATA_2, general2);
+    standard.extd = 0;
+    TEST_ASSERT_FALSE(decode(standard, state));
+    TEST_ASSERT_EQUAL_HEX8(0, state.received);
+
+    TEST_ASSERT_TRUE(decode(broadcast(Packet::GENERAL_DATA_2, general2), state));
+}
+
+void test_telemetry_decodes_node_group_telemetry() {
+    NodeGroup<0x52, 0x53> group;
+    Message21 general2 = { 100, 50, 0xFFFFFFFF };
+    Frame frame(identifier(Packet::GENERAL_DATA_2, 0x53), &general2);
+    frame.extd = 1;
+    TEST_ASSERT_TRUE(group.dispatch(frame));
+
+    InverterState state = {};
+    decode(group.telemetry(1), state);
+    TEST_ASSERT_EQUAL_FLOAT(10.0f, state.ac_current);
+    TEST_ASSERT_EQUAL_FLOAT(5.0f, state.dc_current);
+    TEST_ASSERT_EQUAL_HEX8(1U << (Packet::GENERAL_DATA_2 - Packet::FIRST_BROADCAST), state.received);
+}
+
+void test_telemetry_batch_matches_single_frame_decode() {
+    // Longer than one gather pass and not a multiple of it
+    const uint32_t COUNT = 75;
+    Frame general2[COUNT];
+    Frame general4[COUNT];
+    for (uint32_t i = 0; i < COUNT; i++) {
+        Message21 currents = { (uint16_t)(i * 37 - 1000), (uint16_t)(500 - i * 13), 0xFFFFFFFF };
+        general2[i] = broadcast(Packet::GENERAL_DATA_2, currents);
+        Message23 foc = { (uint32_t)(i * 1001 - 30000), (uint32_t)(i * -77) };
+        general4[i] = broadcast(Packet::GENERAL_DATA_4, foc);
+    }
+
+    float ac[COUNT], dc[COUNT], id[COUNT], iq[COUNT];
+    TEST_ASSERT_EQUAL(COUNT, decode_general2(general2, COUNT, ac, dc));
+    TEST_ASSERT_EQUAL(COUNT, decode_general4(general4, COUNT, id, iq));
+
+    for (uint32_t i = 0; i < COUNT; i++) {
+        InverterState state = {};
+        decode(general2[i], state);
+        decode(general4[i], state);
+        TEST_ASSERT_EQUAL_FLOAT(state.ac_current, ac[i]);
+        TEST_ASSERT_EQUAL_FLOAT(state.dc_current, dc[i]);
+        TEST_ASSERT_EQUAL_FLOAT(state.id, id[i]);
+        TEST_ASSERT_EQUAL_FLOAT(state.iq, iq[i]);
+    }
+    TEST_ASSERT_EQUAL_FLOAT(-100.0f, ac[0]);
+}
+
+void test_telemetry_batch_general1_and_general3() {
+    Frame general1[3];
+    Frame general3[3];
+    for (uint32_t i = 0; i < 3; i++) {
+        Message20 speed = { (uint32_t)(-5000 + (int32_t)i * 5000), (uint16_t)(i * 100), (uint16_t)(380 + i) };
+        general1[i] = broadcast(Packet::GENERAL_DATA_1, speed);
+        Message22 temps = { (uint16_t)(250 + i), (uint16_t)(-10 + (int32_t)i * 10), FaultCodes::NONE, 0xFFFFFF };
+        general3[i] = broadcast(Packet::GENERAL_DATA_3, temps);
+    }
+
+    int32_t erpm[3];
+    float duty[3], voltage[3], controller[3], motor[3];
+    decode_general1(general1, 3, erpm, duty, voltage);
+    decode_general3(general3, 3, controller, motor);
+
+    TEST_ASSERT_EQUAL(-5000, erpm[0]);
+    TEST_ASSERT_EQUAL(5000, erpm[2]);
+    TEST_ASSERT_EQUAL_FLOAT(20.0f, duty[2]);
+    TEST_ASSERT_EQUAL_FLOAT(381.0f, voltage[1]);
+    TEST_ASSERT_EQUAL_FLOAT(25.2f, controller[2]);
+    TEST_ASSERT_EQUAL_FLOAT(-1.0f, motor[0]);
+}
+
+void run_DTIX50_telemetry_tests() {
+    RUN_TEST(test_telemetry_sign_extends_and_scales);
+    RUN_TEST(test_telemetry_decodes_flags_and_limits);
+    RUN_TEST(test_telemetry_rejects_foreign_frames);
+    RUN_TEST(test_telemetry_decodes_node_group_telemetry);
+    RUN_TEST(test_telemetry_batch_matches_single_frame_decode);
+    RUN_TEST(test_telemetry_batch_general1_and_general3);
+}
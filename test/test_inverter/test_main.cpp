@@ -16,5 +16,10 @@ int main() {
     run_DTIX50_message_tests();
     run_DTIX50_command_tests();
     run_DTIX50_controller_tests();
+    run_DTIX50_node_tests();
+    run_DTIX50_telemetry_tests();
+    run_DTIX50_drive_enable_monitor_tests();
+    run_DTIX50_capture_tests();
+    run_DTIX50_derating_tests();
     return UNITY_END();
 }
\ No newline at end of file
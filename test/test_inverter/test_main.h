@@ -1,3 +1,8 @@
 void run_DTIX50_message_tests();
 void run_DTIX50_command_tests();
-void run_DTIX50_controller_tests();
\ No newline at end of file
+void run_DTIX50_controller_tests();
+void run_DTIX50_node_tests();
+void run_DTIX50_telemetry_tests();
+void run_DTIX50_drive_enable_monitor_tests();
+void run_DTIX50_capture_tests();
+void run_DTIX50_derating_tests();
\ No newline at end of file
@@ -0,0 +1,122 @@
+#include <cstring>
+#include <memory>
+#include <vector>
+#include <pedals.h>
+#include <mocks.h>
+
+#include "test_main.h"
+
+using namespace CAN;
+using namespace MOCKS;
+using namespace Pedals;
+
+// ADC1 channels of the pedal sensors
+static const AppsSampler::Channels CHANNELS = { 3, 4, 5 };
+
+void test_sampler_oversamples_both_apps() {
+    MockAdcSource adc;
+    MockClockStrategy clock;
+    AppsSampler sampler(&adc, &clock, CHANNELS, 4);
+    TEST_ASSERT_TRUE(sampler.start());
+
+    adc.push_pattern(3, 1000, 4, 3000, 5, 200, 2);
+    adc.push_pattern(3, 1004, 4, 3008, 5, 204, 2);
+    PedalSample sample;
+    TEST_ASSERT_TRUE(sampler.sample(sample));
+    TEST_ASSERT_EQUAL(1002, sample.apps1);
+    TEST_ASSERT_EQUAL(3004, sample.apps2);
+    // The window closes on the last APPS2 conversion, the trailing brake conversion rolls into the next one
+    TEST_ASSERT_EQUAL(201, sample.brake);
+
+    // An incomplete window does not produce a sample, the previous one is still fresh
+    adc.push_pattern(3, 2000, 4, 2000, 5, 0, 3);
+    TEST_ASSERT_TRUE(sampler.sample(sample));
+    TEST_ASSERT_EQUAL(1002, sample.apps1);
+    TEST_ASSERT_EQUAL(1, sampler.statistics().samples);
+}
+
+void test_sampler_ignores_foreign_channels_and_drains_in_chunks() {
+    MockAdcSource adc;
+    MockClockStrategy clock;
+    AppsSampler sampler(&adc, &clock, CHANNELS, 8);
+    sampler.start();
+
+    // More than one read chunk worth of conversions, with another channel mixed in
+    for (uint32_t i = 0; i < 40; i++) {
+        adc.pending.push_back({ 9, 4095 });
+        adc.push_pattern(3, (uint16_t)(1000 + i), 4, 2000, 5, 100);
+    }
+    TEST_ASSERT_EQUAL(5, sampler.poll());
+    TEST_ASSERT_EQUAL(160, sampler.statistics().conversions);
+    TEST_ASSERT_TRUE(adc.pending.empty());
+
+    PedalSample sample;
+    TEST_ASSERT_TRUE(sampler.sample(sample));
+    // Average of the last window, 1032 to 1039
+    TEST_ASSERT_EQUAL(1035, sample.apps1);
+}
+
+void test_sampler_refuses_stale_output() {
+    MockAdcSource adc;
+    MockClockStrategy clock;
+    AppsSampler sampler(&adc, &clock, CHANNELS, 1);
+    PedalSample sample;
+
+    TEST_ASSERT_FALSE(sampler.sample(sample));
+
+    sampler.start();
+    adc.push_pattern(3, 1000, 4, 3000, 5, 0);
+    TEST_ASSERT_TRUE(sampler.sample(sample));
+
+    // The ADC stalls
+    clock.advance(sampler.max_age_us + 1);
+    TEST_ASSERT_FALSE(sampler.sample(sample));
+    TEST_ASSERT_EQUAL(2, sampler.statistics().stale);
+}
+
+void test_sampler_drives_torque_pipeline() {
+    MockAdcSource adc;
+    MockClockStrategy clock;
+    MockCanService service;
+    std::vector<Frame> sent;
+    service.on_transmit = [&](const Frame* frame, Tick) {
+        sent.push_back(*frame);
+        return Result::OK;
+    };
+    std::shared_ptr<Provider> provider(new Provider(&service));
+
+    AppsSampler sampler(&adc, &clock, CHANNELS, 4);
+    sampler.start();
+    TorquePipeline pipeline(provider, &sampler, &clock, std::unique_ptr<Core::iThreadStrategy>(new NativeThreadStrategy()));
+    pipeline.plausibility.apps1 = { 500, 3500 };
+    pipeline.plausibility.apps2 = { 500, 3500 };
+
+    adc.push_pattern(3, 2000, 4, 2000, 5, 0, 4);
+    pipeline.cycle();
+    TEST_ASSERT_EQUAL(PedalFault::NONE, pipeline.fault());
+    TEST_ASSERT_EQUAL(500, pipeline.command());
+
+    // APPS2 shorted to the sensor supply
+    adc.push_pattern(3, 2000, 4, 4095, 5, 0, 4);
+    pipeline.cycle();
+    TEST_ASSERT_EQUAL(PedalFault::APPS2_SHORT_TO_SUPPLY, pipeline.fault());
+    TEST_ASSERT_EQUAL(0, pipeline.command());
+
+    // APPS1 connector pulled
+    adc.push_pattern(3, 0, 4, 2000, 5, 0, 4);
+    pipeline.cycle();
+    TEST_ASSERT_EQUAL(PedalFault::APPS1_OPEN_OR_GROUND, pipeline.fault());
+
+    // ADC stopped delivering
+    clock.advance(5000);
+    pipeline.cycle();
+    TEST_ASSERT_EQUAL(PedalFault::NO_SAMPLE, pipeline.fault());
+    TEST_ASSERT_EQUAL(4, sent.size());
+}
+
+void run_apps_sampler_tests() {
+    RUN_TEST(test_sampler_oversamples_both_apps);
+    RUN_TEST(test_sampler_ignores_foreign_channels_and_drains_in_chunks);
+    RUN_TEST(test_sampler_refuses_stale_output);
+    RUN_TEST(test_sampler_drives_torque_pipeline);
+}
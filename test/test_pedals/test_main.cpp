@@ -17,5 +17,10 @@ void test_pedal_basic() {
 int main() {
     UNITY_BEGIN();
     RUN_TEST(test_pedal_basic);
+    run_plausibility_tests();
+    run_torque_map_tests();
+    run_torque_pipeline_tests();
+    run_apps_sampler_tests();
+    run_shutdown_sequence_tests();
     return UNITY_END();
 }
\ No newline at end of file
@@ -3,4 +3,10 @@
 
 #include <unity.h>
 
-#endif // TEST_MAIN_H
\ No newline at end of file
+void run_plausibility_tests();
+void run_torque_map_tests();
+void run_torque_pipeline_tests();
+void run_apps_sampler_tests();
+void run_shutdown_sequence_tests();
+
+#endif // TEST_MAIN_H
@@ -0,0 +1,78 @@
+#include <pedals.h>
+
+#include "test_main.h"
+
+using namespace Pedals;
+
+static Plausibility make_plausibility() {
+    Plausibility plausibility;
+    plausibility.apps1 = { 500, 3500 };
+    // APPS2 wired in reverse so a short affects the sensors differently
+    plausibility.apps2 = { 3500, 500 };
+    return plausibility;
+}
+
+static PedalSample make_sample(uint16_t apps1, uint16_t apps2, uint64_t timestamp_us) {
+    PedalSample sample = { apps1, apps2, 0, timestamp_us };
+    return sample;
+}
+
+void test_plausibility_travel_is_mean_of_sensors() {
+    Plausibility plausibility = make_plausibility();
+    uint16_t travel = 0xFFFF;
+
+    TEST_ASSERT_EQUAL(PedalFault::NONE, plausibility.check(make_sample(500, 3500, 0), travel));
+    TEST_ASSERT_EQUAL(0, travel);
+
+    TEST_ASSERT_EQUAL(PedalFault::NONE, plausibility.check(make_sample(2000, 2000, 0), travel));
+    TEST_ASSERT_EQUAL(500, travel);
+
+    // Within the margin past full travel is clamped rather than faulted
+    TEST_ASSERT_EQUAL(PedalFault::NONE, plausibility.check(make_sample(3560, 440, 0), travel));
+    TEST_ASSERT_EQUAL(TRAVEL_FULL, travel);
+}
+
+void test_plausibility_out_of_range_faults_at_once() {
+    Plausibility plausibility = make_plausibility();
+    uint16_t travel = 0;
+
+    // Open circuit or short to ground on APPS1
+    TEST_ASSERT_EQUAL(PedalFault::APPS1_OPEN_OR_GROUND, plausibility.check(make_sample(0, 3500, 0), travel));
+    TEST_ASSERT_EQUAL(0, travel);
+
+    // Short to sensor power on APPS2
+    TEST_ASSERT_EQUAL(PedalFault::APPS2_SHORT_TO_SUPPLY, plausibility.check(make_sample(2000, 4095, 0), travel));
+    TEST_ASSERT_EQUAL(PedalFault::APPS2_SHORT_TO_SUPPLY, plausibility.fault());
+
+    // Off the calibrated range without reaching a rail, e.g. a slipped sensor
+    TEST_ASSERT_EQUAL(PedalFault::APPS1_RANGE, plausibility.check(make_sample(300, 3500, 0), travel));
+    TEST_ASSERT_EQUAL(PedalFault::APPS2_RANGE, plausibility.check(make_sample(500, 3700, 0), travel));
+
+    // Clears as soon as the readings are valid again
+    TEST_ASSERT_EQUAL(PedalFault::NONE, plausibility.check(make_sample(2000, 2000, 0), travel));
+    TEST_ASSERT_EQUAL(500, travel);
+}
+
+void test_plausibility_disagreement_needs_persistence() {
+    Plausibility plausibility = make_plausibility();
+    uint16_t travel = 0;
+
+    // APPS1 at 50%, APPS2 at 30%
+    TEST_ASSERT_EQUAL(PedalFault::NONE, plausibility.check(make_sample(2000, 2600, 0), travel));
+    TEST_ASSERT_EQUAL(400, travel);
+    TEST_ASSERT_EQUAL(PedalFault::NONE, plausibility.check(make_sample(2000, 2600, 99999), travel));
+    TEST_ASSERT_EQUAL(PedalFault::DISAGREEMENT, plausibility.check(make_sample(2000, 2600, 100000), travel));
+    TEST_ASSERT_EQUAL(0, travel);
+
+    // Agreement restarts the persistence window
+    TEST_ASSERT_EQUAL(PedalFault::NONE, plausibility.check(make_sample(2000, 2000, 100001), travel));
+    TEST_ASSERT_EQUAL(PedalFault::NONE, plausibility.check(make_sample(2000, 2600, 150000), travel));
+    TEST_ASSERT_EQUAL(PedalFault::NONE, plausibility.check(make_sample(2000, 2600, 249999), travel));
+    TEST_ASSERT_EQUAL(PedalFault::DISAGREEMENT, plausibility.check(make_sample(2000, 2600, 250000), travel));
+}
+
+void run_plausibility_tests() {
+    RUN_TEST(test_plausibility_travel_is_mean_of_sensors);
+    RUN_TEST(test_plausibility_out_of_range_faults_at_once);
+    RUN_TEST(test_plausibility_disagreement_needs_persistence);
+}
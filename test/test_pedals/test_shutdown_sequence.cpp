@@ -0,0 +1,265 @@
+#include <vector>
+#include <pedals.h>
+#include <battery/messages.h>
+#include <mocks.h>
+
+#include "test_main.h"
+
+using namespace CAN;
+using namespace MOCKS;
+using namespace Pedals;
+using namespace Inverter;
+using namespace Inverter::DTIX50;
+
+static Frame link_voltage(uint16_t volts, uint8_t node = DEFAULT_NODE) {
+    Message20 message = { 0, 0, volts };
+    Frame frame(identifier(Packet::GENERAL_DATA_1, node), &message);
+    frame.extd = 1;
+    return frame;
+}
+
+// Pack voltage in tenths of a volt
+static Frame pack_voltage(uint16_t decivolts) {
+    ::Message1 message = { decivolts, 0, 0, 0 };
+    return Frame(0x001, &message);
+}
+
+static PedalSample brake(uint16_t raw) {
+    return { 0, 0, raw, 0 };
+}
+
+struct Car {
+    enum Milestone : uint8_t { READY_TO_DRIVE, MILESTONES };
+
+    MockClockStrategy clock;
+    ShutdownSequence sequence;
+    Core::Startup::Milestones<MILESTONES> milestones;
+    std::vector<VehicleState> states;
+    std::vector<bool> sounds;
+
+    Car() : sequence(&clock), milestones(&clock) {
+        sequence.set_state_listener(on_state, this);
+        sequence.set_sound_listener(on_sound, this);
+        sequence.set_ready_milestone(milestones.hook(READY_TO_DRIVE));
+        clock.now = 1000000;
+        sequence.start();
+    }
+
+    static void on_state(VehicleState from, VehicleState to, void* context) {
+        ((Car*)context)->states.push_back(to);
+    }
+
+    static void on_sound(bool on, void* context) {
+        ((Car*)context)->sounds.push_back(on);
+    }
+
+    // GLV on, shutdown circuit closed and precharged to 400 V
+    void energize() {
+        sequence.set_glv(true);
+        sequence.set_shutdown(true);
+        sequence.dispatch(pack_voltage(4000));
+        sequence.dispatch(link_voltage(390));
+    }
+
+    void press_start() {
+        sequence.set_start(true);
+        sequence.set_start(false);
+    }
+};
+
+void test_shutdown_sequence_to_ready_to_drive() {
+    Car car;
+    TEST_ASSERT_EQUAL(VehicleState::GLV_OFF, car.sequence.state());
+
+    car.sequence.set_glv(true);
+    TEST_ASSERT_EQUAL(VehicleState::TS_OFF, car.sequence.state());
+    car.sequence.set_shutdown(true);
+    TEST_ASSERT_EQUAL(VehicleState::PRECHARGE, car.sequence.state());
+
+    // Precharge completes at 90 % of the pack voltage
+    TEST_ASSERT_TRUE(car.sequence.dispatch(pack_voltage(4000)));
+    TEST_ASSERT_TRUE(car.sequence.dispatch(link_voltage(359)));
+    TEST_ASSERT_EQUAL(VehicleState::PRECHARGE, car.sequence.state());
+    car.sequence.dispatch(link_voltage(360));
+    TEST_ASSERT_EQUAL(VehicleState::TS_ENERGIZED, car.sequence.state());
+    TEST_ASSERT_FALSE(car.sequence.ready());
+
+    // Start without the brake is refused
+    car.press_start();
+    TEST_ASSERT_EQUAL(VehicleState::TS_ENERGIZED, car.sequence.state());
+    TEST_ASSERT_EQUAL(1, car.sequence.statistics().starts_refused);
+
+    car.sequence.update(brake(2000));
+    car.press_start();
+    TEST_ASSERT_EQUAL(VehicleState::READY_TO_DRIVE, car.sequence.state());
+    TEST_ASSERT_TRUE(car.sequence.ready());
+    TEST_ASSERT_TRUE(car.sequence.sound());
+
+    const VehicleState expected[] = { VehicleState::TS_OFF, VehicleState::PRECHARGE, VehicleState::TS_ENERGIZED, VehicleState::READY_TO_DRIVE };
+    TEST_ASSERT_EQUAL(4, car.states.size());
+    for (uint32_t i = 0; i < 4; i++) {
+        TEST_ASSERT_EQUAL(expected[i], car.states[i]);
+    }
+    TEST_ASSERT_EQUAL(1, car.sounds.size());
+    TEST_ASSERT_TRUE(car.sounds[0]);
+    TEST_ASSERT_EQUAL(4, car.sequence.latency().count());
+    TEST_ASSERT_EQUAL(1000000, car.milestones.at_us(Car::READY_TO_DRIVE));
+
+    // Pressing start again deactivates the motor controller
+    car.press_start();
+    TEST_ASSERT_EQUAL(VehicleState::TS_ENERGIZED, car.sequence.state());
+    TEST_ASSERT_FALSE(car.sequence.ready());
+}
+
+void test_shutdown_sequence_sound_timing() {
+    Car car;
+    car.energize();
+    car.sequence.update(brake(2000));
+    car.press_start();
+    TEST_ASSERT_TRUE(car.sequence.sound());
+
+    car.clock.advance(1999999);
+    car.sequence.poll();
+    TEST_ASSERT_TRUE(car.sequence.sound());
+    car.clock.advance(1);
+    car.sequence.poll();
+    TEST_ASSERT_FALSE(car.sequence.sound());
+    TEST_ASSERT_EQUAL(2000000, car.sequence.statistics().last_sound_us);
+    TEST_ASSERT_EQUAL(2, car.sounds.size());
+    TEST_ASSERT_FALSE(car.sounds[1]);
+    // Still ready to drive, only the sound ended
+    TEST_ASSERT_TRUE(car.sequence.ready());
+
+    // Configured durations are kept within EV 9.2.1
+    car.press_start();
+    car.sequence.config.sound_us = 5000000;
+    car.press_start();
+    car.clock.advance(ShutdownSequence::SOUND_MAX_US);
+    car.sequence.poll();
+    TEST_ASSERT_EQUAL(ShutdownSequence::SOUND_MAX_US, car.sequence.statistics().last_sound_us);
+
+    car.press_start();
+    car.sequence.config.sound_us = 200000;
+    car.press_start();
+    car.clock.advance(200000);
+    car.sequence.poll();
+    TEST_ASSERT_TRUE(car.sequence.sound());
+    car.clock.advance(ShutdownSequence::SOUND_MIN_US - 200000);
+    car.sequence.poll();
+    TEST_ASSERT_FALSE(car.sequence.sound());
+    TEST_ASSERT_EQUAL(3, car.sequence.statistics().sounds);
+}
+
+void test_shutdown_sequence_sound_stops_when_leaving() {
+    Car car;
+    car.energize();
+    car.sequence.update(brake(2000));
+    car.press_start();
+
+    car.clock.advance(300000);
+    car.sequence.set_shutdown(false);
+    TEST_ASSERT_EQUAL(VehicleState::TS_OFF, car.sequence.state());
+    TEST_ASSERT_FALSE(car.sequence.ready());
+    TEST_ASSERT_FALSE(car.sequence.sound());
+    TEST_ASSERT_EQUAL(1, car.sequence.statistics().sounds_cut);
+    TEST_ASSERT_EQUAL(300000, car.sequence.statistics().last_sound_us);
+}
+
+void test_shutdown_sequence_start_held_does_not_rearm() {
+    Car car;
+    car.energize();
+    car.sequence.update(brake(2000));
+
+    // Held through a shutdown, no new edge, no ready to drive
+    car.sequence.set_start(true);
+    TEST_ASSERT_EQUAL(VehicleState::READY_TO_DRIVE, car.sequence.state());
+    car.sequence.set_shutdown(false);
+    car.sequence.set_shutdown(true);
+    car.sequence.dispatch(link_voltage(390));
+    TEST_ASSERT_EQUAL(VehicleState::TS_ENERGIZED, car.sequence.state());
+    car.sequence.set_start(true);
+    TEST_ASSERT_EQUAL(VehicleState::TS_ENERGIZED, car.sequence.state());
+
+    car.sequence.set_start(false);
+    car.sequence.set_start(true);
+    TEST_ASSERT_EQUAL(VehicleState::READY_TO_DRIVE, car.sequence.state());
+}
+
+void test_shutdown_sequence_lockouts() {
+    Car car;
+    car.energize();
+    car.sequence.update(brake(2000));
+    car.press_start();
+
+    TEST_ASSERT_TRUE(car.sequence.dispatch(VehicleEvent::IMD_FAULT));
+    TEST_ASSERT_EQUAL(VehicleState::IMD_LOCKOUT, car.sequence.state());
+    TEST_ASSERT_FALSE(car.sequence.ready());
+
+    // Only the matching reset leaves the lockout, not the cockpit BRB or another reset
+    car.sequence.set_shutdown(false);
+    car.sequence.set_shutdown(true);
+    TEST_ASSERT_FALSE(car.sequence.dispatch(VehicleEvent::AMS_RESET));
+    TEST_ASSERT_EQUAL(VehicleState::IMD_LOCKOUT, car.sequence.state());
+
+    // The circuit is still closed, so TS off goes straight on to precharge
+    TEST_ASSERT_TRUE(car.sequence.dispatch(VehicleEvent::IMD_RESET));
+    TEST_ASSERT_EQUAL(VehicleState::PRECHARGE, car.sequence.state());
+
+    // Also from TS off, and GLV off from anywhere
+    car.sequence.set_shutdown(false);
+    car.sequence.dispatch(VehicleEvent::BRAKE_OVERTRAVEL);
+    TEST_ASSERT_EQUAL(VehicleState::BRAKE_LOCKOUT, car.sequence.state());
+    car.sequence.set_glv(false);
+    TEST_ASSERT_EQUAL(VehicleState::GLV_OFF, car.sequence.state());
+    TEST_ASSERT_FALSE(car.sequence.dispatch(VehicleEvent::AMS_FAULT));
+}
+
+void test_shutdown_sequence_precharge_needs_fresh_voltages() {
+    Car car;
+    car.sequence.set_glv(true);
+    car.sequence.set_shutdown(true);
+
+    car.sequence.dispatch(pack_voltage(4000));
+    car.clock.advance(600000);
+    car.sequence.dispatch(link_voltage(390));
+    TEST_ASSERT_EQUAL(VehicleState::PRECHARGE, car.sequence.state());
+
+    // Another inverter and unrelated frames are not used
+    TEST_ASSERT_FALSE(car.sequence.dispatch(link_voltage(390, DEFAULT_NODE + 1)));
+    Message22 temperatures = { 0, 0, FaultCodes::NONE, 0 };
+    Frame other(identifier(Packet::GENERAL_DATA_3, DEFAULT_NODE), &temperatures);
+    other.extd = 1;
+    TEST_ASSERT_FALSE(car.sequence.dispatch(other));
+
+    car.sequence.dispatch(pack_voltage(4000));
+    TEST_ASSERT_EQUAL(VehicleState::TS_ENERGIZED, car.sequence.state());
+}
+
+void test_shutdown_sequence_default_config_reads_orion_counts() {
+    MockClockStrategy clock;
+    clock.now = 1000000;
+    ShutdownSequence sequence(&clock);
+    sequence.start();
+    sequence.set_glv(true);
+    sequence.set_shutdown(true);
+
+    // 400 V pack, a DC link at 4 V is far from precharged
+    sequence.dispatch(pack_voltage(4000));
+    sequence.dispatch(link_voltage(4));
+    TEST_ASSERT_EQUAL(VehicleState::PRECHARGE, sequence.state());
+    sequence.dispatch(link_voltage(359));
+    TEST_ASSERT_EQUAL(VehicleState::PRECHARGE, sequence.state());
+
+    sequence.dispatch(link_voltage(360));
+    TEST_ASSERT_EQUAL(VehicleState::TS_ENERGIZED, sequence.state());
+}
+
+void run_shutdown_sequence_tests() {
+    RUN_TEST(test_shutdown_sequence_to_ready_to_drive);
+    RUN_TEST(test_shutdown_sequence_sound_timing);
+    RUN_TEST(test_shutdown_sequence_sound_stops_when_leaving);
+    RUN_TEST(test_shutdown_sequence_start_held_does_not_rearm);
+    RUN_TEST(test_shutdown_sequence_lockouts);
+    RUN_TEST(test_shutdown_sequence_precharge_needs_fresh_voltages);
+    RUN_TEST(test_shutdown_sequence_default_config_reads_orion_counts);
+}
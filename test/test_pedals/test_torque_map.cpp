@@ -0,0 +1,45 @@
+#include <pedals.h>
+
+#include "test_main.h"
+
+using namespace Pedals;
+
+void test_torque_map_defaults_to_linear() {
+    TorqueMap map;
+    TEST_ASSERT_EQUAL(0, map.map(0));
+    TEST_ASSERT_EQUAL(333, map.map(333));
+    TEST_ASSERT_EQUAL(TORQUE_FULL, map.map(TRAVEL_FULL));
+}
+
+void test_torque_map_interpolates_and_holds_ends() {
+    TorqueMap map;
+    // Dead band at the top of the pedal, progressive response below it
+    const TorqueMap::Point points[] = { { 50, 0 }, { 500, 200 }, { 900, 1000 } };
+    TEST_ASSERT_TRUE(map.set(points, 3));
+    TEST_ASSERT_EQUAL(3, map.size());
+
+    TEST_ASSERT_EQUAL(0, map.map(0));
+    TEST_ASSERT_EQUAL(0, map.map(50));
+    TEST_ASSERT_EQUAL(100, map.map(275));
+    TEST_ASSERT_EQUAL(200, map.map(500));
+    TEST_ASSERT_EQUAL(600, map.map(700));
+    TEST_ASSERT_EQUAL(1000, map.map(950));
+}
+
+void test_torque_map_rejects_invalid_points() {
+    TorqueMap map;
+    const TorqueMap::Point unsorted[] = { { 500, 0 }, { 500, 1000 } };
+    TEST_ASSERT_FALSE(map.set(unsorted, 2));
+    TEST_ASSERT_FALSE(map.set(unsorted, 1));
+    TEST_ASSERT_FALSE(map.set(nullptr, 2));
+
+    // The previous map is kept
+    TEST_ASSERT_EQUAL(2, map.size());
+    TEST_ASSERT_EQUAL(500, map.map(500));
+}
+
+void run_torque_map_tests() {
+    RUN_TEST(test_torque_map_defaults_to_linear);
+    RUN_TEST(test_torque_map_interpolates_and_holds_ends);
+    RUN_TEST(test_torque_map_rejects_invalid_points);
+}
@@ -0,0 +1,187 @@
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <thread>
+#include <vector>
+#include <pedals.h>
+#include <mocks.h>
+
+#include "test_main.h"
+
+using namespace CAN;
+using namespace MOCKS;
+using namespace Pedals;
+
+struct PipelineBundle {
+    MockCanService service;
+    MockClockStrategy clock;
+    MockPedalSource source{&clock};
+    std::shared_ptr<Provider> provider{new Provider(&service)};
+    std::vector<Frame> sent;
+    TorquePipeline pipeline{provider, &source, &clock, std::unique_ptr<Core::iThreadStrategy>(new NativeThreadStrategy())};
+
+    PipelineBundle() {
+        service.on_transmit = [this](const Frame* frame, Tick) {
+            sent.push_back(*frame);
+            return Result::OK;
+        };
+        pipeline.plausibility.apps1 = { 0, 1000 };
+        pipeline.plausibility.apps2 = { 0, 1000 };
+        pipeline.plausibility.ground_threshold = 50;
+    }
+};
+
+static uint16_t relative_current(const Frame& frame) {
+    Inverter::Command::SetRelativeACCurrent command;
+    memcpy(&command, frame.data, sizeof(command));
+    return (uint16_t)command.relative_ac_current.raw;
+}
+
+static void report(const char* name, const TorquePipeline::Histogram& histogram) {
+    char message[160];
+    snprintf(message, sizeof(message), "%s: n=%u min=%uus p50<=%uus p99<=%uus p99.9<=%uus max=%uus",
+             name, histogram.count(), histogram.min(), histogram.percentile(500),
+             histogram.percentile(990), histogram.percentile(999), histogram.max());
+    TEST_MESSAGE(message);
+}
+
+void test_pipeline_sends_mapped_torque_without_blocking() {
+    PipelineBundle bundle;
+    std::vector<Tick> timeouts;
+    bundle.service.on_transmit = [&](const Frame* frame, Tick timeout) {
+        bundle.sent.push_back(*frame);
+        timeouts.push_back(timeout);
+        return Result::OK;
+    };
+
+    bundle.source.set(400, 400);
+    TEST_ASSERT_TRUE(bundle.pipeline.cycle());
+
+    TEST_ASSERT_EQUAL(1, bundle.sent.size());
+    TEST_ASSERT_EQUAL_HEX32(0x0552, bundle.sent[0].identifier);
+    TEST_ASSERT_EQUAL(1, bundle.sent[0].extd);
+    TEST_ASSERT_EQUAL(400, relative_current(bundle.sent[0]));
+    TEST_ASSERT_EQUAL(0, timeouts[0]);
+    TEST_ASSERT_EQUAL(400, bundle.pipeline.command());
+    TEST_ASSERT_EQUAL(1, bundle.pipeline.statistics().cycles);
+}
+
+void test_pipeline_commands_zero_on_fault() {
+    PipelineBundle bundle;
+    bundle.source.set(600, 600);
+    bundle.pipeline.cycle();
+    TEST_ASSERT_EQUAL(600, bundle.pipeline.command());
+
+    // APPS2 shorted to sensor power
+    bundle.source.set(600, 4095);
+    bundle.pipeline.cycle();
+    TEST_ASSERT_EQUAL(PedalFault::APPS2_SHORT_TO_SUPPLY, bundle.pipeline.fault());
+    TEST_ASSERT_EQUAL(0, relative_current(bundle.sent.back()));
+
+    // No reading at all
+    bundle.source.set(600, 600);
+    bundle.source.available = false;
+    bundle.pipeline.cycle();
+    TEST_ASSERT_EQUAL(PedalFault::NO_SAMPLE, bundle.pipeline.fault());
+    TEST_ASSERT_EQUAL(0, relative_current(bundle.sent.back()));
+
+    TEST_ASSERT_EQUAL(2, bundle.pipeline.statistics().faults);
+    TEST_ASSERT_EQUAL(3, bundle.sent.size());
+}
+
+void test_pipeline_limits_torque_and_ramp() {
+    PipelineBundle bundle;
+    bundle.pipeline.max_torque = 800;
+    bundle.pipeline.max_step = 300;
+
+    bundle.source.set(1000, 1000);
+    bundle.pipeline.cycle();
+    TEST_ASSERT_EQUAL(300, bundle.pipeline.command());
+    bundle.pipeline.cycle();
+    TEST_ASSERT_EQUAL(600, bundle.pipeline.command());
+    bundle.pipeline.cycle();
+    TEST_ASSERT_EQUAL(800, bundle.pipeline.command());
+
+    // Lifting off is never rate limited
+    bundle.source.set(100, 100);
+    bundle.pipeline.cycle();
+    TEST_ASSERT_EQUAL(100, bundle.pipeline.command());
+}
+
+void test_pipeline_counts_refused_commands() {
+    PipelineBundle bundle;
+    bundle.service.on_transmit = [](const Frame*, Tick) { return Result::ERR_TIMEOUT; };
+
+    bundle.source.set(500, 500);
+    TEST_ASSERT_FALSE(bundle.pipeline.cycle());
+    TEST_ASSERT_EQUAL(1, bundle.pipeline.statistics().transmit_failures);
+}
+
+void test_pipeline_measures_latency() {
+    PipelineBundle bundle;
+    bundle.service.on_transmit = [&](const Frame*, Tick) {
+        bundle.clock.advance(37);
+        return Result::OK;
+    };
+
+    bundle.source.set(500, 500);
+    bundle.pipeline.cycle();
+    TEST_ASSERT_EQUAL(1, bundle.pipeline.latency().count());
+    TEST_ASSERT_EQUAL(37, bundle.pipeline.latency().max());
+    // Percentiles report the bucket bound, capped at the largest value seen
+    TEST_ASSERT_EQUAL(37, bundle.pipeline.latency().percentile(500));
+}
+
+void test_pipeline_runs_at_rate_and_stops_at_zero() {
+    NullCanService service;
+    NativeClockStrategy clock;
+    MockPedalSource source(&clock);
+    source.set(3000, 3000);
+    std::shared_ptr<Provider> provider(new Provider(&service));
+    TorquePipeline pipeline(provider, &source, &clock, std::unique_ptr<Core::iThreadStrategy>(new NativeThreadStrategy()));
+
+    pipeline.start();
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    pipeline.stop();
+
+    TorquePipeline::Statistics statistics = pipeline.statistics();
+    // Roughly 200 cycles at 1 kHz, loose bounds for a loaded host
+    TEST_ASSERT_GREATER_OR_EQUAL(50, statistics.cycles);
+    TEST_ASSERT_LESS_OR_EQUAL(260, statistics.cycles);
+    TEST_ASSERT_EQUAL(statistics.cycles, source.samples);
+    TEST_ASSERT_EQUAL(0, pipeline.command());
+
+    report("pipeline latency", pipeline.latency());
+    report("pipeline release jitter", pipeline.jitter());
+}
+
+void test_pipeline_latency_harness() {
+    NullCanService service;
+    NativeClockStrategy clock;
+    MockPedalSource source(&clock);
+    std::shared_ptr<Provider> provider(new Provider(&service));
+    TorquePipeline pipeline(provider, &source, &clock, std::unique_ptr<Core::iThreadStrategy>(new NativeThreadStrategy()));
+
+    const uint32_t CYCLES = 20000;
+    for (uint32_t i = 0; i < CYCLES; i++) {
+        // Sweep the pedal so every segment of the map is exercised
+        uint16_t raw = (uint16_t)((i * 7) % 4096);
+        source.set(raw, raw);
+        pipeline.cycle();
+    }
+
+    TEST_ASSERT_EQUAL(CYCLES, pipeline.latency().count());
+    report("cycle latency", pipeline.latency());
+}
+
+void run_torque_pipeline_tests() {
+    RUN_TEST(test_pipeline_sends_mapped_torque_without_blocking);
+    RUN_TEST(test_pipeline_commands_zero_on_fault);
+    RUN_TEST(test_pipeline_limits_torque_and_ramp);
+    RUN_TEST(test_pipeline_counts_refused_commands);
+    RUN_TEST(test_pipeline_measures_latency);
+    RUN_TEST(test_pipeline_runs_at_rate_and_stops_at_zero);
+    RUN_TEST(test_pipeline_latency_harness);
+}
@@ -0,0 +1,153 @@
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <pump.h>
+#include <mocks.h>
+
+#include "test_main.h"
+
+using namespace CAN;
+using namespace MOCKS;
+using namespace Pump;
+using namespace Inverter;
+using namespace Inverter::DTIX50;
+
+static Frame temperatures(int16_t controller, int16_t motor, uint8_t node = DEFAULT_NODE) {
+    Message22 message = { (uint16_t)controller, (uint16_t)motor, FaultCodes::NONE, 0xFFFFFF };
+    Frame frame(identifier(Packet::GENERAL_DATA_3, node), &message);
+    frame.extd = 1;
+    return frame;
+}
+
+struct Bench {
+    MockPwmOutput pump;
+    MockPwmOutput fan;
+    MockClockStrategy clock;
+    CoolingController controller;
+
+    Bench() : controller(&pump, &fan, &clock, std::unique_ptr<Core::iThreadStrategy>(new NativeThreadStrategy())) {}
+
+    void steps(uint32_t count) {
+        for (uint32_t i = 0; i < count; i++) {
+            clock.advance(controller.period_us);
+            controller.step();
+        }
+    }
+};
+
+void test_cooling_flat_out_without_temperatures() {
+    Bench bench;
+    bench.controller.step();
+    bench.steps(3);
+
+    // Written once, never repeated while nothing changes
+    TEST_ASSERT_EQUAL(1, bench.pump.writes.size());
+    TEST_ASSERT_EQUAL(CoolingController::FULL, bench.pump.last());
+    TEST_ASSERT_EQUAL(1, bench.fan.writes.size());
+    TEST_ASSERT_EQUAL(CoolingController::FULL, bench.fan.last());
+    TEST_ASSERT_EQUAL(4, bench.controller.statistics().stale);
+}
+
+void test_cooling_idles_when_cool() {
+    Bench bench;
+    TEST_ASSERT_TRUE(bench.controller.dispatch(temperatures(300, 500)));
+    bench.controller.step();
+    TEST_ASSERT_EQUAL(-200, bench.controller.error());
+    TEST_ASSERT_EQUAL(300, bench.pump.last());
+    TEST_ASSERT_EQUAL(0, bench.fan.last());
+
+    for (uint32_t i = 0; i < 20; i++) {
+        bench.controller.dispatch(temperatures(300, 500));
+        bench.steps(1);
+    }
+    TEST_ASSERT_EQUAL(1, bench.pump.writes.size());
+    TEST_ASSERT_EQUAL(1, bench.fan.writes.size());
+    TEST_ASSERT_EQUAL(21, bench.controller.statistics().updates);
+}
+
+void test_cooling_pi_tracks_hottest_component() {
+    Bench bench;
+    // Motor 10 degrees over its target, the controller well below its own
+    bench.controller.dispatch(temperatures(400, 900));
+    bench.controller.step();
+    TEST_ASSERT_EQUAL(100, bench.controller.error());
+    TEST_ASSERT_EQUAL(700, bench.pump.last());
+    TEST_ASSERT_EQUAL(700, bench.fan.last());
+
+    // Integral adds half a percent per step, written every full percent
+    bench.steps(10);
+    TEST_ASSERT_EQUAL(750, bench.pump.last());
+    TEST_ASSERT_EQUAL(6, bench.pump.writes.size());
+    TEST_ASSERT_EQUAL(1, bench.fan.writes.size());
+
+    // Saturated, the integral holds instead of winding up
+    bench.controller.dispatch(temperatures(400, 1100));
+    bench.steps(20);
+    TEST_ASSERT_EQUAL(CoolingController::FULL, bench.pump.last());
+    TEST_ASSERT_EQUAL(CoolingController::FULL, bench.fan.last());
+
+    // Back on target only the integral is left
+    bench.controller.dispatch(temperatures(400, 800));
+    bench.steps(1);
+    TEST_ASSERT_EQUAL(350, bench.pump.last());
+    TEST_ASSERT_EQUAL(0, bench.fan.last());
+}
+
+void test_cooling_stale_and_failed_writes() {
+    Bench bench;
+    bench.pump.accept = false;
+    bench.controller.dispatch(temperatures(300, 500));
+    bench.controller.step();
+    TEST_ASSERT_EQUAL(1, bench.controller.statistics().write_failures);
+
+    // Retried on the next step
+    bench.pump.accept = true;
+    bench.steps(1);
+    TEST_ASSERT_EQUAL(300, bench.pump.last());
+
+    // The broadcast stops
+    bench.clock.advance(bench.controller.config.input_timeout_us);
+    bench.controller.step();
+    TEST_ASSERT_EQUAL(CoolingController::FULL, bench.pump.last());
+    TEST_ASSERT_EQUAL(CoolingController::FULL, bench.fan.last());
+    TEST_ASSERT_EQUAL(1, bench.controller.statistics().stale);
+}
+
+void test_cooling_dispatch_filters_frames() {
+    Bench bench;
+    TEST_ASSERT_FALSE(bench.controller.dispatch(temperatures(300, 500, 0x53)));
+    Frame standard = temperatures(300, 500);
+    standard.extd = 0;
+    TEST_ASSERT_FALSE(bench.controller.dispatch(standard));
+    TEST_ASSERT_TRUE(bench.controller.dispatch(temperatures(300, 500)));
+    TEST_ASSERT_EQUAL(1, bench.controller.statistics().updates);
+}
+
+void test_cooling_task_leaves_outputs_flat_out() {
+    MockPwmOutput pump;
+    MockPwmOutput fan;
+    NativeClockStrategy clock;
+    CoolingController controller(&pump, &fan, &clock, std::unique_ptr<Core::iThreadStrategy>(new NativeThreadStrategy()));
+    controller.period_us = 2000;
+    controller.dispatch(temperatures(300, 500));
+
+    controller.start();
+    TEST_ASSERT_TRUE(controller.started());
+    std::this_thread::sleep_for(std::chrono::milliseconds(30));
+    controller.stop();
+    TEST_ASSERT_FALSE(controller.started());
+
+    TEST_ASSERT_GREATER_THAN(5, controller.statistics().steps);
+    TEST_ASSERT_EQUAL(300, pump.writes.front());
+    TEST_ASSERT_EQUAL(CoolingController::FULL, pump.last());
+    TEST_ASSERT_EQUAL(CoolingController::FULL, fan.last());
+}
+
+void run_cooling_controller_tests() {
+    RUN_TEST(test_cooling_flat_out_without_temperatures);
+    RUN_TEST(test_cooling_idles_when_cool);
+    RUN_TEST(test_cooling_pi_tracks_hottest_component);
+    RUN_TEST(test_cooling_stale_and_failed_writes);
+    RUN_TEST(test_cooling_dispatch_filters_frames);
+    RUN_TEST(test_cooling_task_leaves_outputs_flat_out);
+}
@@ -17,5 +17,6 @@ void test_pump_basic() {
 int main() {
     UNITY_BEGIN();
     RUN_TEST(test_pump_basic);
+    run_cooling_controller_tests();
     return UNITY_END();
 }
\ No newline at end of file